@@ -197,6 +197,24 @@ bool ExampleBase::ParseAndCheckExampleOptions(int argc, const char* argv[]) {
 
 const wnn::Operand ExampleBase::BuildConstantFromNpy(const wnn::GraphBuilder& builder,
                                                          const std::string& path) {
+    // Let the graph builder map the weights in place of reading them into a heap copy, the
+    // float data of a C-ordered npy file follows its header. The wire server of the samples
+    // doesn't allow mapping files, see WireServerDescriptor::constantFileDirectory.
+    FILE* fp = cmdBufType == CmdBufType::None ? fopen(path.c_str(), "rb") : nullptr;
+    if (fp != nullptr) {
+        size_t wordSize;
+        std::vector<int32_t> shape;
+        bool fortranOrder;
+        cnpy::parse_npy_header(fp, wordSize, shape, fortranOrder);
+        long headerSize = ftell(fp);
+        fclose(fp);
+        if (!fortranOrder && wordSize == sizeof(float) && headerSize > 0) {
+            wnn::OperandDescriptor desc = {wnn::OperandType::Float32, shape.data(),
+                                           (uint32_t)shape.size()};
+            return builder.ConstantFromFile(&desc, path.c_str(), headerSize,
+                                            utils::SizeOfShape(shape) * sizeof(float));
+        }
+    }
     const cnpy::NpyArray data = cnpy::npy_load(path);
     mConstants.push_back(data.data_holder);
     return utils::BuildConstant(builder, data.shape, data.data<float>(), data.num_bytes());
@@ -239,6 +257,9 @@ namespace utils {
                 activationOperator = builder.LeakyReluOperator(leakyReluOptions);
                 break;
             }
+            case FusedActivation::HARDSWISH:
+                activationOperator = builder.HardSwishOperator();
+                break;
             default:
                 dawn::ErrorLog() << "The activation is unsupported";
                 DAWN_ASSERT(0);
@@ -271,6 +292,9 @@ namespace utils {
                 activationOperand = builder.LeakyRelu(input, leakyReluOptions);
                 break;
             }
+            case FusedActivation::HARDSWISH:
+                activationOperand = builder.HardSwish(input);
+                break;
             default:
                 dawn::ErrorLog() << "The activation is unsupported";
                 DAWN_ASSERT(0);
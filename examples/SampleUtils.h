@@ -68,7 +68,7 @@ namespace utils {
 
     uint32_t SizeOfShape(const std::vector<int32_t>& dims);
 
-    enum FusedActivation { NONE, RELU, RELU6, SIGMOID, LEAKYRELU, TANH };
+    enum FusedActivation { NONE, RELU, RELU6, SIGMOID, LEAKYRELU, TANH, HARDSWISH };
 
     wnn::ClampOptions CreateClampOptions(const wnn::GraphBuilder& builder,
                                          const std::vector<int32_t>& minShape,
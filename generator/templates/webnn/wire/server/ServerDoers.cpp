@@ -105,6 +105,7 @@ namespace webnn::wire::server {
                     if (data->handle != nullptr) {
                         mProcs.{{as_varName(type.name, Name("release"))}}(data->handle);
                     }
+                    OnObjectDestroyed(objectType, objectId);
                     {{type.name.CamelCase()}}Objects().Free(objectId);
                     return true;
                 }
@@ -107,6 +107,7 @@ namespace webnn::wire::server {
     {% endfor %}
 
     const volatile char* Server::HandleCommandsImpl(const volatile char* commands, size_t size) {
+        ProcessEvents();
         while (size >= sizeof(CmdHeader) + sizeof(WireCmd)) {
             // Start by chunked command handling, if it is done, then it means the whole buffer
             // was consumed by it, so we return a pointer to the end of the commands.
@@ -120,6 +121,9 @@ namespace webnn::wire::server {
             }
 
             WireCmd cmdId = *reinterpret_cast<const volatile WireCmd*>(commands + sizeof(CmdHeader));
+            if (cmdId != WireCmd::GraphComputeAsync) {
+                FlushPendingComputes();
+            }
             bool success = false;
             switch (cmdId) {
                 {% for command in cmd_records["command"] %}
@@ -141,6 +145,8 @@ namespace webnn::wire::server {
             return nullptr;
         }
 
+        FlushPendingComputes();
+        ProcessEvents();
         return commands;
     }
 
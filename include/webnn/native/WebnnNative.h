@@ -55,6 +55,14 @@ namespace webnn::native {
     // Backend-agnostic API for webnn_native
     WEBNN_NATIVE_EXPORT const WebnnProcTable& GetProcs();
 
+    // Adds a span timed in microseconds of std::chrono::steady_clock to the trace the contexts
+    // write when created with a trace file, it does nothing if there's no trace. It matches
+    // webnn::wire::TraceEventCallback so that the spans of the wire can be added too.
+    WEBNN_NATIVE_EXPORT void AddTraceEvent(const char* category,
+                                           const char* name,
+                                           uint64_t startMicroseconds,
+                                           uint64_t durationMicroseconds);
+
 }  // namespace webnn::native
 
 #endif  // WEBNN_NATIVE_WEBNN_NATIVE_H_
@@ -24,6 +24,14 @@
 
 namespace webnn::wire {
 
+    // Receives the spans of the work of the wire, timed in microseconds of
+    // std::chrono::steady_clock, e.g. webnn::native::AddTraceEvent to add them to the trace of
+    // the native contexts.
+    using TraceEventCallback = void (*)(const char* category,
+                                        const char* name,
+                                        uint64_t startMicroseconds,
+                                        uint64_t durationMicroseconds);
+
     class WEBNN_WIRE_EXPORT CommandSerializer {
       public:
         virtual ~CommandSerializer() = default;
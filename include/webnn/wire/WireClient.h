@@ -32,6 +32,8 @@ namespace webnn::wire {
 
     struct WEBNN_WIRE_EXPORT WireClientDescriptor {
         CommandSerializer* serializer;
+        // Traces the serialization of the commands and the handling of the returned ones.
+        TraceEventCallback traceEvent = nullptr;
     };
 
     struct ReservedInstance {
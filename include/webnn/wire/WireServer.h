@@ -38,6 +38,17 @@ namespace webnn::wire {
     struct WEBNN_WIRE_EXPORT WireServerDescriptor {
         const WebnnProcTable* procs;
         CommandSerializer* serializer;
+        // The most GraphComputeAsync commands for the same graph that are coalesced into one
+        // compute along the leading dimension of the inputs and outputs, 1 disables batching.
+        // Only consecutive commands handled by the same HandleCommands call are coalesced, and
+        // only for the graphs that are batchable, see wnn::Graph::IsBatchable. The others are
+        // computed per request.
+        uint32_t maxComputeBatchSize = 1;
+        // Traces the handling of the commands and the serialization of the returned ones.
+        TraceEventCallback traceEvent = nullptr;
+        // GraphBuilder.constantFromFile maps files of the server process, so it's only allowed
+        // for the files under this directory. Null rejects every path.
+        const char* constantFileDirectory = nullptr;
     };
 
     class WEBNN_WIRE_EXPORT WireServer : public CommandHandler {
@@ -48,6 +59,11 @@ namespace webnn::wire {
         const volatile char* HandleCommands(const volatile char* commands,
                                             size_t size) override final;
 
+        // The replies to GraphComputeAsync are sent once the computes complete on the workers of
+        // the contexts, from HandleCommands or from here. Call it while no commands come in to
+        // deliver them.
+        void ProcessEvents();
+
         bool InjectInstance(WNNInstance instance, uint32_t id, uint32_t generation);
 
 #if defined(WEBNN_ENABLE_GPU_BUFFER)
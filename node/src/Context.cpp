@@ -16,6 +16,7 @@
 
 #include <napi.h>
 #include <iostream>
+#include <vector>
 
 #include "ML.h"
 
@@ -26,6 +27,8 @@ namespace node {
     Context::Context(const Napi::CallbackInfo& info) : Napi::ObjectWrap<Context>(info) {
         wnn::ContextOptions options = {wnn::DevicePreference::Default,
                                        wnn::PowerPreference::Default};
+        std::string cacheDirectory;
+        std::vector<uint32_t> cpuAffinity;
         if (info.Length() > 0) {
             Napi::Object optionsObject = info[0].As<Napi::Object>();
             if (optionsObject.Has("powerPreference")) {
@@ -67,6 +70,73 @@ namespace node {
                     return;
                 }
             }
+
+            if (optionsObject.Has("cacheDirectory")) {
+                if (!optionsObject.Get("cacheDirectory").IsString()) {
+                    Napi::Error::New(info.Env(), "Invaild cacheDirectory")
+                        .ThrowAsJavaScriptException();
+                    return;
+                }
+                cacheDirectory = optionsObject.Get("cacheDirectory").ToString();
+                options.cacheDirectory = cacheDirectory.c_str();
+            }
+
+            if (optionsObject.Has("threadCount")) {
+                if (!optionsObject.Get("threadCount").IsNumber()) {
+                    Napi::Error::New(info.Env(), "Invaild threadCount")
+                        .ThrowAsJavaScriptException();
+                    return;
+                }
+                options.threadCount = optionsObject.Get("threadCount").ToNumber().Uint32Value();
+            }
+
+            if (optionsObject.Has("cpuAffinity")) {
+                if (!optionsObject.Get("cpuAffinity").IsArray()) {
+                    Napi::Error::New(info.Env(), "Invaild cpuAffinity")
+                        .ThrowAsJavaScriptException();
+                    return;
+                }
+                Napi::Array jsCpuAffinity = optionsObject.Get("cpuAffinity").As<Napi::Array>();
+                for (uint32_t i = 0; i < jsCpuAffinity.Length(); ++i) {
+                    if (!static_cast<Napi::Value>(jsCpuAffinity[i]).IsNumber()) {
+                        Napi::Error::New(info.Env(), "Invaild cpuAffinity")
+                            .ThrowAsJavaScriptException();
+                        return;
+                    }
+                    cpuAffinity.push_back(
+                        static_cast<Napi::Value>(jsCpuAffinity[i]).ToNumber().Uint32Value());
+                }
+                options.cpuAffinity = cpuAffinity.data();
+                options.cpuAffinityCount = cpuAffinity.size();
+            }
+
+            if (optionsObject.Has("numaNode")) {
+                if (!optionsObject.Get("numaNode").IsNumber()) {
+                    Napi::Error::New(info.Env(), "Invaild numaNode").ThrowAsJavaScriptException();
+                    return;
+                }
+                options.numaNode = optionsObject.Get("numaNode").ToNumber().Int32Value();
+            }
+
+            if (optionsObject.Has("threadWaitPolicy")) {
+                if (!optionsObject.Get("threadWaitPolicy").IsString()) {
+                    Napi::Error::New(info.Env(), "Invaild threadWaitPolicy")
+                        .ThrowAsJavaScriptException();
+                    return;
+                }
+                std::string threadWaitPolicy = optionsObject.Get("threadWaitPolicy").ToString();
+                if (threadWaitPolicy == "default") {
+                    options.threadWaitPolicy = wnn::ThreadWaitPolicy::Default;
+                } else if (threadWaitPolicy == "spin") {
+                    options.threadWaitPolicy = wnn::ThreadWaitPolicy::Spin;
+                } else if (threadWaitPolicy == "yield") {
+                    options.threadWaitPolicy = wnn::ThreadWaitPolicy::Yield;
+                } else {
+                    Napi::Error::New(info.Env(), "Invaild threadWaitPolicy")
+                        .ThrowAsJavaScriptException();
+                    return;
+                }
+            }
         }
 
         mImpl = wnn::Context::Acquire(ML::GetInstance()->CreateContext(&options));
@@ -16,30 +16,13 @@
 
 #include <iostream>
 #include <map>
+#include <memory>
+#include <string>
 
 #include "Utils.h"
 
 namespace node {
 
-    struct Input {
-      public:
-        wnn::ArrayBufferView bufferView;
-        std::vector<int32_t> dimensions;
-
-        const wnn::Input* AsPtr() {
-            mInput.resource.arrayBufferView = bufferView;
-            mInput.resource.gpuBufferView = {};
-            if (!dimensions.empty()) {
-                mInput.dimensions = dimensions.data();
-                mInput.dimensionsCount = dimensions.size();
-            }
-            return &mInput;
-        }
-
-      private:
-        wnn::Input mInput;
-    };
-
     bool GetNamedInputs(const Napi::Value& jsValue, std::map<std::string, Input>& namedInputs) {
         if (!jsValue.IsObject()) {
             return false;
@@ -111,6 +94,37 @@ namespace node {
         return true;
     }
 
+    void ReferenceTypedArrays(const Napi::Value& jsValue,
+                              std::vector<Napi::ObjectReference>& references) {
+        Napi::Object jsNamedResources = jsValue.As<Napi::Object>();
+        Napi::Array names = jsNamedResources.GetPropertyNames();
+        for (size_t i = 0; i < names.Length(); ++i) {
+            Napi::Value jsResource = jsNamedResources.Get(names.Get(i));
+            if (!jsResource.IsTypedArray()) {
+                // MLInput dictionary, GetNamedInputs has checked its resource.
+                jsResource = jsResource.As<Napi::Object>().Get("resource");
+            }
+            references.push_back(Napi::Persistent(jsResource.As<Napi::Object>()));
+        }
+    }
+
+    // The state of one computeAsync() call, it lives until the promise is settled on the JS
+    // thread.
+    struct ComputeAsyncRequest {
+        explicit ComputeAsyncRequest(Napi::Env env) : deferred(Napi::Promise::Deferred::New(env)) {
+        }
+
+        Napi::Promise::Deferred deferred;
+        Napi::ThreadSafeFunction settle;
+        // The native named inputs point at the dimensions of these records.
+        std::map<std::string, Input> inputs;
+        std::map<std::string, wnn::Resource> outputs;
+        // Pin the typed arrays the graph reads and writes while it runs off the JS thread.
+        std::vector<Napi::ObjectReference> buffers;
+        WNNErrorType type = WNNErrorType_NoError;
+        std::string message;
+    };
+
     Napi::FunctionReference Graph::constructor;
 
     Graph::Graph(const Napi::CallbackInfo& info) : Napi::ObjectWrap<Graph>(info) {
@@ -138,10 +152,139 @@ namespace node {
         return Napi::Number::New(info.Env(), 0);
     }
 
+    Napi::Value Graph::ComputeAsync(const Napi::CallbackInfo& info) {
+        // Promise<void> computeAsync(NamedInputs inputs, NamedOutputs outputs);
+        WEBNN_NODE_ASSERT(info.Length() == 2, "The number of arguments is invalid.");
+        Napi::Env env = info.Env();
+        std::unique_ptr<ComputeAsyncRequest> request(new ComputeAsyncRequest(env));
+        WEBNN_NODE_ASSERT(GetNamedInputs(info[0], request->inputs),
+                          "The inputs parameter is invalid.");
+        WEBNN_NODE_ASSERT(GetNamedOutputs(info[1], request->outputs),
+                          "The outputs parameter is invalid.");
+
+        wnn::NamedInputs namedInputs = wnn::CreateNamedInputs();
+        for (auto& input : request->inputs) {
+            namedInputs.Set(input.first.data(), input.second.AsPtr());
+        }
+        wnn::NamedOutputs namedOutputs = wnn::CreateNamedOutputs();
+        for (auto& output : request->outputs) {
+            namedOutputs.Set(output.first.data(), &output.second);
+        }
+        ReferenceTypedArrays(info[0], request->buffers);
+        ReferenceTypedArrays(info[1], request->buffers);
+
+        Napi::Promise promise = request->deferred.Promise();
+        request->settle = Napi::ThreadSafeFunction::New(
+            env, Napi::Function::New(env, [](const Napi::CallbackInfo&) {}), "computeAsync", 0, 1);
+        // The callback is called on a worker thread of the native context, the promise is
+        // settled back on the JS thread.
+        mImpl.ComputeAsync(
+            namedInputs, namedOutputs,
+            [](WNNErrorType type, char const* message, void* userdata) {
+                ComputeAsyncRequest* request = static_cast<ComputeAsyncRequest*>(userdata);
+                request->type = type;
+                request->message = message;
+                Napi::ThreadSafeFunction settle = request->settle;
+                settle.BlockingCall(request, [](Napi::Env env, Napi::Function,
+                                                ComputeAsyncRequest* request) {
+                    std::unique_ptr<ComputeAsyncRequest> done(request);
+                    if (done->type == WNNErrorType_NoError) {
+                        done->deferred.Resolve(env.Undefined());
+                    } else {
+                        done->deferred.Reject(Napi::Error::New(env, done->message).Value());
+                    }
+                });
+                settle.Release();
+            },
+            request.release());
+
+        return promise;
+    }
+
+    Napi::Value Graph::Bind(const Napi::CallbackInfo& info) {
+        // void bind(NamedInputs inputs, NamedOutputs outputs);
+        WEBNN_NODE_ASSERT(info.Length() == 2, "The number of arguments is invalid.");
+        std::map<std::string, Input> inputs;
+        WEBNN_NODE_ASSERT(GetNamedInputs(info[0], inputs), "The inputs parameter is invalid.");
+
+        std::map<std::string, wnn::Resource> outputs;
+        WEBNN_NODE_ASSERT(GetNamedOutputs(info[1], outputs), "The outputs parameter is invalid.");
+
+        // The native named records copy the views but point at the dimensions of |mBoundInputs|,
+        // they are built once here and reused by every computeBound() as long as the bound typed
+        // arrays are only updated in place.
+        mBoundInputs = std::move(inputs);
+        wnn::NamedInputs namedInputs = wnn::CreateNamedInputs();
+        for (auto& input : mBoundInputs) {
+            namedInputs.Set(input.first.data(), input.second.AsPtr());
+        }
+        wnn::NamedOutputs namedOutputs = wnn::CreateNamedOutputs();
+        for (auto& output : outputs) {
+            namedOutputs.Set(output.first.data(), &output.second);
+        }
+        mImpl.Bind(namedInputs, namedOutputs);
+
+        mBoundBuffers.clear();
+        ReferenceTypedArrays(info[0], mBoundBuffers);
+        ReferenceTypedArrays(info[1], mBoundBuffers);
+
+        return info.Env().Undefined();
+    }
+
+    Napi::Value Graph::ComputeBound(const Napi::CallbackInfo& info) {
+        // status computeBound();
+        WEBNN_NODE_ASSERT(info.Length() == 0, "The number of arguments is invalid.");
+        WEBNN_NODE_ASSERT(!mBoundBuffers.empty(), "The graph has no bound inputs and outputs.");
+        mImpl.ComputeBound();
+
+        return Napi::Number::New(info.Env(), 0);
+    }
+
+    Napi::Value Graph::EnableProfiling(const Napi::CallbackInfo& info) {
+        // void enableProfiling(boolean enabled);
+        WEBNN_NODE_ASSERT(info.Length() == 1 && info[0].IsBoolean(),
+                          "The enabled parameter is invalid.");
+        mImpl.EnableProfiling(info[0].As<Napi::Boolean>().Value());
+
+        return info.Env().Undefined();
+    }
+
+    Napi::Value Graph::GetProfile(const Napi::CallbackInfo& info) {
+        // sequence<ProfileEntry> getProfile();
+        WEBNN_NODE_ASSERT(info.Length() == 0, "The number of arguments is invalid.");
+        Napi::Env env = info.Env();
+        uint32_t count = mImpl.GetProfileEntryCount();
+        Napi::Array jsProfile = Napi::Array::New(env, count);
+        for (uint32_t i = 0; i < count; ++i) {
+            wnn::ProfileEntry entry = {};
+            mImpl.GetProfileEntry(i, &entry);
+            Napi::Object jsEntry = Napi::Object::New(env);
+            // Entries of operators the builder didn't create have no index.
+            jsEntry.Set("operatorIndex", entry.operatorIndex == UINT32_MAX
+                                             ? env.Null()
+                                             : Napi::Number::New(env, entry.operatorIndex));
+            jsEntry.Set("operatorType", Napi::String::New(env, entry.operatorType));
+            jsEntry.Set("kernel", Napi::String::New(env, entry.kernel));
+            jsEntry.Set("milliseconds", Napi::Number::New(env, entry.milliseconds));
+            jsEntry.Set("byteLength",
+                        Napi::Number::New(env, static_cast<double>(entry.byteLength)));
+            jsProfile.Set(i, jsEntry);
+        }
+
+        return jsProfile;
+    }
+
     Napi::Object Graph::Initialize(Napi::Env env, Napi::Object exports) {
         Napi::HandleScope scope(env);
-        Napi::Function func = DefineClass(
-            env, "MLGraph", {InstanceMethod("compute", &Graph::Compute, napi_enumerable)});
+        Napi::Function func =
+            DefineClass(env, "MLGraph",
+                        {InstanceMethod("compute", &Graph::Compute, napi_enumerable),
+                         InstanceMethod("computeAsync", &Graph::ComputeAsync, napi_enumerable),
+                         InstanceMethod("bind", &Graph::Bind, napi_enumerable),
+                         InstanceMethod("computeBound", &Graph::ComputeBound, napi_enumerable),
+                         InstanceMethod("enableProfiling", &Graph::EnableProfiling,
+                                        napi_enumerable),
+                         InstanceMethod("getProfile", &Graph::GetProfile, napi_enumerable)});
         constructor = Napi::Persistent(func);
         constructor.SuppressDestruct();
         exports.Set("MLGraph", func);
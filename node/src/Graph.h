@@ -17,10 +17,31 @@
 
 #include <napi.h>
 #include <webnn/webnn_cpp.h>
+#include <map>
 #include <string>
+#include <vector>
 
 namespace node {
 
+    struct Input {
+      public:
+        wnn::ArrayBufferView bufferView;
+        std::vector<int32_t> dimensions;
+
+        const wnn::Input* AsPtr() {
+            mInput.resource.arrayBufferView = bufferView;
+            mInput.resource.gpuBufferView = {};
+            if (!dimensions.empty()) {
+                mInput.dimensions = dimensions.data();
+                mInput.dimensionsCount = dimensions.size();
+            }
+            return &mInput;
+        }
+
+      private:
+        wnn::Input mInput;
+    };
+
     class BuildGraphWorker;
     class GraphBuilder;
 
@@ -37,9 +58,18 @@ namespace node {
         friend GraphBuilder;
 
         Napi::Value Compute(const Napi::CallbackInfo& info);
+        Napi::Value ComputeAsync(const Napi::CallbackInfo& info);
+        Napi::Value Bind(const Napi::CallbackInfo& info);
+        Napi::Value ComputeBound(const Napi::CallbackInfo& info);
+        Napi::Value EnableProfiling(const Napi::CallbackInfo& info);
+        Napi::Value GetProfile(const Napi::CallbackInfo& info);
 
         wnn::Graph mImpl;
         std::vector<std::string> mOutputNames;
+        std::map<std::string, Input> mBoundInputs;
+        // The typed arrays passed to bind() stay referenced so that their backing stores, which
+        // the native graph reads and writes in place, can't be collected between computes.
+        std::vector<Napi::ObjectReference> mBoundBuffers;
     };
 
 }  // namespace node
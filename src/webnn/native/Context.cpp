@@ -14,7 +14,9 @@
 
 #include "webnn/native/Context.h"
 
+#include "webnn/native/Tracer.h"
 #include "webnn/native/ValidationUtils_autogen.h"
+#include "webnn/native/reference/ThreadPool.h"
 #include "webnn/native/webnn_platform.h"
 
 #if defined(WEBNN_ENABLE_GPU_BUFFER)
@@ -22,9 +24,18 @@
 #    include <dawn_native/DawnNative.h>
 #endif
 #include <sstream>
+#include <thread>
 
 namespace webnn::native {
 
+    namespace {
+        // Graphs of a context that are computed asynchronously may run in parallel, the backends
+        // already spread a single compute across cores so a couple of workers is enough.
+        constexpr uint32_t kExecutionQueueWorkerCount = 2;
+        // The number of asynchronous computes a context accepts before ComputeAsync blocks.
+        constexpr size_t kMaxPendingComputes = 16;
+    }  // namespace
+
     ContextBase::ContextBase(ContextOptions const* options)
 #if defined(WEBNN_ENABLE_GPU_BUFFER)
         : mWGPUDevice(nullptr)
@@ -32,17 +43,36 @@ namespace webnn::native {
     {
         if (options != nullptr) {
             mContextOptions = *options;
+            if (options->cacheDirectory != nullptr) {
+                mCacheDirectory = options->cacheDirectory;
+                mContextOptions.cacheDirectory = mCacheDirectory.c_str();
+            }
+            // The trace is written by the process, not the context.
+            mContextOptions.traceFile = nullptr;
+            if (options->cpuAffinity != nullptr) {
+                mCpuAffinity.assign(options->cpuAffinity,
+                                    options->cpuAffinity + options->cpuAffinityCount);
+            }
+            mContextOptions.cpuAffinity = mCpuAffinity.data();
+            mContextOptions.cpuAffinityCount = mCpuAffinity.size();
         }
+        mCpuThreadOptions = ResolveCpuThreadOptions(mContextOptions);
+        // The workers run the computes, which take part in the work of the backends' pools.
+        mExecutionQueue.reset(new ExecutionQueue(kExecutionQueueWorkerCount, kMaxPendingComputes,
+                                                 mCpuThreadOptions.affinity));
+        StartTracing(options != nullptr ? options->traceFile : nullptr);
         mRootErrorScope = AcquireRef(new ErrorScope());
         mCurrentErrorScope = mRootErrorScope.Get();
     }
 
 #if defined(WEBNN_ENABLE_GPU_BUFFER)
-    ContextBase::ContextBase(WGPUDevice wgpuDevice) {
+    ContextBase::ContextBase(WGPUDevice wgpuDevice)
+        : mExecutionQueue(new ExecutionQueue(kExecutionQueueWorkerCount, kMaxPendingComputes)) {
         DawnProcTable backend_procs = dawn_native::GetProcs();
         dawnProcSetProcs(&backend_procs);
         mWGPUDevice = wgpuDevice;
         wgpuDeviceReference(mWGPUDevice);
+        StartTracing(nullptr);
         mRootErrorScope = AcquireRef(new ErrorScope());
         mCurrentErrorScope = mRootErrorScope.Get();
     }
@@ -59,6 +89,16 @@ namespace webnn::native {
         return CreateGraphImpl();
     }
 
+    reference::ThreadPool* ContextBase::GetFallbackThreadPool() {
+        std::lock_guard<std::mutex> lock(mFallbackThreadPoolMutex);
+        if (mFallbackThreadPool == nullptr) {
+            mFallbackThreadPool = std::make_unique<reference::ThreadPool>(
+                GetThreadCount(mCpuThreadOptions, std::thread::hardware_concurrency()),
+                mCpuThreadOptions.affinity);
+        }
+        return mFallbackThreadPool.get();
+    }
+
 #if defined(WEBNN_ENABLE_GPU_BUFFER)
     WGPUDevice ContextBase::GetWGPUDevice() {
         return mWGPUDevice;
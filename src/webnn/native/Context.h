@@ -16,17 +16,28 @@
 #define WEBNN_NATIVE_CONTEXT_H_
 
 #include "common/RefCounted.h"
+#include "webnn/native/CpuThreadOptions.h"
 #include "webnn/native/Error.h"
 #include "webnn/native/ErrorScope.h"
+#include "webnn/native/ExecutionQueue.h"
 #include "webnn/native/webnn_platform.h"
 
 #if defined(WEBNN_ENABLE_GPU_BUFFER)
 #    include <webgpu/webgpu.h>
 #endif
 
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
 class WebGLRenderingContext;
 namespace webnn::native {
 
+    namespace reference {
+        class ThreadPool;
+    }  // namespace reference
+
     class ContextBase : public RefCounted {
       public:
         explicit ContextBase(ContextOptions const* options = nullptr);
@@ -66,6 +77,20 @@ namespace webnn::native {
         ContextOptions GetContextOptions() {
             return mContextOptions;
         }
+        // The directory compiled graphs are cached in, empty if caching is disabled.
+        const std::string& GetCacheDirectory() const {
+            return mCacheDirectory;
+        }
+        // The threads the CPU backends may use for the graphs of this context.
+        const CpuThreadOptions& GetCpuThreadOptions() const {
+            return mCpuThreadOptions;
+        }
+        ExecutionQueue* GetExecutionQueue() {
+            return mExecutionQueue.get();
+        }
+        // The pool the reference kernels run on for the operators a backend falls back on, it
+        // is created with the first graph that needs it.
+        reference::ThreadPool* GetFallbackThreadPool();
 
       private:
         // Create concrete model.
@@ -77,6 +102,14 @@ namespace webnn::native {
         Ref<ErrorScope> mCurrentErrorScope;
 
         ContextOptions mContextOptions;
+        // Owns the string mContextOptions.cacheDirectory points to.
+        std::string mCacheDirectory;
+        // Owns the processors mContextOptions.cpuAffinity points to.
+        std::vector<uint32_t> mCpuAffinity;
+        CpuThreadOptions mCpuThreadOptions;
+        std::unique_ptr<ExecutionQueue> mExecutionQueue;
+        std::mutex mFallbackThreadPoolMutex;
+        std::unique_ptr<reference::ThreadPool> mFallbackThreadPool;
 #if defined(WEBNN_ENABLE_GPU_BUFFER)
         WGPUDevice mWGPUDevice;
 #endif
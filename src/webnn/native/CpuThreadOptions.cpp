@@ -0,0 +1,211 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "webnn/native/CpuThreadOptions.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <tuple>
+
+#include "common/Log.h"
+#include "webnn/native/Error.h"
+#include "webnn/native/ErrorData.h"
+
+#if defined(__linux__)
+#    include <sched.h>
+#elif defined(_WIN32)
+#    include <windows.h>
+#endif
+
+namespace webnn::native {
+
+    namespace {
+
+        // The threads of a low power context, enough to overlap a little work without keeping
+        // many cores awake.
+        constexpr uint32_t kLowPowerThreadCount = 2;
+
+        // The most processors Linux supports, which bounds the processor numbers of CPU lists.
+        constexpr unsigned long kMaxCpuCount = 8192;
+
+        // Parses a processor number of a CPU list, which must span all of |number|.
+        ResultOrError<uint32_t> ParseCpu(const std::string& number) {
+            const char* begin = number.c_str();
+            char* end = nullptr;
+            unsigned long cpu = std::strtoul(begin, &end, 10);
+            DAWN_INVALID_IF(number.empty() || number[0] < '0' || number[0] > '9' ||
+                                end != begin + number.size() || cpu >= kMaxCpuCount,
+                            "The processor \"" + number + "\" of the CPU list is invalid.");
+            return static_cast<uint32_t>(cpu);
+        }
+
+        // Parses a sysfs CPU list such as "0-3,8-11".
+        ResultOrError<std::vector<uint32_t>> ParseCpuList(const std::string& list) {
+            std::vector<uint32_t> cpus;
+            std::stringstream stream(list);
+            std::string range;
+            while (std::getline(stream, range, ',')) {
+                size_t dash = range.find('-');
+                uint32_t first;
+                DAWN_TRY_ASSIGN(first, ParseCpu(range.substr(0, dash)));
+                uint32_t last = first;
+                if (dash != std::string::npos) {
+                    DAWN_TRY_ASSIGN(last, ParseCpu(range.substr(dash + 1)));
+                }
+                DAWN_INVALID_IF(first > last, "The CPU range \"" + range + "\" is invalid.");
+                for (uint32_t cpu = first; cpu <= last; ++cpu) {
+                    cpus.push_back(cpu);
+                }
+            }
+            return std::move(cpus);
+        }
+
+        ResultOrError<std::vector<uint32_t>> GetNumaNodeCpus(int32_t node) {
+#if defined(__linux__)
+            std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) +
+                               "/cpulist");
+            std::string list;
+            if (file && std::getline(file, list) && !list.empty()) {
+                return ParseCpuList(list);
+            }
+#endif
+            return std::vector<uint32_t>();
+        }
+
+        std::vector<uint32_t> GetCurrentThreadAffinity() {
+            std::vector<uint32_t> cpus;
+#if defined(__linux__)
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+                for (uint32_t cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+                    if (CPU_ISSET(cpu, &set)) {
+                        cpus.push_back(cpu);
+                    }
+                }
+            }
+#elif defined(_WIN32)
+            // There is no getter, setting the mask returns the previous one.
+            HANDLE thread = GetCurrentThread();
+            DWORD_PTR mask = SetThreadAffinityMask(thread, ~DWORD_PTR(0));
+            if (mask != 0) {
+                SetThreadAffinityMask(thread, mask);
+                for (uint32_t cpu = 0; cpu < sizeof(mask) * 8; ++cpu) {
+                    if (mask & (DWORD_PTR(1) << cpu)) {
+                        cpus.push_back(cpu);
+                    }
+                }
+            }
+#endif
+            return cpus;
+        }
+
+    }  // namespace
+
+    bool CpuThreadOptions::IsDefault() const {
+        return threadCount == 0 && affinity.empty() &&
+               waitPolicy == wnn::ThreadWaitPolicy::Default;
+    }
+
+    bool CpuThreadOptions::operator<(const CpuThreadOptions& other) const {
+        return std::tie(threadCount, affinity, waitPolicy) <
+               std::tie(other.threadCount, other.affinity, other.waitPolicy);
+    }
+
+    CpuThreadOptions ResolveCpuThreadOptions(const ContextOptions& options) {
+        CpuThreadOptions resolved;
+        resolved.threadCount = options.threadCount;
+        resolved.waitPolicy = options.threadWaitPolicy;
+        if (options.cpuAffinityCount != 0) {
+            std::set<uint32_t> cpus(options.cpuAffinity,
+                                    options.cpuAffinity + options.cpuAffinityCount);
+            resolved.affinity.assign(cpus.begin(), cpus.end());
+        } else if (options.numaNode >= 0) {
+            ResultOrError<std::vector<uint32_t>> cpus = GetNumaNodeCpus(options.numaNode);
+            if (cpus.IsError()) {
+                dawn::WarningLog() << cpus.AcquireError()->GetMessage();
+            } else {
+                resolved.affinity = cpus.AcquireSuccess();
+            }
+            if (resolved.affinity.empty()) {
+                dawn::WarningLog() << "Failed to get the processors of NUMA node "
+                                   << options.numaNode << ", the threads aren't restricted.";
+            }
+        }
+        if (resolved.threadCount == 0) {
+            if (options.powerPreference == wnn::PowerPreference::Low_power) {
+                resolved.threadCount = kLowPowerThreadCount;
+            } else if (!resolved.affinity.empty()) {
+                // One thread per processor the context may run on.
+                resolved.threadCount = resolved.affinity.size();
+            }
+            if (!resolved.affinity.empty()) {
+                resolved.threadCount =
+                    std::min(resolved.threadCount, static_cast<uint32_t>(resolved.affinity.size()));
+            }
+        }
+        return resolved;
+    }
+
+    uint32_t GetThreadCount(const CpuThreadOptions& options, uint32_t defaultCount) {
+        return options.threadCount != 0 ? options.threadCount : std::max(defaultCount, 1u);
+    }
+
+    bool SetCurrentThreadAffinity(const std::vector<uint32_t>& cpus) {
+        if (cpus.empty()) {
+            return true;
+        }
+#if defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (uint32_t cpu : cpus) {
+            if (cpu < CPU_SETSIZE) {
+                CPU_SET(cpu, &set);
+            }
+        }
+        return sched_setaffinity(0, sizeof(set), &set) == 0;
+#elif defined(_WIN32)
+        // Only the processors of the first group can be selected.
+        DWORD_PTR mask = 0;
+        for (uint32_t cpu : cpus) {
+            if (cpu < sizeof(mask) * 8) {
+                mask |= DWORD_PTR(1) << cpu;
+            }
+        }
+        return mask != 0 && SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+#else
+        return false;
+#endif
+    }
+
+    ScopedThreadAffinity::ScopedThreadAffinity(const std::vector<uint32_t>& cpus) {
+        if (cpus.empty()) {
+            return;
+        }
+        mPrevious = GetCurrentThreadAffinity();
+        if (!SetCurrentThreadAffinity(cpus)) {
+            dawn::WarningLog() << "Failed to set the affinity of the threads.";
+            mPrevious.clear();
+        }
+    }
+
+    ScopedThreadAffinity::~ScopedThreadAffinity() {
+        SetCurrentThreadAffinity(mPrevious);
+    }
+
+}  // namespace webnn::native
@@ -0,0 +1,60 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef WEBNN_NATIVE_CPU_THREAD_OPTIONS_H_
+#define WEBNN_NATIVE_CPU_THREAD_OPTIONS_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "webnn/native/webnn_platform.h"
+
+namespace webnn::native {
+
+    // The threads the CPU backends may use for the graphs of a context, resolved from the
+    // thread count, affinity, NUMA node, wait policy and power preference of its options.
+    struct CpuThreadOptions {
+        // Zero lets the backend choose.
+        uint32_t threadCount = 0;
+        // The logical processors the threads are restricted to, any processor if empty.
+        std::vector<uint32_t> affinity;
+        wnn::ThreadWaitPolicy waitPolicy = wnn::ThreadWaitPolicy::Default;
+
+        // Whether the backend's own defaults apply, so that its shared pool can be used.
+        bool IsDefault() const;
+        bool operator<(const CpuThreadOptions& other) const;
+    };
+
+    CpuThreadOptions ResolveCpuThreadOptions(const ContextOptions& options);
+
+    // The thread count of |options|, or |defaultCount| when the backend chooses.
+    uint32_t GetThreadCount(const CpuThreadOptions& options, uint32_t defaultCount);
+
+    // Restricts the calling thread to |cpus|, returns false if that isn't supported.
+    bool SetCurrentThreadAffinity(const std::vector<uint32_t>& cpus);
+
+    // Restricts the calling thread to |cpus| while alive. The threads it creates meanwhile
+    // inherit the restriction, which places the workers of pools that don't take an affinity.
+    class ScopedThreadAffinity {
+      public:
+        explicit ScopedThreadAffinity(const std::vector<uint32_t>& cpus);
+        ~ScopedThreadAffinity();
+
+      private:
+        std::vector<uint32_t> mPrevious;
+    };
+
+}  // namespace webnn::native
+
+#endif  // WEBNN_NATIVE_CPU_THREAD_OPTIONS_H_
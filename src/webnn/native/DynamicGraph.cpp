@@ -0,0 +1,97 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "webnn/native/DynamicGraph.h"
+
+#include "webnn/native/NamedInputs.h"
+#include "webnn/native/NamedOutputs.h"
+#include "webnn/native/Utils.h"
+
+namespace webnn::native {
+
+    namespace {
+
+        // Every specialization holds its own compiled kernels and copies of the constants, so
+        // only a few shapes are kept.
+        constexpr size_t kMaxSpecializations = 8;
+
+    }  // namespace
+
+    DynamicGraph::DynamicGraph(ContextBase* context,
+                               GraphBuilderBase* builder,
+                               NamedOperandsBase const* namedOperands,
+                               std::map<std::string, std::vector<int32_t>> inputDimensions,
+                               bool batchable)
+        : GraphBase(context),
+          mBuilder(builder),
+          mNamedOperands(AcquireRef(new NamedOperandsBase())),
+          mInputDimensions(std::move(inputDimensions)),
+          mBatchable(batchable) {
+        // The caller may release its named operands once the graph is built.
+        for (auto& [name, operand] : namedOperands->GetRecords()) {
+            mNamedOperands->Set(name.c_str(), operand);
+        }
+    }
+
+    bool DynamicGraph::IsBatchable() {
+        return mBatchable;
+    }
+
+    ResultOrError<Ref<GraphBase>> DynamicGraph::GetSpecialization(NamedInputsBase* inputs) {
+        std::vector<int32_t> signature;
+        std::map<std::string, std::vector<int32_t>> dimensions;
+        for (auto& [name, declared] : mInputDimensions) {
+            const Input input = inputs->Get(name.c_str());
+            DAWN_INVALID_IF(input.dimensions == nullptr || input.dimensionsCount != declared.size(),
+                            "The dimensions of the dynamic input " + name +
+                                " must be given with its declared rank.");
+            std::vector<int32_t> actual(input.dimensions, input.dimensions + input.dimensionsCount);
+            for (size_t i = 0; i < actual.size(); ++i) {
+                DAWN_INVALID_IF(actual[i] <= 0 || !utils::DimensionsMatch(actual[i], declared[i]),
+                                "The dimensions of the dynamic input " + name +
+                                    " don't match its declared dimensions.");
+            }
+            // The ranks are fixed, so the concatenated dimensions identify the shapes.
+            signature.insert(signature.end(), actual.begin(), actual.end());
+            dimensions[name] = std::move(actual);
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        for (auto it = mSpecializations.begin(); it != mSpecializations.end(); ++it) {
+            if (it->first == signature) {
+                mSpecializations.splice(mSpecializations.begin(), mSpecializations, it);
+                return Ref<GraphBase>(it->second);
+            }
+        }
+        Ref<GraphBase> graph;
+        DAWN_TRY_ASSIGN(graph, mBuilder->BuildSpecialized(mNamedOperands.Get(), dimensions));
+        mSpecializations.emplace_front(std::move(signature), graph);
+        if (mSpecializations.size() > kMaxSpecializations) {
+            mSpecializations.pop_back();
+        }
+        return std::move(graph);
+    }
+
+    MaybeError DynamicGraph::CompileImpl() {
+        // The specializations are compiled when they are built.
+        return {};
+    }
+
+    MaybeError DynamicGraph::ComputeImpl(NamedInputsBase* inputs, NamedOutputsBase* outputs) {
+        Ref<GraphBase> graph;
+        DAWN_TRY_ASSIGN(graph, GetSpecialization(inputs));
+        return graph->ComputeImpl(inputs, outputs);
+    }
+
+}  // namespace webnn::native
@@ -0,0 +1,69 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef WEBNN_NATIVE_DYNAMIC_GRAPH_H_
+#define WEBNN_NATIVE_DYNAMIC_GRAPH_H_
+
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "webnn/native/Error.h"
+#include "webnn/native/Graph.h"
+#include "webnn/native/GraphBuilder.h"
+#include "webnn/native/NamedOperands.h"
+
+namespace webnn::native {
+
+    // Runs a graph whose inputs have dynamic dimensions. The backends plan the memory and the
+    // kernels of a graph for static shapes, so the graph is specialized for the dimensions the
+    // inputs have at compute the first time they are seen. The most recently used
+    // specializations are kept, a compute with their shapes doesn't build anything.
+    class DynamicGraph final : public GraphBase {
+      public:
+        // |inputDimensions| are the declared dimensions of the dynamic inputs, -1 for the
+        // dynamic ones.
+        DynamicGraph(ContextBase* context,
+                     GraphBuilderBase* builder,
+                     NamedOperandsBase const* namedOperands,
+                     std::map<std::string, std::vector<int32_t>> inputDimensions,
+                     bool batchable);
+        ~DynamicGraph() override = default;
+
+        bool IsBatchable() override;
+
+      private:
+        ResultOrError<Ref<GraphBase>> GetSpecialization(NamedInputsBase* inputs);
+
+        MaybeError CompileImpl() override;
+        MaybeError ComputeImpl(NamedInputsBase* inputs, NamedOutputsBase* outputs) override;
+
+        // The operators are owned by the builder, which re-infers them to build specializations.
+        Ref<GraphBuilderBase> mBuilder;
+        Ref<NamedOperandsBase> mNamedOperands;
+        std::map<std::string, std::vector<int32_t>> mInputDimensions;
+        bool mBatchable;
+
+        // The specializations keyed by the dimensions of the dynamic inputs, the most recently
+        // used first.
+        std::list<std::pair<std::vector<int32_t>, Ref<GraphBase>>> mSpecializations;
+        std::mutex mMutex;
+    };
+
+}  // namespace webnn::native
+
+#endif  // WEBNN_NATIVE_DYNAMIC_GRAPH_H_
@@ -31,6 +31,14 @@ namespace webnn::native {
         }
     }
 
+    bool IgnoreError(MaybeError maybeError) {
+        if (maybeError.IsError()) {
+            maybeError.AcquireError();
+            return true;
+        }
+        return false;
+    }
+
     wnn::ErrorType ToWNNErrorType(InternalErrorType type) {
         switch (type) {
             case InternalErrorType::Validation:
@@ -40,8 +48,10 @@ namespace webnn::native {
 
             // There is no equivalent of Internal errors in the WebGPU API. Internal
             // errors cause the device at the API level to be lost, so treat it like a
-            // DeviceLost error.
+            // DeviceLost error. Unimplemented errors are internal errors the graph builder
+            // can recover from by running the operators on the reference backend.
             case InternalErrorType::Internal:
+            case InternalErrorType::Unimplemented:
             case InternalErrorType::DeviceLost:
                 return wnn::ErrorType::DeviceLost;
 
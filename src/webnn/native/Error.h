@@ -77,7 +77,7 @@ namespace webnn::native {
 #define DAWN_DEVICE_LOST_ERROR(MESSAGE) DAWN_MAKE_ERROR(InternalErrorType::DeviceLost, MESSAGE)
 #define DAWN_INTERNAL_ERROR(MESSAGE) DAWN_MAKE_ERROR(InternalErrorType::Internal, MESSAGE)
 #define DAWN_UNIMPLEMENTED_ERROR(MESSAGE) \
-    DAWN_MAKE_ERROR(InternalErrorType::Internal, std::string("Unimplemented: ") + MESSAGE)
+    DAWN_MAKE_ERROR(InternalErrorType::Unimplemented, std::string("Unimplemented: ") + MESSAGE)
 #define DAWN_OUT_OF_MEMORY_ERROR(MESSAGE) DAWN_MAKE_ERROR(InternalErrorType::OutOfMemory, MESSAGE)
 
 #define DAWN_INVALID_IF(EXPR, ...)                                          \
@@ -123,6 +123,9 @@ namespace webnn::native {
 
     // Assert that errors are device loss so that we can continue with destruction
     void IgnoreErrors(MaybeError maybeError);
+    // Drops the error of an attempt that is skipped rather than failing, e.g. an optional graph
+    // rewrite or a probe of what a backend supports. Returns whether there was an error.
+    bool IgnoreError(MaybeError maybeError);
 
     wnn::ErrorType ToWNNErrorType(InternalErrorType type);
     InternalErrorType FromWNNErrorType(wnn::ErrorType type);
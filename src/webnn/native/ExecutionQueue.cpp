@@ -0,0 +1,170 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "webnn/native/ExecutionQueue.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+#include "common/Assert.h"
+#include "webnn/native/CpuThreadOptions.h"
+
+namespace webnn::native {
+
+    namespace {
+        // The queue whose worker is the current thread, if any.
+        thread_local const void* tCurrentQueueState = nullptr;
+    }  // namespace
+
+    struct ExecutionQueue::State {
+        explicit State(size_t maxPendingTasks) : maxPendingTasks(maxPendingTasks) {
+        }
+
+        // The tasks of one key. A key is in |ready| only while it has tasks and none of them is
+        // running, which is what keeps the tasks of a key ordered.
+        struct Strand {
+            std::deque<Task> tasks;
+            bool running = false;
+        };
+
+        const size_t maxPendingTasks;
+
+        std::mutex mutex;
+        std::condition_variable workAvailable;
+        std::condition_variable spaceAvailable;
+        // Notified whenever a key has no more tasks queued or running.
+        std::condition_variable strandCompleted;
+        std::unordered_map<const void*, Strand> strands;
+        std::deque<const void*> ready;
+        size_t pendingTasks = 0;
+        bool stop = false;
+    };
+
+    ExecutionQueue::ExecutionQueue(uint32_t workerCount,
+                                   size_t maxPendingTasks,
+                                   std::vector<uint32_t> affinity)
+        : mWorkerCount(std::max(workerCount, 1u)),
+          mAffinity(std::move(affinity)),
+          mState(std::make_shared<State>(std::max(maxPendingTasks, size_t(1)))) {
+    }
+
+    ExecutionQueue::~ExecutionQueue() {
+        {
+            std::lock_guard<std::mutex> lock(mState->mutex);
+            mState->stop = true;
+        }
+        mState->workAvailable.notify_all();
+        mState->spaceAvailable.notify_all();
+        mState->strandCompleted.notify_all();
+        for (auto& worker : mWorkers) {
+            if (worker.get_id() == std::this_thread::get_id()) {
+                // The queue is destroyed by one of its own tasks, the worker exits on its own
+                // once the task returns.
+                worker.detach();
+            } else {
+                worker.join();
+            }
+        }
+    }
+
+    void ExecutionQueue::Submit(const void* key, Task task) {
+        std::unique_lock<std::mutex> lock(mState->mutex);
+        ASSERT(!mState->stop);
+        // Workers are started lazily so that contexts which never compute asynchronously don't
+        // own threads.
+        StartWorkers();
+        if (tCurrentQueueState != mState.get()) {
+            mState->spaceAvailable.wait(lock, [this] {
+                return mState->stop || mState->pendingTasks < mState->maxPendingTasks;
+            });
+        }
+
+        State::Strand& strand = mState->strands[key];
+        strand.tasks.push_back(std::move(task));
+        ++mState->pendingTasks;
+        if (strand.tasks.size() == 1 && !strand.running) {
+            mState->ready.push_back(key);
+            lock.unlock();
+            mState->workAvailable.notify_one();
+        }
+    }
+
+    void ExecutionQueue::Wait(const void* key) {
+        if (tCurrentQueueState == mState.get()) {
+            return;
+        }
+        std::unique_lock<std::mutex> lock(mState->mutex);
+        mState->strandCompleted.wait(lock, [this, key] {
+            return mState->stop || mState->strands.find(key) == mState->strands.end();
+        });
+    }
+
+    void ExecutionQueue::StartWorkers() {
+        if (!mWorkers.empty()) {
+            return;
+        }
+        for (uint32_t i = 0; i < mWorkerCount; ++i) {
+            mWorkers.emplace_back(&ExecutionQueue::WorkerLoop, mState, mAffinity);
+        }
+    }
+
+    // static
+    void ExecutionQueue::WorkerLoop(std::shared_ptr<State> state, std::vector<uint32_t> affinity) {
+        SetCurrentThreadAffinity(affinity);
+        tCurrentQueueState = state.get();
+        for (;;) {
+            const void* key = nullptr;
+            Task task;
+            {
+                std::unique_lock<std::mutex> lock(state->mutex);
+                state->workAvailable.wait(lock,
+                                          [&state] { return state->stop || !state->ready.empty(); });
+                if (state->ready.empty()) {
+                    return;
+                }
+                key = state->ready.front();
+                state->ready.pop_front();
+                State::Strand& strand = state->strands[key];
+                task = std::move(strand.tasks.front());
+                strand.tasks.pop_front();
+                strand.running = true;
+            }
+
+            task();
+            // Drop what the task holds before taking the lock again, releasing the last graph
+            // may destroy the context and run ~ExecutionQueue on this thread.
+            task = nullptr;
+
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                --state->pendingTasks;
+                auto strand = state->strands.find(key);
+                ASSERT(strand != state->strands.end());
+                strand->second.running = false;
+                if (strand->second.tasks.empty()) {
+                    state->strands.erase(strand);
+                    state->strandCompleted.notify_all();
+                } else {
+                    state->ready.push_back(key);
+                    state->workAvailable.notify_one();
+                }
+            }
+            state->spaceAvailable.notify_one();
+        }
+    }
+
+}  // namespace webnn::native
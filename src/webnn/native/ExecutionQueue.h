@@ -0,0 +1,64 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef WEBNN_NATIVE_EXECUTION_QUEUE_H_
+#define WEBNN_NATIVE_EXECUTION_QUEUE_H_
+
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace webnn::native {
+
+    // Runs the asynchronous computes of a context on worker threads.
+    //
+    // Tasks submitted with the same key (a graph) run one at a time and in submission order,
+    // tasks with different keys may run in parallel. Submit() blocks while |maxPendingTasks|
+    // tasks are queued or running so that a fast producer can't queue unbounded work, except
+    // when it is called from a worker (e.g. from a compute callback) where waiting could
+    // deadlock.
+    class ExecutionQueue {
+      public:
+        using Task = std::function<void()>;
+
+        // The workers are restricted to the processors in |affinity| unless it's empty.
+        ExecutionQueue(uint32_t workerCount,
+                       size_t maxPendingTasks,
+                       std::vector<uint32_t> affinity = {});
+        ~ExecutionQueue();
+
+        void Submit(const void* key, Task task);
+        // Waits until the tasks of |key| submitted so far have completed, so that synchronous
+        // work done afterwards on the calling thread is ordered with them. Returns at once from
+        // a worker, waiting there could deadlock on the strand that is running.
+        void Wait(const void* key);
+
+      private:
+        struct State;
+
+        void StartWorkers();
+        static void WorkerLoop(std::shared_ptr<State> state, std::vector<uint32_t> affinity);
+
+        const uint32_t mWorkerCount;
+        const std::vector<uint32_t> mAffinity;
+        // Shared with the workers, the last reference to a graph may be dropped by a worker and
+        // destroy the context, and with it this queue, while that worker is still running.
+        std::shared_ptr<State> mState;
+        std::vector<std::thread> mWorkers;
+    };
+
+}  // namespace webnn::native
+
+#endif  // WEBNN_NATIVE_EXECUTION_QUEUE_H_
@@ -14,11 +14,18 @@
 
 #include "webnn/native/Graph.h"
 
+#include <memory>
 #include <string>
 
 #include "common/Assert.h"
 #include "common/Log.h"
 #include "common/RefCounted.h"
+#include "webnn/native/FusionOperator.h"
+#include "webnn/native/GraphCache.h"
+#include "webnn/native/NamedInputs.h"
+#include "webnn/native/NamedOutputs.h"
+#include "webnn/native/Operator.h"
+#include "webnn/native/Tracer.h"
 
 namespace webnn::native {
 
@@ -41,6 +48,8 @@ namespace webnn::native {
     GraphBase::GraphBase(ContextBase* context) : ObjectBase(context) {
     }
 
+    GraphBase::~GraphBase() = default;
+
     MaybeError GraphBase::AddConstant(const op::Constant* constant) {
         return DAWN_UNIMPLEMENTED_ERROR("AddConstant");
     }
@@ -129,6 +138,18 @@ namespace webnn::native {
         return DAWN_UNIMPLEMENTED_ERROR("AddInstanceNorm");
     }
 
+    bool GraphBase::SupportsFusedActivation(const op::Conv2d* conv2d, FusionType type) const {
+        return false;
+    }
+
+    bool GraphBase::GetPreferredLayout(wnn::InputOperandLayout* layout) const {
+        return false;
+    }
+
+    bool GraphBase::SupportsOperator(const OperatorBase* op) const {
+        return true;
+    }
+
     MaybeError GraphBase::Finish() {
         return DAWN_UNIMPLEMENTED_ERROR("Finish");
     }
@@ -138,7 +159,8 @@ namespace webnn::native {
     }
 
     void GraphBase::Compute(NamedInputsBase* inputs, NamedOutputsBase* outputs) {
-        GetContext()->ConsumedError(ComputeImpl(inputs, outputs));
+        GetContext()->GetExecutionQueue()->Wait(this);
+        GetContext()->ConsumedError(RunCompute(inputs, outputs));
     }
 
     void GraphBase::ComputeAsync(NamedInputsBase* inputs,
@@ -147,15 +169,161 @@ namespace webnn::native {
                                  void* userdata) {
         if (inputs == nullptr || outputs == nullptr) {
             callback(WNNErrorType_Validation, "named inputs or outputs is empty.", userdata);
+            return;
         }
-        MaybeError maybeError = ComputeImpl(inputs, outputs);
-        if (maybeError.IsError()) {
-            std::unique_ptr<ErrorData> errorData = maybeError.AcquireError();
-            callback(static_cast<WNNErrorType>(ToWNNErrorType(errorData->GetType())),
-                     const_cast<char*>(errorData->GetMessage().c_str()), userdata);
+        // The task keeps the graph and the named records alive until the compute has finished,
+        // the callback is called on a worker thread of the context's execution queue.
+        Ref<GraphBase> graph(this);
+        Ref<NamedInputsBase> namedInputs(inputs);
+        Ref<NamedOutputsBase> namedOutputs(outputs);
+        GetContext()->GetExecutionQueue()->Submit(
+            this, [graph, namedInputs, namedOutputs, callback, userdata]() {
+                MaybeError maybeError = graph->RunCompute(namedInputs.Get(), namedOutputs.Get());
+                if (maybeError.IsError()) {
+                    std::unique_ptr<ErrorData> errorData = maybeError.AcquireError();
+                    callback(static_cast<WNNErrorType>(ToWNNErrorType(errorData->GetType())),
+                             const_cast<char*>(errorData->GetMessage().c_str()), userdata);
+                } else {
+                    callback(WNNErrorType_NoError, "", userdata);
+                }
+            });
+    }
+
+    void GraphBase::Bind(NamedInputsBase* inputs, NamedOutputsBase* outputs) {
+        if (GetContext()->ConsumedError(ValidateBinding(inputs, outputs))) {
+            return;
+        }
+        mBoundInputs = inputs;
+        mBoundOutputs = outputs;
+    }
+
+    void GraphBase::ComputeBound() {
+        if (GetContext()->ConsumedError(ValidateComputeBound())) {
+            return;
+        }
+        GetContext()->GetExecutionQueue()->Wait(this);
+        GetContext()->ConsumedError(RunCompute(mBoundInputs.Get(), mBoundOutputs.Get()));
+    }
+
+    void GraphBase::EnableProfiling(bool enabled) {
+        mProfiling = enabled;
+    }
+
+    uint32_t GraphBase::GetProfileEntryCount() {
+        std::lock_guard<std::mutex> lock(mProfileMutex);
+        return mProfile.size();
+    }
+
+    bool GraphBase::IsBatchable() {
+        return false;
+    }
+
+    void GraphBase::GetProfileEntry(uint32_t index, ProfileEntry* entry) {
+        std::lock_guard<std::mutex> lock(mProfileMutex);
+        if (GetContext()->ConsumedError(ValidateProfileEntry(index, entry))) {
+            return;
+        }
+        const ProfileRecord& record = mProfile[index];
+        auto profiledOperator = mProfiledOperators.find(record.op);
+        if (profiledOperator != mProfiledOperators.end()) {
+            entry->operatorIndex = profiledOperator->second.index;
+            entry->operatorType = profiledOperator->second.type;
         } else {
-            callback(WNNErrorType_NoError, "", userdata);
+            entry->operatorIndex = kNoOperatorIndex;
+            entry->operatorType = "";
+        }
+        entry->kernel = record.kernel.c_str();
+        entry->milliseconds = record.milliseconds;
+        entry->byteLength = record.byteLength;
+    }
+
+    MaybeError GraphBase::RunCompute(NamedInputsBase* inputs, NamedOutputsBase* outputs) {
+        ScopedTrace trace("webnn", "Compute");
+        if (!mProfiling) {
+            return ComputeImpl(inputs, outputs);
+        }
+        std::vector<ProfileRecord> records;
+        {
+            ScopedProfileRecorder recorder(&records);
+            DAWN_TRY(ComputeImpl(inputs, outputs));
+        }
+        std::lock_guard<std::mutex> lock(mProfileMutex);
+        mProfile = std::move(records);
+        return {};
+    }
+
+    MaybeError GraphBase::ValidateBinding(NamedInputsBase* inputs, NamedOutputsBase* outputs) {
+        DAWN_INVALID_IF(inputs == nullptr || outputs == nullptr,
+                        "named inputs or outputs is empty.");
+        return {};
+    }
+
+    MaybeError GraphBase::ValidateProfileEntry(uint32_t index, ProfileEntry* entry) {
+        DAWN_INVALID_IF(entry == nullptr, "The profile entry is null.");
+        DAWN_INVALID_IF(index >= mProfile.size(), "The profile entry index is out of range.");
+        return {};
+    }
+
+    MaybeError GraphBase::ValidateComputeBound() {
+        DAWN_INVALID_IF(mBoundInputs.Get() == nullptr || mBoundOutputs.Get() == nullptr,
+                        "Graph has no bound inputs and outputs.");
+        return {};
+    }
+
+    void GraphBase::SetCacheKey(std::string key) {
+        mCacheKey = std::move(key);
+    }
+
+    void GraphBase::AddOwnedOperator(Ref<OperatorBase> op) {
+        mOwnedOperators.push_back(std::move(op));
+    }
+
+    void GraphBase::AddOwnedActivation(Ref<FusionOperatorBase> activation) {
+        mOwnedActivations.push_back(std::move(activation));
+    }
+
+    void GraphBase::TakeOwnedOperators(GraphBase* graph) {
+        for (auto& op : graph->mOwnedOperators) {
+            mOwnedOperators.push_back(std::move(op));
+        }
+        graph->mOwnedOperators.clear();
+        for (auto& activation : graph->mOwnedActivations) {
+            mOwnedActivations.push_back(std::move(activation));
+        }
+        graph->mOwnedActivations.clear();
+    }
+
+    void GraphBase::SetProfiledOperators(const std::vector<Ref<OperatorBase>>& operators) {
+        // The operators created while building, like inserted transposes, have no index.
+        std::vector<const OperatorBase*> profiled;
+        for (auto& op : operators) {
+            profiled.push_back(op.Get());
+        }
+        for (auto& op : mOwnedOperators) {
+            profiled.push_back(op.Get());
+        }
+        std::vector<const char*> types = GetOperatorTypes(GetContext(), profiled);
+        for (size_t i = 0; i < profiled.size(); ++i) {
+            uint32_t index = i < operators.size() ? i : kNoOperatorIndex;
+            mProfiledOperators[profiled[i]] = {index, types[i]};
+        }
+    }
+
+    bool GraphBase::LoadFromCache(const std::string& name, void* data, size_t byteLength) const {
+        if (mCacheKey.empty()) {
+            return false;
+        }
+        return ReadCachedBlob(GetContext()->GetCacheDirectory(), mCacheKey, name, data,
+                              byteLength);
+    }
+
+    void GraphBase::StoreToCache(const std::string& name,
+                                 const void* data,
+                                 size_t byteLength) const {
+        if (mCacheKey.empty()) {
+            return;
         }
+        WriteCachedBlob(GetContext()->GetCacheDirectory(), mCacheKey, name, data, byteLength);
     }
 
     GraphBase::GraphBase(ContextBase* context, ObjectBase::ErrorTag tag)
@@ -15,6 +15,12 @@
 #ifndef WEBNN_NATIVE_GRAPH_H_
 #define WEBNN_NATIVE_GRAPH_H_
 
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include "common/RefCounted.h"
 #include "webnn/native/Context.h"
 #include "webnn/native/Error.h"
@@ -22,10 +28,13 @@
 #include "webnn/native/GraphBuilder.h"
 #include "webnn/native/ObjectBase.h"
 #include "webnn/native/Operand.h"
+#include "webnn/native/Profiler.h"
 #include "webnn/native/webnn_platform.h"
 
 namespace webnn::native {
 
+    enum class FusionType : uint32_t;
+
     namespace op {
         class Constant;
         class Input;
@@ -54,7 +63,7 @@ namespace webnn::native {
     class GraphBase : public ObjectBase {
       public:
         explicit GraphBase(ContextBase* context);
-        virtual ~GraphBase() = default;
+        virtual ~GraphBase();
 
         virtual MaybeError AddConstant(const op::Constant* constant);
         virtual MaybeError AddInput(const op::Input* input);
@@ -81,19 +90,95 @@ namespace webnn::native {
         virtual MaybeError Finish();
         virtual MaybeError Compile();
 
+        // Whether the backend applies an activation of |type| fused into |conv2d|. The operator
+        // fusion pass only folds a standalone activation into a conv2d if it does.
+        virtual bool SupportsFusedActivation(const op::Conv2d* conv2d, FusionType type) const;
+        // The layout the backend computes conv2d and pool2d in natively, if any. The layout
+        // propagation pass switches the regions in the other layout to it.
+        virtual bool GetPreferredLayout(wnn::InputOperandLayout* layout) const;
+        // Whether the backend can run |op| once it is added to the graph, without finishing or
+        // compiling it. Used to split a graph the backend fails to build into partitions,
+        // backends that accept operators they can't run when adding them override it.
+        virtual bool SupportsOperator(const OperatorBase* op) const;
+
         // Webnn API
+        // Runs on the calling thread once the asynchronous computes queued before it are done,
+        // synchronous computes of one graph may run concurrently.
         void Compute(NamedInputsBase* inputs, NamedOutputsBase* outputs);
+        // Returns once the compute is queued, computes of one graph run in the order they were
+        // queued. |inputs| and |outputs| must not be modified until |callback| is called.
         void ComputeAsync(NamedInputsBase* inputs,
                           NamedOutputsBase* outputs,
                           WNNComputeAsyncCallback callback,
                           void* userdata);
+        // Keeps |inputs| and |outputs| alive so that ComputeBound() can be called repeatedly
+        // without rebuilding the named records. Callers update data in place, backends compare
+        // the bound data pointers to decide whether anything has to be set up again.
+        void Bind(NamedInputsBase* inputs, NamedOutputsBase* outputs);
+        void ComputeBound();
+        // Once profiling is enabled, every compute replaces the profile with the kernels it ran.
+        // The strings of an entry stay valid until the next compute.
+        void EnableProfiling(bool enabled);
+        uint32_t GetProfileEntryCount();
+        void GetProfileEntry(uint32_t index, ProfileEntry* entry);
+        // Whether computing inputs concatenated along their leading dimension gives the outputs
+        // of the separate computes concatenated along theirs, so that computes can be batched.
+        // Only graphs with a dynamic leading dimension on every input and output can be.
+        virtual bool IsBatchable();
 
         GraphBase(ContextBase* context, ObjectBase::ErrorTag tag);
         static GraphBase* MakeError(ContextBase* context);
 
+        // Set by the builder to the key of the graph in the context's cache directory, empty
+        // if the context has no cache directory or the graph can't be cached.
+        void SetCacheKey(std::string key);
+        // Keeps an operator created while building, e.g. a folded constant, alive as long as
+        // the graph because backends may keep pointers into its data.
+        void AddOwnedOperator(Ref<OperatorBase> op);
+        // Keeps an activation fused by the optimizer alive as long as the graph because backends
+        // may keep pointers to it in their kernels.
+        void AddOwnedActivation(Ref<FusionOperatorBase> activation);
+        // Takes over the operators and activations owned by |graph|, e.g. when a graph the
+        // backend failed to build is replaced by a partitioned one.
+        void TakeOwnedOperators(GraphBase* graph);
+        // Set by the builder to its operators in the order it created them, so that profile
+        // entries can be mapped back to them.
+        void SetProfiledOperators(const std::vector<Ref<OperatorBase>>& operators);
+
+      protected:
+        // Backends store the artifacts that are expensive to compile under a name that is
+        // unique within the graph, and load them back when the same graph is built again.
+        bool LoadFromCache(const std::string& name, void* data, size_t byteLength) const;
+        void StoreToCache(const std::string& name, const void* data, size_t byteLength) const;
+
       private:
+        // Run the graphs of their partitions and specializations.
+        friend class DynamicGraph;
+        friend class PartitionedGraph;
+
+        MaybeError ValidateBinding(NamedInputsBase* inputs, NamedOutputsBase* outputs);
+        MaybeError ValidateComputeBound();
+        MaybeError ValidateProfileEntry(uint32_t index, ProfileEntry* entry);
+        // Runs ComputeImpl and records its profile if profiling is enabled.
+        MaybeError RunCompute(NamedInputsBase* inputs, NamedOutputsBase* outputs);
+
         virtual MaybeError CompileImpl() = 0;
         virtual MaybeError ComputeImpl(NamedInputsBase* inputs, NamedOutputsBase* outputs) = 0;
+
+        std::string mCacheKey;
+        Ref<NamedInputsBase> mBoundInputs;
+        Ref<NamedOutputsBase> mBoundOutputs;
+        std::vector<Ref<OperatorBase>> mOwnedOperators;
+        std::vector<Ref<FusionOperatorBase>> mOwnedActivations;
+
+        struct ProfiledOperator {
+            uint32_t index;
+            const char* type;
+        };
+        std::unordered_map<const OperatorBase*, ProfiledOperator> mProfiledOperators;
+        std::atomic<bool> mProfiling{false};
+        std::mutex mProfileMutex;
+        std::vector<ProfileRecord> mProfile;
     };
 }  // namespace webnn::native
 
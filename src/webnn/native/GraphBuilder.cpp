@@ -14,6 +14,8 @@
 
 #include "webnn/native/GraphBuilder.h"
 
+#include <algorithm>
+#include <memory>
 #include <stack>
 #include <string>
 #include <unordered_set>
@@ -23,10 +25,18 @@
 #include "common/Log.h"
 #include "common/RefCounted.h"
 #include "webnn/native/Context.h"
+#include "webnn/native/DynamicGraph.h"
 #include "webnn/native/Graph.h"
+#include "webnn/native/GraphCache.h"
+#include "webnn/native/GraphOptimizer.h"
 #include "webnn/native/Operand.h"
 #include "webnn/native/OperandArray.h"
 #include "webnn/native/Operator.h"
+#include "webnn/native/OperatorCaster.h"
+#include "webnn/native/PartitionedGraph.h"
+#include "webnn/native/Profiler.h"
+#include "webnn/native/Tracer.h"
+#include "webnn/native/Utils.h"
 #include "webnn/native/ops/BatchNorm.h"
 #include "webnn/native/ops/Binary.h"
 #include "webnn/native/ops/Clamp.h"
@@ -49,13 +59,12 @@
 #include "webnn/native/ops/Transpose.h"
 #include "webnn/native/ops/Unary.h"
 
-#define WEBNN_VALIDATE(ptr, objectBase)                                  \
-    Ref<OperatorBase> op = AcquireRef(ptr);                              \
-    if (GetContext()->ConsumedError(op->ValidateAndInferOutputInfo())) { \
-        return objectBase::MakeError(this);                              \
-    }                                                                    \
-    mOperators.push_back(op);                                            \
-    for (;;)                                                             \
+#define WEBNN_VALIDATE(ptr, objectBase)                 \
+    Ref<OperatorBase> op = AcquireRef(ptr);             \
+    if (GetContext()->ConsumedError(AddOperator(op))) { \
+        return objectBase::MakeError(this);             \
+    }                                                   \
+    for (;;)                                            \
     break
 
 #define VALIDATE_FOR_OPERAND(ptr)     \
@@ -67,6 +76,45 @@
 
 namespace webnn::native {
 
+    namespace {
+
+        // The batch sizes a graph is specialized for to check that its outputs are batched like
+        // its inputs.
+        constexpr int32_t kBatchSampleSizes[] = {2, 3};
+
+        bool IsDynamic(const std::vector<int32_t>& shape) {
+            return std::find(shape.begin(), shape.end(), utils::kDynamicDimension) != shape.end();
+        }
+
+        MaybeError BuildOnBackend(GraphBase* graph,
+                                  const std::vector<const OperatorBase*>& operators,
+                                  const std::vector<PartitionedGraph::NamedOutput>& outputs) {
+            // The spans of AddToGraph are named after the operator types, which are only looked
+            // up when tracing.
+            std::vector<const char*> types;
+            if (IsTracing()) {
+                types = GetOperatorTypes(graph->GetContext(), operators);
+            }
+            for (size_t i = 0; i < operators.size(); ++i) {
+                ScopedTrace trace("webnn", types.empty() ? "AddToGraph" : types[i]);
+                DAWN_TRY(operators[i]->AddToGraph(graph));
+            }
+            for (auto& output : outputs) {
+                DAWN_TRY(graph->AddOutput(output.name, output.operand));
+            }
+            {
+                ScopedTrace trace("webnn", "Finish");
+                DAWN_TRY(graph->Finish());
+            }
+            {
+                ScopedTrace trace("webnn", "Compile");
+                DAWN_TRY(graph->Compile());
+            }
+            return {};
+        }
+
+    }  // namespace
+
     GraphBuilderBase::GraphBuilderBase(ContextBase* context) : ObjectBase(context) {
     }
 
@@ -126,6 +174,23 @@ namespace webnn::native {
         return nullptr;
     }
 
+    OperandBase* GraphBuilderBase::ConstantFromFile(OperandDescriptor const* desc,
+                                                    char const* path,
+                                                    size_t byteOffset,
+                                                    size_t byteLength) {
+        Ref<MappedFile> file;
+        auto iter = mMappedFiles.find(path);
+        if (iter != mMappedFiles.end()) {
+            file = iter->second;
+        } else {
+            if (GetContext()->ConsumedError(MappedFile::Create(path), &file)) {
+                return OperandBase::MakeError(this);
+            }
+            mMappedFiles[path] = file;
+        }
+        VALIDATE_FOR_OPERAND(new op::Constant(this, desc, std::move(file), byteOffset, byteLength));
+    }
+
     OperandBase* GraphBuilderBase::Conv2d(OperandBase* input,
                                           OperandBase* filter,
                                           Conv2dOptions const* options) {
@@ -355,8 +420,26 @@ namespace webnn::native {
         VALIDATE_FOR_OPERAND(new op::Transpose(this, input, options));
     }
 
+    MaybeError GraphBuilderBase::InferOutputInfo(OperatorBase* op) {
+        if (!op->SupportsDynamicDimensions()) {
+            for (auto& input : op->Inputs()) {
+                DAWN_INVALID_IF(IsDynamic(input->Shape()),
+                                "The operator doesn't support inputs with dynamic dimensions.");
+            }
+        }
+        return op->ValidateAndInferOutputInfo();
+    }
+
+    MaybeError GraphBuilderBase::AddOperator(Ref<OperatorBase> op) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        DAWN_TRY(InferOutputInfo(op.Get()));
+        mOperators.push_back(std::move(op));
+        return {};
+    }
+
     ResultOrError<Ref<GraphBase>> GraphBuilderBase::BuildImpl(
         NamedOperandsBase const* namedOperands) {
+        std::lock_guard<std::mutex> lock(mMutex);
         DAWN_INVALID_IF(this->IsError(), "The GraphBuilderBase is an error object.");
         DAWN_INVALID_IF(namedOperands->GetRecords().empty(), "The namedOperands are empty.");
 
@@ -364,28 +447,199 @@ namespace webnn::native {
         for (auto& namedOutput : namedOperands->GetRecords()) {
             outputs.push_back(namedOutput.second);
         }
-        std::vector<const OperatorBase*> sorted_operands = TopologicalSort(outputs);
+        std::vector<const OperatorBase*> sorted_operands;
+        {
+            ScopedTrace trace("webnn", "TopologicalSort");
+            sorted_operands = TopologicalSort(outputs);
+        }
         DAWN_INVALID_IF(sorted_operands.empty(), "The graph can't be built.");
-        Ref<GraphBase> graph = AcquireRef(GetContext()->CreateGraph());
         for (auto& op : sorted_operands) {
             DAWN_INVALID_IF(op->IsError(), "The operand is an error object.");
-            DAWN_TRY(op->AddToGraph(graph.Get()));
         }
-        for (auto& [name, output] : namedOperands->GetRecords()) {
-            DAWN_TRY(graph->AddOutput(name, output));
+
+        // A graph with dynamic inputs is built for the dimensions of its inputs at compute.
+        std::map<std::string, std::vector<int32_t>> dynamicInputs;
+        Ref<OperatorCaster> caster = AcquireRef(new OperatorCaster(GetContext()));
+        for (auto& op : sorted_operands) {
+            const op::Input* input = caster->AsInput(op);
+            if (input != nullptr && IsDynamic(input->PrimaryOutput()->Shape())) {
+                dynamicInputs[input->GetName()] = input->PrimaryOutput()->Shape();
+            }
+        }
+        if (!dynamicInputs.empty()) {
+            bool batchable = IsBatchable(sorted_operands, namedOperands, dynamicInputs);
+            Ref<DynamicGraph> graph = AcquireRef(new DynamicGraph(
+                GetContext(), this, namedOperands, std::move(dynamicInputs), batchable));
+            return Ref<GraphBase>(graph.Get());
         }
-        DAWN_TRY(graph->Finish());
-        DAWN_TRY(graph->Compile());
+        return BuildStaticGraph(std::move(sorted_operands), namedOperands);
+    }
 
+    ResultOrError<Ref<GraphBase>> GraphBuilderBase::BuildSpecialized(
+        NamedOperandsBase const* namedOperands,
+        const std::map<std::string, std::vector<int32_t>>& inputDimensions) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        std::vector<const OperandBase*> outputs;
+        for (auto& namedOutput : namedOperands->GetRecords()) {
+            outputs.push_back(namedOutput.second);
+        }
+        std::vector<const OperatorBase*> sorted_operands = TopologicalSort(outputs);
+        Ref<GraphBase> graph;
+        DAWN_TRY(Specialize(sorted_operands, inputDimensions, [&]() -> MaybeError {
+            DAWN_TRY_ASSIGN(graph, BuildStaticGraph(sorted_operands, namedOperands));
+            return {};
+        }));
         return std::move(graph);
     }
 
+    MaybeError GraphBuilderBase::Specialize(
+        const std::vector<const OperatorBase*>& operators,
+        const std::map<std::string, std::vector<int32_t>>& inputDimensions,
+        const std::function<MaybeError()>& specialized) {
+        Ref<OperatorCaster> caster = AcquireRef(new OperatorCaster(GetContext()));
+        std::vector<std::pair<op::Input*, std::vector<int32_t>>> declaredDimensions;
+        for (auto& op : operators) {
+            const op::Input* input = caster->AsInput(op);
+            if (input == nullptr) {
+                continue;
+            }
+            auto dimensions = inputDimensions.find(input->GetName());
+            if (dimensions != inputDimensions.end()) {
+                op::Input* mutableInput = const_cast<op::Input*>(input);
+                declaredDimensions.push_back({mutableInput, input->PrimaryOutput()->Shape()});
+                mutableInput->SetDimensions(dimensions->second);
+            }
+        }
+        auto inferShapes = [&operators, this]() -> MaybeError {
+            for (auto& op : operators) {
+                DAWN_TRY(InferOutputInfo(const_cast<OperatorBase*>(op)));
+            }
+            return {};
+        };
+        auto run = [&]() -> MaybeError {
+            DAWN_TRY(inferShapes());
+            return specialized();
+        };
+        MaybeError result = run();
+
+        for (auto& [input, dimensions] : declaredDimensions) {
+            input->SetDimensions(std::move(dimensions));
+        }
+        // The declared shapes were valid when the operators were created.
+        MaybeError restored = inferShapes();
+        ASSERT(!restored.IsError());
+        if (restored.IsError()) {
+            restored.AcquireError();
+        }
+        return result;
+    }
+
+    bool GraphBuilderBase::IsBatchable(
+        const std::vector<const OperatorBase*>& operators,
+        NamedOperandsBase const* namedOperands,
+        const std::map<std::string, std::vector<int32_t>>& inputDimensions) {
+        auto isBatched = [](const std::vector<int32_t>& shape) {
+            return !shape.empty() && shape[0] == utils::kDynamicDimension &&
+                   !IsDynamic(std::vector<int32_t>(shape.begin() + 1, shape.end()));
+        };
+        Ref<OperatorCaster> caster = AcquireRef(new OperatorCaster(GetContext()));
+        for (auto& op : operators) {
+            const op::Input* input = caster->AsInput(op);
+            if (input == nullptr) {
+                continue;
+            }
+            auto dimensions = inputDimensions.find(input->GetName());
+            if (dimensions == inputDimensions.end() || !isBatched(dimensions->second)) {
+                return false;
+            }
+        }
+        for (auto& [name, output] : namedOperands->GetRecords()) {
+            if (!isBatched(output->Shape())) {
+                return false;
+            }
+        }
+        // The leading dimension of the outputs must be the batch size rather than depend on it
+        // otherwise, e.g. be a multiple of it after a reshape. The dynamic dimensions don't tell
+        // them apart, the graph is specialized to check it. A batch size it can't be specialized
+        // for, e.g. an odd one split in two, makes it not batchable.
+        for (int32_t size : kBatchSampleSizes) {
+            std::map<std::string, std::vector<int32_t>> sampled = inputDimensions;
+            for (auto& [name, dimensions] : sampled) {
+                dimensions[0] = size;
+            }
+            bool batched = true;
+            MaybeError maybeError = Specialize(operators, sampled, [&]() -> MaybeError {
+                for (auto& [name, output] : namedOperands->GetRecords()) {
+                    batched = batched && output->Shape()[0] == size;
+                }
+                return {};
+            });
+            if (IgnoreError(std::move(maybeError)) || !batched) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    ResultOrError<Ref<GraphBase>> GraphBuilderBase::BuildStaticGraph(
+        std::vector<const OperatorBase*> sorted_operands,
+        NamedOperandsBase const* namedOperands) {
+        Ref<GraphBase> graph = AcquireRef(GetContext()->CreateGraph());
+        // The optimizer rewrites the operators in place until it goes out of scope.
+        GraphOptimizer optimizer(this, graph.Get());
+        {
+            ScopedTrace trace("webnn", "Optimize");
+            DAWN_TRY(optimizer.Run(&sorted_operands, namedOperands));
+        }
+        if (!GetContext()->GetCacheDirectory().empty()) {
+            // Hash the graph in the order the backend sees it so that backends can name their
+            // cached artifacts after the order of the Add* calls, some of them already load
+            // artifacts while adding operators.
+            Ref<GraphHasher> hasher = AcquireRef(new GraphHasher(GetContext()));
+            for (auto& op : sorted_operands) {
+                DAWN_TRY(op->AddToGraph(hasher.Get()));
+            }
+            for (auto& [name, output] : namedOperands->GetRecords()) {
+                DAWN_TRY(hasher->AddOutput(name, optimizer.GetReplacement(output)));
+            }
+            graph->SetCacheKey(hasher->GetKey());
+        }
+        std::vector<PartitionedGraph::NamedOutput> namedOutputs;
+        for (auto& [name, output] : namedOperands->GetRecords()) {
+            namedOutputs.push_back({name, optimizer.GetReplacement(output)});
+        }
+        MaybeError maybeError = BuildOnBackend(graph.Get(), sorted_operands, namedOutputs);
+        if (!maybeError.IsError()) {
+            return std::move(graph);
+        }
+        std::unique_ptr<ErrorData> error = maybeError.AcquireError();
+        // Rather than failing the whole graph, the operators the backend doesn't implement run
+        // on the reference backend and the others still run on the backend. Other errors, e.g.
+        // invalid graphs or running out of memory, aren't recovered from.
+        if (error->GetType() == InternalErrorType::Unimplemented &&
+            GetContext()->GetContextOptions().operatorFallback) {
+            Ref<PartitionedGraph> partitioned = AcquireRef(new PartitionedGraph(GetContext()));
+            partitioned->TakeOwnedOperators(graph.Get());
+            MaybeError partitionError = partitioned->Build(this, sorted_operands, namedOutputs);
+            if (!partitionError.IsError()) {
+                return Ref<GraphBase>(partitioned.Get());
+            }
+            std::unique_ptr<ErrorData> fallbackError = partitionError.AcquireError();
+            if (fallbackError->GetType() != InternalErrorType::Unimplemented) {
+                return std::move(fallbackError);
+            }
+        }
+        return std::move(error);
+    }
+
     GraphBase* GraphBuilderBase::Build(NamedOperandsBase const* namedOperands) {
+        ScopedTrace trace("webnn", "Build");
         Ref<GraphBase> result = nullptr;
         if (GetContext()->ConsumedError(BuildImpl(namedOperands), &result)) {
             ASSERT(result == nullptr);
             return GraphBase::MakeError(this->GetContext());
         }
+        result->SetProfiledOperators(mOperators);
         return result.Detach();
     }
 
@@ -17,6 +17,7 @@
 
 #include "common/RefCounted.h"
 #include "webnn/native/Forward.h"
+#include "webnn/native/MappedFile.h"
 #include "webnn/native/NamedOperands.h"
 #include "webnn/native/ObjectBase.h"
 #include "webnn/native/Operand.h"
@@ -24,6 +25,10 @@
 #include "webnn/native/webnn_platform.h"
 
 #include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace webnn::native {
@@ -48,6 +53,10 @@ namespace webnn::native {
         OperandBase* Constant(OperandDescriptor const* desc, ArrayBufferView const* arrayBuffer);
         OperandBase* ConstantWithGpuBuffer(OperandDescriptor const* desc,
                                            GpuBufferView const* arrayBuffer);
+        OperandBase* ConstantFromFile(OperandDescriptor const* desc,
+                                      char const* path,
+                                      size_t byteOffset,
+                                      size_t byteLength);
         OperandBase* Conv2d(OperandBase*, OperandBase*, Conv2dOptions const* options);
         OperandBase* ConvTranspose2d(OperandBase*,
                                      OperandBase*,
@@ -115,10 +124,42 @@ namespace webnn::native {
 
         GraphBase* Build(NamedOperandsBase const* namedOperands);
 
+        // Builds |namedOperands| for the dimensions given to the dynamic inputs by
+        // |inputDimensions|, the declared dimensions are restored afterwards. The operators are
+        // re-inferred in place, so it waits for the other uses of the builder.
+        ResultOrError<Ref<GraphBase>> BuildSpecialized(
+            NamedOperandsBase const* namedOperands,
+            const std::map<std::string, std::vector<int32_t>>& inputDimensions);
+
       private:
+        // Infers the outputs of |op| and adds it to the operators of the builder.
+        MaybeError AddOperator(Ref<OperatorBase> op);
         ResultOrError<Ref<GraphBase>> BuildImpl(NamedOperandsBase const* namedOperands);
+        // |operators| are the operators needed to compute |namedOperands|, sorted topologically,
+        // with static shapes.
+        ResultOrError<Ref<GraphBase>> BuildStaticGraph(std::vector<const OperatorBase*> operators,
+                                                       NamedOperandsBase const* namedOperands);
+        // Re-infers |operators| for the dimensions given to the dynamic inputs by
+        // |inputDimensions|, runs |specialized| and restores the declared dimensions.
+        MaybeError Specialize(const std::vector<const OperatorBase*>& operators,
+                              const std::map<std::string, std::vector<int32_t>>& inputDimensions,
+                              const std::function<MaybeError()>& specialized);
+        // See GraphBase::IsBatchable, |inputDimensions| are the declared dimensions of the
+        // dynamic inputs among the inputs of |operators|.
+        bool IsBatchable(const std::vector<const OperatorBase*>& operators,
+                         NamedOperandsBase const* namedOperands,
+                         const std::map<std::string, std::vector<int32_t>>& inputDimensions);
+        // Like ValidateAndInferOutputInfo, but fails if |op| has inputs with dynamic dimensions
+        // and doesn't support them.
+        MaybeError InferOutputInfo(OperatorBase* op);
 
         std::vector<Ref<OperatorBase>> mOperators;
+        // Building rewrites the shapes and inputs of the operators in place until it is done,
+        // and the graphs with dynamic inputs build at compute, on other threads than the
+        // caller of the builder. Adding operators and building are serialized with it.
+        std::mutex mMutex;
+        // Every constant taken from the same file shares one mapping.
+        std::unordered_map<std::string, Ref<MappedFile>> mMappedFiles;
         // Topological sort of nodes needed to compute rootNodes
         std::vector<const OperatorBase*> TopologicalSort(
             std::vector<const OperandBase*>& rootNodes);
@@ -0,0 +1,452 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "webnn/native/GraphCache.h"
+
+#include <stdio.h>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+#include "common/Assert.h"
+#include "webnn/native/FusionOperator.h"
+#include "webnn/native/ops/BatchNorm.h"
+#include "webnn/native/ops/Binary.h"
+#include "webnn/native/ops/Clamp.h"
+#include "webnn/native/ops/Concat.h"
+#include "webnn/native/ops/Constant.h"
+#include "webnn/native/ops/Conv2d.h"
+#include "webnn/native/ops/Gemm.h"
+#include "webnn/native/ops/Gru.h"
+#include "webnn/native/ops/Input.h"
+#include "webnn/native/ops/InstanceNorm.h"
+#include "webnn/native/ops/LeakyRelu.h"
+#include "webnn/native/ops/Pad.h"
+#include "webnn/native/ops/Pool2d.h"
+#include "webnn/native/ops/Reduce.h"
+#include "webnn/native/ops/Resample2d.h"
+#include "webnn/native/ops/Reshape.h"
+#include "webnn/native/ops/Slice.h"
+#include "webnn/native/ops/Split.h"
+#include "webnn/native/ops/Squeeze.h"
+#include "webnn/native/ops/Transpose.h"
+#include "webnn/native/ops/Unary.h"
+
+namespace webnn::native {
+
+    namespace {
+        // Bump when the hashed content or the layout of cached artifacts changes so that stale
+        // entries are never read.
+        constexpr uint32_t kCacheFormatVersion = 1;
+
+        constexpr uint64_t kFnvOffsetBasis = 14695981039346656037ull;
+        constexpr uint64_t kFnvPrime = 1099511628211ull;
+
+        enum OperatorKind : uint32_t {
+            kConstant = 0,
+            kInput,
+            kOutput,
+            kBatchNorm,
+            kBinary,
+            kClamp,
+            kConcat,
+            kConv2d,
+            kConvTranspose2d,
+            kGemm,
+            kGru,
+            kInstanceNorm,
+            kPad,
+            kPool2d,
+            kReduce,
+            kResample2d,
+            kReshape,
+            kSlice,
+            kSplit,
+            kSqueeze,
+            kTranspose,
+            kUnary,
+        };
+
+        std::string GetBlobPath(const std::string& directory,
+                                const std::string& key,
+                                const std::string& name) {
+            return directory + "/" + key + "-" + name + ".bin";
+        }
+
+        // FNV-1a over 64-bit words, constants can be hundreds of megabytes.
+        uint64_t FnvHash(uint64_t hash, const void* data, size_t byteLength) {
+            const uint8_t* bytes = static_cast<const uint8_t*>(data);
+            size_t i = 0;
+            for (; i + sizeof(uint64_t) <= byteLength; i += sizeof(uint64_t)) {
+                uint64_t word;
+                memcpy(&word, bytes + i, sizeof(uint64_t));
+                hash = (hash ^ word) * kFnvPrime;
+            }
+            for (; i < byteLength; ++i) {
+                hash = (hash ^ bytes[i]) * kFnvPrime;
+            }
+            return hash;
+        }
+
+        std::string ToHexString(uint64_t hash) {
+            std::ostringstream stream;
+            stream << std::hex << std::setw(16) << std::setfill('0') << hash;
+            return stream.str();
+        }
+    }  // namespace
+
+    GraphHasher::GraphHasher(ContextBase* context) : GraphBase(context), mHash(kFnvOffsetBasis) {
+        HashValue(kCacheFormatVersion);
+    }
+
+    void GraphHasher::HashBytes(const void* data, size_t byteLength) {
+        mHash = FnvHash(mHash, data, byteLength);
+    }
+
+    void GraphHasher::HashOperand(const OperandBase* operand) {
+        auto id = mOperandIds.find(operand);
+        ASSERT(id != mOperandIds.end());
+        HashValue(id->second);
+    }
+
+    void GraphHasher::RegisterOutputs(const OperatorBase* op) {
+        for (auto& output : op->Outputs()) {
+            uint32_t id = static_cast<uint32_t>(mOperandIds.size());
+            mOperandIds[output.Get()] = id;
+        }
+    }
+
+    ResultOrError<uint64_t> GraphHasher::HashSingleOperator(const OperatorBase* op) {
+        mHash = kFnvOffsetBasis;
+        DAWN_TRY(op->AddToGraph(this));
+        return mHash;
+    }
+
+    void GraphHasher::HashOperator(uint32_t kind, const OperatorBase* op) {
+        HashValue(kind);
+        HashValue(op->Inputs().size());
+        for (auto& input : op->Inputs()) {
+            HashOperand(input.Get());
+        }
+        HashValue(op->Outputs().size());
+        RegisterOutputs(op);
+        for (auto& output : op->Outputs()) {
+            HashValue(output->Type());
+            std::vector<int32_t> shape = output->Shape();
+            HashArray(shape.data(), shape.size());
+        }
+    }
+
+    void GraphHasher::HashActivation(const FusionOperatorBase* activation) {
+        if (activation == nullptr) {
+            HashValue(false);
+            return;
+        }
+        HashValue(true);
+        HashValue(activation->GetFusionType());
+        switch (activation->GetFusionType()) {
+            case FusionType::Clamp: {
+                auto clamp = static_cast<const op::FusionClamp*>(activation);
+                HashValue(clamp->GetMinValue());
+                HashValue(clamp->GetMaxValue());
+                break;
+            }
+            case FusionType::LeakyRelu: {
+                auto leakyRelu = static_cast<const op::FusionLeakyRelu*>(activation);
+                HashValue(leakyRelu->GetAlpha());
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    MaybeError GraphHasher::AddConstant(const op::Constant* constant) {
+        HashOperator(kConstant, constant);
+        if (constant->GetBuffer() == nullptr) {
+            // The content of GPU buffers isn't visible here.
+            mCacheable = false;
+            return {};
+        }
+        HashArray(static_cast<const uint8_t*>(constant->GetBuffer()), constant->GetByteLength());
+        return {};
+    }
+
+    MaybeError GraphHasher::AddInput(const op::Input* input) {
+        HashOperator(kInput, input);
+        HashArray(input->GetName().data(), input->GetName().size());
+        return {};
+    }
+
+    MaybeError GraphHasher::AddOutput(std::string_view name, const OperandBase* output) {
+        HashValue(kOutput);
+        HashArray(name.data(), name.size());
+        HashOperand(output);
+        return {};
+    }
+
+    MaybeError GraphHasher::AddBatchNorm(const op::BatchNorm* batchNorm) {
+        HashOperator(kBatchNorm, batchNorm);
+        const BatchNormOptions* options = batchNorm->GetOptions();
+        HashValue(options->scale != nullptr);
+        HashValue(options->bias != nullptr);
+        HashValue(options->axis);
+        HashValue(options->epsilon);
+        HashActivation(options->activation);
+        return {};
+    }
+
+    MaybeError GraphHasher::AddBinary(const op::Binary* binary) {
+        HashOperator(kBinary, binary);
+        HashValue(binary->GetType());
+        return {};
+    }
+
+    MaybeError GraphHasher::AddClamp(const op::Clamp* clamp) {
+        HashOperator(kClamp, clamp);
+        HashValue(clamp->GetMinValue());
+        HashValue(clamp->GetMaxValue());
+        return {};
+    }
+
+    MaybeError GraphHasher::AddConcat(const op::Concat* concat) {
+        HashOperator(kConcat, concat);
+        HashValue(concat->GetAxis());
+        return {};
+    }
+
+    MaybeError GraphHasher::AddConv2d(const op::Conv2d* conv2d) {
+        HashOperator(kConv2d, conv2d);
+        const Conv2dOptions* options = conv2d->GetOptions();
+        HashArray(options->padding, options->paddingCount);
+        HashArray(options->strides, options->stridesCount);
+        HashArray(options->dilations, options->dilationsCount);
+        HashValue(options->autoPad);
+        HashValue(options->groups);
+        HashValue(options->inputLayout);
+        HashValue(options->filterLayout);
+        HashValue(options->bias != nullptr);
+        HashActivation(options->activation);
+        return {};
+    }
+
+    MaybeError GraphHasher::AddConvTranspose2d(const op::ConvTranspose2d* convTranspose2d) {
+        HashOperator(kConvTranspose2d, convTranspose2d);
+        const ConvTranspose2dOptions* options = convTranspose2d->GetOptions();
+        HashArray(options->padding, options->paddingCount);
+        HashArray(options->strides, options->stridesCount);
+        HashArray(options->dilations, options->dilationsCount);
+        HashArray(options->outputPadding, options->outputPaddingCount);
+        HashArray(options->outputSizes, options->outputSizesCount);
+        HashValue(options->autoPad);
+        HashValue(options->groups);
+        HashValue(options->inputLayout);
+        HashValue(options->filterLayout);
+        HashValue(options->bias != nullptr);
+        HashActivation(options->activation);
+        return {};
+    }
+
+    MaybeError GraphHasher::AddGemm(const op::Gemm* gemm) {
+        HashOperator(kGemm, gemm);
+        const GemmOptions* options = gemm->GetOptions();
+        HashValue(options->alpha);
+        HashValue(options->beta);
+        HashValue(options->aTranspose);
+        HashValue(options->bTranspose);
+        return {};
+    }
+
+    MaybeError GraphHasher::AddGru(const op::Gru* gru) {
+        HashOperator(kGru, gru);
+        const GruOptions* options = gru->GetOptions();
+        HashValue(gru->GetSteps());
+        HashValue(gru->GetHiddenSize());
+        HashValue(options->bias != nullptr);
+        HashValue(options->recurrentBias != nullptr);
+        HashValue(options->initialHiddenState != nullptr);
+        HashValue(options->resetAfter);
+        HashValue(options->returnSequence);
+        HashValue(options->direction);
+        HashValue(options->layout);
+        Ref<OperatorArrayBase> activations = gru->GetActivations();
+        for (size_t i = 0; i < activations->Size(); ++i) {
+            HashActivation(activations->Get(i));
+        }
+        return {};
+    }
+
+    MaybeError GraphHasher::AddInstanceNorm(const op::InstanceNorm* instanceNorm) {
+        HashOperator(kInstanceNorm, instanceNorm);
+        const InstanceNormOptions* options = instanceNorm->GetOptions();
+        HashValue(options->scale != nullptr);
+        HashValue(options->bias != nullptr);
+        HashValue(options->epsilon);
+        HashValue(options->layout);
+        return {};
+    }
+
+    MaybeError GraphHasher::AddPad(const op::Pad* pad) {
+        HashOperator(kPad, pad);
+        const std::vector<uint32_t>& padding = pad->GetPadding();
+        HashArray(padding.data(), padding.size());
+        HashValue(pad->GetOptions()->mode);
+        HashValue(pad->GetOptions()->value);
+        return {};
+    }
+
+    MaybeError GraphHasher::AddPool2d(const op::Pool2d* pool2d) {
+        HashOperator(kPool2d, pool2d);
+        const Pool2dOptions* options = pool2d->GetOptions();
+        HashValue(pool2d->GetType());
+        HashArray(options->windowDimensions, options->windowDimensionsCount);
+        HashArray(options->padding, options->paddingCount);
+        HashArray(options->strides, options->stridesCount);
+        HashArray(options->dilations, options->dilationsCount);
+        HashValue(options->autoPad);
+        HashValue(options->layout);
+        HashValue(options->roundingType);
+        return {};
+    }
+
+    MaybeError GraphHasher::AddReduce(const op::Reduce* reduce) {
+        HashOperator(kReduce, reduce);
+        const ReduceOptions* options = reduce->GetOptions();
+        HashValue(reduce->GetType());
+        HashArray(options->axes, options->axesCount);
+        HashValue(options->keepDimensions);
+        return {};
+    }
+
+    MaybeError GraphHasher::AddResample2d(const op::Resample2d* resample2d) {
+        HashOperator(kResample2d, resample2d);
+        std::vector<float> scales = resample2d->GetScales();
+        std::vector<int32_t> axes = resample2d->GetAxes();
+        HashValue(resample2d->GetOptions()->mode);
+        HashArray(scales.data(), scales.size());
+        HashArray(axes.data(), axes.size());
+        return {};
+    }
+
+    MaybeError GraphHasher::AddReshape(const op::Reshape* reshape) {
+        // The new shape is the shape of the output.
+        HashOperator(kReshape, reshape);
+        return {};
+    }
+
+    MaybeError GraphHasher::AddSlice(const op::Slice* slice) {
+        HashOperator(kSlice, slice);
+        std::vector<int32_t> starts = slice->GetStarts();
+        std::vector<int32_t> sizes = slice->GetSizes();
+        std::vector<int32_t> axes = slice->GetAxes();
+        HashArray(starts.data(), starts.size());
+        HashArray(sizes.data(), sizes.size());
+        HashArray(axes.data(), axes.size());
+        return {};
+    }
+
+    MaybeError GraphHasher::AddSplit(const op::Split* split) {
+        HashOperator(kSplit, split);
+        std::vector<uint32_t> splits = split->GetSplits();
+        HashArray(splits.data(), splits.size());
+        HashValue(split->GetAxis());
+        return {};
+    }
+
+    MaybeError GraphHasher::AddSqueeze(const op::Squeeze* squeeze) {
+        HashOperator(kSqueeze, squeeze);
+        std::vector<int32_t> axes = squeeze->GetAxes();
+        HashArray(axes.data(), axes.size());
+        return {};
+    }
+
+    MaybeError GraphHasher::AddTranspose(const op::Transpose* transpose) {
+        HashOperator(kTranspose, transpose);
+        std::vector<int32_t> permutation = transpose->GetPermutation();
+        HashArray(permutation.data(), permutation.size());
+        return {};
+    }
+
+    MaybeError GraphHasher::AddUnary(const op::Unary* unary) {
+        HashOperator(kUnary, unary);
+        HashValue(unary->GetType());
+        if (unary->GetType() == op::UnaryOpType::kLeakyRelu) {
+            HashValue(reinterpret_cast<const op::LeakyRelu*>(unary)->GetAlpha());
+        }
+        return {};
+    }
+
+    MaybeError GraphHasher::Finish() {
+        return {};
+    }
+
+    MaybeError GraphHasher::CompileImpl() {
+        UNREACHABLE();
+    }
+
+    MaybeError GraphHasher::ComputeImpl(NamedInputsBase* inputs, NamedOutputsBase* outputs) {
+        UNREACHABLE();
+    }
+
+    std::string GraphHasher::GetKey() const {
+        if (!mCacheable) {
+            return "";
+        }
+        return ToHexString(mHash);
+    }
+
+    std::string HashCacheName(const void* data, size_t byteLength) {
+        return ToHexString(FnvHash(kFnvOffsetBasis, data, byteLength));
+    }
+
+    bool ReadCachedBlob(const std::string& directory,
+                        const std::string& key,
+                        const std::string& name,
+                        void* data,
+                        size_t byteLength) {
+        std::ifstream file(GetBlobPath(directory, key, name), std::ios::binary | std::ios::ate);
+        if (!file.is_open() || static_cast<size_t>(file.tellg()) != byteLength) {
+            return false;
+        }
+        file.seekg(0);
+        file.read(static_cast<char*>(data), byteLength);
+        return file.good();
+    }
+
+    void WriteCachedBlob(const std::string& directory,
+                         const std::string& key,
+                         const std::string& name,
+                         const void* data,
+                         size_t byteLength) {
+        // Write aside and rename so that a concurrent reader never sees a partial artifact.
+        const std::string path = GetBlobPath(directory, key, name);
+        const std::string temporaryPath = path + ".tmp";
+        {
+            std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) {
+                return;
+            }
+            file.write(static_cast<const char*>(data), byteLength);
+            if (!file.good()) {
+                return;
+            }
+        }
+        if (rename(temporaryPath.c_str(), path.c_str()) != 0) {
+            remove(temporaryPath.c_str());
+        }
+    }
+
+}  // namespace webnn::native
@@ -0,0 +1,116 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef WEBNN_NATIVE_GRAPH_CACHE_H_
+#define WEBNN_NATIVE_GRAPH_CACHE_H_
+
+#include <string>
+#include <unordered_map>
+
+#include "webnn/native/Graph.h"
+
+namespace webnn::native {
+
+    class FusionOperatorBase;
+
+    // Computes the key of a graph in the compiled graph cache. It is fed with the same Add*
+    // calls as the backend graph, in the same order, and hashes the operator DAG, every
+    // attribute and the constant bytes, so two builds that produce the same key compile to
+    // the same artifacts.
+    class GraphHasher final : public GraphBase {
+      public:
+        explicit GraphHasher(ContextBase* context);
+        ~GraphHasher() override = default;
+
+        virtual MaybeError AddConstant(const op::Constant* constant) override;
+        virtual MaybeError AddInput(const op::Input* input) override;
+        virtual MaybeError AddOutput(std::string_view name, const OperandBase* output) override;
+        virtual MaybeError AddBatchNorm(const op::BatchNorm* batchNorm) override;
+        virtual MaybeError AddBinary(const op::Binary* binary) override;
+        virtual MaybeError AddClamp(const op::Clamp* clamp) override;
+        virtual MaybeError AddConcat(const op::Concat* concat) override;
+        virtual MaybeError AddConv2d(const op::Conv2d* conv2d) override;
+        virtual MaybeError AddConvTranspose2d(const op::ConvTranspose2d* convTranspose2d) override;
+        virtual MaybeError AddGemm(const op::Gemm* gemm) override;
+        virtual MaybeError AddGru(const op::Gru* gru) override;
+        virtual MaybeError AddInstanceNorm(const op::InstanceNorm* instanceNorm) override;
+        virtual MaybeError AddPad(const op::Pad* pad) override;
+        virtual MaybeError AddPool2d(const op::Pool2d* pool2d) override;
+        virtual MaybeError AddReduce(const op::Reduce* reduce) override;
+        virtual MaybeError AddResample2d(const op::Resample2d* resample2d) override;
+        virtual MaybeError AddReshape(const op::Reshape* reshape) override;
+        virtual MaybeError AddSlice(const op::Slice* slice) override;
+        virtual MaybeError AddSplit(const op::Split* split) override;
+        virtual MaybeError AddSqueeze(const op::Squeeze* squeeze) override;
+        virtual MaybeError AddTranspose(const op::Transpose* transpose) override;
+        virtual MaybeError AddUnary(const op::Unary* unary) override;
+        virtual MaybeError Finish() override;
+
+        // Returns an empty key if the graph can't be cached, e.g. it has GPU buffer constants.
+        std::string GetKey() const;
+
+        // Hashes |op| on its own, its inputs are identified by the ids given to the outputs of
+        // the operators hashed or registered before. Two operators with the same inputs and
+        // attributes get the same value.
+        ResultOrError<uint64_t> HashSingleOperator(const OperatorBase* op);
+        // Gives ids to the outputs of |op| without hashing it.
+        void RegisterOutputs(const OperatorBase* op);
+
+      private:
+        MaybeError CompileImpl() override;
+        MaybeError ComputeImpl(NamedInputsBase* inputs, NamedOutputsBase* outputs) override;
+
+        // Hashes the kind of |op|, the ids of its inputs and the type and shape of its outputs.
+        void HashOperator(uint32_t kind, const OperatorBase* op);
+        void HashOperand(const OperandBase* operand);
+        void HashActivation(const FusionOperatorBase* activation);
+        void HashBytes(const void* data, size_t byteLength);
+        template <typename T>
+        void HashValue(const T& value) {
+            HashBytes(&value, sizeof(T));
+        }
+        template <typename T>
+        void HashArray(const T* data, size_t count) {
+            HashValue(count);
+            if (count != 0) {
+                HashBytes(data, count * sizeof(T));
+            }
+        }
+
+        uint64_t mHash;
+        bool mCacheable = true;
+        std::unordered_map<const OperandBase*, uint32_t> mOperandIds;
+    };
+
+    // Hashes |byteLength| bytes into a string usable in the name of an artifact, e.g. to tie
+    // the artifact to the backend state it was produced with.
+    std::string HashCacheName(const void* data, size_t byteLength);
+
+    // Reads exactly |byteLength| bytes of the artifact |name| of the graph |key| from
+    // |directory|. Returns false on a miss or a size mismatch.
+    bool ReadCachedBlob(const std::string& directory,
+                        const std::string& key,
+                        const std::string& name,
+                        void* data,
+                        size_t byteLength);
+    // Writes the artifact, failures only cost a recompilation next time and are ignored.
+    void WriteCachedBlob(const std::string& directory,
+                         const std::string& key,
+                         const std::string& name,
+                         const void* data,
+                         size_t byteLength);
+
+}  // namespace webnn::native
+
+#endif  // WEBNN_NATIVE_GRAPH_CACHE_H_
@@ -0,0 +1,608 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "webnn/native/GraphOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stack>
+#include <unordered_set>
+
+#include "common/Assert.h"
+#include "webnn/native/Context.h"
+#include "webnn/native/GraphCache.h"
+#include "webnn/native/Operand.h"
+#include "webnn/native/Operator.h"
+#include "webnn/native/OperatorCaster.h"
+#include "webnn/native/Utils.h"
+#include "webnn/native/ops/BatchNorm.h"
+#include "webnn/native/ops/Constant.h"
+#include "webnn/native/ops/Conv2d.h"
+#include "webnn/native/ops/Transpose.h"
+#include "webnn/native/reference/GraphReference.h"
+
+namespace webnn::native {
+
+    namespace {
+
+        // The permutation transposing a 4-D tensor from the other layout to |layout|.
+        std::vector<int32_t> LayoutPermutation(wnn::InputOperandLayout layout) {
+            return layout == wnn::InputOperandLayout::Nchw ? std::vector<int32_t>{0, 3, 1, 2}
+                                                           : std::vector<int32_t>{0, 2, 3, 1};
+        }
+
+        std::vector<int32_t> Permute(const std::vector<int32_t>& shape,
+                                     const std::vector<int32_t>& permutation) {
+            std::vector<int32_t> permuted;
+            for (int32_t axis : permutation) {
+                permuted.push_back(shape[axis]);
+            }
+            return permuted;
+        }
+
+    }  // namespace
+
+    GraphOptimizer::GraphOptimizer(GraphBuilderBase* builder, GraphBase* graph)
+        : mBuilder(builder), mGraph(graph) {
+    }
+
+    GraphOptimizer::~GraphOptimizer() {
+        for (auto change = mInputChanges.rbegin(); change != mInputChanges.rend(); ++change) {
+            change->op->SetInput(change->index, change->input.Get());
+        }
+        for (op::Conv2d* conv2d : mBiasedConv2ds) {
+            conv2d->SetBias(nullptr);
+        }
+        for (OperatorBase* op : mFusedOperators) {
+            op->SetFusedActivation(nullptr);
+        }
+        for (auto change = mLayoutChanges.rbegin(); change != mLayoutChanges.rend(); ++change) {
+            change->op->SwitchLayout(change->layout);
+            for (auto& output : change->op->Outputs()) {
+                output->SetShape(Permute(output->Shape(), LayoutPermutation(change->layout)));
+            }
+        }
+        for (const FilterLayoutChange& change : mFilterLayoutChanges) {
+            change.conv2d->SetFilterLayout(change.layout);
+        }
+    }
+
+    MaybeError GraphOptimizer::Run(std::vector<const OperatorBase*>* operators,
+                                   const NamedOperandsBase* namedOperands) {
+        mOperators.reserve(operators->size());
+        for (const OperatorBase* op : *operators) {
+            mOperators.push_back(const_cast<OperatorBase*>(op));
+        }
+        for (auto& namedOutput : namedOperands->GetRecords()) {
+            mOutputs.push_back(namedOutput.second);
+        }
+        ComputeUses();
+        mCaster = AcquireRef(new OperatorCaster(mBuilder->GetContext()));
+        for (OperatorBase* op : mOperators) {
+            if (op->Inputs().empty() && mCaster->AsConstant(op) != nullptr) {
+                mConstants.insert(op->PrimaryOutput());
+            }
+        }
+
+        const ContextOptions options = mBuilder->GetContext()->GetContextOptions();
+        if (options.constantFolding) {
+            DAWN_TRY(FoldConstants());
+        }
+        if (options.commonSubexpressionElimination) {
+            DAWN_TRY(EliminateCommonSubexpressions());
+        }
+        // Drop the folded operators and the duplicates before fusing, they still use the operands
+        // of the operators they were replaced by.
+        if (options.deadNodeElimination) {
+            EliminateDeadNodes();
+        }
+        if (options.operatorFusion) {
+            DAWN_TRY(FoldBatchNorms());
+        }
+        if (options.layoutPropagation) {
+            const size_t operatorCount = mOperators.size();
+            DAWN_TRY(PropagateLayouts());
+            // The transposes of constants inserted at the boundaries, e.g. of the filters, are
+            // done once here rather than on every compute.
+            if (options.constantFolding && mOperators.size() != operatorCount) {
+                DAWN_TRY(FoldConstants());
+            }
+        }
+        if (options.operatorFusion) {
+            FuseOperators();
+        }
+        if (options.deadNodeElimination) {
+            EliminateDeadNodes();
+        }
+
+        operators->assign(mOperators.begin(), mOperators.end());
+        return {};
+    }
+
+    const OperandBase* GraphOptimizer::GetReplacement(const OperandBase* operand) const {
+        auto replacement = mReplacements.find(operand);
+        while (replacement != mReplacements.end()) {
+            operand = replacement->second;
+            replacement = mReplacements.find(operand);
+        }
+        return operand;
+    }
+
+    void GraphOptimizer::ComputeUses() {
+        mUses.clear();
+        for (OperatorBase* op : mOperators) {
+            for (size_t i = 0; i < op->Inputs().size(); ++i) {
+                mUses[op->Inputs()[i].Get()].push_back({op, i});
+            }
+        }
+    }
+
+    bool GraphOptimizer::IsOutput(const OperandBase* operand) const {
+        return std::find(mOutputs.begin(), mOutputs.end(), operand) != mOutputs.end();
+    }
+
+    void GraphOptimizer::SetInput(OperatorBase* op, size_t index, OperandBase* input) {
+        const OperandBase* previous = op->Inputs()[index].Get();
+        mInputChanges.push_back({op, index, op->Inputs()[index]});
+        op->SetInput(index, input);
+        std::vector<Use>& uses = mUses[previous];
+        uses.erase(std::remove_if(uses.begin(), uses.end(),
+                                  [op, index](const Use& use) {
+                                      return use.op == op && use.index == index;
+                                  }),
+                   uses.end());
+        mUses[input].push_back({op, index});
+    }
+
+    ResultOrError<OperatorBase*> GraphOptimizer::CreateConstant(wnn::OperandType type,
+                                                                std::vector<int32_t> dimensions,
+                                                                std::vector<char> data) {
+        OperandDescriptor desc = {};
+        desc.type = type;
+        desc.dimensions = dimensions.data();
+        desc.dimensionsCount = dimensions.size();
+        Ref<OperatorBase> constant = AcquireRef(new op::Constant(mBuilder, &desc, std::move(data)));
+        DAWN_TRY(constant->ValidateAndInferOutputInfo());
+        mConstants.insert(constant->PrimaryOutput());
+        OperatorBase* result = constant.Get();
+        mGraph->AddOwnedOperator(std::move(constant));
+        return result;
+    }
+
+    ResultOrError<OperatorBase*> GraphOptimizer::CreateTranspose(
+        OperandBase* input,
+        std::vector<int32_t> permutation) {
+        TransposeOptions options = {};
+        options.permutation = permutation.data();
+        options.permutationCount = permutation.size();
+        Ref<OperatorBase> transpose = AcquireRef(new op::Transpose(mBuilder, input, &options));
+        DAWN_TRY(transpose->ValidateAndInferOutputInfo());
+        mUses[input].push_back({transpose.Get(), 0});
+        OperatorBase* result = transpose.Get();
+        mGraph->AddOwnedOperator(std::move(transpose));
+        return result;
+    }
+
+    void GraphOptimizer::Replace(const OperandBase* from, OperandBase* to) {
+        std::vector<Use> uses = std::move(mUses[from]);
+        mUses.erase(from);
+        for (const Use& use : uses) {
+            mInputChanges.push_back({use.op, use.index, use.op->Inputs()[use.index]});
+            use.op->SetInput(use.index, to);
+            mUses[to].push_back(use);
+        }
+        std::replace(mOutputs.begin(), mOutputs.end(), from, static_cast<const OperandBase*>(to));
+        mReplacements[from] = to;
+    }
+
+    MaybeError GraphOptimizer::FoldConstants() {
+        std::vector<OperatorBase*> operators;
+        operators.reserve(mOperators.size());
+        for (OperatorBase* op : mOperators) {
+            operators.push_back(op);
+            bool foldable = !op->Inputs().empty();
+            for (auto& input : op->Inputs()) {
+                foldable = foldable && mConstants.count(input.Get()) != 0;
+            }
+            for (auto& output : op->Outputs()) {
+                foldable = foldable && !IsOutput(output.Get());
+            }
+            if (!foldable) {
+                continue;
+            }
+
+            // The values are computed by the reference kernels, the operators they don't
+            // support are left to the backend.
+            Ref<reference::Graph> evaluator =
+                AcquireRef(new reference::Graph(mBuilder->GetContext(), nullptr));
+            std::unordered_set<const OperatorBase*> addedConstants;
+            bool evaluated = true;
+            for (auto& input : op->Inputs()) {
+                const OperatorBase* constant = input->Operator();
+                if (evaluated && addedConstants.insert(constant).second) {
+                    evaluated = !IgnoreError(constant->AddToGraph(evaluator.Get()));
+                }
+            }
+            evaluated = evaluated && !IgnoreError(op->AddToGraph(evaluator.Get())) &&
+                        !IgnoreError(evaluator->Evaluate());
+            if (!evaluated) {
+                continue;
+            }
+
+            for (auto& output : op->Outputs()) {
+                std::vector<char>& data = evaluator->GetTensor(output.Get())->data;
+                OperatorBase* constant;
+                DAWN_TRY_ASSIGN(constant,
+                                CreateConstant(output->Type(), output->Shape(), std::move(data)));
+                operators.push_back(constant);
+                Replace(output.Get(), constant->PrimaryOutput());
+            }
+        }
+        mOperators = std::move(operators);
+        return {};
+    }
+
+    MaybeError GraphOptimizer::EliminateCommonSubexpressions() {
+        // The operators are visited in topological order, so the inputs of an operator are
+        // already replaced by the operands they are merged into when it is hashed.
+        Ref<GraphHasher> hasher = AcquireRef(new GraphHasher(mBuilder->GetContext()));
+        std::unordered_map<uint64_t, std::vector<OperatorBase*>> candidates;
+        for (OperatorBase* op : mOperators) {
+            // Inputs are distinct by name, comparing constants would mean hashing their data.
+            if (op->Inputs().empty()) {
+                hasher->RegisterOutputs(op);
+                continue;
+            }
+            uint64_t hash;
+            DAWN_TRY_ASSIGN(hash, hasher->HashSingleOperator(op));
+            OperatorBase* equivalent = nullptr;
+            for (OperatorBase* candidate : candidates[hash]) {
+                if (candidate->Inputs() == op->Inputs() &&
+                    candidate->Outputs().size() == op->Outputs().size()) {
+                    equivalent = candidate;
+                    break;
+                }
+            }
+            if (equivalent == nullptr) {
+                candidates[hash].push_back(op);
+                continue;
+            }
+            for (size_t i = 0; i < op->Outputs().size(); ++i) {
+                Replace(op->Outputs()[i].Get(), equivalent->Outputs()[i].Get());
+            }
+        }
+        return {};
+    }
+
+    void GraphOptimizer::EliminateDeadNodes() {
+        std::unordered_set<const OperatorBase*> live;
+        std::stack<const OperatorBase*> toVisit;
+        for (const OperandBase* output : mOutputs) {
+            toVisit.push(output->Operator());
+        }
+        while (!toVisit.empty()) {
+            const OperatorBase* op = toVisit.top();
+            toVisit.pop();
+            if (!live.insert(op).second) {
+                continue;
+            }
+            for (auto& input : op->Inputs()) {
+                toVisit.push(input->Operator());
+            }
+        }
+        mOperators.erase(std::remove_if(mOperators.begin(), mOperators.end(),
+                                        [&live](OperatorBase* op) { return live.count(op) == 0; }),
+                         mOperators.end());
+        ComputeUses();
+    }
+
+    MaybeError GraphOptimizer::FoldBatchNorms() {
+        // batchNorm(conv2d(x, w, b)) = conv2d(x, w * f, (b - mean) * f + bias) with
+        // f = scale / sqrt(variance + epsilon) per output channel.
+        std::vector<OperatorBase*> constants;
+        for (OperatorBase* op : mOperators) {
+            const op::BatchNorm* batchNorm = mCaster->AsBatchNorm(op);
+            if (batchNorm == nullptr) {
+                continue;
+            }
+            OperandBase* convOutput = batchNorm->Inputs()[0].Get();
+            op::Conv2d* conv2d = const_cast<op::Conv2d*>(mCaster->AsConv2d(convOutput->Operator()));
+            if (conv2d == nullptr || mUses[convOutput].size() != 1 || IsOutput(convOutput)) {
+                continue;
+            }
+            const Conv2dOptions* convOptions = conv2d->GetOptions();
+            const BatchNormOptions* options = batchNorm->GetOptions();
+            const bool nchw = convOptions->inputLayout == wnn::InputOperandLayout::Nchw;
+            if (convOptions->activation != nullptr || options->axis != (nchw ? 1u : 3u) ||
+                (options->activation != nullptr &&
+                 !conv2d->CanFuseActivation(mGraph, options->activation->GetFusionType()))) {
+                continue;
+            }
+
+            const int32_t channels = convOutput->Shape()[nchw ? 1 : 3];
+            auto channelValues = [this, channels](const OperandBase* operand) -> const float* {
+                if (mConstants.count(operand) == 0 ||
+                    operand->Type() != wnn::OperandType::Float32 ||
+                    operand->Shape() != std::vector<int32_t>{channels}) {
+                    return nullptr;
+                }
+                return static_cast<const float*>(
+                    mCaster->AsConstant(operand->Operator())->GetBuffer());
+            };
+            auto& inputs = batchNorm->Inputs();
+            const float* mean = channelValues(inputs[1].Get());
+            const float* variance = channelValues(inputs[2].Get());
+            const float* scale =
+                options->scale != nullptr ? channelValues(inputs[3].Get()) : nullptr;
+            const float* bias = options->bias != nullptr
+                                    ? channelValues(inputs[options->scale != nullptr ? 4 : 3].Get())
+                                    : nullptr;
+            const float* convBias =
+                convOptions->bias != nullptr ? channelValues(conv2d->Inputs()[2].Get()) : nullptr;
+            const OperandBase* filter = conv2d->Inputs()[1].Get();
+            const bool outputChannelFirst =
+                convOptions->filterLayout == wnn::Conv2dFilterOperandLayout::Oihw ||
+                convOptions->filterLayout == wnn::Conv2dFilterOperandLayout::Ohwi;
+            if (mean == nullptr || variance == nullptr ||
+                (options->scale != nullptr && scale == nullptr) ||
+                (options->bias != nullptr && bias == nullptr) ||
+                (convOptions->bias != nullptr && convBias == nullptr) ||
+                mConstants.count(filter) == 0 || filter->Type() != wnn::OperandType::Float32 ||
+                filter->Shape()[outputChannelFirst ? 0 : 3] != channels ||
+                mCaster->AsConstant(filter->Operator())->GetBuffer() == nullptr) {
+                continue;
+            }
+
+            std::vector<float> factors(channels);
+            std::vector<char> biasData(channels * sizeof(float));
+            float* newBias = reinterpret_cast<float*>(biasData.data());
+            for (int32_t c = 0; c < channels; ++c) {
+                factors[c] = (scale != nullptr ? scale[c] : 1.0f) /
+                             std::sqrt(variance[c] + options->epsilon);
+                newBias[c] = ((convBias != nullptr ? convBias[c] : 0.0f) - mean[c]) * factors[c] +
+                             (bias != nullptr ? bias[c] : 0.0f);
+            }
+            const size_t filterCount = utils::ElementCount(filter->Shape());
+            const size_t innerCount = filterCount / channels;
+            const float* weights =
+                static_cast<const float*>(mCaster->AsConstant(filter->Operator())->GetBuffer());
+            std::vector<char> filterData(filterCount * sizeof(float));
+            float* newWeights = reinterpret_cast<float*>(filterData.data());
+            for (size_t i = 0; i < filterCount; ++i) {
+                newWeights[i] =
+                    weights[i] * factors[outputChannelFirst ? i / innerCount : i % channels];
+            }
+
+            OperatorBase* newFilter;
+            DAWN_TRY_ASSIGN(newFilter, CreateConstant(wnn::OperandType::Float32, filter->Shape(),
+                                                      std::move(filterData)));
+            OperatorBase* newBiasConstant;
+            DAWN_TRY_ASSIGN(newBiasConstant, CreateConstant(wnn::OperandType::Float32, {channels},
+                                                            std::move(biasData)));
+            constants.push_back(newFilter);
+            constants.push_back(newBiasConstant);
+            SetInput(conv2d, 1, newFilter->PrimaryOutput());
+            if (convOptions->bias != nullptr) {
+                SetInput(conv2d, 2, newBiasConstant->PrimaryOutput());
+            } else {
+                conv2d->SetBias(newBiasConstant->PrimaryOutput());
+                mBiasedConv2ds.push_back(conv2d);
+                mUses[newBiasConstant->PrimaryOutput()].push_back({conv2d, 2});
+            }
+            if (options->activation != nullptr) {
+                conv2d->SetFusedActivation(options->activation);
+                mFusedOperators.push_back(conv2d);
+                mGraph->AddOwnedActivation(options->activation);
+            }
+            mUses.erase(convOutput);
+            Replace(batchNorm->PrimaryOutput(), convOutput);
+        }
+        // The new constants have no inputs, they can go first.
+        mOperators.insert(mOperators.begin(), constants.begin(), constants.end());
+        return {};
+    }
+
+    MaybeError GraphOptimizer::PropagateLayouts() {
+        wnn::InputOperandLayout preferred;
+        if (!mGraph->GetPreferredLayout(&preferred)) {
+            return {};
+        }
+        const wnn::Conv2dFilterOperandLayout preferredFilterLayout =
+            preferred == wnn::InputOperandLayout::Nchw ? wnn::Conv2dFilterOperandLayout::Oihw
+                                                       : wnn::Conv2dFilterOperandLayout::Ohwi;
+        const std::vector<int32_t> toPreferred = LayoutPermutation(preferred);
+        const wnn::InputOperandLayout other = preferred == wnn::InputOperandLayout::Nchw
+                                                  ? wnn::InputOperandLayout::Nhwc
+                                                  : wnn::InputOperandLayout::Nchw;
+        const std::vector<int32_t> fromPreferred = LayoutPermutation(other);
+
+        // The transposes to run before and after each operator once the pass is done.
+        std::unordered_map<const OperatorBase*, std::vector<OperatorBase*>> insertedBefore;
+        std::unordered_map<const OperatorBase*, std::vector<OperatorBase*>> insertedAfter;
+        std::unordered_set<const OperatorBase*> visited;
+        for (OperatorBase* anchor : mOperators) {
+            wnn::InputOperandLayout layout;
+            if (visited.count(anchor) != 0 || !anchor->GetLayout(&layout) || layout == preferred) {
+                continue;
+            }
+
+            // Grows the region of the operators that can switch along with |anchor| through
+            // the layout inputs and their users, a whole chain of them then needs transposes
+            // only where it is entered and left. The counts are taken before the shapes change.
+            std::unordered_map<const OperatorBase*, size_t> region;
+            std::stack<OperatorBase*> toVisit;
+            auto tryAdd = [&](OperatorBase* op) {
+                wnn::InputOperandLayout opLayout;
+                const size_t count = op->GetLayoutInputCount();
+                if (visited.count(op) != 0 || count == 0 ||
+                    (op->GetLayout(&opLayout) && opLayout != other)) {
+                    return;
+                }
+                visited.insert(op);
+                region[op] = count;
+                toVisit.push(op);
+            };
+            tryAdd(anchor);
+            while (!toVisit.empty()) {
+                OperatorBase* op = toVisit.top();
+                toVisit.pop();
+                for (size_t i = 0; i < region[op]; ++i) {
+                    tryAdd(const_cast<OperatorBase*>(op->Inputs()[i]->Operator()));
+                }
+                for (auto& output : op->Outputs()) {
+                    for (const Use& use : mUses[output.Get()]) {
+                        if (use.index < use.op->GetLayoutInputCount()) {
+                            tryAdd(use.op);
+                        }
+                    }
+                }
+            }
+            auto isLayoutUse = [&region](const Use& use) {
+                auto member = region.find(use.op);
+                return member != region.end() && use.index < member->second;
+            };
+
+            // The operators are switched in topological order so that the transposes of the
+            // inputs entering the region go before their first user.
+            std::unordered_map<const OperandBase*, OperandBase*> transposedInputs;
+            for (OperatorBase* op : mOperators) {
+                auto member = region.find(op);
+                if (member == region.end()) {
+                    continue;
+                }
+                for (size_t i = 0; i < member->second; ++i) {
+                    OperandBase* input = op->Inputs()[i].Get();
+                    if (region.count(input->Operator()) != 0) {
+                        continue;
+                    }
+                    auto transposed = transposedInputs.find(input);
+                    if (transposed == transposedInputs.end()) {
+                        OperatorBase* transpose;
+                        DAWN_TRY_ASSIGN(transpose, CreateTranspose(input, toPreferred));
+                        insertedBefore[op].push_back(transpose);
+                        transposed =
+                            transposedInputs.emplace(input, transpose->PrimaryOutput()).first;
+                    }
+                    SetInput(op, i, transposed->second);
+                }
+                op::Conv2d* conv2d = const_cast<op::Conv2d*>(mCaster->AsConv2d(op));
+                if (conv2d != nullptr &&
+                    conv2d->GetOptions()->filterLayout != preferredFilterLayout) {
+                    const wnn::Conv2dFilterOperandLayout filterLayout =
+                        conv2d->GetOptions()->filterLayout;
+                    OperatorBase* transpose;
+                    DAWN_TRY_ASSIGN(transpose,
+                                    CreateTranspose(conv2d->Inputs()[1].Get(),
+                                                    utils::FilterPermutation(
+                                                        filterLayout, preferredFilterLayout)));
+                    insertedBefore[op].push_back(transpose);
+                    SetInput(conv2d, 1, transpose->PrimaryOutput());
+                    conv2d->SetFilterLayout(preferredFilterLayout);
+                    mFilterLayoutChanges.push_back({conv2d, filterLayout});
+                }
+
+                op->SwitchLayout(preferred);
+                mLayoutChanges.push_back({op, other});
+                for (auto& output : op->Outputs()) {
+                    output->SetShape(Permute(output->Shape(), toPreferred));
+                    std::vector<Use> externalUses;
+                    for (const Use& use : mUses[output.Get()]) {
+                        if (!isLayoutUse(use)) {
+                            externalUses.push_back(use);
+                        }
+                    }
+                    if (externalUses.empty() && !IsOutput(output.Get())) {
+                        continue;
+                    }
+                    // The value leaves the region, it is transposed back for the other users.
+                    OperatorBase* transpose;
+                    DAWN_TRY_ASSIGN(transpose, CreateTranspose(output.Get(), fromPreferred));
+                    insertedAfter[op].push_back(transpose);
+                    for (const Use& use : externalUses) {
+                        SetInput(use.op, use.index, transpose->PrimaryOutput());
+                    }
+                    if (IsOutput(output.Get())) {
+                        std::replace(mOutputs.begin(), mOutputs.end(),
+                                     static_cast<const OperandBase*>(output.Get()),
+                                     static_cast<const OperandBase*>(transpose->PrimaryOutput()));
+                        mReplacements[output.Get()] = transpose->PrimaryOutput();
+                    }
+                }
+            }
+        }
+
+        std::vector<OperatorBase*> operators;
+        operators.reserve(mOperators.size());
+        for (OperatorBase* op : mOperators) {
+            auto before = insertedBefore.find(op);
+            if (before != insertedBefore.end()) {
+                operators.insert(operators.end(), before->second.begin(), before->second.end());
+            }
+            operators.push_back(op);
+            auto after = insertedAfter.find(op);
+            if (after != insertedAfter.end()) {
+                operators.insert(operators.end(), after->second.begin(), after->second.end());
+            }
+        }
+        mOperators = std::move(operators);
+
+        // A transpose undoing the transpose it reads, e.g. one of the model next to one at the
+        // boundary of a region, is replaced by the value before both.
+        for (OperatorBase* op : mOperators) {
+            const op::Transpose* transpose = mCaster->AsTranspose(op);
+            if (transpose == nullptr || IsOutput(op->PrimaryOutput())) {
+                continue;
+            }
+            const op::Transpose* producer = mCaster->AsTranspose(op->Inputs()[0]->Operator());
+            if (producer == nullptr) {
+                continue;
+            }
+            const std::vector<int32_t> permutation = transpose->GetPermutation();
+            const std::vector<int32_t> producerPermutation = producer->GetPermutation();
+            bool identity = true;
+            for (size_t i = 0; i < permutation.size(); ++i) {
+                identity =
+                    identity && producerPermutation[permutation[i]] == static_cast<int32_t>(i);
+            }
+            if (identity) {
+                Replace(op->PrimaryOutput(), producer->Inputs()[0].Get());
+            }
+        }
+        return {};
+    }
+
+    void GraphOptimizer::FuseOperators() {
+        for (OperatorBase* op : mOperators) {
+            if (op->Inputs().size() != 1) {
+                continue;
+            }
+            Ref<FusionOperatorBase> activation = op->CreateFusionOperator(mBuilder);
+            if (activation == nullptr) {
+                continue;
+            }
+            // The value before the activation must not be visible anywhere else.
+            OperandBase* input = op->Inputs()[0].Get();
+            OperatorBase* producer = const_cast<OperatorBase*>(input->Operator());
+            if (producer->Outputs().size() != 1 || mUses[input].size() != 1 || IsOutput(input) ||
+                !producer->CanFuseActivation(mGraph, activation->GetFusionType())) {
+                continue;
+            }
+            producer->SetFusedActivation(activation.Get());
+            mFusedOperators.push_back(producer);
+            mGraph->AddOwnedActivation(std::move(activation));
+            Replace(op->PrimaryOutput(), input);
+        }
+    }
+
+}  // namespace webnn::native
@@ -0,0 +1,108 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef WEBNN_NATIVE_GRAPH_OPTIMIZER_H_
+#define WEBNN_NATIVE_GRAPH_OPTIMIZER_H_
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "webnn/native/Error.h"
+#include "webnn/native/FusionOperator.h"
+#include "webnn/native/Graph.h"
+#include "webnn/native/NamedOperands.h"
+
+namespace webnn::native {
+
+    class OperatorCaster;
+
+    // Runs the backend independent passes enabled in the context options on the operator DAG
+    // before the operators are added to the backend graph. The passes rewrite the operators of
+    // the builder in place and the rewrites are undone when the optimizer is destroyed, so that
+    // the builder can build other graphs from the same operators.
+    class GraphOptimizer {
+      public:
+        GraphOptimizer(GraphBuilderBase* builder, GraphBase* graph);
+        ~GraphOptimizer();
+
+        // |operators| are sorted topologically and are replaced by the operators left after the
+        // passes, still in topological order.
+        MaybeError Run(std::vector<const OperatorBase*>* operators,
+                       const NamedOperandsBase* namedOperands);
+
+        // Returns the operand holding the value of |operand| after the rewrites.
+        const OperandBase* GetReplacement(const OperandBase* operand) const;
+
+      private:
+        struct Use {
+            OperatorBase* op;
+            size_t index;
+        };
+
+        MaybeError FoldConstants();
+        MaybeError EliminateCommonSubexpressions();
+        void EliminateDeadNodes();
+        MaybeError FoldBatchNorms();
+        MaybeError PropagateLayouts();
+        void FuseOperators();
+
+        void ComputeUses();
+        bool IsOutput(const OperandBase* operand) const;
+        // Makes |op| use |input| as its input at |index|.
+        void SetInput(OperatorBase* op, size_t index, OperandBase* input);
+        // Makes every user of |from| use |to| instead.
+        void Replace(const OperandBase* from, OperandBase* to);
+        // Creates a constant owning |data|, the graph keeps it alive.
+        ResultOrError<OperatorBase*> CreateConstant(wnn::OperandType type,
+                                                    std::vector<int32_t> dimensions,
+                                                    std::vector<char> data);
+        // Creates a transpose of |input| that is kept alive by the graph.
+        ResultOrError<OperatorBase*> CreateTranspose(OperandBase* input,
+                                                     std::vector<int32_t> permutation);
+
+        GraphBuilderBase* mBuilder;
+        GraphBase* mGraph;
+        Ref<OperatorCaster> mCaster;
+        std::vector<OperatorBase*> mOperators;
+        std::vector<const OperandBase*> mOutputs;
+        std::unordered_map<const OperandBase*, std::vector<Use>> mUses;
+        std::unordered_map<const OperandBase*, OperandBase*> mReplacements;
+        // The outputs of op::Constant, including the ones created by constant folding.
+        std::unordered_set<const OperandBase*> mConstants;
+
+        // What is needed to undo the rewrites.
+        struct InputChange {
+            OperatorBase* op;
+            size_t index;
+            Ref<OperandBase> input;
+        };
+        std::vector<InputChange> mInputChanges;
+        std::vector<op::Conv2d*> mBiasedConv2ds;
+        std::vector<OperatorBase*> mFusedOperators;
+        struct LayoutChange {
+            OperatorBase* op;
+            wnn::InputOperandLayout layout;
+        };
+        std::vector<LayoutChange> mLayoutChanges;
+        struct FilterLayoutChange {
+            op::Conv2d* conv2d;
+            wnn::Conv2dFilterOperandLayout layout;
+        };
+        std::vector<FilterLayoutChange> mFilterLayoutChanges;
+    };
+
+}  // namespace webnn::native
+
+#endif  // WEBNN_NATIVE_GRAPH_OPTIMIZER_H_
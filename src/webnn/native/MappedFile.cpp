@@ -0,0 +1,88 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "webnn/native/MappedFile.h"
+
+#if defined(_WIN32)
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+namespace webnn::native {
+
+    // static
+    ResultOrError<Ref<MappedFile>> MappedFile::Create(const std::string& path) {
+        Ref<MappedFile> file = AcquireRef(new MappedFile());
+#if defined(_WIN32)
+        HANDLE handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        DAWN_INVALID_IF(handle == INVALID_HANDLE_VALUE, "Failed to open the constant file.");
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(handle, &size) || size.QuadPart == 0) {
+            CloseHandle(handle);
+            return DAWN_VALIDATION_ERROR("The constant file is empty or can't be read.");
+        }
+        // The mapping keeps the file alive, the handle can be closed right away.
+        HANDLE mapping = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(handle);
+        if (mapping == nullptr) {
+            return DAWN_INTERNAL_ERROR("Failed to map the constant file.");
+        }
+        file->mMapping = mapping;
+        file->mData = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (file->mData == nullptr) {
+            return DAWN_INTERNAL_ERROR("Failed to map the constant file.");
+        }
+        file->mByteLength = static_cast<size_t>(size.QuadPart);
+#else
+        int fd = open(path.c_str(), O_RDONLY);
+        DAWN_INVALID_IF(fd < 0, "Failed to open the constant file.");
+        struct stat status;
+        if (fstat(fd, &status) != 0 || status.st_size == 0) {
+            close(fd);
+            return DAWN_VALIDATION_ERROR("The constant file is empty or can't be read.");
+        }
+        // A private read-only mapping shares the page cache pages with every other process
+        // mapping the file. The mapping stays valid after closing the descriptor.
+        void* data = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (data == MAP_FAILED) {
+            return DAWN_INTERNAL_ERROR("Failed to map the constant file.");
+        }
+        file->mData = data;
+        file->mByteLength = static_cast<size_t>(status.st_size);
+#endif
+        return std::move(file);
+    }
+
+    MappedFile::~MappedFile() {
+#if defined(_WIN32)
+        if (mData != nullptr) {
+            UnmapViewOfFile(mData);
+        }
+        if (mMapping != nullptr) {
+            CloseHandle(mMapping);
+        }
+#else
+        if (mData != nullptr) {
+            munmap(mData, mByteLength);
+        }
+#endif
+    }
+
+}  // namespace webnn::native
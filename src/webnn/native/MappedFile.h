@@ -0,0 +1,52 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef WEBNN_NATIVE_MAPPED_FILE_H_
+#define WEBNN_NATIVE_MAPPED_FILE_H_
+
+#include <string>
+
+#include "common/RefCounted.h"
+#include "webnn/native/Error.h"
+
+namespace webnn::native {
+
+    // A read-only memory mapping of a whole file. Constants created from a file point into the
+    // mapping instead of owning a copy, so the weights stay backed by the page cache and are
+    // shared by every process that maps the same model.
+    class MappedFile : public RefCounted {
+      public:
+        static ResultOrError<Ref<MappedFile>> Create(const std::string& path);
+        ~MappedFile() override;
+
+        const void* GetData() const {
+            return mData;
+        }
+        size_t GetByteLength() const {
+            return mByteLength;
+        }
+
+      private:
+        MappedFile() = default;
+
+        void* mData = nullptr;
+        size_t mByteLength = 0;
+#if defined(_WIN32)
+        void* mMapping = nullptr;
+#endif
+    };
+
+}  // namespace webnn::native
+
+#endif  // WEBNN_NATIVE_MAPPED_FILE_H_
@@ -18,6 +18,7 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "common/Log.h"
 #include "webnn/native/webnn_platform.h"
@@ -46,11 +47,13 @@ namespace webnn::native {
             // Input data type is Arrary Buffer View.
             const ArrayBufferView arrayBufferView = input->resource.arrayBufferView;
             if (arrayBufferView.buffer != nullptr) {
-                std::unique_ptr<char> buffer(new char[arrayBufferView.byteLength]);
-                memcpy(buffer.get(), arrayBufferView.buffer, arrayBufferView.byteLength);
+                // Setting a bound input again reuses its copy so that the data pointer seen by
+                // the backend stays stable across GraphComputeBound commands.
+                std::vector<char>& buffer = mInputsBuffer[std::string(name)];
+                buffer.resize(arrayBufferView.byteLength);
+                memcpy(buffer.data(), arrayBufferView.buffer, arrayBufferView.byteLength);
 
-                mInputs[std::string(name)].resource.arrayBufferView.buffer = buffer.get();
-                mInputsBuffer.push_back(std::move(buffer));
+                mInputs[std::string(name)].resource.arrayBufferView.buffer = buffer.data();
             } else if (input->resource.gpuBufferView.buffer != nullptr) {
 #    if defined(WEBNN_ENABLE_GPU_BUFFER)
                 GpuBufferView gpuBufferView = input->resource.gpuBufferView;
@@ -62,11 +65,10 @@ namespace webnn::native {
                 UNREACHABLE();
 #    endif
             }
-            std::vector<int32_t> dimensions;
+            std::vector<int32_t>& dimensions = mInputsDimensions[std::string(name)];
             dimensions.assign(input->dimensions, input->dimensions + input->dimensionsCount);
             // Prevent destroy from allocator memory after hanlding the command.
             mInputs[std::string(name)].dimensions = dimensions.data();
-            mInputsDimensions.push_back(std::move(dimensions));
 #endif  // defined(WEBNN_ENABLE_WIRE)
         }
 
@@ -82,11 +84,17 @@ namespace webnn::native {
             return mInputs;
         }
 
+        // Sets |input| without the copy made for the wire, used by a partitioned graph to pass
+        // the tensors it owns from one partition to the next.
+        void SetView(const std::string& name, const Input& input) {
+            mInputs[name] = input;
+        }
+
       private:
         // The tempary memory in Allocator will be released after handling the command, so the
         // buffer and dimensions pointer need to be copied to use in GraphComputeCmd.
-        std::vector<std::unique_ptr<char>> mInputsBuffer;
-        std::vector<std::vector<int32_t>> mInputsDimensions;
+        std::unordered_map<std::string, std::vector<char>> mInputsBuffer;
+        std::unordered_map<std::string, std::vector<int32_t>> mInputsDimensions;
 
         std::unordered_map<std::string, Input> mInputs;
     };
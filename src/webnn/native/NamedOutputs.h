@@ -52,11 +52,12 @@ namespace webnn::native {
 #endif
             } else {
 #if defined(WEBNN_ENABLE_WIRE)
-                // malloc a memory to host the result of computing.
-                std::unique_ptr<char> buffer(new char[resource->arrayBufferView.byteLength]);
+                // malloc a memory to host the result of computing. Setting a bound output again
+                // reuses it so that the data pointer seen by the backend stays stable.
+                std::vector<char>& buffer = mOutputsBuffer[std::string(name)];
+                buffer.resize(resource->arrayBufferView.byteLength);
                 // Prevent destroy from allocator memory after hanlding the command.
-                mOutputs[std::string(name)].arrayBufferView.buffer = buffer.get();
-                mOutputsBuffer.push_back(std::move(buffer));
+                mOutputs[std::string(name)].arrayBufferView.buffer = buffer.data();
 #endif  // defined(WEBNN_ENABLE_WIRE)
             }
         }
@@ -80,10 +81,16 @@ namespace webnn::native {
             return mOutputs;
         }
 
+        // Sets |resource| without the buffer allocated for the wire, used by a partitioned graph
+        // to let a partition write into the tensors it owns.
+        void SetView(const std::string& name, const Resource& resource) {
+            mOutputs[name] = resource;
+        }
+
       private:
         // The tempary memory in Allocator will be released after handling the command, so malloc
         // the same size memory to hold the result from GraphComputeCmd.
-        std::vector<std::unique_ptr<char>> mOutputsBuffer;
+        std::unordered_map<std::string, std::vector<char>> mOutputsBuffer;
 
         std::unordered_map<std::string, Resource> mOutputs;
     };
@@ -16,6 +16,7 @@
 #include "webnn/native/Operator.h"
 
 #include "common/Assert.h"
+#include "webnn/native/FusionOperator.h"
 #include "webnn/native/GraphBuilder.h"
 
 namespace webnn::native {
@@ -49,6 +50,38 @@ namespace webnn::native {
         DAWN_UNREACHABLE();
     }
 
+    void OperatorBase::SetInput(size_t index, OperandBase* input) {
+        DAWN_ASSERT(index < mInputs.size());
+        mInputs[index] = input;
+    }
+
+    bool OperatorBase::CanFuseActivation(const GraphBase* graph, FusionType type) const {
+        return false;
+    }
+
+    void OperatorBase::SetFusedActivation(FusionOperatorBase* activation) {
+        DAWN_UNREACHABLE();
+    }
+
+    Ref<FusionOperatorBase> OperatorBase::CreateFusionOperator(GraphBuilderBase* builder) const {
+        return nullptr;
+    }
+
+    size_t OperatorBase::GetLayoutInputCount() const {
+        return 0;
+    }
+
+    bool OperatorBase::GetLayout(wnn::InputOperandLayout* layout) const {
+        return false;
+    }
+
+    void OperatorBase::SwitchLayout(wnn::InputOperandLayout layout) {
+    }
+
+    bool OperatorBase::SupportsDynamicDimensions() const {
+        return false;
+    }
+
     MaybeError OperatorBase::ValidateAndInferOutputInfo() {
         for (auto& input : mInputs) {
             if (input->IsError()) {
@@ -21,6 +21,8 @@
 
 namespace webnn::native {
 
+    enum class FusionType : uint32_t;
+
     class OperatorBase : public ObjectBase {
       public:
         explicit OperatorBase(GraphBuilderBase* GraphBuilder,
@@ -35,6 +37,29 @@ namespace webnn::native {
         // Add the operand to model for specific backend.
         virtual MaybeError AddToGraph(GraphBase* graph) const;
         virtual MaybeError ValidateAndInferOutputInfo();
+        // Whether ValidateAndInferOutputInfo handles inputs with dynamic dimensions, the output
+        // dimensions that depend on them are dynamic and are only validated once specialized.
+        virtual bool SupportsDynamicDimensions() const;
+
+        // Used by the graph optimization passes to rewrite the operator DAG in place, the passes
+        // restore the original inputs and activations once the graph is built.
+        void SetInput(size_t index, OperandBase* input);
+        // Whether an activation of |type| applied to the primary output can be fused into the
+        // operator by |graph|'s backend.
+        virtual bool CanFuseActivation(const GraphBase* graph, FusionType type) const;
+        virtual void SetFusedActivation(FusionOperatorBase* activation);
+        // Returns the fusion operator equivalent to this operator if it is an element-wise
+        // activation that can be fused into the operator producing its input.
+        virtual Ref<FusionOperatorBase> CreateFusionOperator(GraphBuilderBase* builder) const;
+        // Used by the layout propagation pass. Returns the number of leading inputs that are 4-D
+        // tensors in the layout of the operator if it computes the same values once switched to
+        // the other layout with those inputs and its 4-D outputs transposed accordingly.
+        virtual size_t GetLayoutInputCount() const;
+        // The layout of the operators that have a layout option, like conv2d and pool2d.
+        virtual bool GetLayout(wnn::InputOperandLayout* layout) const;
+        // Switches the options of the operator to |layout|, the output shapes are permuted by the
+        // pass.
+        virtual void SwitchLayout(wnn::InputOperandLayout layout);
 
         static OperatorBase* MakeError(GraphBuilderBase* graphBuilder);
 
@@ -0,0 +1,107 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef WEBNN_NATIVE_OPERATOR_CASTER_H_
+#define WEBNN_NATIVE_OPERATOR_CASTER_H_
+
+#include "common/Assert.h"
+#include "webnn/native/Graph.h"
+#include "webnn/native/ops/BatchNorm.h"
+#include "webnn/native/ops/Constant.h"
+#include "webnn/native/ops/Conv2d.h"
+#include "webnn/native/ops/Input.h"
+#include "webnn/native/ops/Transpose.h"
+
+namespace webnn::native {
+
+    // Recovers the type of an operator through the AddToGraph double dispatch, the graph passes
+    // only look into the few operators they rewrite.
+    class OperatorCaster final : public GraphBase {
+      public:
+        explicit OperatorCaster(ContextBase* context) : GraphBase(context) {
+        }
+
+        const op::Constant* AsConstant(const OperatorBase* op) {
+            Visit(op);
+            return mConstant;
+        }
+        const op::Input* AsInput(const OperatorBase* op) {
+            Visit(op);
+            return mInput;
+        }
+        const op::Conv2d* AsConv2d(const OperatorBase* op) {
+            Visit(op);
+            return mConv2d;
+        }
+        const op::BatchNorm* AsBatchNorm(const OperatorBase* op) {
+            Visit(op);
+            return mBatchNorm;
+        }
+        const op::Transpose* AsTranspose(const OperatorBase* op) {
+            Visit(op);
+            return mTranspose;
+        }
+
+        MaybeError AddConstant(const op::Constant* constant) override {
+            mConstant = constant;
+            return {};
+        }
+        MaybeError AddInput(const op::Input* input) override {
+            mInput = input;
+            return {};
+        }
+        MaybeError AddConv2d(const op::Conv2d* conv2d) override {
+            mConv2d = conv2d;
+            return {};
+        }
+        MaybeError AddBatchNorm(const op::BatchNorm* batchNorm) override {
+            mBatchNorm = batchNorm;
+            return {};
+        }
+        MaybeError AddTranspose(const op::Transpose* transpose) override {
+            mTranspose = transpose;
+            return {};
+        }
+
+      private:
+        void Visit(const OperatorBase* op) {
+            mConstant = nullptr;
+            mInput = nullptr;
+            mConv2d = nullptr;
+            mBatchNorm = nullptr;
+            mTranspose = nullptr;
+            // The operators that aren't overridden above report an unimplemented error.
+            MaybeError maybeError = op->AddToGraph(this);
+            if (maybeError.IsError()) {
+                maybeError.AcquireError();
+            }
+        }
+
+        MaybeError CompileImpl() override {
+            UNREACHABLE();
+        }
+        MaybeError ComputeImpl(NamedInputsBase* inputs, NamedOutputsBase* outputs) override {
+            UNREACHABLE();
+        }
+
+        const op::Constant* mConstant = nullptr;
+        const op::Input* mInput = nullptr;
+        const op::Conv2d* mConv2d = nullptr;
+        const op::BatchNorm* mBatchNorm = nullptr;
+        const op::Transpose* mTranspose = nullptr;
+    };
+
+}  // namespace webnn::native
+
+#endif  // WEBNN_NATIVE_OPERATOR_CASTER_H_
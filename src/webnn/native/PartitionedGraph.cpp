@@ -0,0 +1,364 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "webnn/native/PartitionedGraph.h"
+
+#include <algorithm>
+#include <deque>
+#include <memory>
+
+#include "common/Log.h"
+#include "webnn/native/Context.h"
+#include "webnn/native/Operand.h"
+#include "webnn/native/Operator.h"
+#include "webnn/native/OperatorCaster.h"
+#include "webnn/native/Utils.h"
+#include "webnn/native/ops/Input.h"
+#include "webnn/native/reference/GraphReference.h"
+
+namespace webnn::native {
+
+    namespace {
+
+        // The prefix of the names of the tensors passed between partitions that aren't graph
+        // outputs.
+        constexpr char kTensorNamePrefix[] = "webnn_partition_tensor_";
+
+        ResultOrError<Ref<OperatorBase>> CreatePlaceholder(GraphBuilderBase* builder,
+                                                           const std::string& name,
+                                                           const OperandBase* operand) {
+            OperandDescriptor desc = {};
+            desc.type = operand->Type();
+            desc.dimensions = operand->Shape().data();
+            desc.dimensionsCount = operand->Shape().size();
+            Ref<OperatorBase> input = AcquireRef(new op::Input(builder, name, &desc));
+            DAWN_TRY(input->ValidateAndInferOutputInfo());
+            return std::move(input);
+        }
+
+        // Makes operators read the placeholder inputs of a partition for the operands produced
+        // outside of it, their inputs are restored when it goes out of scope.
+        class InputChanges {
+          public:
+            ~InputChanges() {
+                for (auto change = mChanges.rbegin(); change != mChanges.rend(); ++change) {
+                    change->op->SetInput(change->index, change->input.Get());
+                }
+            }
+
+            void Set(OperatorBase* op, size_t index, OperandBase* input) {
+                mChanges.push_back({op, index, op->Inputs()[index]});
+                op->SetInput(index, input);
+            }
+
+          private:
+            struct Change {
+                OperatorBase* op;
+                size_t index;
+                Ref<OperandBase> input;
+            };
+            std::vector<Change> mChanges;
+        };
+
+        MaybeError AddPartition(GraphBase* graph,
+                                const std::vector<const OperatorBase*>& leaves,
+                                const std::vector<OperatorBase*>& operators,
+                                const std::vector<PartitionedGraph::NamedOutput>& outputs) {
+            for (const OperatorBase* leaf : leaves) {
+                DAWN_TRY(leaf->AddToGraph(graph));
+            }
+            for (const OperatorBase* op : operators) {
+                DAWN_TRY(op->AddToGraph(graph));
+            }
+            for (auto& output : outputs) {
+                DAWN_TRY(graph->AddOutput(output.name, output.operand));
+            }
+            DAWN_TRY(graph->Finish());
+            DAWN_TRY(graph->Compile());
+            return {};
+        }
+
+    }  // namespace
+
+    PartitionedGraph::PartitionedGraph(ContextBase* context) : GraphBase(context) {
+    }
+
+    PartitionedGraph::~PartitionedGraph() = default;
+
+    MaybeError PartitionedGraph::Build(GraphBuilderBase* builder,
+                                       const std::vector<const OperatorBase*>& operators,
+                                       const std::vector<NamedOutput>& outputs) {
+        mCaster = AcquireRef(new OperatorCaster(GetContext()));
+        std::unordered_map<const OperandBase*, std::vector<std::string>> outputNames;
+        for (auto& output : outputs) {
+            outputNames[output.operand].push_back(output.name);
+        }
+
+        // Constants and inputs have no inputs, they are added to every partition using them.
+        std::vector<OperatorBase*> computeOperators;
+        std::unordered_map<const OperatorBase*, bool> onBackend;
+        std::unordered_map<const OperandBase*, std::vector<const OperatorBase*>> users;
+        for (const OperatorBase* op : operators) {
+            if (op->Inputs().empty()) {
+                continue;
+            }
+            computeOperators.push_back(const_cast<OperatorBase*>(op));
+            onBackend[op] = IsSupported(builder, const_cast<OperatorBase*>(op));
+            for (auto& input : op->Inputs()) {
+                users[input.Get()].push_back(op);
+            }
+        }
+
+        // Schedules the operators in a topological order that takes the ready operators of the
+        // current kind before switching to the other one, so that each partition grows as large
+        // as the dependencies allow.
+        std::unordered_map<const OperatorBase*, std::vector<OperatorBase*>> consumers;
+        std::unordered_map<const OperatorBase*, size_t> pendingInputs;
+        for (OperatorBase* op : computeOperators) {
+            std::vector<const OperatorBase*> producers;
+            for (auto& input : op->Inputs()) {
+                const OperatorBase* producer = input->Operator();
+                if (!producer->Inputs().empty() &&
+                    std::find(producers.begin(), producers.end(), producer) == producers.end()) {
+                    producers.push_back(producer);
+                    consumers[producer].push_back(op);
+                    ++pendingInputs[op];
+                }
+            }
+        }
+        std::deque<OperatorBase*> ready[2];
+        for (OperatorBase* op : computeOperators) {
+            if (pendingInputs[op] == 0) {
+                ready[onBackend[op]].push_back(op);
+            }
+        }
+        std::unordered_map<const OperatorBase*, size_t> partitionOf;
+        bool current = !computeOperators.empty() && onBackend[computeOperators[0]];
+        while (!ready[0].empty() || !ready[1].empty()) {
+            if (ready[current].empty()) {
+                current = !current;
+            }
+            if (mPartitions.empty() || mPartitions.back().onBackend != current) {
+                mPartitions.emplace_back();
+                mPartitions.back().onBackend = current;
+            }
+            OperatorBase* op = ready[current].front();
+            ready[current].pop_front();
+            partitionOf[op] = mPartitions.size() - 1;
+            mPartitions.back().operators.push_back(op);
+            for (OperatorBase* consumer : consumers[op]) {
+                if (--pendingInputs[consumer] == 0) {
+                    ready[onBackend[consumer]].push_back(consumer);
+                }
+            }
+        }
+
+        // The tensors passed between partitions are named after the graph output they are, if
+        // any, so that the partition producing it writes into the caller's buffer.
+        std::unordered_map<const OperandBase*, std::string> tensorNames;
+        auto tensorName = [&](const OperandBase* operand) -> std::string {
+            auto name = tensorNames.find(operand);
+            if (name == tensorNames.end()) {
+                auto graphNames = outputNames.find(operand);
+                std::string newName = graphNames != outputNames.end()
+                                          ? graphNames->second[0]
+                                          : kTensorNamePrefix + std::to_string(tensorNames.size());
+                name = tensorNames.emplace(operand, newName).first;
+            }
+            return name->second;
+        };
+
+        size_t fallbackCount = 0;
+        for (size_t index = 0; index < mPartitions.size(); ++index) {
+            Partition& partition = mPartitions[index];
+            std::vector<const OperatorBase*> leaves;
+            std::unordered_map<const OperandBase*, OperandBase*> placeholders;
+            InputChanges inputChanges;
+            for (OperatorBase* op : partition.operators) {
+                for (size_t i = 0; i < op->Inputs().size(); ++i) {
+                    OperandBase* input = op->Inputs()[i].Get();
+                    const OperatorBase* producer = input->Operator();
+                    if (producer->Inputs().empty()) {
+                        if (std::find(leaves.begin(), leaves.end(), producer) != leaves.end()) {
+                            continue;
+                        }
+                        leaves.push_back(producer);
+                        const op::Input* graphInput = mCaster->AsInput(producer);
+                        if (graphInput != nullptr) {
+                            partition.inputs.push_back(graphInput->GetName());
+                            mGraphInputs.insert(graphInput->GetName());
+                        }
+                        continue;
+                    }
+                    if (partitionOf[producer] == index) {
+                        continue;
+                    }
+                    auto placeholder = placeholders.find(input);
+                    if (placeholder == placeholders.end()) {
+                        const std::string name = tensorName(input);
+                        Ref<OperatorBase> inputOp;
+                        DAWN_TRY_ASSIGN(inputOp, CreatePlaceholder(builder, name, input));
+                        leaves.push_back(inputOp.Get());
+                        partition.inputs.push_back(name);
+                        placeholder = placeholders.emplace(input, inputOp->PrimaryOutput()).first;
+                        AddOwnedOperator(std::move(inputOp));
+                    }
+                    inputChanges.Set(op, i, placeholder->second);
+                }
+            }
+
+            std::vector<NamedOutput> partitionOutputs;
+            for (OperatorBase* op : partition.operators) {
+                for (auto& output : op->Outputs()) {
+                    auto graphNames = outputNames.find(output.Get());
+                    bool usedLater = false;
+                    for (const OperatorBase* user : users[output.Get()]) {
+                        usedLater = usedLater || partitionOf[user] != index;
+                    }
+                    if (graphNames != outputNames.end()) {
+                        for (const std::string& name : graphNames->second) {
+                            partitionOutputs.push_back({name, output.Get()});
+                        }
+                    } else if (usedLater) {
+                        partitionOutputs.push_back({tensorName(output.Get()), output.Get()});
+                    }
+                }
+            }
+            for (auto& output : partitionOutputs) {
+                partition.outputs.push_back(output.name);
+                const OperandBase* operand = output.operand;
+                mTensorByteLengths[output.name] =
+                    utils::ByteLength(operand->Type(), operand->Shape());
+            }
+
+            if (partition.onBackend) {
+                partition.graph = AcquireRef(GetContext()->CreateGraph());
+                // The operators build on their own but not together, e.g. on backends that
+                // only build single operators or fixed patterns. Any other error, e.g. running
+                // out of memory, fails the graph.
+                MaybeError maybeError = AddPartition(partition.graph.Get(), leaves,
+                                                     partition.operators, partitionOutputs);
+                if (maybeError.IsError()) {
+                    std::unique_ptr<ErrorData> error = maybeError.AcquireError();
+                    if (error->GetType() != InternalErrorType::Unimplemented) {
+                        return std::move(error);
+                    }
+                    partition.onBackend = false;
+                }
+            }
+            if (!partition.onBackend) {
+                partition.graph = AcquireRef(
+                    new reference::Graph(GetContext(), GetContext()->GetFallbackThreadPool()));
+                DAWN_TRY(AddPartition(partition.graph.Get(), leaves, partition.operators,
+                                      partitionOutputs));
+                for (const OperatorBase* op : partition.operators) {
+                    if (!partition.graph->SupportsOperator(op)) {
+                        return DAWN_UNIMPLEMENTED_ERROR(
+                            "Neither the backend nor the reference backend supports the graph.");
+                    }
+                }
+                fallbackCount += partition.operators.size();
+            }
+        }
+        dawn::InfoLog() << "Split the graph into " << mPartitions.size() << " partitions, "
+                        << fallbackCount << " of " << computeOperators.size()
+                        << " operators run on the reference backend.";
+        return {};
+    }
+
+    bool PartitionedGraph::IsSupported(GraphBuilderBase* builder, OperatorBase* op) {
+        Ref<GraphBase> probe = AcquireRef(GetContext()->CreateGraph());
+        std::vector<Ref<OperatorBase>> placeholders;
+        std::vector<const OperatorBase*> leaves;
+        InputChanges inputChanges;
+        for (size_t i = 0; i < op->Inputs().size(); ++i) {
+            OperandBase* input = op->Inputs()[i].Get();
+            const OperatorBase* producer = input->Operator();
+            if (producer->Inputs().empty()) {
+                if (std::find(leaves.begin(), leaves.end(), producer) == leaves.end()) {
+                    leaves.push_back(producer);
+                }
+                continue;
+            }
+            ResultOrError<Ref<OperatorBase>> result =
+                CreatePlaceholder(builder, "input" + std::to_string(i), input);
+            if (result.IsError()) {
+                result.AcquireError();
+                return false;
+            }
+            Ref<OperatorBase> placeholder = result.AcquireSuccess();
+            leaves.push_back(placeholder.Get());
+            inputChanges.Set(op, i, placeholder->PrimaryOutput());
+            placeholders.push_back(std::move(placeholder));
+        }
+        // Backends reject most of the operators they don't implement when they are added, the
+        // others are reported by SupportsOperator. The probe is neither finished nor compiled.
+        for (const OperatorBase* leaf : leaves) {
+            if (IgnoreError(leaf->AddToGraph(probe.Get()))) {
+                return false;
+            }
+        }
+        return !IgnoreError(op->AddToGraph(probe.Get())) && probe->SupportsOperator(op);
+    }
+
+    ResultOrError<ArrayBufferView> PartitionedGraph::GetTensorView(
+        const std::string& name,
+        NamedOutputsBase* outputs,
+        std::unordered_map<std::string, std::vector<char>>* buffers) const {
+        const Resource resource = outputs->Get(name.c_str());
+        if (resource.arrayBufferView.buffer != nullptr) {
+            return resource.arrayBufferView;
+        }
+        DAWN_INVALID_IF(resource.gpuBufferView.buffer != nullptr,
+                        "Partitioned graphs only support array buffer outputs.");
+        const size_t byteLength = mTensorByteLengths.at(name);
+        std::vector<char>& buffer = (*buffers)[name];
+        buffer.resize(byteLength);
+        ArrayBufferView view = {};
+        view.buffer = buffer.data();
+        view.byteLength = byteLength;
+        return view;
+    }
+
+    MaybeError PartitionedGraph::CompileImpl() {
+        // The partitions are compiled by Build.
+        return {};
+    }
+
+    MaybeError PartitionedGraph::ComputeImpl(NamedInputsBase* inputs, NamedOutputsBase* outputs) {
+        std::unordered_map<std::string, std::vector<char>> buffers;
+        for (const Partition& partition : mPartitions) {
+            Ref<NamedInputsBase> namedInputs = AcquireRef(new NamedInputsBase());
+            for (const std::string& name : partition.inputs) {
+                if (mGraphInputs.count(name) != 0) {
+                    namedInputs->SetView(name, inputs->Get(name.c_str()));
+                    continue;
+                }
+                Input input = {};
+                DAWN_TRY_ASSIGN(input.resource.arrayBufferView,
+                                GetTensorView(name, outputs, &buffers));
+                namedInputs->SetView(name, input);
+            }
+            Ref<NamedOutputsBase> namedOutputs = AcquireRef(new NamedOutputsBase());
+            for (const std::string& name : partition.outputs) {
+                Resource resource = {};
+                DAWN_TRY_ASSIGN(resource.arrayBufferView, GetTensorView(name, outputs, &buffers));
+                namedOutputs->SetView(name, resource);
+            }
+            DAWN_TRY(partition.graph->ComputeImpl(namedInputs.Get(), namedOutputs.Get()));
+        }
+        return {};
+    }
+
+}  // namespace webnn::native
@@ -0,0 +1,86 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef WEBNN_NATIVE_PARTITIONED_GRAPH_H_
+#define WEBNN_NATIVE_PARTITIONED_GRAPH_H_
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "webnn/native/Error.h"
+#include "webnn/native/Graph.h"
+#include "webnn/native/NamedInputs.h"
+#include "webnn/native/NamedOutputs.h"
+
+namespace webnn::native {
+
+    class OperatorCaster;
+
+    // Runs a graph that the backend can't build as a whole. The operators are split into
+    // maximal partitions of the operators the backend supports and of the ones it doesn't,
+    // which are run by the reference executor. The partitions are computed one after the
+    // other and read and write the tensors passed between them in place. The tensors are
+    // allocated per compute, so the graph can be computed concurrently.
+    class PartitionedGraph final : public GraphBase {
+      public:
+        struct NamedOutput {
+            std::string name;
+            const OperandBase* operand;
+        };
+
+        explicit PartitionedGraph(ContextBase* context);
+        ~PartitionedGraph() override;
+
+        // |operators| are sorted topologically, their inputs are restored once the partitions
+        // are built.
+        MaybeError Build(GraphBuilderBase* builder,
+                         const std::vector<const OperatorBase*>& operators,
+                         const std::vector<NamedOutput>& outputs);
+
+      private:
+        struct Partition {
+            bool onBackend;
+            std::vector<OperatorBase*> operators;
+            Ref<GraphBase> graph;
+            // The names of the graph inputs and of the tensors of earlier partitions it reads,
+            // and of the tensors it writes.
+            std::vector<std::string> inputs;
+            std::vector<std::string> outputs;
+        };
+
+        // Whether the backend supports |op| on its own, with its inputs fed as graph inputs.
+        bool IsSupported(GraphBuilderBase* builder, OperatorBase* op);
+        // The view of the tensor written by a partition. A buffer is only allocated in
+        // |buffers| if the caller doesn't provide one for it, i.e. if it isn't a graph output
+        // the caller asked for.
+        ResultOrError<ArrayBufferView> GetTensorView(
+            const std::string& name,
+            NamedOutputsBase* outputs,
+            std::unordered_map<std::string, std::vector<char>>* buffers) const;
+
+        MaybeError CompileImpl() override;
+        MaybeError ComputeImpl(NamedInputsBase* inputs, NamedOutputsBase* outputs) override;
+
+        Ref<OperatorCaster> mCaster;
+        std::vector<Partition> mPartitions;
+        std::unordered_set<std::string> mGraphInputs;
+        // The byte lengths of the tensors written by the partitions.
+        std::unordered_map<std::string, size_t> mTensorByteLengths;
+    };
+
+}  // namespace webnn::native
+
+#endif  // WEBNN_NATIVE_PARTITIONED_GRAPH_H_
@@ -0,0 +1,194 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "webnn/native/Profiler.h"
+
+#include "common/Assert.h"
+#include "webnn/native/Graph.h"
+#include "webnn/native/Operand.h"
+#include "webnn/native/Operator.h"
+#include "webnn/native/Utils.h"
+#include "webnn/native/ops/Binary.h"
+#include "webnn/native/ops/Pool2d.h"
+#include "webnn/native/ops/Reduce.h"
+#include "webnn/native/ops/Unary.h"
+
+namespace webnn::native {
+
+    namespace {
+
+        thread_local std::vector<ProfileRecord>* tRecords = nullptr;
+
+        // Names the operators after the builder methods creating them through the AddToGraph
+        // double dispatch.
+        class OperatorTypeNamer final : public GraphBase {
+          public:
+            explicit OperatorTypeNamer(ContextBase* context) : GraphBase(context) {
+            }
+
+            const char* GetType(const OperatorBase* op) {
+                mType = "unknown";
+                MaybeError maybeError = op->AddToGraph(this);
+                if (maybeError.IsError()) {
+                    maybeError.AcquireError();
+                }
+                return mType;
+            }
+
+            MaybeError AddConstant(const op::Constant* constant) override {
+                return SetType("constant");
+            }
+            MaybeError AddInput(const op::Input* input) override {
+                return SetType("input");
+            }
+            MaybeError AddBatchNorm(const op::BatchNorm* batchNorm) override {
+                return SetType("batchNorm");
+            }
+            MaybeError AddBinary(const op::Binary* binary) override {
+                constexpr const char* kTypes[] = {"add", "sub", "mul",    "div",
+                                                  "max", "min", "matmul", "pow"};
+                return SetType(kTypes[binary->GetType()]);
+            }
+            MaybeError AddConvTranspose2d(const op::ConvTranspose2d* convTranspose2d) override {
+                return SetType("convTranspose2d");
+            }
+            MaybeError AddConv2d(const op::Conv2d* conv2d) override {
+                return SetType("conv2d");
+            }
+            MaybeError AddGru(const op::Gru* gru) override {
+                return SetType("gru");
+            }
+            MaybeError AddPad(const op::Pad* pad) override {
+                return SetType("pad");
+            }
+            MaybeError AddPool2d(const op::Pool2d* pool2d) override {
+                constexpr const char* kTypes[] = {"averagePool2d", "l2Pool2d", "maxPool2d"};
+                return SetType(kTypes[pool2d->GetType()]);
+            }
+            MaybeError AddReduce(const op::Reduce* reduce) override {
+                constexpr const char* kTypes[] = {
+                    "reduceL1",      "reduceL2",  "reduceMax", "reduceMean", "reduceMin",
+                    "reduceProduct", "reduceSum", "argMax",    "argMin"};
+                return SetType(kTypes[reduce->GetType()]);
+            }
+            MaybeError AddResample2d(const op::Resample2d* resample2d) override {
+                return SetType("resample2d");
+            }
+            MaybeError AddReshape(const op::Reshape* reshape) override {
+                return SetType("reshape");
+            }
+            MaybeError AddSqueeze(const op::Squeeze* squeeze) override {
+                return SetType("squeeze");
+            }
+            MaybeError AddSlice(const op::Slice* slice) override {
+                return SetType("slice");
+            }
+            MaybeError AddSplit(const op::Split* split) override {
+                return SetType("split");
+            }
+            MaybeError AddTranspose(const op::Transpose* transpose) override {
+                return SetType("transpose");
+            }
+            MaybeError AddUnary(const op::Unary* unary) override {
+                constexpr const char* kTypes[] = {
+                    "abs", "ceil", "cos",     "exp", "floor",   "hardSwish", "log", "leakyRelu",
+                    "neg", "relu", "sigmoid", "sin", "softmax", "tan",       "tanh"};
+                return SetType(kTypes[unary->GetType()]);
+            }
+            MaybeError AddConcat(const op::Concat* concat) override {
+                return SetType("concat");
+            }
+            MaybeError AddGemm(const op::Gemm* gemm) override {
+                return SetType("gemm");
+            }
+            MaybeError AddClamp(const op::Clamp* clamp) override {
+                return SetType("clamp");
+            }
+            MaybeError AddInstanceNorm(const op::InstanceNorm* instanceNorm) override {
+                return SetType("instanceNorm");
+            }
+
+          private:
+            MaybeError SetType(const char* type) {
+                mType = type;
+                return {};
+            }
+
+            MaybeError CompileImpl() override {
+                UNREACHABLE();
+            }
+            MaybeError ComputeImpl(NamedInputsBase* inputs, NamedOutputsBase* outputs) override {
+                UNREACHABLE();
+            }
+
+            const char* mType = "unknown";
+        };
+
+    }  // namespace
+
+    ScopedProfileRecorder::ScopedProfileRecorder(std::vector<ProfileRecord>* records)
+        : mPrevious(tRecords) {
+        tRecords = records;
+    }
+
+    ScopedProfileRecorder::~ScopedProfileRecorder() {
+        tRecords = mPrevious;
+    }
+
+    // static
+    bool ScopedProfileRecorder::IsRecording() {
+        return tRecords != nullptr;
+    }
+
+    ScopedKernelProfile::ScopedKernelProfile(const OperatorBase* op,
+                                             const char* kernel,
+                                             uint64_t byteLength)
+        : mRecords(tRecords), mOp(op), mKernel(kernel), mByteLength(byteLength) {
+        if (mRecords != nullptr) {
+            mStart = std::chrono::steady_clock::now();
+        }
+    }
+
+    ScopedKernelProfile::~ScopedKernelProfile() {
+        if (mRecords == nullptr) {
+            return;
+        }
+        std::chrono::duration<double, std::milli> duration =
+            std::chrono::steady_clock::now() - mStart;
+        mRecords->push_back({mOp, mKernel, duration.count(), mByteLength});
+    }
+
+    uint64_t GetTensorByteLength(const OperatorBase* op) {
+        uint64_t byteLength = 0;
+        for (auto& input : op->Inputs()) {
+            byteLength += utils::ByteLength(input->Type(), input->Shape());
+        }
+        for (auto& output : op->Outputs()) {
+            byteLength += utils::ByteLength(output->Type(), output->Shape());
+        }
+        return byteLength;
+    }
+
+    std::vector<const char*> GetOperatorTypes(ContextBase* context,
+                                              const std::vector<const OperatorBase*>& operators) {
+        Ref<OperatorTypeNamer> namer = AcquireRef(new OperatorTypeNamer(context));
+        std::vector<const char*> types;
+        types.reserve(operators.size());
+        for (auto& op : operators) {
+            types.push_back(namer->GetType(op));
+        }
+        return types;
+    }
+
+}  // namespace webnn::native
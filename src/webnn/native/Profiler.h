@@ -0,0 +1,83 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef WEBNN_NATIVE_PROFILER_H_
+#define WEBNN_NATIVE_PROFILER_H_
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "webnn/native/Forward.h"
+
+namespace webnn::native {
+
+    class ContextBase;
+
+    // The operator index of the profile entries of operators the builder didn't create, like
+    // the transposes inserted by layout propagation, and of the work of the graph itself.
+    constexpr uint32_t kNoOperatorIndex = UINT32_MAX;
+
+    // A kernel run by a compute of a profiling graph.
+    struct ProfileRecord {
+        // The operator the kernel computes, nullptr for the work of the graph itself like the
+        // reorders of its outputs. It is only a key, the operator may no longer exist.
+        const OperatorBase* op;
+        std::string kernel;
+        double milliseconds;
+        // The bytes of the tensors the kernel reads and writes.
+        uint64_t byteLength;
+    };
+
+    // Installs |records| as the profile of the kernels run on the calling thread while it is
+    // alive. The graph creates one around ComputeImpl when profiling is enabled, so the kernels
+    // of the graphs it delegates to, like its partitions, are recorded too.
+    class ScopedProfileRecorder {
+      public:
+        explicit ScopedProfileRecorder(std::vector<ProfileRecord>* records);
+        ~ScopedProfileRecorder();
+
+        static bool IsRecording();
+
+      private:
+        std::vector<ProfileRecord>* mPrevious;
+    };
+
+    // Times the kernel run within its scope if the calling thread records a profile, otherwise
+    // it only costs a thread local read.
+    class ScopedKernelProfile {
+      public:
+        ScopedKernelProfile(const OperatorBase* op, const char* kernel, uint64_t byteLength);
+        ~ScopedKernelProfile();
+
+      private:
+        std::vector<ProfileRecord>* mRecords;
+        const OperatorBase* mOp;
+        const char* mKernel;
+        uint64_t mByteLength;
+        std::chrono::steady_clock::time_point mStart;
+    };
+
+    // The bytes of the inputs and outputs of |op| as inferred by the builder.
+    uint64_t GetTensorByteLength(const OperatorBase* op);
+
+    // The type of each of |operators| as named by the builder method creating it, e.g.
+    // "conv2d".
+    std::vector<const char*> GetOperatorTypes(ContextBase* context,
+                                              const std::vector<const OperatorBase*>& operators);
+
+}  // namespace webnn::native
+
+#endif  // WEBNN_NATIVE_PROFILER_H_
@@ -0,0 +1,141 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "webnn/native/Tracer.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "common/Log.h"
+
+#if defined(_WIN32)
+#    include <process.h>
+#else
+#    include <unistd.h>
+#endif
+
+namespace webnn::native {
+
+    namespace detail {
+        std::atomic<bool> gTracing{false};
+    }  // namespace detail
+
+    namespace {
+
+        // The events are written as a JSON array which is closed when the process exits. The
+        // trace viewers also load the array of a process that didn't exit cleanly.
+        class TraceWriter {
+          public:
+            ~TraceWriter() {
+                std::lock_guard<std::mutex> lock(mMutex);
+                if (mFile != nullptr) {
+                    detail::gTracing = false;
+                    fputs("\n]\n", mFile);
+                    fclose(mFile);
+                }
+            }
+
+            void Open(const char* path) {
+                std::lock_guard<std::mutex> lock(mMutex);
+                if (mFile != nullptr) {
+                    return;
+                }
+                mFile = fopen(path, "w");
+                if (mFile == nullptr) {
+                    dawn::ErrorLog() << "Failed to open the trace file " << path << ".";
+                    return;
+                }
+                fputs("[", mFile);
+#if defined(_WIN32)
+                mProcessId = _getpid();
+#else
+                mProcessId = getpid();
+#endif
+                detail::gTracing = true;
+            }
+
+            void Write(const char* category, const char* name, uint64_t start, uint64_t duration) {
+                // Complete events, the thread ids are only used to group the spans.
+                size_t threadId = std::hash<std::thread::id>()(std::this_thread::get_id());
+                std::string event = "{\"cat\":\"" + Escape(category) + "\",\"name\":\"" +
+                                    Escape(name) + "\",\"ph\":\"X\",\"ts\":" +
+                                    std::to_string(start) + ",\"dur\":" + std::to_string(duration) +
+                                    ",\"pid\":" + std::to_string(mProcessId) +
+                                    ",\"tid\":" + std::to_string(threadId % 1000000) + "}";
+                std::lock_guard<std::mutex> lock(mMutex);
+                if (mFile == nullptr) {
+                    return;
+                }
+                fputs(mFirstEvent ? "\n" : ",\n", mFile);
+                fputs(event.c_str(), mFile);
+                mFirstEvent = false;
+            }
+
+          private:
+            static std::string Escape(const char* value) {
+                std::string escaped;
+                for (const char* c = value; *c != '\0'; ++c) {
+                    if (*c == '"' || *c == '\\') {
+                        escaped += '\\';
+                    }
+                    escaped += *c;
+                }
+                return escaped;
+            }
+
+            std::mutex mMutex;
+            FILE* mFile = nullptr;
+            bool mFirstEvent = true;
+            int mProcessId = 0;
+        };
+
+        TraceWriter& GetTraceWriter() {
+            static TraceWriter writer;
+            return writer;
+        }
+
+    }  // namespace
+
+    void StartTracing(const char* path) {
+        if (path == nullptr) {
+            path = std::getenv("WEBNN_TRACE_FILE");
+        }
+        if (path == nullptr || path[0] == '\0' || IsTracing()) {
+            return;
+        }
+        GetTraceWriter().Open(path);
+    }
+
+    uint64_t GetTraceTimestamp() {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    void WriteTraceEvent(const char* category,
+                         const char* name,
+                         uint64_t start,
+                         uint64_t duration) {
+        if (!IsTracing()) {
+            return;
+        }
+        GetTraceWriter().Write(category, name, start, duration);
+    }
+
+}  // namespace webnn::native
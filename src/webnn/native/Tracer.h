@@ -0,0 +1,68 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef WEBNN_NATIVE_TRACER_H_
+#define WEBNN_NATIVE_TRACER_H_
+
+#include <atomic>
+#include <cstdint>
+
+namespace webnn::native {
+
+    namespace detail {
+        extern std::atomic<bool> gTracing;
+    }  // namespace detail
+
+    // Starts writing the spans of the process to |path| as Chrome trace JSON, which can be
+    // loaded in chrome://tracing or Perfetto. The WEBNN_TRACE_FILE environment variable is used
+    // if |path| is null. Only the first path given is written to, later calls are ignored.
+    void StartTracing(const char* path);
+
+    inline bool IsTracing() {
+        return detail::gTracing.load(std::memory_order_relaxed);
+    }
+
+    // Microseconds of std::chrono::steady_clock.
+    uint64_t GetTraceTimestamp();
+
+    // Writes a span that began at |start| if tracing, |category| and |name| are copied.
+    void WriteTraceEvent(const char* category,
+                         const char* name,
+                         uint64_t start,
+                         uint64_t duration);
+
+    // Traces the work done within its scope. When tracing is off it only costs an atomic read.
+    class ScopedTrace {
+      public:
+        ScopedTrace(const char* category, const char* name)
+            : mCategory(category), mName(name), mStart(IsTracing() ? GetTraceTimestamp() : 0) {
+        }
+        ~ScopedTrace() {
+            if (mStart != 0) {
+                WriteTraceEvent(mCategory, mName, mStart, GetTraceTimestamp() - mStart);
+            }
+        }
+
+        ScopedTrace(const ScopedTrace&) = delete;
+        ScopedTrace& operator=(const ScopedTrace&) = delete;
+
+      private:
+        const char* mCategory;
+        const char* mName;
+        uint64_t mStart;
+    };
+
+}  // namespace webnn::native
+
+#endif  // WEBNN_NATIVE_TRACER_H_
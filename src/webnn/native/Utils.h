@@ -17,9 +17,69 @@
 
 #include <webnn/native/webnn_structs_autogen.h>
 #include <webnn/webnn_cpp.h>
+#include <string>
 #include <vector>
 
 namespace webnn::native::utils {
+    // The size in bytes of one element of |type|.
+    inline size_t OperandTypeByteSize(wnn::OperandType type) {
+        switch (type) {
+            case wnn::OperandType::Float16:
+                return 2;
+            case wnn::OperandType::Int8:
+            case wnn::OperandType::Uint8:
+                return 1;
+            default:
+                return 4;
+        }
+    }
+
+    // The value of the dimensions of an input that are only given at compute, the output
+    // dimensions that depend on them are dynamic too.
+    constexpr int32_t kDynamicDimension = -1;
+
+    // Whether two dimensions can be the same once the dynamic ones are given.
+    inline bool DimensionsMatch(int32_t a, int32_t b) {
+        return a == b || a == kDynamicDimension || b == kDynamicDimension;
+    }
+
+    // A dynamic dimension counts as empty.
+    inline size_t ElementCount(const std::vector<int32_t>& shape) {
+        size_t count = 1;
+        for (int32_t dimension : shape) {
+            count *= dimension > 0 ? dimension : 0;
+        }
+        return count;
+    }
+
+    inline size_t ByteLength(wnn::OperandType type, const std::vector<int32_t>& shape) {
+        return OperandTypeByteSize(type) * ElementCount(shape);
+    }
+
+    // The permutation transposing a conv2d filter from the layout |from| to |to|.
+    inline std::vector<int32_t> FilterPermutation(wnn::Conv2dFilterOperandLayout from,
+                                                  wnn::Conv2dFilterOperandLayout to) {
+        auto dimensions = [](wnn::Conv2dFilterOperandLayout layout) -> std::string {
+            switch (layout) {
+                case wnn::Conv2dFilterOperandLayout::Oihw:
+                    return "oihw";
+                case wnn::Conv2dFilterOperandLayout::Hwio:
+                    return "hwio";
+                case wnn::Conv2dFilterOperandLayout::Ohwi:
+                    return "ohwi";
+                case wnn::Conv2dFilterOperandLayout::Ihwo:
+                    return "ihwo";
+            }
+            DAWN_UNREACHABLE();
+        };
+        const std::string source = dimensions(from);
+        std::vector<int32_t> permutation;
+        for (char dimension : dimensions(to)) {
+            permutation.push_back(static_cast<int32_t>(source.find(dimension)));
+        }
+        return permutation;
+    }
+
     template <typename T>
     void ComputeImplicitPaddingForAutoPad(wnn::AutoPad autoPad,
                                           T dilation,
@@ -20,6 +20,7 @@
 #include "common/Assert.h"
 #include "webnn/native/GraphBuilder.h"
 #include "webnn/native/Instance.h"
+#include "webnn/native/Tracer.h"
 
 #if defined(_WIN32)
 #    include <crtdbg.h>
@@ -84,4 +85,11 @@ namespace webnn::native {
         return GetProcsAutogen();
     }
 
+    void AddTraceEvent(const char* category,
+                       const char* name,
+                       uint64_t startMicroseconds,
+                       uint64_t durationMicroseconds) {
+        WriteTraceEvent(category, name, startMicroseconds, durationMicroseconds);
+    }
+
 }  // namespace webnn::native
@@ -614,7 +614,7 @@ namespace webnn::native::dmlx {
                 break;
             case FusionType::LeakyRelu:
                 dmlActivation = ::dml::FusedActivation::LeakyRelu(
-                    reinterpret_cast<op::FusionLeakyRelu*>(activation)->GetAlpha());
+                    static_cast<op::FusionLeakyRelu*>(activation)->GetAlpha());
                 break;
             default:
                 DAWN_ASSERT(0);
@@ -633,7 +633,7 @@ namespace webnn::native::dmlx {
         if (type == FusionType::HardSwish) {
             return HardSwish(input);
         } else if (type == FusionType::Clamp) {
-            auto clamp = reinterpret_cast<const op::FusionClamp*>(activation);
+            auto clamp = static_cast<const op::FusionClamp*>(activation);
             return ::dml::Clip(input, clamp->GetMinValue(), clamp->GetMaxValue());
         }
         return input;
@@ -846,6 +846,10 @@ namespace webnn::native::dmlx {
         return {};
     }
 
+    bool Graph::SupportsFusedActivation(const op::Conv2d* conv2d, FusionType type) const {
+        return true;
+    }
+
     MaybeError Graph::AddConv2d(const op::Conv2d* conv2d) {
         auto inputsOperand = conv2d->Inputs();
         DAWN_ASSERT(inputsOperand.size() == 2 || inputsOperand.size() == 3);
@@ -1104,7 +1108,8 @@ namespace webnn::native::dmlx {
 
         if (pool2d->GetType() == op::Pool2dType::kAveragePool2d) {
             if (dilations[0] != 1 || dilations[1] != 1) {
-                return DAWN_INTERNAL_ERROR("The dilations of average pool2d are not supported.");
+                return DAWN_UNIMPLEMENTED_ERROR(
+                    "The dilations of average pool2d are not supported.");
             }
             output = ::dml::AveragePooling(input, strides, windowSizes, startPadding, endPadding,
                                            false, outputShape);
@@ -1134,7 +1139,7 @@ namespace webnn::native::dmlx {
                                        dilations, false, outputShape)
                          .values;
         } else {
-            return DAWN_INTERNAL_ERROR("This pool2d type is not supported.");
+            return DAWN_UNIMPLEMENTED_ERROR("This pool2d type is not supported.");
         }
 
         if (options->layout == wnn::InputOperandLayout::Nhwc) {
@@ -1271,7 +1276,7 @@ namespace webnn::native::dmlx {
         ::dml::Expression input = mExpression.at(inputOperand);
         auto newShape = reshape->GetNewShape();
         if (newShape.size() > DML_TENSOR_DIMENSION_COUNT_MAX1) {
-            return DAWN_INTERNAL_ERROR("The size of new shape is not supported by DML.");
+            return DAWN_UNIMPLEMENTED_ERROR("The size of new shape is not supported by DML.");
         }
         ::dml::TensorDimensions newSizes(newShape.size());
         uint32_t outputElementCount = 1;
@@ -1425,7 +1430,7 @@ namespace webnn::native::dmlx {
         ::dml::Expression input = mExpression.at(inputOperand);
         std::vector<int32_t> permutation = transpose->GetPermutation();
         if (permutation.size() > DML_TENSOR_DIMENSION_COUNT_MAX1) {
-            return DAWN_INTERNAL_ERROR("The size of permutation is not supported by DML.");
+            return DAWN_UNIMPLEMENTED_ERROR("The size of permutation is not supported by DML.");
         }
 
         // Transpose is implemented by dml::Reinterpret and dml::Identity
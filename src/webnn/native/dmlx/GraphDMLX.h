@@ -97,6 +97,8 @@ namespace webnn::native::dmlx {
         virtual MaybeError AddClamp(const op::Clamp* clamp) override;
         virtual MaybeError AddInstanceNorm(const op::InstanceNorm* instanceNorm) override;
         virtual MaybeError Finish() override;
+        virtual bool SupportsFusedActivation(const op::Conv2d* conv2d,
+                                             FusionType type) const override;
 
       private:
         MaybeError CompileImpl() override;
@@ -27,7 +27,20 @@ namespace webnn::native::mlas {
     }
 
     ContextBase* Backend::CreateContext(ContextOptions const* options) {
-        return new Context();
+        CpuThreadOptions threadOptions =
+            ResolveCpuThreadOptions(options != nullptr ? *options : ContextOptions{});
+        std::shared_ptr<MLAS_THREADPOOL> threadPool;
+        {
+            std::lock_guard<std::mutex> lock(mThreadPoolsMutex);
+            auto iter = mThreadPools.find(threadOptions);
+            if (iter == mThreadPools.end()) {
+                iter = mThreadPools
+                           .emplace(threadOptions, Context::CreateThreadPool(threadOptions))
+                           .first;
+            }
+            threadPool = iter->second;
+        }
+        return new Context(options, std::move(threadPool));
     }
 
     BackendConnection* Connect(InstanceBase* instance) {
@@ -19,7 +19,11 @@
 #include "webnn/native/Context.h"
 #include "webnn/native/Error.h"
 
+#include <map>
 #include <memory>
+#include <mutex>
+
+#include <mlas.h>
 
 namespace webnn::native::mlas {
 
@@ -31,6 +35,8 @@ namespace webnn::native::mlas {
         ContextBase* CreateContext(ContextOptions const* options = nullptr) override;
 
       private:
+        std::mutex mThreadPoolsMutex;
+        std::map<CpuThreadOptions, std::shared_ptr<MLAS_THREADPOOL>> mThreadPools;
     };
 
 }  // namespace webnn::native::mlas
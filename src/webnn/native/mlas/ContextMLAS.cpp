@@ -23,32 +23,41 @@
 namespace webnn::native::mlas {
 
     ContextBase* Create() {
-        Ref<ContextBase> context = AcquireRef(new Context());
-        reinterpret_cast<Context*>(context.Get())->CreateThreadPool();
+        Ref<ContextBase> context =
+            AcquireRef(new Context(nullptr, Context::CreateThreadPool(CpuThreadOptions())));
         return context.Detach();
     }
 
-    Context::Context() : mThreadPool(nullptr) {
+    Context::Context(ContextOptions const* options, std::shared_ptr<MLAS_THREADPOOL> threadPool)
+        : ContextBase(options), mThreadPool(std::move(threadPool)) {
     }
 
-    Context::~Context() {
-        if (mThreadPool)
-            delete mThreadPool;
-    }
+    Context::~Context() = default;
 
-    void Context::CreateThreadPool() {
-        std::vector<size_t> cpuList = onnxruntime::Env::Default().GetThreadAffinityMasks();
-        if (cpuList.empty() || cpuList.size() == 1)
-            return;
-        int threadPoolSize = static_cast<int>(cpuList.size());
-        onnxruntime::ThreadOptions options;
-        options.affinity = cpuList;
-        mThreadPool = new onnxruntime::concurrency::ThreadPool(
-            &onnxruntime::Env::Default(), options, nullptr, threadPoolSize, false);
+    // static
+    std::shared_ptr<MLAS_THREADPOOL> Context::CreateThreadPool(const CpuThreadOptions& options) {
+        std::vector<size_t> cpuList;
+        if (options.affinity.empty()) {
+            cpuList = onnxruntime::Env::Default().GetThreadAffinityMasks();
+        } else {
+            cpuList.assign(options.affinity.begin(), options.affinity.end());
+        }
+        int threadPoolSize = static_cast<int>(GetThreadCount(options, cpuList.size()));
+        if (cpuList.empty() || threadPoolSize == 1)
+            return nullptr;
+        onnxruntime::ThreadOptions threadOptions;
+        // One processor per thread, the threads share the processors if there are fewer.
+        for (int i = 0; i < threadPoolSize; ++i) {
+            threadOptions.affinity.push_back(cpuList[i % cpuList.size()]);
+        }
+        // The pool spins for work between parallel sections when asked for low latency.
+        bool lowLatency = options.waitPolicy == wnn::ThreadWaitPolicy::Spin;
+        return std::make_shared<onnxruntime::concurrency::ThreadPool>(
+            &onnxruntime::Env::Default(), threadOptions, nullptr, threadPoolSize, lowLatency);
     }
 
     MLAS_THREADPOOL* Context::GetThreadPool() {
-        return mThreadPool;
+        return mThreadPool.get();
     }
 
     GraphBase* Context::CreateGraphImpl() {
@@ -19,21 +19,25 @@
 
 #include <mlas.h>
 
+#include <memory>
+
 namespace webnn::native::mlas {
 
     class Context : public ContextBase {
       public:
-        Context();
+        Context(ContextOptions const* options, std::shared_ptr<MLAS_THREADPOOL> threadPool);
         ~Context() override;
 
-        void CreateThreadPool();
+        // Returns null when the graphs should run on the calling thread only.
+        static std::shared_ptr<MLAS_THREADPOOL> CreateThreadPool(const CpuThreadOptions& options);
 
         MLAS_THREADPOOL* GetThreadPool();
 
       private:
         GraphBase* CreateGraphImpl() override;
 
-        MLAS_THREADPOOL* mThreadPool;
+        // Shared by the contexts created with the same thread options.
+        std::shared_ptr<MLAS_THREADPOOL> mThreadPool;
     };
 
 }  // namespace webnn::native::mlas
@@ -16,6 +16,8 @@
 
 #include <mlas.h>
 
+#include <algorithm>
+#include <limits>
 #include <numeric>
 
 #include "common/Assert.h"
@@ -24,6 +26,8 @@
 #include "webnn/native/NamedInputs.h"
 #include "webnn/native/NamedOutputs.h"
 #include "webnn/native/Operand.h"
+#include "webnn/native/Profiler.h"
+#include "webnn/native/Tracer.h"
 #include "webnn/native/Utils.h"
 
 #define VERBOSE 0
@@ -60,46 +64,68 @@ namespace webnn::native::mlas {
         explicit Memory(wnn::OperandType type,
                         const std::vector<int32_t>& dims,
                         bool blockedLayout = false)
-            : mType(type), mDimensions(dims), mBuffer(nullptr), mBlockedLayout(blockedLayout) {
-        }
-
-        ~Memory() {
-            if (mBuffer) {
-                AlignedFree(mBuffer);
-            }
-        };
-
-        bool Allocate() {
+            : mType(type),
+              mDimensions(dims),
+              mBuffer(nullptr),
+              mByteLength(0),
+              mBlockedLayout(blockedLayout),
+              mOwnsBuffer(false),
+              mExternalBuffer(nullptr) {
             size_t elementNum = std::accumulate(mDimensions.begin(), mDimensions.end(), (size_t)1,
                                                 std::multiplies<size_t>{});
-            size_t elementSize;
             switch (mType) {
                 case wnn::OperandType::Float32:
-                    elementSize = sizeof(float);
+                    mByteLength = elementNum * sizeof(float);
                     break;
                 case wnn::OperandType::Float16:
-                    elementSize = sizeof(int16_t);
+                    mByteLength = elementNum * sizeof(int16_t);
                     break;
                 case wnn::OperandType::Int32:
-                    elementSize = sizeof(int32_t);
+                    mByteLength = elementNum * sizeof(int32_t);
                     break;
                 case wnn::OperandType::Uint32:
-                    elementSize = sizeof(uint32_t);
+                    mByteLength = elementNum * sizeof(uint32_t);
                     break;
                 case wnn::OperandType::Int8:
-                    elementSize = sizeof(int8_t);
+                    mByteLength = elementNum * sizeof(int8_t);
                     break;
                 case wnn::OperandType::Uint8:
-                    elementSize = sizeof(uint8_t);
+                    mByteLength = elementNum * sizeof(uint8_t);
                     break;
                 default:
-                    return false;
+                    break;
+            }
+        }
+
+        ~Memory() {
+            if (mBuffer && mOwnsBuffer) {
+                AlignedFree(mBuffer);
             }
-            mByteLength = elementNum * elementSize;
+        };
+
+        bool Allocate() {
             mBuffer = AlignedAlloc(mByteLength);
+            mOwnsBuffer = true;
             return mBuffer != nullptr;
         }
 
+        // Points the memory at a region of an arena owned by the graph.
+        void Bind(void* buffer) {
+            DAWN_ASSERT(mBuffer == nullptr);
+            mBuffer = buffer;
+        }
+
+        // Temporarily redirects the memory to a buffer of the caller for one compute.
+        void BindExternal(void* buffer) {
+            mExternalBuffer = buffer;
+        }
+        void UnbindExternal() {
+            mExternalBuffer = nullptr;
+        }
+        bool IsExternal() {
+            return mExternalBuffer != nullptr;
+        }
+
         wnn::OperandType GetType() {
             return mType;
         }
@@ -107,7 +133,7 @@ namespace webnn::native::mlas {
             return mDimensions;
         }
         void* GetBuffer() {
-            return mBuffer;
+            return mExternalBuffer ? mExternalBuffer : mBuffer;
         }
         size_t GetByteLength() {
             return mByteLength;
@@ -122,6 +148,8 @@ namespace webnn::native::mlas {
         void* mBuffer;
         size_t mByteLength;
         bool mBlockedLayout;
+        bool mOwnsBuffer;
+        void* mExternalBuffer;
     };
 
     class Kernel : public RefCounted {
@@ -130,6 +158,29 @@ namespace webnn::native::mlas {
         virtual ~Kernel() = default;
 
         virtual void Compute(MLAS_THREADPOOL* threadPool = nullptr) = 0;
+        // The memories read or written by Compute, used to compute their live ranges.
+        virtual std::vector<Ref<Memory>> GetMemories() const = 0;
+        virtual Ref<Memory> GetOutput() const = 0;
+        // The MLAS routine run by Compute, reported in profiles.
+        virtual const char* GetName() const = 0;
+
+        // The operator the kernel computes, nullptr for the reorders of the graph outputs.
+        const OperatorBase* GetOperator() const {
+            return mOperator;
+        }
+        void SetOperator(const OperatorBase* op) {
+            mOperator = op;
+        }
+        uint64_t GetByteLength() const {
+            uint64_t byteLength = 0;
+            for (auto& memory : GetMemories()) {
+                byteLength += memory->GetByteLength();
+            }
+            return byteLength;
+        }
+
+      private:
+        const OperatorBase* mOperator = nullptr;
     };
 
     class Clamp : public Kernel {
@@ -149,6 +200,16 @@ namespace webnn::native::mlas {
             MlasActivation(&mActivation, output, nullptr, 1, mElementNum, mElementNum);
         }
 
+        virtual std::vector<Ref<Memory>> GetMemories() const {
+            return {mInput, mOutput};
+        }
+        virtual Ref<Memory> GetOutput() const {
+            return mOutput;
+        }
+        virtual const char* GetName() const {
+            return "MlasActivation";
+        }
+
       private:
         Ref<Memory> mInput;
         Ref<Memory> mOutput;
@@ -193,6 +254,27 @@ namespace webnn::native::mlas {
             }
         }
 
+        virtual std::vector<Ref<Memory>> GetMemories() const {
+            return {mInput, mOutput};
+        }
+        virtual Ref<Memory> GetOutput() const {
+            return mOutput;
+        }
+        virtual const char* GetName() const {
+            switch (mOpType) {
+                case op::UnaryOpType::kSigmoid:
+                    return "MlasComputeLogistic";
+                case op::UnaryOpType::kSoftmax:
+                    return "MlasComputeSoftmax";
+                case op::UnaryOpType::kExp:
+                    return "MlasComputeExp";
+                case op::UnaryOpType::kTanh:
+                    return "MlasComputeTanh";
+                default:
+                    return "MlasActivation";
+            }
+        }
+
       private:
         op::UnaryOpType mOpType;
         Ref<Memory> mInput;
@@ -226,6 +308,16 @@ namespace webnn::native::mlas {
             MlasReorderInputNchw(input, output, mInputChannels, mInputSize);
         }
 
+        virtual std::vector<Ref<Memory>> GetMemories() const {
+            return {mInput, mOutput};
+        }
+        virtual Ref<Memory> GetOutput() const {
+            return mOutput;
+        }
+        virtual const char* GetName() const {
+            return "MlasReorderInputNchw";
+        }
+
       private:
         Ref<Memory> mInput;
         Ref<Memory> mOutput;
@@ -255,6 +347,16 @@ namespace webnn::native::mlas {
             MlasReorderOutputNchw(mOutputShape.data(), input, output);
         }
 
+        virtual std::vector<Ref<Memory>> GetMemories() const {
+            return {mInput, mOutput};
+        }
+        virtual Ref<Memory> GetOutput() const {
+            return mOutput;
+        }
+        virtual const char* GetName() const {
+            return "MlasReorderOutputNchw";
+        }
+
       private:
         Ref<Memory> mInput;
         Ref<Memory> mOutput;
@@ -309,12 +411,9 @@ namespace webnn::native::mlas {
                             outputShape.data(), outputChannels / mGroupCount, &mActivation,
                             &workingBufferSize, threadPool);
             if (workingBufferSize > 0) {
+                // Allocated from the graph arena, it's only live while this kernel runs.
                 mWorkingBuffer =
                     AcquireRef(new Memory(wnn::OperandType::Float32, {int32_t(workingBufferSize)}));
-                if (!mWorkingBuffer->Allocate()) {
-                    dawn::ErrorLog() << "Failed to allocate working buffer";
-                    return false;
-                }
             }
             return true;
         }
@@ -351,6 +450,23 @@ namespace webnn::native::mlas {
 #endif
         }
 
+        virtual std::vector<Ref<Memory>> GetMemories() const {
+            std::vector<Ref<Memory>> memories = {mInput, mFilter, mOutput};
+            if (mBias.Get() != nullptr) {
+                memories.push_back(mBias);
+            }
+            if (mWorkingBuffer.Get() != nullptr) {
+                memories.push_back(mWorkingBuffer);
+            }
+            return memories;
+        }
+        virtual Ref<Memory> GetOutput() const {
+            return mOutput;
+        }
+        virtual const char* GetName() const {
+            return nchwcConv ? "MlasNchwcConv" : "MlasConv";
+        }
+
       private:
         friend class Graph;
         bool nchwcConv;
@@ -419,6 +535,16 @@ namespace webnn::native::mlas {
 #endif
         }
 
+        virtual std::vector<Ref<Memory>> GetMemories() const {
+            return {mInput, mOutput};
+        }
+        virtual Ref<Memory> GetOutput() const {
+            return mOutput;
+        }
+        virtual const char* GetName() const {
+            return "MlasNchwcPool";
+        }
+
       private:
         friend class Graph;
         MLAS_POOLING_KIND mKind;
@@ -433,10 +559,86 @@ namespace webnn::native::mlas {
         std::vector<int64_t> mOutputShape;
     };
 
-    Graph::Graph(Context* context) : GraphBase(context) {
+    class Transpose : public Kernel {
+      public:
+        Transpose(const Ref<Memory>& input,
+                  const Ref<Memory>& output,
+                  const std::vector<int32_t>& inputShape,
+                  const std::vector<int32_t>& permutation)
+            : mInput(input), mOutput(output) {
+            std::vector<size_t> inputStrides(inputShape.size(), 1);
+            for (size_t i = inputShape.size() - 1; i > 0; --i) {
+                inputStrides[i - 1] = inputStrides[i] * inputShape[i];
+            }
+            for (int32_t axis : permutation) {
+                mOutputShape.push_back(inputShape[axis]);
+                mStrides.push_back(inputStrides[axis]);
+            }
+        }
+        virtual ~Transpose() = default;
+
+        virtual void Compute(MLAS_THREADPOOL* threadPool = nullptr) {
+            const float* input = reinterpret_cast<const float*>(mInput->GetBuffer());
+            float* output = reinterpret_cast<float*>(mOutput->GetBuffer());
+            // Writes the output contiguously row by row, gathering each row from the input with
+            // the stride of the innermost output dimension.
+            const size_t rank = mOutputShape.size();
+            const size_t rowSize = mOutputShape[rank - 1];
+            const size_t rowStride = mStrides[rank - 1];
+            const size_t rowCount = std::accumulate(mOutputShape.begin(), mOutputShape.end() - 1,
+                                                    (size_t)1, std::multiplies<size_t>{});
+            std::vector<size_t> index(rank, 0);
+            size_t offset = 0;
+            for (size_t row = 0; row < rowCount; ++row) {
+                for (size_t i = 0; i < rowSize; ++i) {
+                    output[i] = input[offset + i * rowStride];
+                }
+                output += rowSize;
+                for (size_t axis = rank - 1; axis > 0; --axis) {
+                    offset += mStrides[axis - 1];
+                    if (++index[axis - 1] < mOutputShape[axis - 1]) {
+                        break;
+                    }
+                    offset -= mStrides[axis - 1] * mOutputShape[axis - 1];
+                    index[axis - 1] = 0;
+                }
+            }
+        }
+
+        virtual std::vector<Ref<Memory>> GetMemories() const {
+            return {mInput, mOutput};
+        }
+        virtual Ref<Memory> GetOutput() const {
+            return mOutput;
+        }
+        virtual const char* GetName() const {
+            return "Transpose";
+        }
+
+      private:
+        Ref<Memory> mInput;
+        Ref<Memory> mOutput;
+        std::vector<size_t> mOutputShape;
+        // The input stride of each output dimension.
+        std::vector<size_t> mStrides;
+    };
+
+    Graph::Graph(Context* context) : GraphBase(context), mArena(nullptr), mArenaByteLength(0) {
     }
 
     Graph::~Graph() {
+        if (mArena) {
+            AlignedFree(mArena);
+        }
+    }
+
+    Ref<Memory> Graph::CreateIntermediateMemory(wnn::OperandType type,
+                                                const std::vector<int32_t>& dims,
+                                                bool blockedLayout) {
+        // The buffer is assigned from the arena by Finish.
+        Ref<Memory> memory = AcquireRef(new Memory(type, dims, blockedLayout));
+        mIntermediates.push_back(memory);
+        return memory;
     }
 
     MaybeError Graph::AddConstant(const op::Constant* constant) {
@@ -447,6 +649,7 @@ namespace webnn::native::mlas {
         }
         memcpy(memory->GetBuffer(), constant->GetBuffer(), constant->GetByteLength());
         mMemoryMap.insert(std::make_pair(operand, memory));
+        mConstants.insert(operand);
 #if (VERBOSE)
         dawn::InfoLog() << "add constant memory: " << memory.Get();
 #endif
@@ -468,42 +671,48 @@ namespace webnn::native::mlas {
     }
 
     MaybeError Graph::AddOutput(std::string_view name, const OperandBase* output) {
-        DAWN_ASSERT(mMemoryMap.find(output) != mMemoryMap.end());
-        Ref<Memory> memory = mMemoryMap.at(output);
+        Ref<Memory> memory;
+        DAWN_TRY_ASSIGN(memory, GetNchwMemory(output, nullptr));
+        mOutputs.insert(std::make_pair(name.data(), memory));
+        return {};
+    }
+
+    void Graph::AddKernel(Ref<Kernel> kernel, const OperatorBase* op) {
+        kernel->SetOperator(op);
+        mKernels.push_back(std::move(kernel));
+    }
+
+    ResultOrError<Ref<Memory>> Graph::GetNchwMemory(const OperandBase* operand,
+                                                    const OperatorBase* op) {
+        DAWN_ASSERT(mMemoryMap.find(operand) != mMemoryMap.end());
+        Ref<Memory> memory = mMemoryMap.at(operand);
         if (memory->IsBlockedLayout()) {
             // ReorderOutput
-            const size_t rank = output->Shape().size();
+            const size_t rank = operand->Shape().size();
             if (rank != 4) {
-                return DAWN_INTERNAL_ERROR("NCHWc memory layout only supports rank 4.");
+                return DAWN_UNIMPLEMENTED_ERROR("NCHWc memory layout only supports rank 4.");
             }
-            int32_t channels = output->Shape()[1];
+            int32_t channels = operand->Shape()[1];
             DAWN_ASSERT(channels <= memory->GetDimensions()[1]);
-            Ref<Memory> nchwMemory = AcquireRef(new Memory(output->Type(), output->Shape()));
-            if (!nchwMemory->Allocate()) {
-                return DAWN_INTERNAL_ERROR("Failed to allocate output memory.");
-            }
-            std::vector<int64_t> outputShape = {output->Shape()[0], output->Shape()[1],
-                                                output->Shape()[2], output->Shape()[3]};
-            mKernels.push_back(AcquireRef(new ReorderOutput(memory, nchwMemory, outputShape)));
+            Ref<Memory> nchwMemory = CreateIntermediateMemory(operand->Type(), operand->Shape());
+            std::vector<int64_t> outputShape = {operand->Shape()[0], operand->Shape()[1],
+                                                operand->Shape()[2], operand->Shape()[3]};
+            AddKernel(AcquireRef(new ReorderOutput(memory, nchwMemory, outputShape)), op);
             memory = nchwMemory;
         }
-        mOutputs.insert(std::make_pair(name.data(), memory));
-        return {};
+        return memory;
     }
 
     MaybeError Graph::AddClamp(const op::Clamp* clamp) {
         const OperandBase* inputOperand = clamp->Inputs()[0].Get();
         if (inputOperand->Type() != wnn::OperandType::Float32) {
-            return DAWN_INTERNAL_ERROR("Only support float32");
+            return DAWN_UNIMPLEMENTED_ERROR("Only support float32");
         }
         DAWN_ASSERT(mMemoryMap.find(inputOperand) != mMemoryMap.end());
         Ref<Memory> inputMemory = mMemoryMap.at(inputOperand);
         const OperandBase* outputOperand = clamp->PrimaryOutput();
         Ref<Memory> outputMemory =
-            AcquireRef(new Memory(outputOperand->Type(), outputOperand->Shape()));
-        if (!outputMemory->Allocate()) {
-            return DAWN_INTERNAL_ERROR("Failed to allocate output memory");
-        }
+            CreateIntermediateMemory(outputOperand->Type(), outputOperand->Shape());
         mMemoryMap.insert(std::make_pair(outputOperand, outputMemory));
         std::vector<int32_t> dimensions = inputOperand->Shape();
         size_t elementNum = std::accumulate(dimensions.begin(), dimensions.end(), (size_t)1,
@@ -512,8 +721,7 @@ namespace webnn::native::mlas {
         activation.ActivationKind = MlasClipActivation;
         activation.Parameters.Clip.minimum = clamp->GetMinValue();
         activation.Parameters.Clip.maximum = clamp->GetMaxValue();
-        mKernels.push_back(
-            AcquireRef(new Clamp(inputMemory, outputMemory, elementNum, activation)));
+        AddKernel(AcquireRef(new Clamp(inputMemory, outputMemory, elementNum, activation)), clamp);
         return {};
     }
 
@@ -523,24 +731,24 @@ namespace webnn::native::mlas {
         }
         const OperandBase* a = binary->Inputs()[0].Get();
         if (a->Type() != wnn::OperandType::Float32) {
-            return DAWN_INTERNAL_ERROR("Only support float32 input.");
+            return DAWN_UNIMPLEMENTED_ERROR("Only support float32 input.");
         }
         const OperandBase* b = binary->Inputs()[1].Get();
         if (b->Type() != wnn::OperandType::Float32) {
-            return DAWN_INTERNAL_ERROR("Only support float32 input.");
+            return DAWN_UNIMPLEMENTED_ERROR("Only support float32 input.");
         }
         if (a->Shape() != b->Shape()) {
-            return DAWN_INTERNAL_ERROR("Shapes don't match.");
+            return DAWN_UNIMPLEMENTED_ERROR("Shapes don't match.");
         }
         DAWN_ASSERT(mMemoryMap.find(a) != mMemoryMap.end());
         Ref<Memory> aMemory = mMemoryMap.at(a);
         if (!aMemory->IsBlockedLayout()) {
-            return DAWN_INTERNAL_ERROR("Only support blocked memory.");
+            return DAWN_UNIMPLEMENTED_ERROR("Only support blocked memory.");
         }
         DAWN_ASSERT(mMemoryMap.find(b) != mMemoryMap.end());
         Ref<Memory> bMemory = mMemoryMap.at(b);
         if (!bMemory->IsBlockedLayout()) {
-            return DAWN_INTERNAL_ERROR("Only support blocked memory.");
+            return DAWN_UNIMPLEMENTED_ERROR("Only support blocked memory.");
         }
 #if (VERBOSE)
         dawn::InfoLog() << "Add add";
@@ -556,7 +764,7 @@ namespace webnn::native::mlas {
             bConv2d = mConv2dKernels.at(b->Operator());
         }
         if (aConv2d.Get() == nullptr && bConv2d.Get() == nullptr) {
-            return DAWN_INTERNAL_ERROR("At least one operand should be conv2d.");
+            return DAWN_UNIMPLEMENTED_ERROR("At least one operand should be conv2d.");
         }
         Ref<Conv2d> conv2d;
         if (aConv2d.Get() != nullptr && bConv2d.Get() != nullptr) {
@@ -592,21 +800,32 @@ namespace webnn::native::mlas {
         return {};
     }
 
+    bool Graph::SupportsFusedActivation(const op::Conv2d* conv2d, FusionType type) const {
+        return type == FusionType::Clamp || type == FusionType::HardSwish ||
+               type == FusionType::Relu || type == FusionType::Sigmoid ||
+               type == FusionType::LeakyRelu;
+    }
+
+    bool Graph::GetPreferredLayout(wnn::InputOperandLayout* layout) const {
+        *layout = wnn::InputOperandLayout::Nchw;
+        return true;
+    }
+
     MaybeError Graph::AddConv2d(const op::Conv2d* conv2d) {
         const Conv2dOptions* options = conv2d->GetOptions();
         if (options->inputLayout != wnn::InputOperandLayout::Nchw) {
-            return DAWN_INTERNAL_ERROR("Only support nchw input layout");
+            return DAWN_UNIMPLEMENTED_ERROR("Only support nchw input layout");
         }
         if (options->filterLayout != wnn::Conv2dFilterOperandLayout::Oihw) {
-            return DAWN_INTERNAL_ERROR("Only support iohw filter layout");
+            return DAWN_UNIMPLEMENTED_ERROR("Only support iohw filter layout");
         }
         const OperandBase* inputOperand = conv2d->Inputs()[0].Get();
         if (inputOperand->Type() != wnn::OperandType::Float32) {
-            return DAWN_INTERNAL_ERROR("Only support float32 input");
+            return DAWN_UNIMPLEMENTED_ERROR("Only support float32 input");
         }
         const OperandBase* filterOperand = conv2d->Inputs()[1].Get();
         if (filterOperand->Type() != wnn::OperandType::Float32) {
-            return DAWN_INTERNAL_ERROR("Only support float32 filter");
+            return DAWN_UNIMPLEMENTED_ERROR("Only support float32 filter");
         }
         size_t groupCount = options->groups;
         size_t batchCount = inputOperand->Shape()[0];
@@ -675,6 +894,12 @@ namespace webnn::native::mlas {
             }
         }
 
+        // The NCHWc filter and bias are reordered once here, so they must be constants.
+        if (nchwcConv && (mConstants.count(filterOperand) == 0 ||
+                          (options->bias && mConstants.count(conv2d->Inputs()[2].Get()) == 0))) {
+            return DAWN_UNIMPLEMENTED_ERROR("Only support constant filter and bias");
+        }
+
         DAWN_ASSERT(mMemoryMap.find(inputOperand) != mMemoryMap.end());
         Ref<Memory> inputMemory = mMemoryMap.at(inputOperand);
         if (nchwcConv && reorderInput) {
@@ -684,13 +909,11 @@ namespace webnn::native::mlas {
                     static_cast<int32_t>(batchCount), static_cast<int32_t>(nchwcInputChannels),
                     inputHeight, inputWidth};
                 Ref<Memory> reorderOutputMemory =
-                    AcquireRef(new Memory(inputOperand->Type(), reorderedOutputShape, true));
-                if (!reorderOutputMemory->Allocate()) {
-                    return DAWN_INTERNAL_ERROR("Failed to allocate reorder output memory.");
-                }
+                    CreateIntermediateMemory(inputOperand->Type(), reorderedOutputShape, true);
                 size_t inputSize = inputHeight * inputWidth;
-                mKernels.push_back(AcquireRef(new ReorderInput(
-                    reorderInputMemory, reorderOutputMemory, inputChannels, inputSize)));
+                AddKernel(AcquireRef(new ReorderInput(reorderInputMemory, reorderOutputMemory,
+                                                      inputChannels, inputSize)),
+                          conv2d);
                 inputMemory = reorderOutputMemory;
                 inputShape[1] = nchwcInputChannels;
             } else {
@@ -726,7 +949,7 @@ namespace webnn::native::mlas {
         if (options->bias) {
             const OperandBase* biasOperand = conv2d->Inputs()[2].Get();
             if (biasOperand->Type() != wnn::OperandType::Float32) {
-                return DAWN_INTERNAL_ERROR("Only support float32 bias");
+                return DAWN_UNIMPLEMENTED_ERROR("Only support float32 bias");
             }
             DAWN_ASSERT(mMemoryMap.find(biasOperand) != mMemoryMap.end());
             biasMemory = mMemoryMap.at(biasOperand);
@@ -750,9 +973,9 @@ namespace webnn::native::mlas {
                 case FusionType::Clamp:
                     activation.ActivationKind = MlasClipActivation;
                     activation.Parameters.Clip.minimum =
-                        reinterpret_cast<op::FusionClamp*>(options->activation)->GetMinValue();
+                        static_cast<op::FusionClamp*>(options->activation)->GetMinValue();
                     activation.Parameters.Clip.maximum =
-                        reinterpret_cast<op::FusionClamp*>(options->activation)->GetMaxValue();
+                        static_cast<op::FusionClamp*>(options->activation)->GetMaxValue();
                     break;
                 case FusionType::HardSwish:
                     activation.ActivationKind = MlasHardSigmoidActivation;
@@ -768,26 +991,23 @@ namespace webnn::native::mlas {
                 case FusionType::LeakyRelu:
                     activation.ActivationKind = MlasLeakyReluActivation;
                     activation.Parameters.LeakyRelu.alpha =
-                        reinterpret_cast<op::FusionLeakyRelu*>(options->activation)->GetAlpha();
+                        static_cast<op::FusionLeakyRelu*>(options->activation)->GetAlpha();
                     break;
                 default:
-                    return DAWN_INTERNAL_ERROR("Unsupported fused activation");
+                    return DAWN_UNIMPLEMENTED_ERROR("Unsupported fused activation");
             }
         }
 
         Ref<Memory> outputMemory;
         if (!nchwcConv) {
-            outputMemory = AcquireRef(new Memory(outputOperand->Type(), outputOperand->Shape()));
+            outputMemory = CreateIntermediateMemory(outputOperand->Type(), outputOperand->Shape());
         } else {
             std::vector<int32_t> nchwcOutputShape = {
                 outputOperand->Shape()[0], static_cast<int32_t>(nchwcOutputChannels),
                 outputOperand->Shape()[2], outputOperand->Shape()[3]};
-            outputMemory = AcquireRef(new Memory(outputOperand->Type(), nchwcOutputShape, true));
+            outputMemory = CreateIntermediateMemory(outputOperand->Type(), nchwcOutputShape, true);
             outputShape[1] = nchwcOutputChannels;
         }
-        if (!outputMemory->Allocate()) {
-            return DAWN_INTERNAL_ERROR("Failed to allocate output memory");
-        }
         mMemoryMap.insert(std::make_pair(outputOperand, outputMemory));
 
         Ref<Conv2d> kernel = AcquireRef(new Conv2d(
@@ -797,13 +1017,16 @@ namespace webnn::native::mlas {
             if (!kernel->Prepare(reinterpret_cast<Context*>(GetContext())->GetThreadPool())) {
                 return DAWN_INTERNAL_ERROR("Failed to prepare conv2d.");
             }
+            if (kernel->mWorkingBuffer.Get() != nullptr) {
+                mIntermediates.push_back(kernel->mWorkingBuffer);
+            }
         }
 #if (VERBOSE)
         dawn::InfoLog() << "Add conv2d " << conv2d << " kernel " << kernel.Get();
         dawn::InfoLog() << "    input memory: " << inputMemory.Get();
         dawn::InfoLog() << "    output memory: " << outputMemory.Get();
 #endif
-        mKernels.push_back(kernel);
+        AddKernel(kernel, conv2d);
         mConv2dKernels.insert(std::make_pair(conv2d, kernel));
         return {};
     }
@@ -811,11 +1034,11 @@ namespace webnn::native::mlas {
     MaybeError Graph::AddPool2d(const op::Pool2d* pool2d) {
         const Pool2dOptions* options = pool2d->GetOptions();
         if (options->layout != wnn::InputOperandLayout::Nchw) {
-            return DAWN_INTERNAL_ERROR("Only support nchw input layout");
+            return DAWN_UNIMPLEMENTED_ERROR("Only support nchw input layout");
         }
         const OperandBase* inputOperand = pool2d->Inputs()[0].Get();
         if (inputOperand->Type() != wnn::OperandType::Float32) {
-            return DAWN_INTERNAL_ERROR("Only support float32 input");
+            return DAWN_UNIMPLEMENTED_ERROR("Only support float32 input");
         }
         size_t nchwcBlockSize = MlasNchwcGetBlockSize();
         bool nchwcPool = nchwcBlockSize > 1 ? true : false;
@@ -826,7 +1049,7 @@ namespace webnn::native::mlas {
         } else if (pool2d->GetType() == op::Pool2dType::kMaxPool2d) {
             kind = MlasMaximumPooling;
         } else {
-            return DAWN_INTERNAL_ERROR("Pool type is unsupported");
+            return DAWN_UNIMPLEMENTED_ERROR("Pool type is unsupported");
         }
         size_t batchCount = inputOperand->Shape()[0];
         size_t inputChannels = inputOperand->Shape()[1];
@@ -862,7 +1085,7 @@ namespace webnn::native::mlas {
         }
 
         if (!nchwcPool) {
-            return DAWN_INTERNAL_ERROR("Only support nchwc pool");
+            return DAWN_UNIMPLEMENTED_ERROR("Only support nchwc pool");
         }
 
         DAWN_ASSERT(mMemoryMap.find(inputOperand) != mMemoryMap.end());
@@ -874,13 +1097,11 @@ namespace webnn::native::mlas {
                                                              static_cast<int32_t>(nchwcChannels),
                                                              inputHeight, inputWidth};
                 Ref<Memory> reorderOutputMemory =
-                    AcquireRef(new Memory(inputOperand->Type(), reorderedOutputShape, true));
-                if (!reorderOutputMemory->Allocate()) {
-                    return DAWN_INTERNAL_ERROR("Failed to allocate reorder output memory.");
-                }
+                    CreateIntermediateMemory(inputOperand->Type(), reorderedOutputShape, true);
                 size_t inputSize = inputHeight * inputWidth;
-                mKernels.push_back(AcquireRef(new ReorderInput(
-                    reorderInputMemory, reorderOutputMemory, inputChannels, inputSize)));
+                AddKernel(AcquireRef(new ReorderInput(reorderInputMemory, reorderOutputMemory,
+                                                      inputChannels, inputSize)),
+                          pool2d);
                 inputMemory = reorderOutputMemory;
                 inputShape[1] = nchwcChannels;
             } else {
@@ -895,10 +1116,7 @@ namespace webnn::native::mlas {
         std::vector<int32_t> nchwcOutputShape = {
             outputOperand->Shape()[0], inputMemory->GetDimensions()[1], outputOperand->Shape()[2],
             outputOperand->Shape()[3]};
-        outputMemory = AcquireRef(new Memory(outputOperand->Type(), nchwcOutputShape, true));
-        if (!outputMemory->Allocate()) {
-            return DAWN_INTERNAL_ERROR("Failed to allocate output memory");
-        }
+        outputMemory = CreateIntermediateMemory(outputOperand->Type(), nchwcOutputShape, true);
         mMemoryMap.insert(std::make_pair(outputOperand, outputMemory));
         Ref<Pool2d> kernel =
             AcquireRef(new Pool2d(kind, globalPooling, inputMemory, outputMemory, inputShape,
@@ -906,7 +1124,27 @@ namespace webnn::native::mlas {
 #if (VERBOSE)
         dawn::InfoLog() << "Add pool2d " << pool2d << " kernel " << kernel.Get();
 #endif
-        mKernels.push_back(kernel);
+        AddKernel(kernel, pool2d);
+        return {};
+    }
+
+    MaybeError Graph::AddTranspose(const op::Transpose* transpose) {
+        const OperandBase* inputOperand = transpose->Inputs()[0].Get();
+        if (inputOperand->Type() != wnn::OperandType::Float32) {
+            return DAWN_UNIMPLEMENTED_ERROR("Only support float32");
+        }
+        if (inputOperand->Shape().empty()) {
+            return DAWN_UNIMPLEMENTED_ERROR("Transpose of a scalar is not supported.");
+        }
+        Ref<Memory> inputMemory;
+        DAWN_TRY_ASSIGN(inputMemory, GetNchwMemory(inputOperand, transpose));
+        const OperandBase* outputOperand = transpose->PrimaryOutput();
+        Ref<Memory> outputMemory =
+            CreateIntermediateMemory(outputOperand->Type(), outputOperand->Shape());
+        mMemoryMap.insert(std::make_pair(outputOperand, outputMemory));
+        AddKernel(AcquireRef(new Transpose(inputMemory, outputMemory, inputOperand->Shape(),
+                                           transpose->GetPermutation())),
+                  transpose);
         return {};
     }
 
@@ -918,16 +1156,13 @@ namespace webnn::native::mlas {
             opType == op::UnaryOpType::kTanh) {
             const OperandBase* inputOperand = unary->Inputs()[0].Get();
             if (inputOperand->Type() != wnn::OperandType::Float32) {
-                return DAWN_INTERNAL_ERROR("Only support float32");
+                return DAWN_UNIMPLEMENTED_ERROR("Only support float32");
             }
             DAWN_ASSERT(mMemoryMap.find(inputOperand) != mMemoryMap.end());
             Ref<Memory> inputMemory = mMemoryMap.at(inputOperand);
             const OperandBase* outputOperand = unary->PrimaryOutput();
             Ref<Memory> outputMemory =
-                AcquireRef(new Memory(outputOperand->Type(), outputOperand->Shape()));
-            if (!outputMemory->Allocate()) {
-                return DAWN_INTERNAL_ERROR("Failed to allocate output memory");
-            }
+                CreateIntermediateMemory(outputOperand->Type(), outputOperand->Shape());
             mMemoryMap.insert(std::make_pair(outputOperand, outputMemory));
             std::vector<int32_t> dimensions = inputOperand->Shape();
             size_t elementNum = std::accumulate(dimensions.begin(), dimensions.end(), (size_t)1,
@@ -944,8 +1179,9 @@ namespace webnn::native::mlas {
                 activation.Parameters.LeakyRelu.alpha =
                     reinterpret_cast<const op::LeakyRelu*>(unary)->GetAlpha();
             }
-            mKernels.push_back(
-                AcquireRef(new Unary(opType, inputMemory, outputMemory, elementNum, activation)));
+            AddKernel(
+                AcquireRef(new Unary(opType, inputMemory, outputMemory, elementNum, activation)),
+                unary);
         } else {
             return DAWN_UNIMPLEMENTED_ERROR("Unsupported unary op");
         }
@@ -953,6 +1189,91 @@ namespace webnn::native::mlas {
     }
 
     MaybeError Graph::Finish() {
+        // The live range of a memory spans from the first to the last kernel that uses it. Graph
+        // outputs are read after the last kernel has run.
+        std::unordered_map<const Memory*, std::pair<size_t, size_t>> liveRanges;
+        for (size_t i = 0; i < mKernels.size(); ++i) {
+            mKernelOutputs.insert(mKernels[i]->GetOutput().Get());
+            for (auto& memory : mKernels[i]->GetMemories()) {
+                auto iter = liveRanges.find(memory.Get());
+                if (iter == liveRanges.end()) {
+                    liveRanges.insert(std::make_pair(memory.Get(), std::make_pair(i, i)));
+                } else {
+                    iter->second.second = i;
+                }
+            }
+        }
+        for (auto& [_, memory] : mOutputs) {
+            auto iter = liveRanges.find(memory.Get());
+            if (iter != liveRanges.end()) {
+                iter->second.second = mKernels.size();
+            }
+        }
+
+        struct Block {
+            Memory* memory;
+            size_t first;
+            size_t last;
+            size_t byteLength;
+            size_t offset;
+        };
+        const size_t alignment = MlasGetPreferredBufferAlignment();
+        std::vector<Block> blocks;
+        size_t unplannedByteLength = 0;
+        for (auto& memory : mIntermediates) {
+            auto iter = liveRanges.find(memory.Get());
+            if (iter == liveRanges.end()) {
+                // Not used by any kernel, e.g. a conv2d output replaced by a fused add.
+                continue;
+            }
+            size_t byteLength = (memory->GetByteLength() + alignment - 1) / alignment * alignment;
+            blocks.push_back({memory.Get(), iter->second.first, iter->second.second, byteLength, 0});
+            unplannedByteLength += byteLength;
+        }
+
+        // Greedy by size: place the largest blocks first, each one into the smallest gap left by
+        // the already placed blocks whose live ranges overlap with it.
+        std::sort(blocks.begin(), blocks.end(), [](const Block& a, const Block& b) {
+            return a.byteLength > b.byteLength;
+        });
+        std::vector<const Block*> placed;
+        for (auto& block : blocks) {
+            std::vector<const Block*> overlapped;
+            for (const Block* other : placed) {
+                if (other->first <= block.last && block.first <= other->last) {
+                    overlapped.push_back(other);
+                }
+            }
+            std::sort(overlapped.begin(), overlapped.end(),
+                      [](const Block* a, const Block* b) { return a->offset < b->offset; });
+            size_t offset = 0;
+            size_t bestOffset = std::numeric_limits<size_t>::max();
+            size_t bestGap = std::numeric_limits<size_t>::max();
+            for (const Block* other : overlapped) {
+                if (other->offset >= offset + block.byteLength &&
+                    other->offset - offset < bestGap) {
+                    bestGap = other->offset - offset;
+                    bestOffset = offset;
+                }
+                offset = std::max(offset, other->offset + other->byteLength);
+            }
+            block.offset = bestOffset != std::numeric_limits<size_t>::max() ? bestOffset : offset;
+            mArenaByteLength = std::max(mArenaByteLength, block.offset + block.byteLength);
+            placed.push_back(&block);
+        }
+
+        if (mArenaByteLength > 0) {
+            mArena = AlignedAlloc(mArenaByteLength);
+            if (mArena == nullptr) {
+                return DAWN_OUT_OF_MEMORY_ERROR("Failed to allocate the memory arena.");
+            }
+            for (auto& block : blocks) {
+                block.memory->Bind(static_cast<int8_t*>(mArena) + block.offset);
+            }
+        }
+        dawn::InfoLog() << "MLAS planned " << blocks.size() << " intermediate tensors into "
+                        << mArenaByteLength << " bytes (" << unplannedByteLength
+                        << " bytes without reuse).";
         return {};
     }
 
@@ -960,34 +1281,80 @@ namespace webnn::native::mlas {
         return {};
     }
 
+    bool Graph::CanBindExternal(Memory* memory, const void* buffer, size_t byteLength) const {
+        // Blocked memories need a reorder, misaligned buffers would slow down or break the
+        // vectorized kernels.
+        return !memory->IsBlockedLayout() && byteLength == memory->GetByteLength() &&
+               reinterpret_cast<uintptr_t>(buffer) % MlasGetPreferredBufferAlignment() == 0;
+    }
+
     MaybeError Graph::ComputeImpl(NamedInputsBase* inputs, NamedOutputsBase* outputs) {
+        // Validate everything before any memory is bound to a caller's buffer.
+        for (auto& [name, input] : inputs->GetRecords()) {
+            DAWN_INVALID_IF(mInputs.at(name)->GetByteLength() <
+                                input.resource.arrayBufferView.byteLength,
+                            "The size of input memory is less than input buffer.");
+        }
+        for (auto& [name, output] : outputs->GetRecords()) {
+            DAWN_INVALID_IF(output.arrayBufferView.byteLength < mOutputs.at(name)->GetByteLength(),
+                            "The size of output buffer is less than output memory.");
+        }
+
+        std::vector<Ref<Memory>> externalMemories;
         for (auto& [name, input] : inputs->GetRecords()) {
             Ref<Memory> inputMemory = mInputs.at(name);
             auto& resource = input.resource.arrayBufferView;
-            DAWN_INVALID_IF(inputMemory->GetByteLength() < resource.byteLength,
-                            "The size of input memory is less than input buffer.");
-            memcpy(inputMemory->GetBuffer(),
-                   static_cast<int8_t*>(resource.buffer) + resource.byteOffset,
-                   resource.byteLength);
+            void* buffer = static_cast<int8_t*>(resource.buffer) + resource.byteOffset;
+            // An input that a kernel accumulates into, e.g. by a conv2d fused with add, can't
+            // alias the caller's buffer.
+            if (mKernelOutputs.find(inputMemory.Get()) == mKernelOutputs.end() &&
+                CanBindExternal(inputMemory.Get(), buffer, resource.byteLength)) {
+                inputMemory->BindExternal(buffer);
+                externalMemories.push_back(inputMemory);
+                continue;
+            }
+            memcpy(inputMemory->GetBuffer(), buffer, resource.byteLength);
         }
 
+        for (auto& [name, output] : outputs->GetRecords()) {
+            Ref<Memory> outputMemory = mOutputs.at(name);
+            const ArrayBufferView& arrayBufferView = output.arrayBufferView;
+            void* buffer = static_cast<int8_t*>(arrayBufferView.buffer) + arrayBufferView.byteOffset;
+            // Only a memory that a kernel writes can be written into the caller's buffer, an
+            // output that is a constant or a graph input is copied.
+            if (!outputMemory->IsExternal() &&
+                mKernelOutputs.find(outputMemory.Get()) != mKernelOutputs.end() &&
+                CanBindExternal(outputMemory.Get(), buffer, arrayBufferView.byteLength)) {
+                bool isInput = false;
+                for (auto& [_, inputMemory] : mInputs) {
+                    isInput = isInput || inputMemory.Get() == outputMemory.Get();
+                }
+                if (!isInput) {
+                    outputMemory->BindExternal(buffer);
+                    externalMemories.push_back(outputMemory);
+                }
+            }
+        }
+
+        const bool profiling = ScopedProfileRecorder::IsRecording();
         for (auto& kernel : mKernels) {
+            ScopedTrace trace("mlas", kernel->GetName());
+            ScopedKernelProfile profile(kernel->GetOperator(), kernel->GetName(),
+                                        profiling ? kernel->GetByteLength() : 0);
             kernel->Compute(reinterpret_cast<Context*>(GetContext())->GetThreadPool());
         }
 
-        std::vector<std::string> outputNames;
-        for (auto& [name, _] : outputs->GetRecords()) {
-            outputNames.push_back(name);
+        for (auto& [name, output] : outputs->GetRecords()) {
+            Ref<Memory> outputMemory = mOutputs.at(name);
+            const ArrayBufferView& arrayBufferView = output.arrayBufferView;
+            void* buffer = static_cast<int8_t*>(arrayBufferView.buffer) + arrayBufferView.byteOffset;
+            if (outputMemory->GetBuffer() != buffer) {
+                memcpy(buffer, outputMemory->GetBuffer(), outputMemory->GetByteLength());
+            }
         }
 
-        for (size_t i = 0; i < outputNames.size(); ++i) {
-            std::string outputName = outputNames[i];
-            Ref<Memory> outputMemory = mOutputs.at(outputName);
-            const ArrayBufferView& output = outputs->GetRecords().at(outputName).arrayBufferView;
-            DAWN_INVALID_IF(output.byteLength < outputMemory->GetByteLength(),
-                            "The size of output buffer is less than output memory.");
-            memcpy(static_cast<int8_t*>(output.buffer) + output.byteOffset,
-                   outputMemory->GetBuffer(), output.byteLength);
+        for (auto& memory : externalMemories) {
+            memory->UnbindExternal();
         }
         return {};
     }
@@ -50,18 +50,43 @@ namespace webnn::native::mlas {
         virtual MaybeError AddClamp(const op::Clamp* clamp) override;
         virtual MaybeError AddConv2d(const op::Conv2d* conv2d) override;
         virtual MaybeError AddPool2d(const op::Pool2d* pool2d) override;
+        virtual MaybeError AddTranspose(const op::Transpose* transpose) override;
         virtual MaybeError AddUnary(const op::Unary* unary) override;
         virtual MaybeError Finish() override;
+        virtual bool SupportsFusedActivation(const op::Conv2d* conv2d,
+                                             FusionType type) const override;
+        virtual bool GetPreferredLayout(wnn::InputOperandLayout* layout) const override;
 
       private:
         MaybeError CompileImpl() override;
         MaybeError ComputeImpl(NamedInputsBase* inputs, NamedOutputsBase* outputs) override;
 
+        // Creates the memory of an intermediate tensor, it is backed by the arena planned in
+        // Finish rather than an allocation of its own.
+        Ref<Memory> CreateIntermediateMemory(wnn::OperandType type,
+                                             const std::vector<int32_t>& dims,
+                                             bool blockedLayout = false);
+        // Appends |kernel|, which computes |op|, to the kernels run by a compute.
+        void AddKernel(Ref<Kernel> kernel, const OperatorBase* op);
+        // Returns the memory of |operand| in the plain layout, reordering it from NCHWc if the
+        // kernel producing it writes the blocked layout. The reorder is attributed to |op|.
+        ResultOrError<Ref<Memory>> GetNchwMemory(const OperandBase* operand,
+                                                 const OperatorBase* op);
+        // Whether |memory| can use the caller's |buffer| directly instead of copying.
+        bool CanBindExternal(Memory* memory, const void* buffer, size_t byteLength) const;
+
         std::unordered_map<std::string, Ref<Memory>> mInputs;
         std::unordered_map<std::string, Ref<Memory>> mOutputs;
         std::unordered_map<const OperandBase*, Ref<Memory>> mMemoryMap;
+        // The operands whose data is known when the graph is built, e.g. to reorder it.
+        std::unordered_set<const OperandBase*> mConstants;
         std::unordered_map<const OperatorBase*, Ref<Conv2d>> mConv2dKernels;
         std::vector<Ref<Kernel>> mKernels;
+        std::vector<Ref<Memory>> mIntermediates;
+        // Memories written by a kernel, graph inputs among them are always copied.
+        std::unordered_set<const Memory*> mKernelOutputs;
+        void* mArena;
+        size_t mArenaByteLength;
     };
 
 }  // namespace webnn::native::mlas
@@ -232,14 +232,14 @@ namespace webnn::native::nnapi {
             } else if (options->activation->GetFusionType() == FusionType::Clamp) {
                 auto activationNode =
                     CreateOperand("", outputNode->type, outputNode->dimensions, nullptr);
-                auto clamp = reinterpret_cast<const op::FusionClamp*>(options->activation);
+                auto clamp = static_cast<const op::FusionClamp*>(options->activation);
                 DAWN_TRY(AddClampImpl(finalOutputNode, activationNode, clamp->GetMinValue(),
                                       clamp->GetMaxValue()));
                 outputOpIndex = activationNode->opIndex;
             } else if (options->activation->GetFusionType() == FusionType::LeakyRelu) {
                 auto activationNode =
                     CreateOperand("", outputNode->type, outputNode->dimensions, nullptr);
-                auto leakyRelu = reinterpret_cast<const op::FusionLeakyRelu*>(options->activation);
+                auto leakyRelu = static_cast<const op::FusionLeakyRelu*>(options->activation);
                 DAWN_TRY(AddLeakyReluImpl(finalOutputNode, activationNode, leakyRelu->GetAlpha()));
                 outputOpIndex = activationNode->opIndex;
             } else if (options->activation->GetFusionType() == FusionType::Sigmoid) {
@@ -738,6 +738,11 @@ namespace webnn::native::nnapi {
         return {};
     }
 
+    bool Graph::SupportsFusedActivation(const op::Conv2d* conv2d, FusionType type) const {
+        return type == FusionType::Clamp || type == FusionType::Relu ||
+               type == FusionType::Sigmoid || type == FusionType::LeakyRelu;
+    }
+
     MaybeError Graph::AddConv2d(const op::Conv2d* conv2d) {
         auto options = conv2d->GetOptions();
 
@@ -961,7 +966,7 @@ namespace webnn::native::nnapi {
                 auto activationNode =
                     CreateOperand("", outputNode->type, outputNode->dimensions, nullptr);
                 DAWN_TRY(CheckForNullNode(activationNode, "Failed to create NNAPI operand"));
-                auto clamp = reinterpret_cast<const op::FusionClamp*>(options->activation);
+                auto clamp = static_cast<const op::FusionClamp*>(options->activation);
                 DAWN_TRY(AddClampImpl(outputNode, activationNode, clamp->GetMinValue(),
                                       clamp->GetMaxValue()));
                 mGraphNodeMap[conv2d->PrimaryOutput()] = activationNode->opIndex;
@@ -969,7 +974,7 @@ namespace webnn::native::nnapi {
                 auto activationNode =
                     CreateOperand("", outputNode->type, outputNode->dimensions, nullptr);
                 DAWN_TRY(CheckForNullNode(activationNode, "Failed to create NNAPI operand"));
-                auto leakyRelu = reinterpret_cast<const op::FusionLeakyRelu*>(options->activation);
+                auto leakyRelu = static_cast<const op::FusionLeakyRelu*>(options->activation);
                 DAWN_TRY(AddLeakyReluImpl(outputNode, activationNode, leakyRelu->GetAlpha()));
                 mGraphNodeMap[conv2d->PrimaryOutput()] = activationNode->opIndex;
             } else if (options->activation->GetFusionType() == FusionType::Sigmoid) {
@@ -81,6 +81,8 @@ namespace webnn::native::nnapi {
         virtual MaybeError AddGemm(const op::Gemm* Gemm) override;
         virtual MaybeError AddInstanceNorm(const op::InstanceNorm* InstanceNorm) override;
         virtual MaybeError Finish() override;
+        virtual bool SupportsFusedActivation(const op::Conv2d* conv2d,
+                                             FusionType type) const override;
 
         MaybeError AddSoftMax(const std::shared_ptr<NodeInfo>& input0Node,
                               std::shared_ptr<NodeInfo> outputNode);
@@ -44,11 +44,16 @@ namespace webnn::native::null {
         return new Context(reinterpret_cast<ContextOptions const*>(options));
     }
 
-    Context::Context(ContextOptions const* options) {
+    Context::Context(ContextOptions const* options)
+        : ContextBase(options),
+          mThreadPool(std::make_unique<reference::ThreadPool>(
+              GetThreadCount(GetCpuThreadOptions(), std::thread::hardware_concurrency()),
+              GetCpuThreadOptions().affinity)) {
     }
 
 #if defined(WEBNN_ENABLE_GPU_BUFFER)
-    Context::Context(WGPUDevice device) {
+    Context::Context(WGPUDevice device)
+        : mThreadPool(std::make_unique<reference::ThreadPool>(std::thread::hardware_concurrency())) {
     }
 #endif
 
@@ -61,103 +66,7 @@ namespace webnn::native::null {
     }
 
     // Graph
-    Graph::Graph(Context* context) : GraphBase(context) {
-    }
-
-    MaybeError Graph::CompileImpl() {
-        return {};
-    }
-
-    MaybeError Graph::ComputeImpl(NamedInputsBase* inputs, NamedOutputsBase* outputs) {
-        return {};
-    }
-
-    MaybeError Graph::AddConstant(const op::Constant* constant) {
-        return {};
-    }
-
-    MaybeError Graph::AddInput(const op::Input* input) {
-        return {};
-    }
-
-    MaybeError Graph::AddOutput(std::string_view name, const OperandBase* output) {
-        return {};
-    }
-
-    MaybeError Graph::AddBinary(const op::Binary* binary) {
-        return {};
-    }
-
-    MaybeError Graph::AddConv2d(const op::Conv2d* conv2d) {
-        return {};
-    }
-
-    MaybeError Graph::AddGru(const op::Gru* gru) {
-        return {};
-    }
-
-    MaybeError Graph::AddPad(const op::Pad* pad) {
-        return {};
-    }
-
-    MaybeError Graph::AddPool2d(const op::Pool2d* pool2d) {
-        return {};
-    }
-
-    MaybeError Graph::AddReduce(const op::Reduce* reduce) {
-        return {};
-    }
-
-    MaybeError Graph::AddResample2d(const op::Resample2d* resample2d) {
-        return {};
-    }
-
-    MaybeError Graph::AddReshape(const op::Reshape* relu) {
-        return {};
-    }
-
-    MaybeError Graph::AddSqueeze(const op::Squeeze* squeeze) {
-        return {};
-    }
-
-    MaybeError Graph::AddSlice(const op::Slice* slice) {
-        return {};
-    }
-
-    MaybeError Graph::AddSplit(const op::Split* split) {
-        return {};
-    }
-
-    MaybeError Graph::AddTranspose(const op::Transpose* transpose) {
-        return {};
-    }
-
-    MaybeError Graph::AddUnary(const op::Unary* unary) {
-        return {};
-    }
-
-    MaybeError Graph::AddBatchNorm(const op::BatchNorm* batchNorm) {
-        return {};
-    }
-
-    MaybeError Graph::AddConcat(const op::Concat* concat) {
-        return {};
-    }
-
-    MaybeError Graph::AddGemm(const op::Gemm* gemm) {
-        return {};
-    }
-
-    MaybeError Graph::AddClamp(const op::Clamp* clamp) {
-        return {};
-    }
-
-    MaybeError Graph::AddInstanceNorm(const op::InstanceNorm* instanceNorm) {
-        return {};
-    }
-
-    MaybeError Graph::Finish() {
-        return {};
+    Graph::Graph(Context* context) : reference::Graph(context, context->GetThreadPool()) {
     }
 
 }  // namespace webnn::native::null
@@ -15,9 +15,13 @@
 #ifndef WEBNN_NATIVE_NULL_CONTEXT_NULL_H_
 #define WEBNN_NATIVE_NULL_CONTEXT_NULL_H_
 
+#include <memory>
+
 #include "webnn/native/Context.h"
 #include "webnn/native/Graph.h"
 #include "webnn/native/GraphBuilder.h"
+#include "webnn/native/reference/GraphReference.h"
+#include "webnn/native/reference/ThreadPool.h"
 
 #if defined(WEBNN_ENABLE_GPU_BUFFER)
 #    include <webgpu/webgpu.h>
@@ -35,8 +39,14 @@ namespace webnn::native::null {
 #endif
         ~Context() override = default;
 
+        reference::ThreadPool* GetThreadPool() const {
+            return mThreadPool.get();
+        }
+
       private:
         GraphBase* CreateGraphImpl() override;
+
+        std::unique_ptr<reference::ThreadPool> mThreadPool;
     };
 
     // GraphBuilder
@@ -47,36 +57,11 @@ namespace webnn::native::null {
     };
 
     // Graph
-    class Graph : public GraphBase {
+    // Graphs of the Null backend are run by the portable reference executor.
+    class Graph : public reference::Graph {
       public:
         explicit Graph(Context* context);
         ~Graph() override = default;
-        virtual MaybeError AddConstant(const op::Constant* constant) override;
-        virtual MaybeError AddInput(const op::Input* input) override;
-        virtual MaybeError AddOutput(std::string_view name, const OperandBase* ouput) override;
-        virtual MaybeError AddBinary(const op::Binary* binary) override;
-        virtual MaybeError AddConv2d(const op::Conv2d* conv2d) override;
-        virtual MaybeError AddGru(const op::Gru* gru) override;
-        virtual MaybeError AddPad(const op::Pad* pad) override;
-        virtual MaybeError AddPool2d(const op::Pool2d* pool2d) override;
-        virtual MaybeError AddReduce(const op::Reduce* reduce) override;
-        virtual MaybeError AddResample2d(const op::Resample2d* resample2d) override;
-        virtual MaybeError AddReshape(const op::Reshape* relu) override;
-        virtual MaybeError AddSqueeze(const op::Squeeze* squeeze) override;
-        virtual MaybeError AddSlice(const op::Slice* slice) override;
-        virtual MaybeError AddSplit(const op::Split* split) override;
-        virtual MaybeError AddTranspose(const op::Transpose* transpose) override;
-        virtual MaybeError AddUnary(const op::Unary* unary) override;
-        virtual MaybeError AddBatchNorm(const op::BatchNorm* batchNorm) override;
-        virtual MaybeError AddConcat(const op::Concat* concat) override;
-        virtual MaybeError AddGemm(const op::Gemm* gemm) override;
-        virtual MaybeError AddClamp(const op::Clamp* clamp) override;
-        virtual MaybeError AddInstanceNorm(const op::InstanceNorm* instanceNorm) override;
-        virtual MaybeError Finish() override;
-
-      private:
-        MaybeError CompileImpl() override;
-        MaybeError ComputeImpl(NamedInputsBase* inputs, NamedOutputsBase* outputs) override;
     };
 
 }  // namespace webnn::native::null
@@ -19,7 +19,7 @@
 
 namespace webnn::native::onednn {
 
-    Context::Context() : mEngine(nullptr) {
+    Context::Context(ContextOptions const* options) : ContextBase(options), mEngine(nullptr) {
     }
 
     Context::~Context() {
@@ -15,15 +15,23 @@
 #include "webnn/native/onednn/GraphDNNL.h"
 
 #include <numeric>
+#include <string>
 
 #include "common/Assert.h"
 #include "common/Log.h"
 #include "webnn/native/ErrorData.h"
+#include "webnn/native/GraphCache.h"
 #include "webnn/native/NamedInputs.h"
 #include "webnn/native/NamedOutputs.h"
 #include "webnn/native/Operand.h"
+#include "webnn/native/Profiler.h"
+#include "webnn/native/Tracer.h"
 #include "webnn/native/Utils.h"
 
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP
+#    include <omp.h>
+#endif
+
 #define FAILED(status) (((dnnl_status_t)(status)) != dnnl_success)
 
 const char* dnnl_status2str(dnnl_status_t v) {
@@ -77,6 +85,20 @@ const char* dnnl_status2str(dnnl_status_t v) {
 
 namespace webnn::native::onednn {
     namespace {
+        // The layout a constant is reordered to depends on the oneDNN build and on the ISA it
+        // dispatches to, the cached bytes are only valid for the same ones and the same
+        // destination memory descriptor.
+        std::string GetReorderCacheName(const dnnl_memory_desc_t* dstDesc, size_t index) {
+            const dnnl_version_t* version = dnnl_version();
+            std::string state = std::to_string(version->major) + "." +
+                                std::to_string(version->minor) + "." +
+                                std::to_string(version->patch) + "-" + version->hash + "-" +
+                                std::to_string(dnnl_get_effective_cpu_isa()) + "-";
+            state.append(reinterpret_cast<const char*>(dstDesc), sizeof(dnnl_memory_desc_t));
+            return "onednn-reorder-" + std::to_string(index) + "-" +
+                   HashCacheName(state.data(), state.size());
+        }
+
         dnnl_status_t GetDnnlDataType(wnn::OperandType operandType,
                                       dnnl_data_type_t& dnnlDataType) {
             if (operandType == wnn::OperandType::Float32) {
@@ -309,6 +331,7 @@ namespace webnn::native::onednn {
             return dnnl_invalid_arguments;
         }
         auto& info = mOperandsToBuild[0];
+        mBuildingOperator = info.op;
         if (mOperandsToBuild.size() == 1) {
             if (info.opType == OperatorType::UNARY) {
                 DNNL_TRY(AddUnaryImpl(reinterpret_cast<const op::Unary*>(info.op)));
@@ -331,7 +354,7 @@ namespace webnn::native::onednn {
                 return dnnl_invalid_arguments;
             }
             const op::Binary* add = nullptr;
-            const op::FusionClamp* clamp = nullptr;
+            const op::Clamp* clamp = nullptr;
             for (size_t i = 1; i < mOperandsToBuild.size(); ++i) {
                 auto& postOp = mOperandsToBuild[i];
                 if (postOp.opType == OperatorType::BINARY &&
@@ -339,7 +362,7 @@ namespace webnn::native::onednn {
                         op::BinaryOpType::kAdd) {
                     add = reinterpret_cast<const op::Binary*>(postOp.op);
                 } else if (postOp.opType == OperatorType::CLAMP) {
-                    clamp = reinterpret_cast<const op::FusionClamp*>(postOp.op);
+                    clamp = static_cast<const op::Clamp*>(postOp.op);
                 }
             }
             if ((mOperandsToBuild.size() == 2 && !add && !clamp) ||
@@ -356,6 +379,7 @@ namespace webnn::native::onednn {
 
     MaybeError Graph::AddOutput(std::string_view name, const OperandBase* output) {
         DAWN_TRY(BuildPrimitives());
+        mBuildingOperator = nullptr;
         DAWN_ASSERT(mOperandMemoryMap.find(output) != mOperandMemoryMap.end());
         dnnl_memory_t plainOutputMemory;
         DAWN_TRY(ReorderToPlainFormat(mOperandMemoryMap.at(output), &plainOutputMemory));
@@ -502,7 +526,7 @@ namespace webnn::native::onednn {
         } else {
             args = {{DNNL_ARG_SRC_0, aMemory}, {DNNL_ARG_SRC_1, bMemory}, {DNNL_ARG_DST, cMemory}};
         }
-        mOperations.push_back({primitive, args});
+        mOperations.push_back({primitive, args, mBuildingOperator});
         mMemories.push_back(cMemory);
         mOperandMemoryMap.insert(std::make_pair(binary->PrimaryOutput(), cMemory));
         if (cRank != 0 && cRank < cMemoryDesc->ndims) {
@@ -523,7 +547,7 @@ namespace webnn::native::onednn {
 
     dnnl_status_t Graph::AddConv2dImpl(const op::Conv2d* conv2d,
                                        const op::Binary* add,
-                                       const op::FusionClamp* clamp) {
+                                       const op::Clamp* clamp) {
         DAWN_ASSERT(conv2d->Inputs().size() == 2 || conv2d->Inputs().size() == 3);
         const OperandBase* inputOperand = conv2d->Inputs()[0].Get();
         DAWN_ASSERT(mOperandMemoryMap.find(inputOperand) != mOperandMemoryMap.end());
@@ -759,7 +783,7 @@ namespace webnn::native::onednn {
         if (add) {
             args.push_back({DNNL_ARG_BIAS, biasMemory});
         }
-        mOperations.push_back({primitive, args});
+        mOperations.push_back({primitive, args, mBuildingOperator});
         mMemories.push_back(outputMemory);
 
         const OperandBase* output =
@@ -878,7 +902,7 @@ namespace webnn::native::onednn {
             mMemories.push_back(workspaceMemory);
         }
         DNNL_TRY(dnnl_primitive_desc_destroy(primitiveDesc));
-        mOperations.push_back({primitive, args});
+        mOperations.push_back({primitive, args, mBuildingOperator});
         mMemories.push_back(outputMemory);
         mOperandMemoryMap.insert(std::make_pair(pool2d->PrimaryOutput(), outputMemory));
         return dnnl_success;
@@ -921,7 +945,9 @@ namespace webnn::native::onednn {
         DNNL_TRY(dnnl_primitive_create(&primitive, primitiveDesc));
         DNNL_TRY(dnnl_primitive_desc_destroy(primitiveDesc));
         mOperations.push_back(
-            {primitive, {{DNNL_ARG_SRC, inputMemory}, {DNNL_ARG_DST, outputMemory}}});
+            {primitive,
+             {{DNNL_ARG_SRC, inputMemory}, {DNNL_ARG_DST, outputMemory}},
+             mBuildingOperator});
         mMemories.push_back(outputMemory);
         mOperandMemoryMap.insert(std::make_pair(unary->PrimaryOutput(), outputMemory));
         return dnnl_success;
@@ -958,7 +984,9 @@ namespace webnn::native::onednn {
         DNNL_TRY(dnnl_primitive_create(&primitive, primitiveDesc));
         DNNL_TRY(dnnl_primitive_desc_destroy(primitiveDesc));
         mOperations.push_back(
-            {primitive, {{DNNL_ARG_SRC, inputMemory}, {DNNL_ARG_DST, outputMemory}}});
+            {primitive,
+             {{DNNL_ARG_SRC, inputMemory}, {DNNL_ARG_DST, outputMemory}},
+             mBuildingOperator});
         mMemories.push_back(outputMemory);
         mOperandMemoryMap.insert(std::make_pair(clamp->PrimaryOutput(), outputMemory));
         return dnnl_success;
@@ -970,10 +998,33 @@ namespace webnn::native::onednn {
 
     MaybeError Graph::CompileImpl() {
         DAWN_TRY(dnnl_stream_create(&mStream, GetEngine(), dnnl_stream_default_flags));
+        for (auto& operation : mOperations) {
+            const_dnnl_primitive_desc_t primitiveDesc;
+            DAWN_TRY(dnnl_primitive_get_primitive_desc(operation.primitive, &primitiveDesc));
+            const char* implementation;
+            DAWN_TRY(dnnl_primitive_desc_query(primitiveDesc, dnnl_query_impl_info_str, 0,
+                                               &implementation));
+            operation.kernel = implementation;
+            operation.byteLength = 0;
+            for (auto& arg : operation.args) {
+                const dnnl_memory_desc_t* memoryDesc;
+                DAWN_TRY(GetMemoryDesc(arg.memory, &memoryDesc));
+                operation.byteLength += dnnl_memory_desc_get_size(memoryDesc);
+            }
+        }
         return {};
     }
 
     MaybeError Graph::ComputeImpl(NamedInputsBase* inputs, NamedOutputsBase* outputs) {
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP
+        // The OpenMP runtime sizes the parallel regions started by the calling thread, its
+        // processors and wait policy are set for the whole process through OMP_PLACES and
+        // OMP_WAIT_POLICY.
+        const uint32_t threadCount = GetContext()->GetCpuThreadOptions().threadCount;
+        if (threadCount != 0) {
+            omp_set_num_threads(threadCount);
+        }
+#endif
         for (auto& [name, input] : inputs->GetRecords()) {
             dnnl_memory_t inputMemory = mInputMemoryMap.at(name);
             auto& resource = input.resource.arrayBufferView;
@@ -981,32 +1032,85 @@ namespace webnn::native::onednn {
                 inputMemory, static_cast<int8_t*>(resource.buffer) + resource.byteOffset, mStream));
         }
 
-        for (auto op : mOperations) {
-            DAWN_TRY(dnnl_primitive_execute(op.primitive, mStream, op.args.size(), op.args.data()));
+        // Bind the plain output memories to the caller's buffers, the last primitive or reorder
+        // then writes the results in place. Inputs and constants keep their own data, as does a
+        // memory that backs more than one output, they are read back after execution.
+        std::vector<std::pair<dnnl_memory_t, ArrayBufferView>> outputsToBind;
+        std::vector<std::pair<dnnl_memory_t, ArrayBufferView>> outputsToRead;
+        for (auto& [name, output] : outputs->GetRecords()) {
+            dnnl_memory_t outputMemory = mOutputMemoryMap.at(name);
+            const dnnl_memory_desc_t* outputMemoryDesc;
+            DAWN_TRY(GetMemoryDesc(outputMemory, &outputMemoryDesc));
+            const ArrayBufferView& arrayBufferView = output.arrayBufferView;
+            DAWN_INVALID_IF(
+                arrayBufferView.byteLength < dnnl_memory_desc_get_size(outputMemoryDesc),
+                "The size of output buffer is less than output memory.");
+            bool isInput = false;
+            for (auto& [_, inputMemory] : mInputMemoryMap) {
+                isInput = isInput || inputMemory == outputMemory;
+            }
+            bool isBound = false;
+            for (auto& [boundMemory, _] : outputsToBind) {
+                isBound = isBound || boundMemory == outputMemory;
+            }
+            if (isInput || isBound ||
+                mConstantMemories.find(outputMemory) != mConstantMemories.end()) {
+                outputsToRead.push_back(std::make_pair(outputMemory, arrayBufferView));
+            } else {
+                outputsToBind.push_back(std::make_pair(outputMemory, arrayBufferView));
+            }
         }
 
-        DAWN_TRY(dnnl_stream_wait(mStream));
+        // The bound memories get their own data back once the outputs are read, so that a later
+        // compute that doesn't ask for an output doesn't write to the buffer of this one.
+        std::vector<std::pair<dnnl_memory_t, void*>> ownHandles;
+        dnnl_status_t status = BindOutputs(outputsToBind, &ownHandles);
+        if (status == dnnl_success) {
+            status = Execute(outputsToRead);
+        }
+        for (auto& [memory, handle] : ownHandles) {
+            DAWN_TRY(dnnl_memory_set_data_handle_v2(memory, handle, mStream));
+        }
+        DAWN_TRY(status);
+        return {};
+    }
 
-        std::vector<std::string> outputNames;
-        for (auto& [name, _] : outputs->GetRecords()) {
-            outputNames.push_back(name);
+    dnnl_status_t Graph::BindOutputs(
+        const std::vector<std::pair<dnnl_memory_t, ArrayBufferView>>& outputs,
+        std::vector<std::pair<dnnl_memory_t, void*>>* ownHandles) {
+        for (auto& [memory, arrayBufferView] : outputs) {
+            void* ownHandle;
+            DNNL_TRY(dnnl_memory_get_data_handle(memory, &ownHandle));
+            ownHandles->push_back(std::make_pair(memory, ownHandle));
+            DNNL_TRY(dnnl_memory_set_data_handle_v2(
+                memory, static_cast<int8_t*>(arrayBufferView.buffer) + arrayBufferView.byteOffset,
+                mStream));
         }
+        return dnnl_success;
+    }
 
-        for (size_t i = 0; i < outputNames.size(); ++i) {
-            std::string outputName = outputNames[i];
-            dnnl_memory_t outputMemory = mOutputMemoryMap.at(outputName);
-            const dnnl_memory_desc_t* outputMemoryDesc;
-            DAWN_TRY(GetMemoryDesc(outputMemory, &outputMemoryDesc));
-            size_t bufferLength = dnnl_memory_desc_get_size(outputMemoryDesc);
-            void* outputBuffer = malloc(bufferLength);
-            DAWN_TRY(ReadFromMemory(outputBuffer, bufferLength, outputMemory));
-            ArrayBufferView output = outputs->GetRecords().at(outputName).arrayBufferView;
-            if (output.byteLength >= bufferLength) {
-                memcpy(static_cast<int8_t*>(output.buffer) + output.byteOffset, outputBuffer,
-                       bufferLength);
+    dnnl_status_t Graph::Execute(
+        const std::vector<std::pair<dnnl_memory_t, ArrayBufferView>>& outputsToRead) {
+        const bool timed = ScopedProfileRecorder::IsRecording() || IsTracing();
+        for (auto& op : mOperations) {
+            ScopedTrace trace("onednn", op.kernel.c_str());
+            ScopedKernelProfile profile(op.op, op.kernel.c_str(), op.byteLength);
+            DNNL_TRY(dnnl_primitive_execute(op.primitive, mStream, op.args.size(), op.args.data()));
+            if (timed) {
+                // Primitives may run asynchronously, wait so that the time is the primitive's.
+                DNNL_TRY(dnnl_stream_wait(mStream));
             }
         }
-        return {};
+        DNNL_TRY(dnnl_stream_wait(mStream));
+
+        for (auto& [outputMemory, arrayBufferView] : outputsToRead) {
+            const dnnl_memory_desc_t* outputMemoryDesc;
+            DNNL_TRY(GetMemoryDesc(outputMemory, &outputMemoryDesc));
+            DNNL_TRY(ReadFromMemory(
+                static_cast<int8_t*>(arrayBufferView.buffer) + arrayBufferView.byteOffset,
+                dnnl_memory_desc_get_size(outputMemoryDesc), outputMemory));
+        }
+        return dnnl_success;
     }
 
     dnnl_engine_t Graph::GetEngine() {
@@ -1029,6 +1133,23 @@ namespace webnn::native::onednn {
         if (!dnnl_memory_desc_equal(srcDesc, dstDesc)) {
             dnnl_memory_t dstMem;
             DNNL_TRY(dnnl_memory_create(&dstMem, dstDesc, GetEngine(), DNNL_MEMORY_ALLOCATE));
+            const bool isConstant = mConstantMemories.find(srcMem) != mConstantMemories.end();
+            // Reordering weights into the layout picked by the primitive is the costly part of
+            // building, so the reordered bytes are kept in the compiled graph cache.
+            const std::string cacheName =
+                isConstant ? GetReorderCacheName(dstDesc, mCachedReorderCount++) : "";
+            void* dstBuffer = nullptr;
+            const size_t dstByteLength = dnnl_memory_desc_get_size(dstDesc);
+            if (isConstant) {
+                DNNL_TRY(dnnl_memory_get_data_handle(dstMem, &dstBuffer));
+                if (LoadFromCache(cacheName, dstBuffer, dstByteLength)) {
+                    mMemories.push_back(dstMem);
+                    if (userDstMem != nullptr) {
+                        *userDstMem = dstMem;
+                    }
+                    return dnnl_success;
+                }
+            }
             dnnl_primitive_desc_t reorderDesc;
             DNNL_TRY(dnnl_reorder_primitive_desc_create(&reorderDesc, srcDesc, GetEngine(), dstDesc,
                                                         GetEngine(), NULL));
@@ -1036,14 +1157,17 @@ namespace webnn::native::onednn {
             DNNL_TRY(dnnl_primitive_create(&reorder, reorderDesc));
             DNNL_TRY(dnnl_primitive_desc_destroy(reorderDesc));
             std::vector<dnnl_exec_arg_t> args = {{DNNL_ARG_SRC, srcMem}, {DNNL_ARG_DST, dstMem}};
-            if (mConstantMemories.find(srcMem) != mConstantMemories.end()) {
+            if (isConstant) {
+                ScopedTrace trace("onednn", "ReorderConstant");
                 dnnl_stream_t stream;
                 DNNL_TRY(dnnl_stream_create(&stream, GetEngine(), dnnl_stream_default_flags));
 
                 DNNL_TRY(dnnl_primitive_execute(reorder, stream, args.size(), args.data()));
+                DNNL_TRY(dnnl_stream_wait(stream));
                 DNNL_TRY(dnnl_primitive_destroy(reorder));
+                StoreToCache(cacheName, dstBuffer, dstByteLength);
             } else {
-                mOperations.push_back({reorder, args});
+                mOperations.push_back({reorder, args, mBuildingOperator});
             }
             mMemories.push_back(dstMem);
             if (userDstMem != nullptr) {
@@ -17,6 +17,9 @@
 
 #include <map>
 #include <set>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include <dnnl.h>
 
@@ -53,7 +56,7 @@ namespace webnn::native::onednn {
       private:
         dnnl_status_t AddConv2dImpl(const op::Conv2d* conv2d,
                                     const op::Binary* add = nullptr,
-                                    const op::FusionClamp* clamp = nullptr);
+                                    const op::Clamp* clamp = nullptr);
         dnnl_status_t AddBinaryImpl(const op::Binary* binary);
         dnnl_status_t AddClampImpl(const op::Clamp* clamp);
         dnnl_status_t AddPool2dImpl(const op::Pool2d* pool2d);
@@ -63,6 +66,14 @@ namespace webnn::native::onednn {
 
         MaybeError CompileImpl() override;
         MaybeError ComputeImpl(NamedInputsBase* inputs, NamedOutputsBase* outputs) override;
+        // Points the memories of |outputs| to their buffers, their own data handles are added
+        // to |ownHandles| to be restored after execution.
+        dnnl_status_t BindOutputs(
+            const std::vector<std::pair<dnnl_memory_t, ArrayBufferView>>& outputs,
+            std::vector<std::pair<dnnl_memory_t, void*>>* ownHandles);
+        // Executes the primitives, waits for them and reads |outputsToRead| from their memories.
+        dnnl_status_t Execute(
+            const std::vector<std::pair<dnnl_memory_t, ArrayBufferView>>& outputsToRead);
         dnnl_engine_t GetEngine();
         dnnl_status_t GetMemoryDesc(dnnl_memory_t memory, const dnnl_memory_desc_t** desc);
         dnnl_status_t ReorderIfNeeded(const dnnl_memory_desc_t* srcDesc,
@@ -89,9 +100,17 @@ namespace webnn::native::onednn {
         typedef struct {
             dnnl_primitive_t primitive;
             std::vector<dnnl_exec_arg_t> args;
+            // The operator the primitive was built for, null for the output reorders.
+            const OperatorBase* op;
+            // The implementation chosen by oneDNN and the bytes of the arguments, for profiling.
+            std::string kernel;
+            uint64_t byteLength;
         } Operation;
 
         std::vector<Operation> mOperations;
+        const OperatorBase* mBuildingOperator = nullptr;
+        // Names the reordered constants in the compiled graph cache.
+        uint32_t mCachedReorderCount = 0;
 
         dnnl_stream_t mStream;
     };
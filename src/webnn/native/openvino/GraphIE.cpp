@@ -85,7 +85,7 @@ namespace webnn::native::ie {
             // Inference Engine C API only support rank 8 with defination of dimensions_t
             // https://github.com/openvinotoolkit/openvino/blob/master/inference-engine/ie_bridges/c/include/c_api/ie_c_api.h#L132.
             if (desc->dimensionsCount > 8) {
-                return DAWN_INTERNAL_ERROR("Inference Engine C API only support rank 8.");
+                return DAWN_UNIMPLEMENTED_ERROR("Inference Engine C API only support rank 8.");
             }
             for (size_t i = 0; i < desc->dimensionsCount; ++i) {
                 if (desc->dimensions[i] < 0) {
@@ -154,7 +154,7 @@ namespace webnn::native::ie {
             switch (activation->GetFusionType()) {
                 // Currently we implement Relu6 operator by Clamp.
                 case FusionType::Clamp: {
-                    auto clamp = reinterpret_cast<const op::FusionClamp*>(activation);
+                    auto clamp = static_cast<const op::FusionClamp*>(activation);
                     status = ngraph_clamp(inputNode, clamp->GetMinValue(), clamp->GetMaxValue(),
                                           activationNode);
                     break;
@@ -166,7 +166,7 @@ namespace webnn::native::ie {
                     status = ngraph_sigmoid(inputNode, activationNode);
                     break;
                 case FusionType::LeakyRelu: {
-                    auto leakyRelu = reinterpret_cast<const op::FusionLeakyRelu*>(activation);
+                    auto leakyRelu = static_cast<const op::FusionLeakyRelu*>(activation);
                     const ngraph_node_t* constantNode = AddConstantWithGraph<float>(
                         precision_e::FP32, {1}, {leakyRelu->GetAlpha()});
                     status = ngraph_leaky_relu(inputNode, constantNode, activationNode);
@@ -615,6 +615,12 @@ namespace webnn::native::ie {
         return {};
     }
 
+    bool Graph::SupportsFusedActivation(const op::Conv2d* conv2d, FusionType type) const {
+        return type == FusionType::Clamp || type == FusionType::Relu ||
+               type == FusionType::Sigmoid || type == FusionType::LeakyRelu ||
+               type == FusionType::HardSwish;
+    }
+
     MaybeError Graph::AddConv2d(const op::Conv2d* conv2d) {
         IEStatusCode status;
         auto options = conv2d->GetOptions();
@@ -973,7 +979,7 @@ namespace webnn::native::ie {
             windowDimensions.push_back(options->windowDimensions[1]);
         }
         if (options->dilations[0] != 1 || options->dilations[1] != 1) {
-            return DAWN_INTERNAL_ERROR("The dilations of pool2d are not supported.");
+            return DAWN_UNIMPLEMENTED_ERROR("The dilations of pool2d are not supported.");
         }
         ngraph_node_t* poolNode = nullptr;
         IEStatusCode status = IEStatusCode::OK;
@@ -1313,6 +1319,14 @@ namespace webnn::native::ie {
         wnn::DevicePreference devicePreference = GetContext()->GetContextOptions().devicePreference;
         const char* deviceName = devicePreference == wnn::DevicePreference::Gpu ? "GPU" : "CPU";
 
+        const std::string& cacheDirectory = GetContext()->GetCacheDirectory();
+        if (!cacheDirectory.empty()) {
+            // Inference Engine exports the compiled network to the cache directory and imports
+            // it instead of compiling when it sees the same network again.
+            ie_config_t cacheConfig = {"CACHE_DIR", cacheDirectory.c_str(), NULL};
+            IEStatusCode status = ie_core_set_config(mInferEngineCore, &cacheConfig, deviceName);
+            DAWN_TRY(CheckStatusCode(status, "IE set cache directory"));
+        }
         ie_config_t config = {NULL, NULL, NULL};
         ie_executable_network_t* executableNetwork;
         IEStatusCode status = ie_core_load_network(mInferEngineCore, mInferEngineNetwork,
@@ -77,6 +77,8 @@ namespace webnn::native::ie {
         virtual MaybeError AddGemm(const op::Gemm* Gemm) override;
         virtual MaybeError AddInstanceNorm(const op::InstanceNorm* InstanceNorm) override;
         virtual MaybeError Finish() override;
+        virtual bool SupportsFusedActivation(const op::Conv2d* conv2d,
+                                             FusionType type) const override;
 
       private:
         MaybeError CompileImpl() override;
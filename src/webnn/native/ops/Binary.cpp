@@ -15,6 +15,7 @@
 #include "webnn/native/ops/Binary.h"
 
 #include "webnn/native/Error.h"
+#include "webnn/native/Utils.h"
 
 namespace webnn::native::op {
 
@@ -28,16 +29,21 @@ namespace webnn::native::op {
         newShape.resize(rankOutput);
         DAWN_ASSERT(rankA >= skipAxes && rankB >= skipAxes);
         // For each dimension of the output tensor, its size is the maximum size along that
-        // dimension of the input tensors.
+        // dimension of the input tensors. A dynamic dimension broadcast with a size other than 1
+        // must be that size.
         for (size_t i = 0; i < rankOutput; ++i) {
             // Skip some axes from the right side when broadcasting.
             if (i >= skipAxes) {
                 auto dimA = i < rankA ? shapeA[rankA - i - 1] : 1;
                 auto dimB = i < rankB ? shapeB[rankB - i - 1] : 1;
-                if (dimA != dimB && dimA != 1 && dimB != 1) {
+                if (!utils::DimensionsMatch(dimA, dimB) && dimA != 1 && dimB != 1) {
                     return DAWN_VALIDATION_ERROR("Shapes are incompatible, broadcasting failed.");
                 }
-                newShape[rankOutput - i - 1] = dimA > dimB ? dimA : dimB;
+                if (dimA == 1 || dimA == utils::kDynamicDimension) {
+                    newShape[rankOutput - i - 1] = dimB == 1 ? dimA : dimB;
+                } else {
+                    newShape[rankOutput - i - 1] = dimA;
+                }
             }
         }
         return {};
@@ -48,26 +54,26 @@ namespace webnn::native::op {
         auto rankA = inputShapeA.size(), rankB = inputShapeB.size();
         std::vector<int32_t> outputShape;
         if (rankA == 1 && rankB == 1) {
-            if (inputShapeA != inputShapeB) {
+            if (!utils::DimensionsMatch(inputShapeA[0], inputShapeB[0])) {
                 return DAWN_VALIDATION_ERROR(
                     "The two 1D inputs of Matmul should have the same shape.");
             }
             outputShape = {1};
         }
         if (rankA == 2 && rankB == 1) {
-            if (inputShapeA[1] != inputShapeB[0]) {
+            if (!utils::DimensionsMatch(inputShapeA[1], inputShapeB[0])) {
                 return DAWN_VALIDATION_ERROR("The input shapes are incompatible.");
             }
             outputShape = {inputShapeA[0], 1};
         }
         if (rankA == 1 && rankB == 2) {
-            if (inputShapeA[0] != inputShapeB[0]) {
+            if (!utils::DimensionsMatch(inputShapeA[0], inputShapeB[0])) {
                 return DAWN_VALIDATION_ERROR("The input shapes are incompatible.");
             }
             outputShape = {1, inputShapeB[1]};
         }
         if (rankA >= 2 && rankB >= 2) {
-            if (inputShapeA[rankA - 1] != inputShapeB[rankB - 2]) {
+            if (!utils::DimensionsMatch(inputShapeA[rankA - 1], inputShapeB[rankB - 2])) {
                 return DAWN_VALIDATION_ERROR("The input shapes are incompatible.");
             }
             auto maybeError = BroadcastShape(inputShapeA, inputShapeB, outputShape, 2);
@@ -92,6 +98,13 @@ namespace webnn::native::op {
         return {};
     }
 
+    size_t Binary::GetLayoutInputCount() const {
+        // Broadcasting aligns the trailing dimensions, so only the element-wise operators on
+        // inputs of the same 4-D shape are independent of the layout.
+        const std::vector<int32_t>& shape = mInputs[0]->Shape();
+        return mOpType != kMatMul && shape.size() == 4 && mInputs[1]->Shape() == shape ? 2 : 0;
+    }
+
     MaybeError Binary::ValidateAndInferOutputInfo() {
         MaybeError maybeError = OperatorBase::ValidateAndInferOutputInfo();
         if (maybeError.IsError()) {
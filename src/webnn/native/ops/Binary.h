@@ -46,6 +46,10 @@ namespace webnn::native::op {
         }
 
         MaybeError ValidateAndInferOutputInfo() override;
+        bool SupportsDynamicDimensions() const override {
+            return true;
+        }
+        size_t GetLayoutInputCount() const override;
 
       private:
         MaybeError CaculateMatMulShape();
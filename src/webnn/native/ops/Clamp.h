@@ -54,6 +54,11 @@ namespace webnn::native::op {
             return graph->AddClamp(this);
         }
 
+        Ref<FusionOperatorBase> CreateFusionOperator(GraphBuilderBase* builder) const override;
+        size_t GetLayoutInputCount() const override {
+            return mInputs[0]->Shape().size() == 4 ? 1 : 0;
+        }
+
         MaybeError ValidateAndInferOutputInfo() override {
             MaybeError maybeError = OperatorBase::ValidateAndInferOutputInfo();
             if (maybeError.IsError()) {
@@ -65,6 +70,9 @@ namespace webnn::native::op {
 
             return {};
         }
+        bool SupportsDynamicDimensions() const override {
+            return true;
+        }
     };
 
     class FusionClamp final : public ClampBase, public FusionOperatorBase {
@@ -74,6 +82,13 @@ namespace webnn::native::op {
         }
     };
 
+    inline Ref<FusionOperatorBase> Clamp::CreateFusionOperator(GraphBuilderBase* builder) const {
+        ClampOptions options;
+        options.minValue = GetMinValue();
+        options.maxValue = GetMaxValue();
+        return AcquireRef(new FusionClamp(builder, &options));
+    }
+
 }  // namespace webnn::native::op
 
 #endif  // WEBNN_NATIVE_OPS_CLAMP_H_
@@ -15,20 +15,44 @@
 #include "webnn/native/ops/Concat.h"
 
 #include "webnn/native/Error.h"
+#include "webnn/native/Utils.h"
 
 namespace webnn::native::op {
     MaybeError Concat::CalculateShape() {
         auto outputShape = mInputs[0]->Shape();
         // The size of the dimension along axis is computed as the sum of all the input sizes of
-        // the same dimension.
+        // the same dimension, it is dynamic if one of them is. The other dimensions are only
+        // dynamic if they are in all the inputs.
         outputShape[mAxis] = 0;
         for (auto& input : mInputs) {
-            outputShape[mAxis] += input->Shape()[mAxis];
+            const std::vector<int32_t>& shape = input->Shape();
+            for (size_t i = 0; i < shape.size(); ++i) {
+                if (i == mAxis) {
+                    if (outputShape[i] != utils::kDynamicDimension) {
+                        outputShape[i] = shape[i] == utils::kDynamicDimension
+                                             ? utils::kDynamicDimension
+                                             : outputShape[i] + shape[i];
+                    }
+                } else if (outputShape[i] == utils::kDynamicDimension) {
+                    outputShape[i] = shape[i];
+                }
+            }
         }
         mOutputs[0]->SetShape(std::move(outputShape));
         return {};
     }
 
+    size_t Concat::GetLayoutInputCount() const {
+        return mOutputs[0]->Shape().size() == 4 ? mInputs.size() : 0;
+    }
+
+    void Concat::SwitchLayout(wnn::InputOperandLayout layout) {
+        // Maps the axis of the dimension in the other layout to its axis in |layout|.
+        const uint32_t nhwcToNchw[] = {0, 2, 3, 1};
+        const uint32_t nchwToNhwc[] = {0, 3, 1, 2};
+        mAxis = layout == wnn::InputOperandLayout::Nchw ? nhwcToNchw[mAxis] : nchwToNhwc[mAxis];
+    }
+
     MaybeError Concat::ValidateAndInferOutputInfo() {
         MaybeError maybeError = OperatorBase::ValidateAndInferOutputInfo();
         if (maybeError.IsError()) {
@@ -53,7 +77,7 @@ namespace webnn::native::op {
             }
 
             for (size_t i = 0; i < inputShape.size(); ++i) {
-                if (uint32_t(i) != mAxis && shape[i] != inputShape[i]) {
+                if (uint32_t(i) != mAxis && !utils::DimensionsMatch(shape[i], inputShape[i])) {
                     return DAWN_VALIDATION_ERROR(
                         "Argument inputs must have same shape except for the size of the dimension "
                         "to "
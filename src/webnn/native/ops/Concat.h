@@ -36,6 +36,11 @@ namespace webnn::native::op {
             return mAxis;
         }
         MaybeError ValidateAndInferOutputInfo() override;
+        bool SupportsDynamicDimensions() const override {
+            return true;
+        }
+        size_t GetLayoutInputCount() const override;
+        void SwitchLayout(wnn::InputOperandLayout layout) override;
 
       private:
         MaybeError CalculateShape();
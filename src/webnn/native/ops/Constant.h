@@ -17,7 +17,9 @@
 
 #include "common/Assert.h"
 #include "webnn/native/Graph.h"
+#include "webnn/native/MappedFile.h"
 #include "webnn/native/Operand.h"
+#include "webnn/native/Utils.h"
 
 namespace webnn::native::op {
 
@@ -45,6 +47,43 @@ namespace webnn::native::op {
             mByteLength = arrayBuffer->byteLength;
         }
 
+        // Points into |file| instead of copying, the constant keeps the mapping alive.
+        Constant(GraphBuilderBase* builder,
+                 const OperandDescriptor* desc,
+                 Ref<MappedFile> file,
+                 size_t byteOffset,
+                 size_t byteLength)
+            : OperatorBase(builder),
+              mBuffer(nullptr),
+              mByteLength(byteLength),
+              mMappedFile(std::move(file)) {
+            if (desc == nullptr) {
+                return;
+            }
+            mDimensions.assign(desc->dimensions, desc->dimensions + desc->dimensionsCount);
+            mDescriptor.dimensions = mDimensions.data();
+            mDescriptor.dimensionsCount = mDimensions.size();
+            mDescriptor.type = desc->type;
+            if (byteOffset <= mMappedFile->GetByteLength() &&
+                byteLength <= mMappedFile->GetByteLength() - byteOffset) {
+                mBuffer = const_cast<int8_t*>(
+                    static_cast<const int8_t*>(mMappedFile->GetData()) + byteOffset);
+            }
+        }
+
+        // Owns |data|, used for the values computed by constant folding.
+        Constant(GraphBuilderBase* builder,
+                 const OperandDescriptor* desc,
+                 std::vector<char> data)
+            : OperatorBase(builder), mBuffer(nullptr), mOwnedData(std::move(data)) {
+            mDimensions.assign(desc->dimensions, desc->dimensions + desc->dimensionsCount);
+            mDescriptor.dimensions = mDimensions.data();
+            mDescriptor.dimensionsCount = mDimensions.size();
+            mDescriptor.type = desc->type;
+            mBuffer = mOwnedData.data();
+            mByteLength = mOwnedData.size();
+        }
+
 #if defined(WEBNN_ENABLE_GPU_BUFFER)
         Constant(GraphBuilderBase* builder,
                  const OperandDescriptor* desc,
@@ -70,7 +109,7 @@ namespace webnn::native::op {
             if (mWGPUBuffer)
                 wgpuBufferReference(mWGPUBuffer);
 #    else
-            if (mBuffer)
+            if (mBuffer && mMappedFile == nullptr && mOwnedData.empty())
                 free(mBuffer);
 #    endif
 #endif
@@ -81,6 +120,18 @@ namespace webnn::native::op {
         }
 
         MaybeError ValidateAndInferOutputInfo() override {
+            if (mMappedFile != nullptr) {
+                DAWN_INVALID_IF(mBuffer == nullptr || mByteLength == 0,
+                                "The byte range is outside of the constant file.");
+                // The mapping is used in place, a shorter range would be read past its end.
+                size_t byteLength = utils::OperandTypeByteSize(mDescriptor.type);
+                for (int32_t dimension : mDimensions) {
+                    DAWN_INVALID_IF(dimension <= 0, "The constant dimensions must be positive.");
+                    byteLength *= dimension;
+                }
+                DAWN_INVALID_IF(byteLength != mByteLength,
+                                "The byte length of the constant doesn't match its dimensions.");
+            }
             // if (mBuffer == nullptr || mByteLength == 0) {
             //     return DAWN_VALIDATION_ERROR("Constant array buffer is invalid.");
             // }
@@ -111,6 +162,12 @@ namespace webnn::native::op {
             return mByteOffset;
         }
 
+        // The file backing a constant created with ConstantFromFile, or null. Backends can
+        // keep a reference to it and use GetBuffer() directly instead of copying the data.
+        MappedFile* GetMappedFile() const {
+            return mMappedFile.Get();
+        }
+
       private:
         OperandDescriptor mDescriptor;
         std::vector<int32_t> mDimensions;
@@ -120,6 +177,8 @@ namespace webnn::native::op {
 #endif
         size_t mByteLength;
         size_t mByteOffset;
+        Ref<MappedFile> mMappedFile;
+        std::vector<char> mOwnedData;
     };
 
 }  // namespace webnn::native::op
@@ -31,6 +31,10 @@ namespace webnn::native::op {
         return graph->AddConv2d(this);
     }
 
+    bool Conv2d::CanFuseActivation(const GraphBase* graph, FusionType type) const {
+        return mOptions.activation == nullptr && graph->SupportsFusedActivation(this, type);
+    }
+
     Conv2dOptions const* Conv2d::GetOptions() const {
         return &mOptions;
     }
@@ -97,14 +101,24 @@ namespace webnn::native::op {
             default:
                 return DAWN_VALIDATION_ERROR("The filter layout is unsupported");
         }
-        MaybeError maybeError = ValidateGroup(filterDepthIn, inputChannels);
-        if (maybeError.IsError()) {
-            return maybeError;
+        // The dynamic dimensions are validated once they are given.
+        if (inputChannels != utils::kDynamicDimension &&
+            filterDepthIn != utils::kDynamicDimension) {
+            MaybeError maybeError = ValidateGroup(filterDepthIn, inputChannels);
+            if (maybeError.IsError()) {
+                return maybeError;
+            }
         }
 
         int32_t outputHeight, outputWidth;
         calculateOutputSize(inputHeight, inputWidth, filterHeight, filterWidth, outputHeight,
                             outputWidth);
+        if (inputHeight == utils::kDynamicDimension || filterHeight == utils::kDynamicDimension) {
+            outputHeight = utils::kDynamicDimension;
+        }
+        if (inputWidth == utils::kDynamicDimension || filterWidth == utils::kDynamicDimension) {
+            outputWidth = utils::kDynamicDimension;
+        }
         std::vector<int32_t> outputShape;
         if (nchw) {
             outputShape = {batchSize, outputChannels, outputHeight, outputWidth};
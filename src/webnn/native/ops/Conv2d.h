@@ -68,6 +68,33 @@ namespace webnn::native::op {
         }
         ~Conv2dBase() override = default;
 
+        void SetFusedActivation(FusionOperatorBase* activation) override {
+            mActivation = activation;
+            mOptions.activation = activation;
+        }
+
+        // Used by the graph optimization passes like SetInput, a null |bias| removes the bias.
+        void SetBias(OperandBase* bias) {
+            if (mOptions.bias != nullptr) {
+                mInputs.pop_back();
+            }
+            mOptions.bias = bias;
+            if (bias != nullptr) {
+                mInputs.push_back(bias);
+            }
+        }
+
+        size_t GetLayoutInputCount() const override {
+            return 1;
+        }
+        bool GetLayout(wnn::InputOperandLayout* layout) const override {
+            *layout = mOptions.inputLayout;
+            return true;
+        }
+        void SwitchLayout(wnn::InputOperandLayout layout) override {
+            mOptions.inputLayout = layout;
+        }
+
       protected:
         MaybeError ValidateBase() {
             MaybeError maybeError = OperatorBase::ValidateAndInferOutputInfo();
@@ -135,8 +162,16 @@ namespace webnn::native::op {
         ~Conv2d() override = default;
 
         MaybeError AddToGraph(GraphBase* graph) const override;
+        bool CanFuseActivation(const GraphBase* graph, FusionType type) const override;
+        // Used by the layout propagation pass once the filter is transposed to |layout|.
+        void SetFilterLayout(wnn::Conv2dFilterOperandLayout layout) {
+            mOptions.filterLayout = layout;
+        }
         Conv2dOptions const* GetOptions() const;
         MaybeError ValidateAndInferOutputInfo() override;
+        bool SupportsDynamicDimensions() const override {
+            return true;
+        }
         void calculateOutputSize(int32_t inputHeight,
                                  int32_t inputWidth,
                                  int32_t filterHeight,
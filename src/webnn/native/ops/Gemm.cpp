@@ -17,6 +17,7 @@
 #include <algorithm>
 
 #include "webnn/native/Error.h"
+#include "webnn/native/Utils.h"
 
 namespace webnn::native::op {
     Gemm::Gemm(GraphBuilderBase* builder,
@@ -39,8 +40,9 @@ namespace webnn::native::op {
         // or [N, K] if bTranspose is true.
         auto inputAShape = mInputs[0]->Shape();
         auto inputBShape = mInputs[1]->Shape();
-        bool matMulSupported = (mOptions.aTranspose ? inputAShape[0] : inputAShape[1]) ==
-                               (mOptions.bTranspose ? inputBShape[1] : inputBShape[0]);
+        bool matMulSupported =
+            utils::DimensionsMatch(mOptions.aTranspose ? inputAShape[0] : inputAShape[1],
+                                   mOptions.bTranspose ? inputBShape[1] : inputBShape[0]);
         if (!matMulSupported) {
             return DAWN_VALIDATION_ERROR(
                 "Matrix multiplication failed, K should be same in the two input tensors.");
@@ -59,7 +61,7 @@ namespace webnn::native::op {
 
             for (int32_t i = cShape.size() - 1, j = outputShape.size() - 1; i >= 0 && j >= 0;
                  --i, --j) {
-                if (cShape[i] != outputShape[j] && cShape[i] != 1) {
+                if (!utils::DimensionsMatch(cShape[i], outputShape[j]) && cShape[i] != 1) {
                     return DAWN_VALIDATION_ERROR(
                         "The specified third input is either a scalar, or of the shape that is "
                         "unidirectionally broadcastable.");
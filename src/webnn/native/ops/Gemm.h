@@ -29,6 +29,9 @@ namespace webnn::native::op {
             return graph->AddGemm(this);
         }
         MaybeError ValidateAndInferOutputInfo() override;
+        bool SupportsDynamicDimensions() const override {
+            return true;
+        }
 
         GemmOptions const* GetOptions() const {
             return &mOptions;
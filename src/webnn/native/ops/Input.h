@@ -17,9 +17,12 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
+#include "webnn/native/Error.h"
 #include "webnn/native/Graph.h"
 #include "webnn/native/Operand.h"
+#include "webnn/native/Utils.h"
 
 namespace webnn::native::op {
 
@@ -39,6 +42,11 @@ namespace webnn::native::op {
         }
 
         MaybeError ValidateAndInferOutputInfo() override {
+            for (int32_t dimension : mDimensions) {
+                if (dimension < 0 && dimension != utils::kDynamicDimension) {
+                    return DAWN_VALIDATION_ERROR("Argument dimensions are invalid.");
+                }
+            }
             mOutputs[0]->SetType(mDescriptor.type);
             mOutputs[0]->SetShape(mDimensions);
             return {};
@@ -52,6 +60,14 @@ namespace webnn::native::op {
             return &mDescriptor;
         }
 
+        // Gives dynamic dimensions the values they have at compute, the output is inferred again
+        // by the caller.
+        void SetDimensions(std::vector<int32_t> dimensions) {
+            mDimensions = std::move(dimensions);
+            mDescriptor.dimensions = mDimensions.data();
+            mDescriptor.dimensionsCount = mDimensions.size();
+        }
+
       private:
         std::string mName;
         OperandDescriptor mDescriptor;
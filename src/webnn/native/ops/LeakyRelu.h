@@ -41,6 +41,12 @@ namespace webnn::native::op {
             : LeakyReluBase(options), Unary(builder, kLeakyRelu, input) {
         }
         ~LeakyRelu() override = default;
+
+        Ref<FusionOperatorBase> CreateFusionOperator(GraphBuilderBase* builder) const override {
+            LeakyReluOptions options;
+            options.alpha = GetAlpha();
+            return AcquireRef(new FusionLeakyRelu(builder, &options));
+        }
     };
 
     class FusionLeakyRelu final : public LeakyReluBase, public FusionOperatorBase {
@@ -74,6 +74,19 @@ namespace webnn::native::op {
         return graph->AddPool2d(this);
     }
 
+    size_t Pool2d::GetLayoutInputCount() const {
+        return 1;
+    }
+
+    bool Pool2d::GetLayout(wnn::InputOperandLayout* layout) const {
+        *layout = mOptions.layout;
+        return true;
+    }
+
+    void Pool2d::SwitchLayout(wnn::InputOperandLayout layout) {
+        mOptions.layout = layout;
+    }
+
     Pool2dOptions const* Pool2d::GetOptions() const {
         return &mOptions;
     }
@@ -121,11 +134,28 @@ namespace webnn::native::op {
         int32_t ceilOutputWidth =
             ceil(1 + 1.0 * (inputWidth - windowWidth + paddingBeginningWidth + paddingEndingWidth) /
                          mStride[1]);
+        // The output sizes along a dynamic dimension are dynamic, except for a global pooling
+        // with explicit padding. They are validated once the dimension is given.
+        bool dynamicHeight = inputHeight == utils::kDynamicDimension &&
+                             (mOptions.windowDimensions != nullptr ||
+                              mOptions.autoPad != wnn::AutoPad::Explicit);
+        bool dynamicWidth = inputWidth == utils::kDynamicDimension &&
+                            (mOptions.windowDimensions != nullptr ||
+                             mOptions.autoPad != wnn::AutoPad::Explicit);
+        if (dynamicHeight) {
+            floorOutputHeight = ceilOutputHeight = utils::kDynamicDimension;
+        }
+        if (dynamicWidth) {
+            floorOutputWidth = ceilOutputWidth = utils::kDynamicDimension;
+        }
         if (mOptions.outputSizes == nullptr) {
             outputHeight = mOptions.roundingType == wnn::RoundingType::Floor ? floorOutputHeight
                                                                              : ceilOutputHeight;
             outputWidth = mOptions.roundingType == wnn::RoundingType::Floor ? floorOutputWidth
                                                                             : ceilOutputWidth;
+        } else if (dynamicHeight || dynamicWidth) {
+            outputHeight = mOptions.outputSizes[0];
+            outputWidth = mOptions.outputSizes[1];
         } else {
             outputHeight = mOptions.outputSizes[0];
             outputWidth = mOptions.outputSizes[1];
@@ -36,6 +36,12 @@ namespace webnn::native::op {
 
         MaybeError AddToGraph(GraphBase* graph) const override;
         MaybeError ValidateAndInferOutputInfo() override;
+        bool SupportsDynamicDimensions() const override {
+            return true;
+        }
+        size_t GetLayoutInputCount() const override;
+        bool GetLayout(wnn::InputOperandLayout* layout) const override;
+        void SwitchLayout(wnn::InputOperandLayout layout) override;
 
         Pool2dOptions const* GetOptions() const;
         Pool2dType GetType() const;
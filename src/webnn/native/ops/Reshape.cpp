@@ -15,14 +15,20 @@
 #include "webnn/native/ops/Reshape.h"
 
 #include "webnn/native/Error.h"
+#include "webnn/native/Utils.h"
 
 namespace webnn::native::op {
 
     MaybeError Reshape::CalculateShape() {
         auto inputShape = mInputs[0]->Shape();
         uint32_t inputSize = 1, capacity = 1;
+        bool dynamic = false;
         for (auto dim : inputShape) {
-            inputSize *= dim;
+            if (dim == utils::kDynamicDimension) {
+                dynamic = true;
+            } else {
+                inputSize *= dim;
+            }
         }
         int minus1DimIdx = -1;
         bool hasMinus1 = false;
@@ -43,10 +49,14 @@ namespace webnn::native::op {
         }
 
         // The size of the dimension with the value -1 is computed so that the total size remains
-        // constant.
+        // constant. It is dynamic if the size of the input is, and the sizes are validated once
+        // it is given.
         if (hasMinus1) {
-            outputShape[minus1DimIdx] = inputSize / capacity;
-        } else {
+            if (!dynamic && inputSize % capacity != 0) {
+                return DAWN_VALIDATION_ERROR("Total size should be divisible by newShape.");
+            }
+            outputShape[minus1DimIdx] = dynamic ? utils::kDynamicDimension : inputSize / capacity;
+        } else if (!dynamic) {
             // The number of elements implied by newShape must be the same as the number of elements
             // in the input tensor.
             if (inputSize != capacity) {
@@ -36,6 +36,9 @@ namespace webnn::native::op {
             return graph->AddReshape(this);
         }
         MaybeError ValidateAndInferOutputInfo() override;
+        bool SupportsDynamicDimensions() const override {
+            return true;
+        }
         std::vector<int32_t> GetNewShape() const {
             return mNewShape;
         }
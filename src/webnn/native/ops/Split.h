@@ -19,6 +19,7 @@
 
 #include "webnn/native/GraphBuilder.h"
 #include "webnn/native/Operand.h"
+#include "webnn/native/Utils.h"
 
 namespace webnn::native::op {
 
@@ -48,9 +49,13 @@ namespace webnn::native::op {
                 axis += inputShape.size();
             }
 
+            // A dynamic dimension is validated once it is given.
+            bool dynamic = inputShape[axis] == utils::kDynamicDimension;
             if (mSplits.size() == 1) {
                 outputSize = mSplits[0];
-                outputShape[axis] /= outputSize;
+                if (!dynamic) {
+                    outputShape[axis] /= outputSize;
+                }
             } else {
                 outputSize = mSplits.size();
             }
@@ -66,7 +71,7 @@ namespace webnn::native::op {
 
             // The number of output must evenly divide the dimension size of input along
             // options.axis.
-            if (dimSumAlongAxis != inputShape[axis]) {
+            if (!dynamic && dimSumAlongAxis != inputShape[axis]) {
                 return DAWN_VALIDATION_ERROR(
                     "The sum of sizes must equal to the dimension size of input along "
                     "options.axis.");
@@ -91,6 +96,9 @@ namespace webnn::native::op {
 
             return CalculateShape();
         }
+        bool SupportsDynamicDimensions() const override {
+            return true;
+        }
 
         std::vector<uint32_t> GetSplits() const {
             return mSplits;
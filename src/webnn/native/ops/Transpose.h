@@ -42,6 +42,9 @@ namespace webnn::native::op {
             return graph->AddTranspose(this);
         }
         MaybeError ValidateAndInferOutputInfo() override;
+        bool SupportsDynamicDimensions() const override {
+            return true;
+        }
 
         std::vector<int32_t> GetPermutation() const {
             return mPermutation;
@@ -18,6 +18,26 @@
 
 namespace webnn::native::op {
 
+    Ref<FusionOperatorBase> Unary::CreateFusionOperator(GraphBuilderBase* builder) const {
+        switch (mOpType) {
+            case kHardSwish:
+                return AcquireRef(new FusionUnary(builder, FusionType::HardSwish));
+            case kRelu:
+                return AcquireRef(new FusionUnary(builder, FusionType::Relu));
+            case kSigmoid:
+                return AcquireRef(new FusionUnary(builder, FusionType::Sigmoid));
+            case kTanh:
+                return AcquireRef(new FusionUnary(builder, FusionType::Tanh));
+            default:
+                return nullptr;
+        }
+    }
+
+    size_t Unary::GetLayoutInputCount() const {
+        // Softmax is on 2-D inputs only, the other unary operators are element-wise.
+        return mInputs[0]->Shape().size() == 4 ? 1 : 0;
+    }
+
     MaybeError Unary::ValidateAndInferOutputInfo() {
         MaybeError maybeError = OperatorBase::ValidateAndInferOutputInfo();
         if (maybeError.IsError()) {
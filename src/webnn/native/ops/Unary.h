@@ -51,6 +51,11 @@ namespace webnn::native::op {
             return graph->AddUnary(this);
         }
         MaybeError ValidateAndInferOutputInfo() override;
+        bool SupportsDynamicDimensions() const override {
+            return true;
+        }
+        Ref<FusionOperatorBase> CreateFusionOperator(GraphBuilderBase* builder) const override;
+        size_t GetLayoutInputCount() const override;
         UnaryOpType GetType() const {
             return mOpType;
         }
@@ -0,0 +1,1828 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "webnn/native/reference/GraphReference.h"
+
+#include <math.h>
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+#include "common/Assert.h"
+#include "common/Log.h"
+#include "webnn/native/ErrorData.h"
+#include "webnn/native/NamedInputs.h"
+#include "webnn/native/NamedOutputs.h"
+#include "webnn/native/Profiler.h"
+#include "webnn/native/Utils.h"
+#include "webnn/native/ops/BatchNorm.h"
+#include "webnn/native/ops/Binary.h"
+#include "webnn/native/ops/Clamp.h"
+#include "webnn/native/ops/Concat.h"
+#include "webnn/native/ops/Constant.h"
+#include "webnn/native/ops/Conv2d.h"
+#include "webnn/native/ops/Gemm.h"
+#include "webnn/native/ops/Gru.h"
+#include "webnn/native/ops/Input.h"
+#include "webnn/native/ops/InstanceNorm.h"
+#include "webnn/native/ops/LeakyRelu.h"
+#include "webnn/native/ops/Pad.h"
+#include "webnn/native/ops/Pool2d.h"
+#include "webnn/native/ops/Reduce.h"
+#include "webnn/native/ops/Resample2d.h"
+#include "webnn/native/ops/Reshape.h"
+#include "webnn/native/ops/Slice.h"
+#include "webnn/native/ops/Split.h"
+#include "webnn/native/ops/Squeeze.h"
+#include "webnn/native/ops/Transpose.h"
+#include "webnn/native/ops/Unary.h"
+#include "webnn/native/reference/ThreadPool.h"
+
+namespace webnn::native::reference {
+
+    namespace {
+        // Below this amount of scalar work a kernel runs on the calling thread, waking the pool
+        // costs more than it saves.
+        constexpr size_t kMinParallelWork = 1 << 14;
+
+        size_t ShapeSize(const std::vector<int32_t>& shape, size_t begin, size_t end) {
+            size_t size = 1;
+            for (size_t i = begin; i < end; ++i) {
+                size *= shape[i];
+            }
+            return size;
+        }
+
+        std::vector<size_t> Strides(const std::vector<int32_t>& shape) {
+            std::vector<size_t> strides(shape.size());
+            size_t stride = 1;
+            for (size_t i = shape.size(); i-- > 0;) {
+                strides[i] = stride;
+                stride *= shape[i];
+            }
+            return strides;
+        }
+
+        // The strides of |shape| when it's broadcast to |outputShape|, broadcast dimensions get
+        // a stride of 0.
+        std::vector<size_t> BroadcastStrides(const std::vector<int32_t>& shape,
+                                             const std::vector<int32_t>& outputShape) {
+            std::vector<size_t> strides(outputShape.size(), 0);
+            std::vector<size_t> shapeStrides = Strides(shape);
+            size_t offset = outputShape.size() - shape.size();
+            for (size_t i = 0; i < shape.size(); ++i) {
+                strides[offset + i] = shape[i] == 1 ? 0 : shapeStrides[i];
+            }
+            return strides;
+        }
+
+        void ParallelFor(ThreadPool* pool,
+                         size_t count,
+                         size_t workPerItem,
+                         const ThreadPool::Task& task) {
+            bool worthIt = count * workPerItem >= kMinParallelWork;
+            ThreadPool::ParallelFor(worthIt ? pool : nullptr, count, task);
+        }
+
+        int32_t CeilDiv(int32_t a, int32_t b) {
+            return (a + b - 1) / b;
+        }
+
+        float Sigmoid(float x) {
+            return 1.0f / (1.0f + expf(-x));
+        }
+
+        float HardSwish(float x) {
+            return x * std::max(0.0f, std::min(6.0f, x + 3.0f)) / 6.0f;
+        }
+
+        float ActivationValue(const FusionOperatorBase* activation, float x) {
+            switch (activation->GetFusionType()) {
+                case FusionType::Clamp: {
+                    auto clamp = static_cast<const op::FusionClamp*>(activation);
+                    return std::min(std::max(x, clamp->GetMinValue()), clamp->GetMaxValue());
+                }
+                case FusionType::Relu:
+                    return std::max(x, 0.0f);
+                case FusionType::Sigmoid:
+                    return Sigmoid(x);
+                case FusionType::LeakyRelu: {
+                    auto leakyRelu = static_cast<const op::FusionLeakyRelu*>(activation);
+                    return x < 0 ? x * leakyRelu->GetAlpha() : x;
+                }
+                case FusionType::HardSwish:
+                    return HardSwish(x);
+                case FusionType::Tanh:
+                    return tanhf(x);
+                default:
+                    UNREACHABLE();
+            }
+        }
+
+        template <typename Fn>
+        void Map(ThreadPool* pool, const float* input, float* output, size_t count, Fn fn) {
+            ParallelFor(pool, count, 1, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    output[i] = fn(input[i]);
+                }
+            });
+        }
+
+        void ApplyActivation(ThreadPool* pool,
+                             const FusionOperatorBase* activation,
+                             float* data,
+                             size_t count) {
+            if (activation == nullptr) {
+                return;
+            }
+            switch (activation->GetFusionType()) {
+                case FusionType::Clamp: {
+                    auto clamp = static_cast<const op::FusionClamp*>(activation);
+                    float minValue = clamp->GetMinValue(), maxValue = clamp->GetMaxValue();
+                    Map(pool, data, data, count, [minValue, maxValue](float x) {
+                        return std::min(std::max(x, minValue), maxValue);
+                    });
+                    break;
+                }
+                case FusionType::Relu:
+                    Map(pool, data, data, count, [](float x) { return std::max(x, 0.0f); });
+                    break;
+                default:
+                    Map(pool, data, data, count,
+                        [activation](float x) { return ActivationValue(activation, x); });
+                    break;
+            }
+        }
+
+        // Copies |input| into |output| so that output dimension i is input dimension
+        // permutation[i]. T is a trivially copyable type of the element size.
+        template <typename T>
+        void TransposeImpl(ThreadPool* pool,
+                           const T* input,
+                           T* output,
+                           const std::vector<int32_t>& inputShape,
+                           const std::vector<int32_t>& permutation) {
+            size_t rank = inputShape.size();
+            if (rank == 0) {
+                output[0] = input[0];
+                return;
+            }
+            std::vector<size_t> inputStrides = Strides(inputShape);
+            std::vector<int32_t> outputShape(rank);
+            std::vector<size_t> strides(rank);
+            for (size_t i = 0; i < rank; ++i) {
+                outputShape[i] = inputShape[permutation[i]];
+                strides[i] = inputStrides[permutation[i]];
+            }
+            size_t inner = outputShape[rank - 1];
+            size_t innerStride = strides[rank - 1];
+            size_t outer = ShapeSize(outputShape, 0, rank - 1);
+            ParallelFor(pool, outer, inner, [&](size_t begin, size_t end) {
+                for (size_t o = begin; o < end; ++o) {
+                    size_t offset = 0, remaining = o;
+                    for (size_t d = rank - 1; d-- > 0;) {
+                        offset += (remaining % outputShape[d]) * strides[d];
+                        remaining /= outputShape[d];
+                    }
+                    const T* src = input + offset;
+                    T* dst = output + o * inner;
+                    for (size_t i = 0; i < inner; ++i) {
+                        dst[i] = src[i * innerStride];
+                    }
+                }
+            });
+        }
+
+        void TransposeData(ThreadPool* pool,
+                           const void* input,
+                           void* output,
+                           size_t elementSize,
+                           const std::vector<int32_t>& inputShape,
+                           const std::vector<int32_t>& permutation) {
+            switch (elementSize) {
+                case 4:
+                    TransposeImpl(pool, static_cast<const uint32_t*>(input),
+                                  static_cast<uint32_t*>(output), inputShape, permutation);
+                    break;
+                case 2:
+                    TransposeImpl(pool, static_cast<const uint16_t*>(input),
+                                  static_cast<uint16_t*>(output), inputShape, permutation);
+                    break;
+                case 1:
+                    TransposeImpl(pool, static_cast<const uint8_t*>(input),
+                                  static_cast<uint8_t*>(output), inputShape, permutation);
+                    break;
+                default:
+                    UNREACHABLE();
+            }
+        }
+
+        const std::vector<int32_t> kNhwcToNchw = {0, 3, 1, 2};
+        const std::vector<int32_t> kNchwToNhwc = {0, 2, 3, 1};
+
+        std::vector<int32_t> PermuteShape(const std::vector<int32_t>& shape,
+                                          const std::vector<int32_t>& permutation) {
+            std::vector<int32_t> permuted(shape.size());
+            for (size_t i = 0; i < shape.size(); ++i) {
+                permuted[i] = shape[permutation[i]];
+            }
+            return permuted;
+        }
+
+        // Element-wise binary with numpy style broadcasting. The innermost dimension is handled
+        // by a tight loop per broadcast case so that it vectorizes.
+        template <typename Fn>
+        void Broadcast(ThreadPool* pool, const Tensor* a, const Tensor* b, Tensor* output, Fn fn) {
+            const std::vector<int32_t>& outputShape = output->shape;
+            size_t rank = outputShape.size();
+            std::vector<size_t> aStrides = BroadcastStrides(a->shape, outputShape);
+            std::vector<size_t> bStrides = BroadcastStrides(b->shape, outputShape);
+            size_t inner = rank == 0 ? 1 : outputShape[rank - 1];
+            size_t aInner = rank == 0 ? 0 : aStrides[rank - 1];
+            size_t bInner = rank == 0 ? 0 : bStrides[rank - 1];
+            size_t outer = rank == 0 ? 1 : ShapeSize(outputShape, 0, rank - 1);
+            const float* aData = a->Float();
+            const float* bData = b->Float();
+            float* outputData = output->Float();
+            ParallelFor(pool, outer, inner, [&](size_t begin, size_t end) {
+                for (size_t o = begin; o < end; ++o) {
+                    size_t aOffset = 0, bOffset = 0, remaining = o;
+                    for (size_t d = rank == 0 ? 0 : rank - 1; d-- > 0;) {
+                        size_t index = remaining % outputShape[d];
+                        remaining /= outputShape[d];
+                        aOffset += index * aStrides[d];
+                        bOffset += index * bStrides[d];
+                    }
+                    const float* pa = aData + aOffset;
+                    const float* pb = bData + bOffset;
+                    float* dst = outputData + o * inner;
+                    if (aInner != 0 && bInner != 0) {
+                        for (size_t i = 0; i < inner; ++i) {
+                            dst[i] = fn(pa[i], pb[i]);
+                        }
+                    } else if (aInner != 0) {
+                        const float vb = pb[0];
+                        for (size_t i = 0; i < inner; ++i) {
+                            dst[i] = fn(pa[i], vb);
+                        }
+                    } else if (bInner != 0) {
+                        const float va = pa[0];
+                        for (size_t i = 0; i < inner; ++i) {
+                            dst[i] = fn(va, pb[i]);
+                        }
+                    } else {
+                        std::fill(dst, dst + inner, fn(pa[0], pb[0]));
+                    }
+                }
+            });
+        }
+
+        // output[M, N] = a[M, K] * b[K, N], all row major.
+        void MatMulRows(const float* a,
+                        const float* b,
+                        float* output,
+                        size_t rowBegin,
+                        size_t rowEnd,
+                        size_t n,
+                        size_t k) {
+            for (size_t i = rowBegin; i < rowEnd; ++i) {
+                float* dst = output + i * n;
+                std::fill(dst, dst + n, 0.0f);
+                const float* aRow = a + i * k;
+                for (size_t l = 0; l < k; ++l) {
+                    const float av = aRow[l];
+                    const float* bRow = b + l * n;
+                    for (size_t j = 0; j < n; ++j) {
+                        dst[j] += av * bRow[j];
+                    }
+                }
+            }
+        }
+
+        float Dot(const float* a, const float* b, size_t count) {
+            float sum = 0;
+            for (size_t i = 0; i < count; ++i) {
+                sum += a[i] * b[i];
+            }
+            return sum;
+        }
+
+        struct Conv2dParams {
+            int32_t batchSize;
+            int32_t inputChannels;
+            int32_t inputHeight;
+            int32_t inputWidth;
+            int32_t outputChannels;
+            int32_t outputHeight;
+            int32_t outputWidth;
+            int32_t filterHeight;
+            int32_t filterWidth;
+            int32_t groups;
+            int32_t strideHeight;
+            int32_t strideWidth;
+            int32_t dilationHeight;
+            int32_t dilationWidth;
+            int32_t padTop;
+            int32_t padLeft;
+        };
+
+        // NCHW input, OIHW filter, NCHW output. Every (batch, output channel) plane is computed
+        // independently, each filter tap is applied to a whole output row whose valid column
+        // range is computed up front so the inner loop has no bounds checks.
+        void Conv2dNchw(ThreadPool* pool,
+                        const Conv2dParams& p,
+                        const float* input,
+                        const float* filter,
+                        const float* bias,
+                        float* output) {
+            const int32_t inputChannelsPerGroup = p.inputChannels / p.groups;
+            const int32_t outputChannelsPerGroup = p.outputChannels / p.groups;
+            const size_t inputPlane = size_t(p.inputHeight) * p.inputWidth;
+            const size_t outputPlane = size_t(p.outputHeight) * p.outputWidth;
+            const size_t work = outputPlane * inputChannelsPerGroup * p.filterHeight * p.filterWidth;
+            ParallelFor(
+                pool, size_t(p.batchSize) * p.outputChannels, work, [&](size_t begin, size_t end) {
+                    for (size_t index = begin; index < end; ++index) {
+                        const int32_t n = index / p.outputChannels;
+                        const int32_t oc = index % p.outputChannels;
+                        const int32_t g = oc / outputChannelsPerGroup;
+                        float* out = output + index * outputPlane;
+                        std::fill(out, out + outputPlane, bias != nullptr ? bias[oc] : 0.0f);
+                        for (int32_t icg = 0; icg < inputChannelsPerGroup; ++icg) {
+                            const int32_t ic = g * inputChannelsPerGroup + icg;
+                            const float* in = input + (size_t(n) * p.inputChannels + ic) * inputPlane;
+                            const float* w = filter + (size_t(oc) * inputChannelsPerGroup + icg) *
+                                                          p.filterHeight * p.filterWidth;
+                            for (int32_t kh = 0; kh < p.filterHeight; ++kh) {
+                                for (int32_t kw = 0; kw < p.filterWidth; ++kw) {
+                                    const float weight = w[kh * p.filterWidth + kw];
+                                    const int32_t offsetW = kw * p.dilationWidth - p.padLeft;
+                                    const int32_t owBegin =
+                                        offsetW >= 0 ? 0 : CeilDiv(-offsetW, p.strideWidth);
+                                    const int32_t owEnd =
+                                        offsetW > p.inputWidth - 1
+                                            ? 0
+                                            : std::min(p.outputWidth,
+                                                       (p.inputWidth - 1 - offsetW) /
+                                                               p.strideWidth +
+                                                           1);
+                                    for (int32_t oh = 0; oh < p.outputHeight; ++oh) {
+                                        const int32_t ih =
+                                            oh * p.strideHeight + kh * p.dilationHeight - p.padTop;
+                                        if (ih < 0 || ih >= p.inputHeight) {
+                                            continue;
+                                        }
+                                        const float* inRow = in + size_t(ih) * p.inputWidth;
+                                        float* outRow = out + size_t(oh) * p.outputWidth;
+                                        for (int32_t ow = owBegin; ow < owEnd; ++ow) {
+                                            outRow[ow] += weight * inRow[ow * p.strideWidth + offsetW];
+                                        }
+                                    }
+                                }
+                            }
+                        }
+                    }
+                });
+        }
+
+        // NCHW input, [I/groups, O, H, W] filter, NCHW output. Scatters every input pixel into
+        // the output plane of a single output channel so that planes can run in parallel.
+        void ConvTranspose2dNchw(ThreadPool* pool,
+                                 const Conv2dParams& p,
+                                 const float* input,
+                                 const float* filter,
+                                 const float* bias,
+                                 float* output) {
+            const int32_t inputChannelsPerGroup = p.inputChannels / p.groups;
+            const int32_t outputChannelsPerGroup = p.outputChannels / p.groups;
+            const size_t inputPlane = size_t(p.inputHeight) * p.inputWidth;
+            const size_t outputPlane = size_t(p.outputHeight) * p.outputWidth;
+            const size_t work = inputPlane * inputChannelsPerGroup * p.filterHeight * p.filterWidth;
+            ParallelFor(
+                pool, size_t(p.batchSize) * p.outputChannels, work, [&](size_t begin, size_t end) {
+                    for (size_t index = begin; index < end; ++index) {
+                        const int32_t n = index / p.outputChannels;
+                        const int32_t oc = index % p.outputChannels;
+                        const int32_t g = oc / outputChannelsPerGroup;
+                        float* out = output + index * outputPlane;
+                        std::fill(out, out + outputPlane, bias != nullptr ? bias[oc] : 0.0f);
+                        for (int32_t icg = 0; icg < inputChannelsPerGroup; ++icg) {
+                            const int32_t ic = g * inputChannelsPerGroup + icg;
+                            const float* in = input + (size_t(n) * p.inputChannels + ic) * inputPlane;
+                            const float* w = filter + (size_t(icg) * p.outputChannels + oc) *
+                                                          p.filterHeight * p.filterWidth;
+                            for (int32_t kh = 0; kh < p.filterHeight; ++kh) {
+                                for (int32_t kw = 0; kw < p.filterWidth; ++kw) {
+                                    const float weight = w[kh * p.filterWidth + kw];
+                                    const int32_t offsetW = kw * p.dilationWidth - p.padLeft;
+                                    const int32_t iwBegin =
+                                        offsetW >= 0 ? 0 : CeilDiv(-offsetW, p.strideWidth);
+                                    const int32_t iwEnd =
+                                        offsetW > p.outputWidth - 1
+                                            ? 0
+                                            : std::min(p.inputWidth,
+                                                       (p.outputWidth - 1 - offsetW) /
+                                                               p.strideWidth +
+                                                           1);
+                                    for (int32_t ih = 0; ih < p.inputHeight; ++ih) {
+                                        const int32_t oh =
+                                            ih * p.strideHeight + kh * p.dilationHeight - p.padTop;
+                                        if (oh < 0 || oh >= p.outputHeight) {
+                                            continue;
+                                        }
+                                        const float* inRow = in + size_t(ih) * p.inputWidth;
+                                        float* outRow = out + size_t(oh) * p.outputWidth;
+                                        for (int32_t iw = iwBegin; iw < iwEnd; ++iw) {
+                                            outRow[iw * p.strideWidth + offsetW] += weight * inRow[iw];
+                                        }
+                                    }
+                                }
+                            }
+                        }
+                    }
+                });
+        }
+
+        // Repacks a 4-D filter into the [d0, d1, h, w] order. |strides| holds the source strides
+        // of d0, d1, h and w.
+        void RepackFilter(const float* src,
+                          float* dst,
+                          const std::vector<int32_t>& dims,
+                          const std::vector<size_t>& strides) {
+            size_t index = 0;
+            for (int32_t d0 = 0; d0 < dims[0]; ++d0) {
+                for (int32_t d1 = 0; d1 < dims[1]; ++d1) {
+                    for (int32_t h = 0; h < dims[2]; ++h) {
+                        for (int32_t w = 0; w < dims[3]; ++w) {
+                            dst[index++] = src[d0 * strides[0] + d1 * strides[1] +
+                                               h * strides[2] + w * strides[3]];
+                        }
+                    }
+                }
+            }
+        }
+
+        // Returns the dims and source strides to repack a conv2d filter into OIHW.
+        void GetOihwRepack(wnn::Conv2dFilterOperandLayout layout,
+                           const std::vector<int32_t>& shape,
+                           std::vector<int32_t>& dims,
+                           std::vector<size_t>& strides) {
+            std::vector<size_t> s = Strides(shape);
+            switch (layout) {
+                case wnn::Conv2dFilterOperandLayout::Oihw:
+                    dims = {shape[0], shape[1], shape[2], shape[3]};
+                    strides = {s[0], s[1], s[2], s[3]};
+                    break;
+                case wnn::Conv2dFilterOperandLayout::Hwio:
+                    dims = {shape[3], shape[2], shape[0], shape[1]};
+                    strides = {s[3], s[2], s[0], s[1]};
+                    break;
+                case wnn::Conv2dFilterOperandLayout::Ohwi:
+                    dims = {shape[0], shape[3], shape[1], shape[2]};
+                    strides = {s[0], s[3], s[1], s[2]};
+                    break;
+                case wnn::Conv2dFilterOperandLayout::Ihwo:
+                    dims = {shape[3], shape[0], shape[1], shape[2]};
+                    strides = {s[3], s[0], s[1], s[2]};
+                    break;
+                default:
+                    UNREACHABLE();
+            }
+        }
+
+        // Returns the dims and source strides to repack a convTranspose2d filter into IOHW.
+        void GetIohwRepack(wnn::ConvTranspose2dFilterOperandLayout layout,
+                           const std::vector<int32_t>& shape,
+                           std::vector<int32_t>& dims,
+                           std::vector<size_t>& strides) {
+            std::vector<size_t> s = Strides(shape);
+            switch (layout) {
+                case wnn::ConvTranspose2dFilterOperandLayout::Iohw:
+                    dims = {shape[0], shape[1], shape[2], shape[3]};
+                    strides = {s[0], s[1], s[2], s[3]};
+                    break;
+                case wnn::ConvTranspose2dFilterOperandLayout::Hwoi:
+                    dims = {shape[3], shape[2], shape[0], shape[1]};
+                    strides = {s[3], s[2], s[0], s[1]};
+                    break;
+                case wnn::ConvTranspose2dFilterOperandLayout::Ohwi:
+                    dims = {shape[3], shape[0], shape[1], shape[2]};
+                    strides = {s[3], s[0], s[1], s[2]};
+                    break;
+                default:
+                    UNREACHABLE();
+            }
+        }
+
+        int32_t ReflectIndex(wnn::PaddingMode mode, int32_t index, int32_t size) {
+            switch (mode) {
+                case wnn::PaddingMode::Edge:
+                    return std::min(std::max(index, 0), size - 1);
+                case wnn::PaddingMode::Reflection:
+                    if (size == 1) {
+                        return 0;
+                    }
+                    while (index < 0 || index >= size) {
+                        index = index < 0 ? -index : 2 * (size - 1) - index;
+                    }
+                    return index;
+                case wnn::PaddingMode::Symmetric:
+                    while (index < 0 || index >= size) {
+                        index = index < 0 ? -index - 1 : 2 * size - 1 - index;
+                    }
+                    return index;
+                default:
+                    return index < 0 || index >= size ? -1 : index;
+            }
+        }
+
+        bool IsFloat32(const OperatorBase* op, size_t inputCount) {
+            for (size_t i = 0; i < inputCount && i < op->Inputs().size(); ++i) {
+                if (op->Inputs()[i]->Type() != wnn::OperandType::Float32) {
+                    return false;
+                }
+            }
+            for (auto& output : op->Outputs()) {
+                if (output->Type() != wnn::OperandType::Float32) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool IsFloat32(const OperatorBase* op) {
+            return IsFloat32(op, op->Inputs().size());
+        }
+    }  // namespace
+
+    Tensor::Tensor(wnn::OperandType type, std::vector<int32_t> shape)
+        : type(type), shape(std::move(shape)) {
+        data.resize(utils::ElementCount(this->shape) * utils::OperandTypeByteSize(type));
+    }
+
+    size_t Tensor::ElementCount() const {
+        return utils::ElementCount(shape);
+    }
+
+    Graph::Graph(ContextBase* context, ThreadPool* threadPool)
+        : GraphBase(context), mThreadPool(threadPool) {
+    }
+
+    Tensor* Graph::CreateTensor(const OperandBase* operand) {
+        auto tensor = std::make_unique<Tensor>(operand->Type(), operand->Shape());
+        Tensor* result = tensor.get();
+        mTensors[operand] = std::move(tensor);
+        return result;
+    }
+
+    Tensor* Graph::GetTensor(const OperandBase* operand) const {
+        DAWN_ASSERT(mTensors.find(operand) != mTensors.end());
+        return mTensors.at(operand).get();
+    }
+
+    void Graph::SetUnsupported(const std::string& reason) {
+        if (mUnsupportedReason.empty()) {
+            mUnsupportedReason = reason;
+        }
+    }
+
+    bool Graph::SupportsOperator(const OperatorBase* op) const {
+        return mUnsupportedReason.empty();
+    }
+
+    MaybeError Graph::AddConstant(const op::Constant* constant) {
+        Tensor* tensor = CreateTensor(constant->PrimaryOutput());
+        if (constant->GetBuffer() == nullptr) {
+            SetUnsupported("The reference backend only supports array buffer constants.");
+            return {};
+        }
+        DAWN_INVALID_IF(constant->GetByteLength() != tensor->ByteLength(),
+                        "The byte length of the constant doesn't match its dimensions.");
+        memcpy(tensor->data.data(), constant->GetBuffer(), tensor->ByteLength());
+        return {};
+    }
+
+    MaybeError Graph::AddInput(const op::Input* input) {
+        mInputs[input->GetName()] = CreateTensor(input->PrimaryOutput());
+        return {};
+    }
+
+    MaybeError Graph::AddOutput(std::string_view name, const OperandBase* output) {
+        mOutputs[std::string(name)] = GetTensor(output);
+        return {};
+    }
+
+    MaybeError Graph::AddBatchNorm(const op::BatchNorm* batchNorm) {
+        auto& inputs = batchNorm->Inputs();
+        const BatchNormOptions* options = batchNorm->GetOptions();
+        Tensor* input = GetTensor(inputs[0].Get());
+        Tensor* mean = GetTensor(inputs[1].Get());
+        Tensor* variance = GetTensor(inputs[2].Get());
+        Tensor* scale = options->scale != nullptr ? GetTensor(inputs[3].Get()) : nullptr;
+        Tensor* bias = options->bias != nullptr
+                           ? GetTensor(inputs[options->scale != nullptr ? 4 : 3].Get())
+                           : nullptr;
+        Tensor* output = CreateTensor(batchNorm->PrimaryOutput());
+        if (!IsFloat32(batchNorm)) {
+            SetUnsupported("batchNorm only supports float32.");
+            return {};
+        }
+        const size_t axis = options->axis;
+        const float epsilon = options->epsilon;
+        const FusionOperatorBase* activation = options->activation;
+        ThreadPool* pool = mThreadPool;
+        mKernels.push_back([=](std::vector<float>*) {
+            const auto& shape = input->shape;
+            const size_t outer = ShapeSize(shape, 0, axis);
+            const size_t channels = shape[axis];
+            const size_t inner = ShapeSize(shape, axis + 1, shape.size());
+            std::vector<float> a(channels), b(channels);
+            for (size_t c = 0; c < channels; ++c) {
+                a[c] = (scale != nullptr ? scale->Float()[c] : 1.0f) /
+                       sqrtf(variance->Float()[c] + epsilon);
+                b[c] = (bias != nullptr ? bias->Float()[c] : 0.0f) - mean->Float()[c] * a[c];
+            }
+            const float* src = input->Float();
+            float* dst = output->Float();
+            ParallelFor(pool, outer * channels, inner, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    const size_t c = i % channels;
+                    const float* x = src + i * inner;
+                    float* y = dst + i * inner;
+                    for (size_t j = 0; j < inner; ++j) {
+                        y[j] = x[j] * a[c] + b[c];
+                    }
+                }
+            });
+            ApplyActivation(pool, activation, dst, output->ElementCount());
+        });
+        return {};
+    }
+
+    MaybeError Graph::AddBinary(const op::Binary* binary) {
+        Tensor* a = GetTensor(binary->Inputs()[0].Get());
+        Tensor* b = GetTensor(binary->Inputs()[1].Get());
+        Tensor* output = CreateTensor(binary->PrimaryOutput());
+        if (!IsFloat32(binary)) {
+            SetUnsupported("binary ops only support float32.");
+            return {};
+        }
+        ThreadPool* pool = mThreadPool;
+        switch (binary->GetType()) {
+            case op::BinaryOpType::kAdd:
+                mKernels.push_back([=](std::vector<float>*) {
+                    Broadcast(pool, a, b, output, [](float x, float y) { return x + y; });
+                });
+                break;
+            case op::BinaryOpType::kSub:
+                mKernels.push_back([=](std::vector<float>*) {
+                    Broadcast(pool, a, b, output, [](float x, float y) { return x - y; });
+                });
+                break;
+            case op::BinaryOpType::kMul:
+                mKernels.push_back([=](std::vector<float>*) {
+                    Broadcast(pool, a, b, output, [](float x, float y) { return x * y; });
+                });
+                break;
+            case op::BinaryOpType::kDiv:
+                mKernels.push_back([=](std::vector<float>*) {
+                    Broadcast(pool, a, b, output, [](float x, float y) { return x / y; });
+                });
+                break;
+            case op::BinaryOpType::kMax:
+                mKernels.push_back([=](std::vector<float>*) {
+                    Broadcast(pool, a, b, output,
+                              [](float x, float y) { return std::max(x, y); });
+                });
+                break;
+            case op::BinaryOpType::kMin:
+                mKernels.push_back([=](std::vector<float>*) {
+                    Broadcast(pool, a, b, output,
+                              [](float x, float y) { return std::min(x, y); });
+                });
+                break;
+            case op::BinaryOpType::kPower:
+                mKernels.push_back([=](std::vector<float>*) {
+                    Broadcast(pool, a, b, output, [](float x, float y) { return powf(x, y); });
+                });
+                break;
+            case op::BinaryOpType::kMatMul:
+                mKernels.push_back([=](std::vector<float>*) {
+                    // 1-D operands are promoted to matrices, the leading dimensions are
+                    // broadcast batches of matrices.
+                    std::vector<int32_t> aShape = a->shape, bShape = b->shape;
+                    if (aShape.size() == 1) {
+                        aShape.insert(aShape.begin(), 1);
+                    }
+                    if (bShape.size() == 1) {
+                        bShape.push_back(1);
+                    }
+                    const size_t m = aShape[aShape.size() - 2], k = aShape.back();
+                    const size_t n = bShape.back();
+                    std::vector<int32_t> aBatch(aShape.begin(), aShape.end() - 2);
+                    std::vector<int32_t> bBatch(bShape.begin(), bShape.end() - 2);
+                    std::vector<int32_t> batchShape(std::max(aBatch.size(), bBatch.size()));
+                    for (size_t i = 0; i < batchShape.size(); ++i) {
+                        int32_t dimA = i < aBatch.size() ? aBatch[aBatch.size() - i - 1] : 1;
+                        int32_t dimB = i < bBatch.size() ? bBatch[bBatch.size() - i - 1] : 1;
+                        batchShape[batchShape.size() - i - 1] = std::max(dimA, dimB);
+                    }
+                    std::vector<size_t> aStrides = BroadcastStrides(aBatch, batchShape);
+                    std::vector<size_t> bStrides = BroadcastStrides(bBatch, batchShape);
+                    const size_t batchCount = utils::ElementCount(batchShape);
+                    const float* aData = a->Float();
+                    const float* bData = b->Float();
+                    float* outputData = output->Float();
+                    ParallelFor(pool, batchCount * m, n * k, [&](size_t begin, size_t end) {
+                        for (size_t row = begin; row < end; ++row) {
+                            const size_t batch = row / m, i = row % m;
+                            size_t aOffset = 0, bOffset = 0, remaining = batch;
+                            for (size_t d = batchShape.size(); d-- > 0;) {
+                                size_t index = remaining % batchShape[d];
+                                remaining /= batchShape[d];
+                                aOffset += index * aStrides[d];
+                                bOffset += index * bStrides[d];
+                            }
+                            MatMulRows(aData + aOffset * m * k, bData + bOffset * k * n,
+                                       outputData + batch * m * n, i, i + 1, n, k);
+                        }
+                    });
+                });
+                break;
+            default:
+                return DAWN_UNIMPLEMENTED_ERROR("The binary op type isn't supported.");
+        }
+        return {};
+    }
+
+    MaybeError Graph::AddClamp(const op::Clamp* clamp) {
+        Tensor* input = GetTensor(clamp->Inputs()[0].Get());
+        Tensor* output = CreateTensor(clamp->PrimaryOutput());
+        if (!IsFloat32(clamp)) {
+            SetUnsupported("clamp only supports float32.");
+            return {};
+        }
+        const float minValue = clamp->GetMinValue(), maxValue = clamp->GetMaxValue();
+        ThreadPool* pool = mThreadPool;
+        mKernels.push_back([=](std::vector<float>*) {
+            Map(pool, input->Float(), output->Float(), output->ElementCount(),
+                [minValue, maxValue](float x) { return std::min(std::max(x, minValue), maxValue); });
+        });
+        return {};
+    }
+
+    MaybeError Graph::AddConcat(const op::Concat* concat) {
+        std::vector<Tensor*> inputs;
+        for (auto& input : concat->Inputs()) {
+            inputs.push_back(GetTensor(input.Get()));
+        }
+        Tensor* output = CreateTensor(concat->PrimaryOutput());
+        const size_t axis = concat->GetAxis();
+        mKernels.push_back([=](std::vector<float>*) {
+            const size_t elementSize = utils::OperandTypeByteSize(output->type);
+            const size_t outer = ShapeSize(output->shape, 0, axis);
+            const size_t outputRow = ShapeSize(output->shape, axis, output->shape.size());
+            size_t offset = 0;
+            for (Tensor* input : inputs) {
+                const size_t inputRow = ShapeSize(input->shape, axis, input->shape.size());
+                for (size_t o = 0; o < outer; ++o) {
+                    memcpy(output->data.data() + (o * outputRow + offset) * elementSize,
+                           input->data.data() + o * inputRow * elementSize,
+                           inputRow * elementSize);
+                }
+                offset += inputRow;
+            }
+        });
+        return {};
+    }
+
+    bool Graph::SupportsFusedActivation(const op::Conv2d* conv2d, FusionType type) const {
+        return true;
+    }
+
+    MaybeError Graph::AddConv2d(const op::Conv2d* conv2d) {
+        auto& inputs = conv2d->Inputs();
+        const Conv2dOptions* options = conv2d->GetOptions();
+        Tensor* input = GetTensor(inputs[0].Get());
+        Tensor* filter = GetTensor(inputs[1].Get());
+        Tensor* bias = options->bias != nullptr ? GetTensor(inputs[2].Get()) : nullptr;
+        Tensor* output = CreateTensor(conv2d->PrimaryOutput());
+        if (!IsFloat32(conv2d)) {
+            SetUnsupported("conv2d only supports float32.");
+            return {};
+        }
+
+        const bool nhwc = options->inputLayout == wnn::InputOperandLayout::Nhwc;
+        std::vector<int32_t> inputShape = nhwc ? PermuteShape(input->shape, kNhwcToNchw)
+                                               : input->shape;
+        std::vector<int32_t> outputShape = nhwc ? PermuteShape(output->shape, kNhwcToNchw)
+                                                : output->shape;
+        std::vector<int32_t> filterDims;
+        std::vector<size_t> filterStrides;
+        GetOihwRepack(options->filterLayout, filter->shape, filterDims, filterStrides);
+
+        Conv2dParams params;
+        params.batchSize = inputShape[0];
+        params.inputChannels = inputShape[1];
+        params.inputHeight = inputShape[2];
+        params.inputWidth = inputShape[3];
+        params.outputChannels = outputShape[1];
+        params.outputHeight = outputShape[2];
+        params.outputWidth = outputShape[3];
+        params.filterHeight = filterDims[2];
+        params.filterWidth = filterDims[3];
+        params.groups = options->groups;
+        params.strideHeight = options->strides[0];
+        params.strideWidth = options->strides[1];
+        params.dilationHeight = options->dilations[0];
+        params.dilationWidth = options->dilations[1];
+        std::vector<int32_t> padding(options->padding, options->padding + options->paddingCount);
+        if (options->autoPad != wnn::AutoPad::Explicit) {
+            padding = utils::ComputeImplicitPaddingForAutoPad(
+                options, std::vector<int32_t>{params.inputHeight, params.inputWidth},
+                std::vector<int32_t>{params.filterHeight, params.filterWidth});
+        }
+        params.padTop = padding[0];
+        params.padLeft = padding[2];
+
+        const FusionOperatorBase* activation = options->activation;
+        const bool repackFilter = options->filterLayout != wnn::Conv2dFilterOperandLayout::Oihw;
+        ThreadPool* pool = mThreadPool;
+        mKernels.push_back([=](std::vector<float>* scratch) {
+            const size_t inputCount = input->ElementCount();
+            const size_t outputCount = output->ElementCount();
+            scratch->resize((nhwc ? inputCount + outputCount : 0) +
+                            (repackFilter ? filter->ElementCount() : 0));
+            float* next = scratch->data();
+            const float* src = input->Float();
+            if (nhwc) {
+                TransposeData(pool, input->Float(), next, sizeof(float), input->shape,
+                              kNhwcToNchw);
+                src = next;
+                next += inputCount;
+            }
+            float* dst = output->Float();
+            if (nhwc) {
+                dst = next;
+                next += outputCount;
+            }
+            const float* weights = filter->Float();
+            if (repackFilter) {
+                RepackFilter(filter->Float(), next, filterDims, filterStrides);
+                weights = next;
+            }
+            Conv2dNchw(pool, params, src, weights, bias != nullptr ? bias->Float() : nullptr,
+                       dst);
+            ApplyActivation(pool, activation, dst, outputCount);
+            if (nhwc) {
+                TransposeData(pool, dst, output->Float(), sizeof(float), outputShape,
+                              kNchwToNhwc);
+            }
+        });
+        return {};
+    }
+
+    MaybeError Graph::AddConvTranspose2d(const op::ConvTranspose2d* convTranspose2d) {
+        auto& inputs = convTranspose2d->Inputs();
+        const ConvTranspose2dOptions* options = convTranspose2d->GetOptions();
+        Tensor* input = GetTensor(inputs[0].Get());
+        Tensor* filter = GetTensor(inputs[1].Get());
+        Tensor* bias = options->bias != nullptr ? GetTensor(inputs[2].Get()) : nullptr;
+        Tensor* output = CreateTensor(convTranspose2d->PrimaryOutput());
+        if (!IsFloat32(convTranspose2d)) {
+            SetUnsupported("convTranspose2d only supports float32.");
+            return {};
+        }
+
+        const bool nhwc = options->inputLayout == wnn::InputOperandLayout::Nhwc;
+        std::vector<int32_t> inputShape = nhwc ? PermuteShape(input->shape, kNhwcToNchw)
+                                               : input->shape;
+        std::vector<int32_t> outputShape = nhwc ? PermuteShape(output->shape, kNhwcToNchw)
+                                                : output->shape;
+        std::vector<int32_t> filterDims;
+        std::vector<size_t> filterStrides;
+        GetIohwRepack(options->filterLayout, filter->shape, filterDims, filterStrides);
+
+        Conv2dParams params;
+        params.batchSize = inputShape[0];
+        params.inputChannels = inputShape[1];
+        params.inputHeight = inputShape[2];
+        params.inputWidth = inputShape[3];
+        params.outputChannels = outputShape[1];
+        params.outputHeight = outputShape[2];
+        params.outputWidth = outputShape[3];
+        params.filterHeight = filterDims[2];
+        params.filterWidth = filterDims[3];
+        params.groups = options->groups;
+        params.strideHeight = options->strides[0];
+        params.strideWidth = options->strides[1];
+        params.dilationHeight = options->dilations[0];
+        params.dilationWidth = options->dilations[1];
+        std::vector<int32_t> padding(options->padding, options->padding + options->paddingCount);
+        if (options->autoPad != wnn::AutoPad::Explicit) {
+            padding = utils::ComputeImplicitPaddingForConvTranspose2dAutoPad(
+                options, std::vector<int32_t>{params.inputHeight, params.inputWidth},
+                std::vector<int32_t>{params.filterHeight, params.filterWidth});
+        }
+        params.padTop = padding[0];
+        params.padLeft = padding[2];
+
+        const FusionOperatorBase* activation = options->activation;
+        const bool repackFilter =
+            options->filterLayout != wnn::ConvTranspose2dFilterOperandLayout::Iohw;
+        ThreadPool* pool = mThreadPool;
+        mKernels.push_back([=](std::vector<float>* scratch) {
+            const size_t inputCount = input->ElementCount();
+            const size_t outputCount = output->ElementCount();
+            scratch->resize((nhwc ? inputCount + outputCount : 0) +
+                            (repackFilter ? filter->ElementCount() : 0));
+            float* next = scratch->data();
+            const float* src = input->Float();
+            if (nhwc) {
+                TransposeData(pool, input->Float(), next, sizeof(float), input->shape,
+                              kNhwcToNchw);
+                src = next;
+                next += inputCount;
+            }
+            float* dst = output->Float();
+            if (nhwc) {
+                dst = next;
+                next += outputCount;
+            }
+            const float* weights = filter->Float();
+            if (repackFilter) {
+                RepackFilter(filter->Float(), next, filterDims, filterStrides);
+                weights = next;
+            }
+            ConvTranspose2dNchw(pool, params, src, weights,
+                                bias != nullptr ? bias->Float() : nullptr, dst);
+            ApplyActivation(pool, activation, dst, outputCount);
+            if (nhwc) {
+                TransposeData(pool, dst, output->Float(), sizeof(float), outputShape,
+                              kNchwToNhwc);
+            }
+        });
+        return {};
+    }
+
+    MaybeError Graph::AddGemm(const op::Gemm* gemm) {
+        auto& inputs = gemm->Inputs();
+        const GemmOptions* options = gemm->GetOptions();
+        Tensor* a = GetTensor(inputs[0].Get());
+        Tensor* b = GetTensor(inputs[1].Get());
+        Tensor* c = inputs.size() == 3 ? GetTensor(inputs[2].Get()) : nullptr;
+        Tensor* output = CreateTensor(gemm->PrimaryOutput());
+        if (!IsFloat32(gemm)) {
+            SetUnsupported("gemm only supports float32.");
+            return {};
+        }
+        const bool aTranspose = options->aTranspose, bTranspose = options->bTranspose;
+        const float alpha = options->alpha, beta = options->beta;
+        ThreadPool* pool = mThreadPool;
+        mKernels.push_back([=](std::vector<float>* scratch) {
+            const size_t m = output->shape[0], n = output->shape[1];
+            const size_t k = aTranspose ? a->shape[0] : a->shape[1];
+            scratch->resize((aTranspose ? m * k : 0) + (bTranspose ? k * n : 0));
+            float* next = scratch->data();
+            const float* aData = a->Float();
+            if (aTranspose) {
+                TransposeData(pool, aData, next, sizeof(float), a->shape, {1, 0});
+                aData = next;
+                next += m * k;
+            }
+            const float* bData = b->Float();
+            if (bTranspose) {
+                TransposeData(pool, bData, next, sizeof(float), b->shape, {1, 0});
+                bData = next;
+            }
+            float* dst = output->Float();
+            std::vector<size_t> cStrides;
+            if (c != nullptr) {
+                cStrides = BroadcastStrides(c->shape, output->shape);
+            }
+            ParallelFor(pool, m, n * k, [&](size_t begin, size_t end) {
+                MatMulRows(aData, bData, dst, begin, end, n, k);
+                for (size_t i = begin; i < end; ++i) {
+                    float* row = dst + i * n;
+                    for (size_t j = 0; j < n; ++j) {
+                        row[j] *= alpha;
+                    }
+                    if (c != nullptr) {
+                        const float* cRow = c->Float() + i * cStrides[0];
+                        for (size_t j = 0; j < n; ++j) {
+                            row[j] += beta * cRow[j * cStrides[1]];
+                        }
+                    }
+                }
+            });
+        });
+        return {};
+    }
+
+    MaybeError Graph::AddGru(const op::Gru* gru) {
+        auto& inputs = gru->Inputs();
+        const GruOptions* options = gru->GetOptions();
+        Tensor* input = GetTensor(inputs[0].Get());
+        Tensor* weight = GetTensor(inputs[1].Get());
+        Tensor* recurrentWeight = GetTensor(inputs[2].Get());
+        size_t index = 3;
+        Tensor* bias = options->bias != nullptr ? GetTensor(inputs[index++].Get()) : nullptr;
+        Tensor* recurrentBias =
+            options->recurrentBias != nullptr ? GetTensor(inputs[index++].Get()) : nullptr;
+        Tensor* initialHiddenState =
+            options->initialHiddenState != nullptr ? GetTensor(inputs[index++].Get()) : nullptr;
+        Tensor* output = CreateTensor(gru->Outputs()[0].Get());
+        Tensor* sequence =
+            options->returnSequence ? CreateTensor(gru->Outputs()[1].Get()) : nullptr;
+        if (!IsFloat32(gru)) {
+            SetUnsupported("gru only supports float32.");
+            return {};
+        }
+
+        const size_t steps = gru->GetSteps();
+        const size_t hiddenSize = gru->GetHiddenSize();
+        const bool resetAfter = options->resetAfter;
+        const wnn::RecurrentNetworkDirection direction = options->direction;
+        // Offsets of the update (z), reset (r) and new (n) gates in the weights.
+        const bool zrn = options->layout == wnn::RecurrentNetworkWeightLayout::Zrn;
+        const size_t zOffset = zrn ? 0 : hiddenSize;
+        const size_t rOffset = zrn ? hiddenSize : 0;
+        const size_t nOffset = 2 * hiddenSize;
+        Ref<OperatorArrayBase> activations = gru->GetActivations();
+        const FusionOperatorBase* gateActivation = activations->Get(0);
+        const FusionOperatorBase* newActivation = activations->Get(1);
+        mKernels.push_back([=](std::vector<float>*) {
+            const size_t batchSize = input->shape[1];
+            const size_t inputSize = input->shape[2];
+            const size_t numDirections = weight->shape[0];
+            const size_t gates = 3 * hiddenSize;
+            std::vector<float> hidden(batchSize * hiddenSize);
+            std::vector<float> inputGates(batchSize * gates), hiddenGates(batchSize * gates);
+            std::vector<float> resetHidden(hiddenSize);
+            for (size_t d = 0; d < numDirections; ++d) {
+                const bool backward = direction == wnn::RecurrentNetworkDirection::Backward ||
+                                      (direction == wnn::RecurrentNetworkDirection::Both && d == 1);
+                const float* w = weight->Float() + d * gates * inputSize;
+                const float* r = recurrentWeight->Float() + d * gates * hiddenSize;
+                const float* wb = bias != nullptr ? bias->Float() + d * gates : nullptr;
+                const float* rb = recurrentBias != nullptr ? recurrentBias->Float() + d * gates
+                                                           : nullptr;
+                if (initialHiddenState != nullptr) {
+                    memcpy(hidden.data(),
+                           initialHiddenState->Float() + d * batchSize * hiddenSize,
+                           hidden.size() * sizeof(float));
+                } else {
+                    std::fill(hidden.begin(), hidden.end(), 0.0f);
+                }
+                for (size_t s = 0; s < steps; ++s) {
+                    const size_t t = backward ? steps - 1 - s : s;
+                    const float* x = input->Float() + t * batchSize * inputSize;
+                    for (size_t bi = 0; bi < batchSize; ++bi) {
+                        const float* xRow = x + bi * inputSize;
+                        const float* hRow = hidden.data() + bi * hiddenSize;
+                        float* ig = inputGates.data() + bi * gates;
+                        float* hg = hiddenGates.data() + bi * gates;
+                        for (size_t g = 0; g < gates; ++g) {
+                            ig[g] = Dot(xRow, w + g * inputSize, inputSize) +
+                                    (wb != nullptr ? wb[g] : 0.0f);
+                            hg[g] = rb != nullptr ? rb[g] : 0.0f;
+                        }
+                        // With resetAfter = false the reset gate is applied to the hidden state
+                        // before the recurrent weight of the new gate.
+                        const size_t recurrentGates = resetAfter ? gates : nOffset;
+                        for (size_t g = 0; g < recurrentGates; ++g) {
+                            if (g >= nOffset && g < nOffset + hiddenSize && !resetAfter) {
+                                continue;
+                            }
+                            hg[g] += Dot(hRow, r + g * hiddenSize, hiddenSize);
+                        }
+                        if (!resetAfter) {
+                            for (size_t h = 0; h < hiddenSize; ++h) {
+                                resetHidden[h] =
+                                    ActivationValue(gateActivation, ig[rOffset + h] + hg[rOffset + h]) *
+                                    hRow[h];
+                            }
+                            for (size_t h = 0; h < hiddenSize; ++h) {
+                                hg[nOffset + h] += Dot(resetHidden.data(),
+                                                       r + (nOffset + h) * hiddenSize, hiddenSize);
+                            }
+                        }
+                    }
+                    for (size_t bi = 0; bi < batchSize; ++bi) {
+                        float* hRow = hidden.data() + bi * hiddenSize;
+                        const float* ig = inputGates.data() + bi * gates;
+                        const float* hg = hiddenGates.data() + bi * gates;
+                        for (size_t h = 0; h < hiddenSize; ++h) {
+                            const float z =
+                                ActivationValue(gateActivation, ig[zOffset + h] + hg[zOffset + h]);
+                            const float rv =
+                                ActivationValue(gateActivation, ig[rOffset + h] + hg[rOffset + h]);
+                            const float n = ActivationValue(
+                                newActivation, resetAfter ? ig[nOffset + h] + rv * hg[nOffset + h]
+                                                          : ig[nOffset + h] + hg[nOffset + h]);
+                            hRow[h] = (1.0f - z) * n + z * hRow[h];
+                        }
+                    }
+                    if (sequence != nullptr) {
+                        memcpy(sequence->Float() + (t * numDirections + d) * hidden.size(),
+                               hidden.data(), hidden.size() * sizeof(float));
+                    }
+                }
+                memcpy(output->Float() + d * hidden.size(), hidden.data(),
+                       hidden.size() * sizeof(float));
+            }
+        });
+        return {};
+    }
+
+    MaybeError Graph::AddInstanceNorm(const op::InstanceNorm* instanceNorm) {
+        auto& inputs = instanceNorm->Inputs();
+        const InstanceNormOptions* options = instanceNorm->GetOptions();
+        Tensor* input = GetTensor(inputs[0].Get());
+        Tensor* scale = options->scale != nullptr ? GetTensor(inputs[1].Get()) : nullptr;
+        Tensor* bias = options->bias != nullptr
+                           ? GetTensor(inputs[options->scale != nullptr ? 2 : 1].Get())
+                           : nullptr;
+        Tensor* output = CreateTensor(instanceNorm->PrimaryOutput());
+        if (!IsFloat32(instanceNorm)) {
+            SetUnsupported("instanceNorm only supports float32.");
+            return {};
+        }
+        const bool nhwc = options->layout == wnn::InputOperandLayout::Nhwc;
+        const float epsilon = options->epsilon;
+        ThreadPool* pool = mThreadPool;
+        mKernels.push_back([=](std::vector<float>*) {
+            const auto& shape = input->shape;
+            const size_t batchSize = shape[0];
+            const size_t channels = nhwc ? shape[3] : shape[1];
+            const size_t spatial = nhwc ? size_t(shape[1]) * shape[2] : size_t(shape[2]) * shape[3];
+            // Element (n, c, i) lives at n * channels * spatial + c * cStride + i * iStride.
+            const size_t cStride = nhwc ? 1 : spatial;
+            const size_t iStride = nhwc ? channels : 1;
+            const float* src = input->Float();
+            float* dst = output->Float();
+            ParallelFor(pool, batchSize * channels, spatial, [&](size_t begin, size_t end) {
+                for (size_t index = begin; index < end; ++index) {
+                    const size_t n = index / channels, c = index % channels;
+                    const float* x = src + n * channels * spatial + c * cStride;
+                    float* y = dst + n * channels * spatial + c * cStride;
+                    float mean = 0;
+                    for (size_t i = 0; i < spatial; ++i) {
+                        mean += x[i * iStride];
+                    }
+                    mean /= spatial;
+                    float variance = 0;
+                    for (size_t i = 0; i < spatial; ++i) {
+                        float diff = x[i * iStride] - mean;
+                        variance += diff * diff;
+                    }
+                    variance /= spatial;
+                    const float a = (scale != nullptr ? scale->Float()[c] : 1.0f) /
+                                    sqrtf(variance + epsilon);
+                    const float b = (bias != nullptr ? bias->Float()[c] : 0.0f) - mean * a;
+                    for (size_t i = 0; i < spatial; ++i) {
+                        y[i * iStride] = x[i * iStride] * a + b;
+                    }
+                }
+            });
+        });
+        return {};
+    }
+
+    MaybeError Graph::AddPad(const op::Pad* pad) {
+        auto& inputs = pad->Inputs();
+        Tensor* input = GetTensor(inputs[0].Get());
+        Tensor* padding = inputs.size() == 2 ? GetTensor(inputs[1].Get()) : nullptr;
+        Tensor* output = CreateTensor(pad->PrimaryOutput());
+        if (!IsFloat32(pad, 1)) {
+            SetUnsupported("pad only supports float32.");
+            return {};
+        }
+        const std::vector<uint32_t> staticPadding = pad->GetPadding();
+        const wnn::PaddingMode mode = pad->GetOptions()->mode;
+        const float value = pad->GetOptions()->value;
+        ThreadPool* pool = mThreadPool;
+        mKernels.push_back([=](std::vector<float>*) {
+            const auto& inputShape = input->shape;
+            const auto& outputShape = output->shape;
+            const size_t rank = inputShape.size();
+            const uint32_t* beginPadding =
+                padding != nullptr ? reinterpret_cast<const uint32_t*>(padding->data.data())
+                                   : staticPadding.data();
+            // For every dimension, the input index of each output index or -1 for the constant
+            // padding value.
+            std::vector<std::vector<int32_t>> indexMaps(rank);
+            for (size_t d = 0; d < rank; ++d) {
+                indexMaps[d].resize(outputShape[d]);
+                for (int32_t i = 0; i < outputShape[d]; ++i) {
+                    indexMaps[d][i] = ReflectIndex(
+                        mode, i - static_cast<int32_t>(beginPadding[2 * d]), inputShape[d]);
+                }
+            }
+            std::vector<size_t> inputStrides = Strides(inputShape);
+            const size_t inner = outputShape[rank - 1];
+            const size_t outer = ShapeSize(outputShape, 0, rank - 1);
+            const float* src = input->Float();
+            float* dst = output->Float();
+            ParallelFor(pool, outer, inner, [&](size_t begin, size_t end) {
+                for (size_t o = begin; o < end; ++o) {
+                    size_t offset = 0, remaining = o;
+                    bool padded = false;
+                    for (size_t d = rank - 1; d-- > 0;) {
+                        int32_t index = indexMaps[d][remaining % outputShape[d]];
+                        remaining /= outputShape[d];
+                        if (index < 0) {
+                            padded = true;
+                            break;
+                        }
+                        offset += index * inputStrides[d];
+                    }
+                    float* row = dst + o * inner;
+                    if (padded) {
+                        std::fill(row, row + inner, value);
+                        continue;
+                    }
+                    const std::vector<int32_t>& lastMap = indexMaps[rank - 1];
+                    for (size_t i = 0; i < inner; ++i) {
+                        row[i] = lastMap[i] < 0 ? value : src[offset + lastMap[i]];
+                    }
+                }
+            });
+        });
+        return {};
+    }
+
+    MaybeError Graph::AddPool2d(const op::Pool2d* pool2d) {
+        const Pool2dOptions* options = pool2d->GetOptions();
+        Tensor* input = GetTensor(pool2d->Inputs()[0].Get());
+        Tensor* output = CreateTensor(pool2d->PrimaryOutput());
+        if (!IsFloat32(pool2d)) {
+            SetUnsupported("pool2d only supports float32.");
+            return {};
+        }
+        const bool nhwc = options->layout == wnn::InputOperandLayout::Nhwc;
+        std::vector<int32_t> inputShape = nhwc ? PermuteShape(input->shape, kNhwcToNchw)
+                                               : input->shape;
+        std::vector<int32_t> outputShape = nhwc ? PermuteShape(output->shape, kNhwcToNchw)
+                                                : output->shape;
+        const int32_t inputHeight = inputShape[2], inputWidth = inputShape[3];
+        const int32_t windowHeight =
+            options->windowDimensions == nullptr ? inputHeight : options->windowDimensions[0];
+        const int32_t windowWidth =
+            options->windowDimensions == nullptr ? inputWidth : options->windowDimensions[1];
+        const int32_t strideHeight = options->strides[0], strideWidth = options->strides[1];
+        const int32_t dilationHeight = options->dilations[0], dilationWidth = options->dilations[1];
+        int32_t padTop = options->padding[0], padBottom = options->padding[1];
+        int32_t padLeft = options->padding[2], padRight = options->padding[3];
+        if (options->autoPad != wnn::AutoPad::Explicit) {
+            utils::ComputeImplicitPaddingForAutoPad(options->autoPad, dilationHeight, inputHeight,
+                                                    windowHeight, strideHeight, padTop, padBottom);
+            utils::ComputeImplicitPaddingForAutoPad(options->autoPad, dilationWidth, inputWidth,
+                                                    windowWidth, strideWidth, padLeft, padRight);
+        }
+        const op::Pool2dType type = pool2d->GetType();
+        ThreadPool* pool = mThreadPool;
+        mKernels.push_back([=](std::vector<float>* scratch) {
+            const size_t inputCount = input->ElementCount();
+            const size_t outputCount = output->ElementCount();
+            scratch->resize(nhwc ? inputCount + outputCount : 0);
+            const float* src = input->Float();
+            float* dst = output->Float();
+            if (nhwc) {
+                TransposeData(pool, input->Float(), scratch->data(), sizeof(float), input->shape,
+                              kNhwcToNchw);
+                src = scratch->data();
+                dst = scratch->data() + inputCount;
+            }
+            const int32_t outputHeight = outputShape[2], outputWidth = outputShape[3];
+            const size_t inputPlane = size_t(inputHeight) * inputWidth;
+            const size_t outputPlane = size_t(outputHeight) * outputWidth;
+            const size_t planes = size_t(outputShape[0]) * outputShape[1];
+            ParallelFor(pool, planes, outputPlane * windowHeight * windowWidth,
+                        [&](size_t begin, size_t end) {
+                            for (size_t plane = begin; plane < end; ++plane) {
+                                const float* in = src + plane * inputPlane;
+                                float* out = dst + plane * outputPlane;
+                                for (int32_t oh = 0; oh < outputHeight; ++oh) {
+                                    for (int32_t ow = 0; ow < outputWidth; ++ow) {
+                                        float result = type == op::Pool2dType::kMaxPool2d
+                                                           ? std::numeric_limits<float>::lowest()
+                                                           : 0.0f;
+                                        size_t count = 0;
+                                        for (int32_t kh = 0; kh < windowHeight; ++kh) {
+                                            const int32_t ih =
+                                                oh * strideHeight + kh * dilationHeight - padTop;
+                                            if (ih < 0 || ih >= inputHeight) {
+                                                continue;
+                                            }
+                                            for (int32_t kw = 0; kw < windowWidth; ++kw) {
+                                                const int32_t iw =
+                                                    ow * strideWidth + kw * dilationWidth - padLeft;
+                                                if (iw < 0 || iw >= inputWidth) {
+                                                    continue;
+                                                }
+                                                const float x = in[ih * inputWidth + iw];
+                                                switch (type) {
+                                                    case op::Pool2dType::kMaxPool2d:
+                                                        result = std::max(result, x);
+                                                        break;
+                                                    case op::Pool2dType::kL2Pool2d:
+                                                        result += x * x;
+                                                        break;
+                                                    default:
+                                                        result += x;
+                                                        break;
+                                                }
+                                                ++count;
+                                            }
+                                        }
+                                        if (type == op::Pool2dType::kAveragePool2d) {
+                                            // Padding values are not counted in the average.
+                                            result = count > 0 ? result / count : 0.0f;
+                                        } else if (type == op::Pool2dType::kL2Pool2d) {
+                                            result = sqrtf(result);
+                                        }
+                                        out[oh * outputWidth + ow] = result;
+                                    }
+                                }
+                            }
+                        });
+            if (nhwc) {
+                TransposeData(pool, dst, output->Float(), sizeof(float), outputShape,
+                              kNchwToNhwc);
+            }
+        });
+        return {};
+    }
+
+    MaybeError Graph::AddReduce(const op::Reduce* reduce) {
+        Tensor* input = GetTensor(reduce->Inputs()[0].Get());
+        Tensor* output = CreateTensor(reduce->PrimaryOutput());
+        if (!IsFloat32(reduce)) {
+            SetUnsupported("reduce ops only support float32.");
+            return {};
+        }
+        const ReduceOptions* options = reduce->GetOptions();
+        std::vector<bool> reduced(input->shape.size(), false);
+        for (uint32_t i = 0; i < options->axesCount; ++i) {
+            int32_t axis = options->axes[i];
+            reduced[axis == -1 ? input->shape.size() - 1 : axis] = true;
+        }
+        const op::ReduceType type = reduce->GetType();
+        ThreadPool* pool = mThreadPool;
+        mKernels.push_back([=](std::vector<float>*) {
+            const auto& shape = input->shape;
+            std::vector<size_t> strides = Strides(shape);
+            std::vector<int32_t> keptDims, reducedDims;
+            std::vector<size_t> keptStrides, reducedStrides;
+            for (size_t d = 0; d < shape.size(); ++d) {
+                (reduced[d] ? reducedDims : keptDims).push_back(shape[d]);
+                (reduced[d] ? reducedStrides : keptStrides).push_back(strides[d]);
+            }
+            // The input offsets of the reduced elements relative to the first one.
+            const size_t reduceCount = utils::ElementCount(reducedDims);
+            std::vector<size_t> reduceOffsets(reduceCount);
+            for (size_t r = 0; r < reduceCount; ++r) {
+                size_t offset = 0, remaining = r;
+                for (size_t d = reducedDims.size(); d-- > 0;) {
+                    offset += (remaining % reducedDims[d]) * reducedStrides[d];
+                    remaining /= reducedDims[d];
+                }
+                reduceOffsets[r] = offset;
+            }
+            const size_t outputCount = utils::ElementCount(keptDims);
+            const float* src = input->Float();
+            float* dst = output->Float();
+            ParallelFor(pool, outputCount, reduceCount, [&](size_t begin, size_t end) {
+                for (size_t o = begin; o < end; ++o) {
+                    size_t base = 0, remaining = o;
+                    for (size_t d = keptDims.size(); d-- > 0;) {
+                        base += (remaining % keptDims[d]) * keptStrides[d];
+                        remaining /= keptDims[d];
+                    }
+                    const float* x = src + base;
+                    float result = 0;
+                    switch (type) {
+                        case op::ReduceType::kReduceL1:
+                            for (size_t r = 0; r < reduceCount; ++r) {
+                                result += fabsf(x[reduceOffsets[r]]);
+                            }
+                            break;
+                        case op::ReduceType::kReduceL2:
+                            for (size_t r = 0; r < reduceCount; ++r) {
+                                result += x[reduceOffsets[r]] * x[reduceOffsets[r]];
+                            }
+                            result = sqrtf(result);
+                            break;
+                        case op::ReduceType::kReduceMax:
+                            result = std::numeric_limits<float>::lowest();
+                            for (size_t r = 0; r < reduceCount; ++r) {
+                                result = std::max(result, x[reduceOffsets[r]]);
+                            }
+                            break;
+                        case op::ReduceType::kReduceMin:
+                            result = std::numeric_limits<float>::max();
+                            for (size_t r = 0; r < reduceCount; ++r) {
+                                result = std::min(result, x[reduceOffsets[r]]);
+                            }
+                            break;
+                        case op::ReduceType::kReduceMean:
+                        case op::ReduceType::kReduceSum:
+                            for (size_t r = 0; r < reduceCount; ++r) {
+                                result += x[reduceOffsets[r]];
+                            }
+                            if (type == op::ReduceType::kReduceMean) {
+                                result /= reduceCount;
+                            }
+                            break;
+                        case op::ReduceType::kReduceProduct:
+                            result = 1;
+                            for (size_t r = 0; r < reduceCount; ++r) {
+                                result *= x[reduceOffsets[r]];
+                            }
+                            break;
+                        case op::ReduceType::kReduceArgMax:
+                        case op::ReduceType::kReduceArgMin: {
+                            // The index is flattened over the reduced dimensions.
+                            size_t best = 0;
+                            for (size_t r = 1; r < reduceCount; ++r) {
+                                float value = x[reduceOffsets[r]];
+                                float bestValue = x[reduceOffsets[best]];
+                                if (type == op::ReduceType::kReduceArgMax ? value > bestValue
+                                                                          : value < bestValue) {
+                                    best = r;
+                                }
+                            }
+                            result = static_cast<float>(best);
+                            break;
+                        }
+                        default:
+                            UNREACHABLE();
+                    }
+                    dst[o] = result;
+                }
+            });
+        });
+        return {};
+    }
+
+    MaybeError Graph::AddResample2d(const op::Resample2d* resample2d) {
+        Tensor* input = GetTensor(resample2d->Inputs()[0].Get());
+        Tensor* output = CreateTensor(resample2d->PrimaryOutput());
+        if (!IsFloat32(resample2d)) {
+            SetUnsupported("resample2d only supports float32.");
+            return {};
+        }
+        const std::vector<int32_t> axes = resample2d->GetAxes();
+        const bool linear =
+            resample2d->GetOptions()->mode == wnn::InterpolationMode::Linear;
+        ThreadPool* pool = mThreadPool;
+        mKernels.push_back([=](std::vector<float>*) {
+            const auto& inputShape = input->shape;
+            const auto& outputShape = output->shape;
+            const size_t rank = inputShape.size();
+            const size_t outer = ShapeSize(inputShape, 0, axes[0]);
+            const size_t inner = ShapeSize(inputShape, axes[1] + 1, rank);
+            const int32_t inputHeight = inputShape[axes[0]], inputWidth = inputShape[axes[1]];
+            const int32_t outputHeight = outputShape[axes[0]], outputWidth = outputShape[axes[1]];
+            const float scaleHeight = float(outputHeight) / inputHeight;
+            const float scaleWidth = float(outputWidth) / inputWidth;
+            // Source coordinates use the half pixel convention.
+            struct Sample {
+                int32_t index0;
+                int32_t index1;
+                float weight1;
+            };
+            auto makeSamples = [linear](int32_t outputSize, int32_t inputSize, float scale) {
+                std::vector<Sample> samples(outputSize);
+                for (int32_t i = 0; i < outputSize; ++i) {
+                    if (linear) {
+                        float x = std::max((i + 0.5f) / scale - 0.5f, 0.0f);
+                        int32_t index0 = std::min(static_cast<int32_t>(x), inputSize - 1);
+                        int32_t index1 = std::min(index0 + 1, inputSize - 1);
+                        samples[i] = {index0, index1, x - index0};
+                    } else {
+                        int32_t index = std::min(static_cast<int32_t>((i + 0.5f) / scale),
+                                                 inputSize - 1);
+                        samples[i] = {index, index, 0.0f};
+                    }
+                }
+                return samples;
+            };
+            const std::vector<Sample> rows = makeSamples(outputHeight, inputHeight, scaleHeight);
+            const std::vector<Sample> cols = makeSamples(outputWidth, inputWidth, scaleWidth);
+            const float* src = input->Float();
+            float* dst = output->Float();
+            ParallelFor(pool, outer * outputHeight, outputWidth * inner,
+                        [&](size_t begin, size_t end) {
+                            for (size_t index = begin; index < end; ++index) {
+                                const size_t o = index / outputHeight;
+                                const Sample& row = rows[index % outputHeight];
+                                const float* plane = src + o * inputHeight * inputWidth * inner;
+                                float* out = dst + index * outputWidth * inner;
+                                for (int32_t ow = 0; ow < outputWidth; ++ow) {
+                                    const Sample& col = cols[ow];
+                                    const float* p00 =
+                                        plane + (row.index0 * inputWidth + col.index0) * inner;
+                                    const float* p01 =
+                                        plane + (row.index0 * inputWidth + col.index1) * inner;
+                                    const float* p10 =
+                                        plane + (row.index1 * inputWidth + col.index0) * inner;
+                                    const float* p11 =
+                                        plane + (row.index1 * inputWidth + col.index1) * inner;
+                                    float* y = out + ow * inner;
+                                    for (size_t i = 0; i < inner; ++i) {
+                                        float top = p00[i] + (p01[i] - p00[i]) * col.weight1;
+                                        float bottom = p10[i] + (p11[i] - p10[i]) * col.weight1;
+                                        y[i] = top + (bottom - top) * row.weight1;
+                                    }
+                                }
+                            }
+                        });
+        });
+        return {};
+    }
+
+    MaybeError Graph::AddReshape(const op::Reshape* reshape) {
+        Tensor* input = GetTensor(reshape->Inputs()[0].Get());
+        Tensor* output = CreateTensor(reshape->PrimaryOutput());
+        mKernels.push_back(
+            [=]() { memcpy(output->data.data(), input->data.data(), output->ByteLength()); });
+        return {};
+    }
+
+    MaybeError Graph::AddSlice(const op::Slice* slice) {
+        Tensor* input = GetTensor(slice->Inputs()[0].Get());
+        Tensor* output = CreateTensor(slice->PrimaryOutput());
+        const std::vector<int32_t> inputShape = input->shape;
+        std::vector<int32_t> starts(inputShape.size(), 0);
+        std::vector<int32_t> sliceAxes = slice->GetAxes();
+        std::vector<int32_t> sliceStarts = slice->GetStarts();
+        for (size_t i = 0; i < sliceStarts.size(); ++i) {
+            int32_t axis = sliceAxes.empty() ? i : sliceAxes[i];
+            if (axis < 0) {
+                axis += inputShape.size();
+            }
+            int32_t start = sliceStarts[i];
+            starts[axis] = start < 0 ? start + inputShape[axis] : start;
+        }
+        ThreadPool* pool = mThreadPool;
+        mKernels.push_back([=](std::vector<float>*) {
+            const size_t elementSize = utils::OperandTypeByteSize(output->type);
+            const auto& outputShape = output->shape;
+            const size_t rank = outputShape.size();
+            std::vector<size_t> inputStrides = Strides(inputShape);
+            const size_t inner = outputShape[rank - 1];
+            const size_t outer = ShapeSize(outputShape, 0, rank - 1);
+            ParallelFor(pool, outer, inner, [&](size_t begin, size_t end) {
+                for (size_t o = begin; o < end; ++o) {
+                    size_t offset = starts[rank - 1], remaining = o;
+                    for (size_t d = rank - 1; d-- > 0;) {
+                        offset += (remaining % outputShape[d] + starts[d]) * inputStrides[d];
+                        remaining /= outputShape[d];
+                    }
+                    memcpy(output->data.data() + o * inner * elementSize,
+                           input->data.data() + offset * elementSize, inner * elementSize);
+                }
+            });
+        });
+        return {};
+    }
+
+    MaybeError Graph::AddSplit(const op::Split* split) {
+        Tensor* input = GetTensor(split->Inputs()[0].Get());
+        std::vector<Tensor*> outputs;
+        for (auto& output : split->Outputs()) {
+            outputs.push_back(CreateTensor(output.Get()));
+        }
+        int32_t axis = split->GetAxis();
+        if (axis < 0) {
+            axis += input->shape.size();
+        }
+        mKernels.push_back([=](std::vector<float>*) {
+            const size_t elementSize = utils::OperandTypeByteSize(input->type);
+            const size_t outer = ShapeSize(input->shape, 0, axis);
+            const size_t inputRow = ShapeSize(input->shape, axis, input->shape.size());
+            size_t offset = 0;
+            for (Tensor* output : outputs) {
+                const size_t outputRow = ShapeSize(output->shape, axis, output->shape.size());
+                for (size_t o = 0; o < outer; ++o) {
+                    memcpy(output->data.data() + o * outputRow * elementSize,
+                           input->data.data() + (o * inputRow + offset) * elementSize,
+                           outputRow * elementSize);
+                }
+                offset += outputRow;
+            }
+        });
+        return {};
+    }
+
+    MaybeError Graph::AddSqueeze(const op::Squeeze* squeeze) {
+        Tensor* input = GetTensor(squeeze->Inputs()[0].Get());
+        Tensor* output = CreateTensor(squeeze->PrimaryOutput());
+        mKernels.push_back(
+            [=]() { memcpy(output->data.data(), input->data.data(), output->ByteLength()); });
+        return {};
+    }
+
+    MaybeError Graph::AddTranspose(const op::Transpose* transpose) {
+        Tensor* input = GetTensor(transpose->Inputs()[0].Get());
+        Tensor* output = CreateTensor(transpose->PrimaryOutput());
+        const std::vector<int32_t> permutation = transpose->GetPermutation();
+        ThreadPool* pool = mThreadPool;
+        mKernels.push_back([=](std::vector<float>*) {
+            TransposeData(pool, input->data.data(), output->data.data(),
+                          utils::OperandTypeByteSize(input->type), input->shape, permutation);
+        });
+        return {};
+    }
+
+    MaybeError Graph::AddUnary(const op::Unary* unary) {
+        Tensor* input = GetTensor(unary->Inputs()[0].Get());
+        Tensor* output = CreateTensor(unary->PrimaryOutput());
+        if (!IsFloat32(unary)) {
+            SetUnsupported("unary ops only support float32.");
+            return {};
+        }
+        ThreadPool* pool = mThreadPool;
+        switch (unary->GetType()) {
+            case op::UnaryOpType::kAbs:
+                mKernels.push_back([=](std::vector<float>*) {
+                    Map(pool, input->Float(), output->Float(), output->ElementCount(),
+                        [](float x) { return fabsf(x); });
+                });
+                break;
+            case op::UnaryOpType::kCeil:
+                mKernels.push_back([=](std::vector<float>*) {
+                    Map(pool, input->Float(), output->Float(), output->ElementCount(),
+                        [](float x) { return ceilf(x); });
+                });
+                break;
+            case op::UnaryOpType::kCos:
+                mKernels.push_back([=](std::vector<float>*) {
+                    Map(pool, input->Float(), output->Float(), output->ElementCount(),
+                        [](float x) { return cosf(x); });
+                });
+                break;
+            case op::UnaryOpType::kExp:
+                mKernels.push_back([=](std::vector<float>*) {
+                    Map(pool, input->Float(), output->Float(), output->ElementCount(),
+                        [](float x) { return expf(x); });
+                });
+                break;
+            case op::UnaryOpType::kFloor:
+                mKernels.push_back([=](std::vector<float>*) {
+                    Map(pool, input->Float(), output->Float(), output->ElementCount(),
+                        [](float x) { return floorf(x); });
+                });
+                break;
+            case op::UnaryOpType::kHardSwish:
+                mKernels.push_back([=](std::vector<float>*) {
+                    Map(pool, input->Float(), output->Float(), output->ElementCount(), HardSwish);
+                });
+                break;
+            case op::UnaryOpType::kLog:
+                mKernels.push_back([=](std::vector<float>*) {
+                    Map(pool, input->Float(), output->Float(), output->ElementCount(),
+                        [](float x) { return logf(x); });
+                });
+                break;
+            case op::UnaryOpType::kLeakyRelu: {
+                const float alpha = static_cast<const op::LeakyRelu*>(unary)->GetAlpha();
+                mKernels.push_back([=](std::vector<float>*) {
+                    Map(pool, input->Float(), output->Float(), output->ElementCount(),
+                        [alpha](float x) { return x < 0 ? x * alpha : x; });
+                });
+                break;
+            }
+            case op::UnaryOpType::kNeg:
+                mKernels.push_back([=](std::vector<float>*) {
+                    Map(pool, input->Float(), output->Float(), output->ElementCount(),
+                        [](float x) { return -x; });
+                });
+                break;
+            case op::UnaryOpType::kRelu:
+                mKernels.push_back([=](std::vector<float>*) {
+                    Map(pool, input->Float(), output->Float(), output->ElementCount(),
+                        [](float x) { return std::max(x, 0.0f); });
+                });
+                break;
+            case op::UnaryOpType::kSigmoid:
+                mKernels.push_back([=](std::vector<float>*) {
+                    Map(pool, input->Float(), output->Float(), output->ElementCount(), Sigmoid);
+                });
+                break;
+            case op::UnaryOpType::kSin:
+                mKernels.push_back([=](std::vector<float>*) {
+                    Map(pool, input->Float(), output->Float(), output->ElementCount(),
+                        [](float x) { return sinf(x); });
+                });
+                break;
+            case op::UnaryOpType::kTan:
+                mKernels.push_back([=](std::vector<float>*) {
+                    Map(pool, input->Float(), output->Float(), output->ElementCount(),
+                        [](float x) { return tanf(x); });
+                });
+                break;
+            case op::UnaryOpType::kTanh:
+                mKernels.push_back([=](std::vector<float>*) {
+                    Map(pool, input->Float(), output->Float(), output->ElementCount(),
+                        [](float x) { return tanhf(x); });
+                });
+                break;
+            case op::UnaryOpType::kSoftmax:
+                mKernels.push_back([=](std::vector<float>*) {
+                    const size_t rows = input->shape[0], cols = input->shape[1];
+                    const float* src = input->Float();
+                    float* dst = output->Float();
+                    ParallelFor(pool, rows, cols, [&](size_t begin, size_t end) {
+                        for (size_t i = begin; i < end; ++i) {
+                            const float* x = src + i * cols;
+                            float* y = dst + i * cols;
+                            const float maxValue = *std::max_element(x, x + cols);
+                            float sum = 0;
+                            for (size_t j = 0; j < cols; ++j) {
+                                y[j] = expf(x[j] - maxValue);
+                                sum += y[j];
+                            }
+                            for (size_t j = 0; j < cols; ++j) {
+                                y[j] /= sum;
+                            }
+                        }
+                    });
+                });
+                break;
+            default:
+                return DAWN_UNIMPLEMENTED_ERROR("The unary op type isn't supported.");
+        }
+        return {};
+    }
+
+    MaybeError Graph::Finish() {
+        return {};
+    }
+
+    MaybeError Graph::CompileImpl() {
+        return {};
+    }
+
+    MaybeError Graph::Evaluate() {
+        DAWN_INVALID_IF(!mInputs.empty(), "Only graphs without inputs can be evaluated.");
+        DAWN_INVALID_IF(!mUnsupportedReason.empty(), mUnsupportedReason);
+        std::lock_guard<std::mutex> lock(mComputeMutex);
+        std::vector<float> scratch;
+        for (auto& kernel : mKernels) {
+            kernel(&scratch);
+        }
+        return {};
+    }
+
+    MaybeError Graph::ComputeImpl(NamedInputsBase* inputs, NamedOutputsBase* outputs) {
+        DAWN_INVALID_IF(!mUnsupportedReason.empty(), mUnsupportedReason);
+        std::lock_guard<std::mutex> lock(mComputeMutex);
+        for (auto& [name, input] : inputs->GetRecords()) {
+            DAWN_INVALID_IF(mInputs.find(name) == mInputs.end(), "Invalid input " + name + ".");
+            Tensor* tensor = mInputs.at(name);
+            auto& resource = input.resource.arrayBufferView;
+            DAWN_INVALID_IF(resource.buffer == nullptr,
+                            "The reference backend only supports array buffer inputs.");
+            DAWN_INVALID_IF(resource.byteLength < tensor->ByteLength(),
+                            "The size of input buffer is less than input memory.");
+            memcpy(tensor->data.data(), static_cast<int8_t*>(resource.buffer) + resource.byteOffset,
+                   tensor->ByteLength());
+        }
+
+        {
+            ScopedKernelProfile profile(nullptr, "reference", 0);
+            std::vector<float> scratch;
+            for (auto& kernel : mKernels) {
+                kernel(&scratch);
+            }
+        }
+
+        for (auto& [name, output] : outputs->GetRecords()) {
+            DAWN_INVALID_IF(mOutputs.find(name) == mOutputs.end(), "Invalid output " + name + ".");
+            Tensor* tensor = mOutputs.at(name);
+            const ArrayBufferView& arrayBufferView = output.arrayBufferView;
+            DAWN_INVALID_IF(arrayBufferView.buffer == nullptr,
+                            "The reference backend only supports array buffer outputs.");
+            DAWN_INVALID_IF(arrayBufferView.byteLength < tensor->ByteLength(),
+                            "The size of output buffer is less than output memory.");
+            memcpy(static_cast<int8_t*>(arrayBufferView.buffer) + arrayBufferView.byteOffset,
+                   tensor->data.data(), tensor->ByteLength());
+        }
+        return {};
+    }
+
+}  // namespace webnn::native::reference
@@ -0,0 +1,118 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef WEBNN_NATIVE_REFERENCE_GRAPH_REFERENCE_H_
+#define WEBNN_NATIVE_REFERENCE_GRAPH_REFERENCE_H_
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "webnn/native/Error.h"
+#include "webnn/native/Graph.h"
+#include "webnn/native/Operand.h"
+
+namespace webnn::native::reference {
+
+    class ThreadPool;
+
+    // A host tensor owned by the reference graph. Arithmetic kernels work on float32 data, data
+    // movement kernels (concat, slice, transpose...) work on any element size.
+    struct Tensor {
+        Tensor(wnn::OperandType type, std::vector<int32_t> shape);
+
+        size_t ElementCount() const;
+        size_t ByteLength() const {
+            return data.size();
+        }
+        float* Float() {
+            return reinterpret_cast<float*>(data.data());
+        }
+        const float* Float() const {
+            return reinterpret_cast<const float*>(data.data());
+        }
+
+        wnn::OperandType type;
+        std::vector<int32_t> shape;
+        std::vector<char> data;
+    };
+
+    // A portable, dependency free CPU executor for every operator in webnn/native/ops. It is
+    // the compute path of the Null backend and is meant to be simple and correct rather than
+    // fast: loops are written over contiguous innermost dimensions so that compilers can
+    // vectorize them, and the outer dimensions are spread across a ThreadPool.
+    class Graph : public GraphBase {
+      public:
+        Graph(ContextBase* context, ThreadPool* threadPool);
+        ~Graph() override = default;
+
+        virtual MaybeError AddConstant(const op::Constant* constant) override;
+        virtual MaybeError AddInput(const op::Input* input) override;
+        virtual MaybeError AddOutput(std::string_view name, const OperandBase* output) override;
+        virtual MaybeError AddBatchNorm(const op::BatchNorm* batchNorm) override;
+        virtual MaybeError AddBinary(const op::Binary* binary) override;
+        virtual MaybeError AddClamp(const op::Clamp* clamp) override;
+        virtual MaybeError AddConcat(const op::Concat* concat) override;
+        virtual MaybeError AddConv2d(const op::Conv2d* conv2d) override;
+        virtual MaybeError AddConvTranspose2d(const op::ConvTranspose2d* convTranspose2d) override;
+        virtual MaybeError AddGemm(const op::Gemm* gemm) override;
+        virtual MaybeError AddGru(const op::Gru* gru) override;
+        virtual MaybeError AddInstanceNorm(const op::InstanceNorm* instanceNorm) override;
+        virtual MaybeError AddPad(const op::Pad* pad) override;
+        virtual MaybeError AddPool2d(const op::Pool2d* pool2d) override;
+        virtual MaybeError AddReduce(const op::Reduce* reduce) override;
+        virtual MaybeError AddResample2d(const op::Resample2d* resample2d) override;
+        virtual MaybeError AddReshape(const op::Reshape* reshape) override;
+        virtual MaybeError AddSlice(const op::Slice* slice) override;
+        virtual MaybeError AddSplit(const op::Split* split) override;
+        virtual MaybeError AddSqueeze(const op::Squeeze* squeeze) override;
+        virtual MaybeError AddTranspose(const op::Transpose* transpose) override;
+        virtual MaybeError AddUnary(const op::Unary* unary) override;
+        virtual MaybeError Finish() override;
+        virtual bool SupportsFusedActivation(const op::Conv2d* conv2d,
+                                             FusionType type) const override;
+        virtual bool SupportsOperator(const OperatorBase* op) const override;
+
+        // Runs the kernels of a graph made of constants only, the values are then read with
+        // GetTensor. Used by constant folding while building graphs of other backends.
+        MaybeError Evaluate();
+        Tensor* GetTensor(const OperandBase* operand) const;
+
+      private:
+        MaybeError CompileImpl() override;
+        MaybeError ComputeImpl(NamedInputsBase* inputs, NamedOutputsBase* outputs) override;
+
+        Tensor* CreateTensor(const OperandBase* operand);
+        // Records that |op| can't be run by the float32 kernels. Building still succeeds so that
+        // validation keeps working, computing reports the reason. SupportsOperator reports it to
+        // the partitioned graphs, which then fail to build rather than to compute.
+        void SetUnsupported(const std::string& reason);
+
+        ThreadPool* mThreadPool;
+        std::unordered_map<const OperandBase*, std::unique_ptr<Tensor>> mTensors;
+        std::unordered_map<std::string, Tensor*> mInputs;
+        std::unordered_map<std::string, Tensor*> mOutputs;
+        // The kernels read and write the tensors of the graph, so computes are serialized. The
+        // scratch memory a kernel needs is owned by the compute that runs it.
+        std::vector<std::function<void(std::vector<float>* scratch)>> mKernels;
+        std::mutex mComputeMutex;
+        std::string mUnsupportedReason;
+    };
+
+}  // namespace webnn::native::reference
+
+#endif  // WEBNN_NATIVE_REFERENCE_GRAPH_REFERENCE_H_
@@ -0,0 +1,120 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "webnn/native/reference/ThreadPool.h"
+
+#include <algorithm>
+
+#include "webnn/native/CpuThreadOptions.h"
+
+namespace webnn::native::reference {
+
+    namespace {
+        // Each participant gets a few chunks so that uneven rows are balanced.
+        constexpr size_t kChunksPerThread = 4;
+    }  // namespace
+
+    ThreadPool::ThreadPool(uint32_t threadCount, std::vector<uint32_t> affinity)
+        : mThreadCount(std::max(threadCount, 1u)), mAffinity(std::move(affinity)) {
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStop = true;
+        }
+        mWorkAvailable.notify_all();
+        for (auto& worker : mWorkers) {
+            worker.join();
+        }
+    }
+
+    // static
+    void ThreadPool::ParallelFor(ThreadPool* pool, size_t count, const Task& task) {
+        if (count == 0) {
+            return;
+        }
+        if (pool == nullptr || pool->mThreadCount == 1 || count == 1) {
+            task(0, count);
+            return;
+        }
+        pool->Run(count, task);
+    }
+
+    void ThreadPool::StartWorkers() {
+        // Workers are started lazily so that contexts which never compute don't own threads.
+        if (!mWorkers.empty()) {
+            return;
+        }
+        for (uint32_t i = 1; i < mThreadCount; ++i) {
+            mWorkers.emplace_back(&ThreadPool::WorkerLoop, this);
+        }
+    }
+
+    void ThreadPool::Run(size_t count, const Task& task) {
+        std::lock_guard<std::mutex> runLock(mRunMutex);
+        StartWorkers();
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mTask = &task;
+            mCount = count;
+            mChunkCount = std::min(count, size_t(mThreadCount) * kChunksPerThread);
+            mNextChunk = 0;
+            mActiveWorkers = mWorkers.size();
+            ++mGeneration;
+        }
+        mWorkAvailable.notify_all();
+        RunChunks();
+
+        std::unique_lock<std::mutex> lock(mMutex);
+        mWorkDone.wait(lock, [this] { return mActiveWorkers == 0; });
+        mTask = nullptr;
+    }
+
+    void ThreadPool::RunChunks() {
+        for (;;) {
+            size_t chunk = mNextChunk.fetch_add(1);
+            if (chunk >= mChunkCount) {
+                return;
+            }
+            size_t begin = chunk * mCount / mChunkCount;
+            size_t end = (chunk + 1) * mCount / mChunkCount;
+            (*mTask)(begin, end);
+        }
+    }
+
+    void ThreadPool::WorkerLoop() {
+        SetCurrentThreadAffinity(mAffinity);
+        uint64_t generation = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mWorkAvailable.wait(lock,
+                                    [this, generation] { return mStop || mGeneration != generation; });
+                if (mStop) {
+                    return;
+                }
+                generation = mGeneration;
+            }
+            RunChunks();
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                if (--mActiveWorkers == 0) {
+                    mWorkDone.notify_one();
+                }
+            }
+        }
+    }
+
+}  // namespace webnn::native::reference
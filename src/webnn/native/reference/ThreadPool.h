@@ -0,0 +1,72 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef WEBNN_NATIVE_REFERENCE_THREADPOOL_H_
+#define WEBNN_NATIVE_REFERENCE_THREADPOOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace webnn::native::reference {
+
+    // A minimal fork-join pool used by the reference kernels. The calling thread always takes
+    // part in the work, so a pool created with one thread runs everything inline.
+    class ThreadPool {
+      public:
+        using Task = std::function<void(size_t begin, size_t end)>;
+
+        // The workers are restricted to the processors in |affinity| unless it's empty.
+        explicit ThreadPool(uint32_t threadCount, std::vector<uint32_t> affinity = {});
+        ~ThreadPool();
+
+        uint32_t GetThreadCount() const {
+            return mThreadCount;
+        }
+
+        // Splits [0, count) into chunks and runs |task| on them. Returns once every chunk has
+        // been processed. A null pool runs the whole range on the calling thread.
+        static void ParallelFor(ThreadPool* pool, size_t count, const Task& task);
+
+      private:
+        void Run(size_t count, const Task& task);
+        void StartWorkers();
+        void WorkerLoop();
+        void RunChunks();
+
+        const uint32_t mThreadCount;
+        const std::vector<uint32_t> mAffinity;
+        std::vector<std::thread> mWorkers;
+
+        // Serializes concurrent ParallelFor calls from different graphs.
+        std::mutex mRunMutex;
+
+        std::mutex mMutex;
+        std::condition_variable mWorkAvailable;
+        std::condition_variable mWorkDone;
+        const Task* mTask = nullptr;
+        size_t mCount = 0;
+        size_t mChunkCount = 0;
+        std::atomic<size_t> mNextChunk{0};
+        size_t mActiveWorkers = 0;
+        uint64_t mGeneration = 0;
+        bool mStop = false;
+    };
+
+}  // namespace webnn::native::reference
+
+#endif  // WEBNN_NATIVE_REFERENCE_THREADPOOL_H_
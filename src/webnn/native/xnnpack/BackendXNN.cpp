@@ -35,6 +35,9 @@ namespace webnn::native::xnnpack {
         if (mThreadpool != NULL) {
             pthreadpool_destroy(mThreadpool);
         }
+        for (auto& [options, threadpool] : mThreadpools) {
+            pthreadpool_destroy(threadpool);
+        }
     }
 
     MaybeError Backend::Initialize() {
@@ -59,10 +62,41 @@ namespace webnn::native::xnnpack {
             dawn::ErrorLog() << "XNNPACK backend only supports CPU device.";
             return nullptr;
         }
-        Ref<ContextBase> context = AcquireRef(new Context(mThreadpool));
+        CpuThreadOptions threadOptions =
+            ResolveCpuThreadOptions(options != nullptr ? *options : ContextOptions{});
+        pthreadpool_t threadpool = GetThreadpool(threadOptions);
+        if (threadpool == NULL) {
+            return nullptr;
+        }
+        Ref<ContextBase> context = AcquireRef(new Context(options, threadpool));
         return context.Detach();
     }
 
+    pthreadpool_t Backend::GetThreadpool(const CpuThreadOptions& options) {
+        // The wait policy is a flag of the runtimes, the pools only differ in their threads.
+        CpuThreadOptions key = options;
+        key.waitPolicy = wnn::ThreadWaitPolicy::Default;
+        if (key.IsDefault()) {
+            return mThreadpool;
+        }
+        std::lock_guard<std::mutex> lock(mThreadpoolsMutex);
+        auto iter = mThreadpools.find(key);
+        if (iter != mThreadpools.end()) {
+            return iter->second;
+        }
+        // pthreadpool doesn't take an affinity, the workers inherit the one of the thread
+        // creating them.
+        ScopedThreadAffinity affinity(key.affinity);
+        pthreadpool_t threadpool =
+            pthreadpool_create(GetThreadCount(key, std::thread::hardware_concurrency() / 2));
+        if (threadpool == NULL) {
+            dawn::ErrorLog() << "pthreadpool_create failed";
+            return NULL;
+        }
+        mThreadpools.emplace(key, threadpool);
+        return threadpool;
+    }
+
     BackendConnection* Connect(InstanceBase* instance) {
         Backend* backend = new Backend(instance);
 
@@ -21,7 +21,9 @@
 
 #include <xnnpack.h>
 
+#include <map>
 #include <memory>
+#include <mutex>
 
 namespace webnn::native::xnnpack {
 
@@ -34,7 +36,12 @@ namespace webnn::native::xnnpack {
         ContextBase* CreateContext(ContextOptions const* options = nullptr) override;
 
       private:
+        // Returns the pool shared by the contexts created with the same thread options.
+        pthreadpool_t GetThreadpool(const CpuThreadOptions& options);
+
         pthreadpool_t mThreadpool;
+        std::mutex mThreadpoolsMutex;
+        std::map<CpuThreadOptions, pthreadpool_t> mThreadpools;
     };
 
 }  // namespace webnn/native::xnnpack
@@ -22,13 +22,21 @@
 
 namespace webnn::native::xnnpack {
 
-    Context::Context(pthreadpool_t threadpool) : mThreadpool(threadpool) {
+    Context::Context(ContextOptions const* options, pthreadpool_t threadpool)
+        : ContextBase(options), mThreadpool(threadpool) {
     }
 
     pthreadpool_t Context::GetThreadpool() {
         return mThreadpool;
     }
 
+    uint32_t Context::GetRuntimeFlags() const {
+        // The workers yield by default so that idle contexts don't hold on to cores.
+        return GetCpuThreadOptions().waitPolicy == wnn::ThreadWaitPolicy::Spin
+                   ? 0
+                   : XNN_FLAG_YIELD_WORKERS;
+    }
+
     GraphBase* Context::CreateGraphImpl() {
         return new Graph(this);
     }
@@ -23,10 +23,12 @@ namespace webnn::native::xnnpack {
 
     class Context : public ContextBase {
       public:
-        explicit Context(pthreadpool_t threadpool);
+        Context(ContextOptions const* options, pthreadpool_t threadpool);
         ~Context() override = default;
 
         pthreadpool_t GetThreadpool();
+        // The flags of the runtimes that follow the wait policy of the options.
+        uint32_t GetRuntimeFlags() const;
 
       private:
         GraphBase* CreateGraphImpl() override;
@@ -15,7 +15,9 @@
 #include "webnn/native/xnnpack/GraphXNN.h"
 
 #include <math.h>
+#include <algorithm>
 #include <numeric>
+#include <string>
 
 #include "common/Assert.h"
 #include "common/Log.h"
@@ -23,6 +25,8 @@
 #include "webnn/native/NamedInputs.h"
 #include "webnn/native/NamedOutputs.h"
 #include "webnn/native/Operand.h"
+#include "webnn/native/Profiler.h"
+#include "webnn/native/Utils.h"
 #include "webnn/native/xnnpack/ContextXNN.h"
 
 #define FAILED(status) (((xnn_status)(status)) != xnn_status_success)
@@ -58,10 +62,16 @@ const char* xnn_status2str(xnn_status v) {
             COMPLAIN_XNN_ERROR_AND_RETURN_XNN_ERROR(#f, s_); \
     } while (0)
 
+// The parameters XNNPACK rejects are reported as unimplemented so that the graph can fall back
+// to the reference backend for them.
 #define COMPLAIN_XNN_ERROR_AND_RETURN_DAWN_ERROR(what, status)                              \
     do {                                                                                    \
         std::string message = std::string(what) + std::string(" returns XNNPACK error: ") + \
                               std::string(xnn_status2str(s_));                              \
+        if (s_ == xnn_status_invalid_parameter || s_ == xnn_status_unsupported_parameter || \
+            s_ == xnn_status_unsupported_hardware) {                                        \
+            return DAWN_UNIMPLEMENTED_ERROR(message.c_str());                               \
+        }                                                                                   \
         return DAWN_INTERNAL_ERROR(message.c_str());                                        \
     } while (0)
 
@@ -86,19 +96,244 @@ namespace webnn::native::xnnpack {
             }
             return xnn_status_success;
         }
+
+        // Copies |source| of |shape| to |destination| with the dimensions reordered by
+        // |permutation|, dimension i of the destination is dimension permutation[i] of the source.
+        void PermuteData(const float* source,
+                         const std::vector<int32_t>& shape,
+                         const std::vector<int32_t>& permutation,
+                         float* destination) {
+            const size_t rank = shape.size();
+            std::vector<size_t> strides(rank, 1);
+            for (size_t i = rank; i > 1; --i) {
+                strides[i - 2] = strides[i - 1] * shape[i - 1];
+            }
+            size_t count = 1;
+            for (int32_t dimension : shape) {
+                count *= dimension;
+            }
+            std::vector<size_t> index(rank, 0);
+            for (size_t i = 0; i < count; ++i) {
+                size_t offset = 0;
+                for (size_t d = 0; d < rank; ++d) {
+                    offset += index[d] * strides[permutation[d]];
+                }
+                destination[i] = source[offset];
+                for (size_t d = rank; d-- > 0;) {
+                    if (++index[d] < static_cast<size_t>(shape[permutation[d]])) {
+                        break;
+                    }
+                    index[d] = 0;
+                }
+            }
+        }
+
+        // Whether permuting |shape| by |permutation| keeps the elements in the same order, i.e.
+        // only moves dimensions of size 1, so that it is a reshape.
+        bool IsReshape(const std::vector<int32_t>& shape, const std::vector<int32_t>& permutation) {
+            int32_t last = -1;
+            for (int32_t axis : permutation) {
+                if (shape[axis] == 1) {
+                    continue;
+                }
+                if (axis < last) {
+                    return false;
+                }
+                last = axis;
+            }
+            return true;
+        }
+
+        // Returns |shape| with its dimensions reordered by |permutation|.
+        std::vector<int32_t> PermuteShape(const std::vector<int32_t>& shape,
+                                          const std::vector<int32_t>& permutation) {
+            std::vector<int32_t> permuted;
+            for (int32_t axis : permutation) {
+                permuted.push_back(shape[axis]);
+            }
+            return permuted;
+        }
+
+        // Returns the permutation reordering the dimensions by |first| and then by |second|.
+        std::vector<int32_t> ComposePermutations(const std::vector<int32_t>& first,
+                                                 const std::vector<int32_t>& second) {
+            std::vector<int32_t> composed;
+            for (int32_t axis : second) {
+                composed.push_back(first[axis]);
+            }
+            return composed;
+        }
+
+        bool IsIdentity(const std::vector<int32_t>& permutation) {
+            for (size_t i = 0; i < permutation.size(); ++i) {
+                if (permutation[i] != static_cast<int32_t>(i)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // Concatenates |count| values of |dims| along |axis|, XNNPACK has nodes for up to 4.
+        xnn_status DefineXnnConcatenateNode(xnn_subgraph_t subgraph,
+                                            size_t axis,
+                                            const uint32_t* inputIds,
+                                            size_t count,
+                                            const std::vector<size_t>& dims,
+                                            uint32_t outputId) {
+            switch (count) {
+                case 1:
+                    XNN_TRY(xnn_define_static_reshape(subgraph, dims.size(), dims.data(),
+                                                      inputIds[0], outputId, 0));
+                    break;
+                case 2:
+                    XNN_TRY(xnn_define_concatenate2(subgraph, axis, inputIds[0], inputIds[1],
+                                                    outputId, 0));
+                    break;
+                case 3:
+                    XNN_TRY(xnn_define_concatenate3(subgraph, axis, inputIds[0], inputIds[1],
+                                                    inputIds[2], outputId, 0));
+                    break;
+                case 4:
+                    XNN_TRY(xnn_define_concatenate4(subgraph, axis, inputIds[0], inputIds[1],
+                                                    inputIds[2], inputIds[3], outputId, 0));
+                    break;
+                default:
+                    UNREACHABLE();
+            }
+            return xnn_status_success;
+        }
+
+        // Concatenates the values |inputIds| of |inputDims| along |axis| into |outputId| of
+        // |outputDims|. More than 4 values are concatenated by a tree of nodes, each level
+        // concatenates runs of up to 4 values of the level below into internal values.
+        xnn_status DefineXnnConcatenate(xnn_subgraph_t subgraph,
+                                        size_t axis,
+                                        std::vector<uint32_t> inputIds,
+                                        std::vector<std::vector<size_t>> inputDims,
+                                        const std::vector<size_t>& outputDims,
+                                        uint32_t outputId) {
+            constexpr size_t kMaxConcatInputs = 4;
+            while (inputIds.size() > kMaxConcatInputs) {
+                std::vector<uint32_t> levelIds;
+                std::vector<std::vector<size_t>> levelDims;
+                for (size_t i = 0; i < inputIds.size(); i += kMaxConcatInputs) {
+                    const size_t count = std::min(kMaxConcatInputs, inputIds.size() - i);
+                    std::vector<size_t> dims = inputDims[i];
+                    for (size_t j = 1; j < count; ++j) {
+                        dims[axis] += inputDims[i + j][axis];
+                    }
+                    uint32_t id = inputIds[i];
+                    if (count > 1) {
+                        XNN_TRY(xnn_define_tensor_value(subgraph, xnn_datatype_fp32, dims.size(),
+                                                        dims.data(), nullptr,
+                                                        XNN_INVALID_VALUE_ID, 0, &id));
+                        XNN_TRY(DefineXnnConcatenateNode(subgraph, axis, &inputIds[i], count, dims,
+                                                         id));
+                    }
+                    levelIds.push_back(id);
+                    levelDims.push_back(std::move(dims));
+                }
+                inputIds = std::move(levelIds);
+                inputDims = std::move(levelDims);
+            }
+            XNN_TRY(DefineXnnConcatenateNode(subgraph, axis, inputIds.data(), inputIds.size(),
+                                             outputDims, outputId));
+            return xnn_status_success;
+        }
+
+        // Splits |inputId| of |dims| along its first dimension into values of one row each,
+        // appended to |outputIds| in order. XNNPACK has even split nodes for up to 4 outputs,
+        // so the rows are split by a tree of them, which fails if a level can't be split evenly.
+        xnn_status DefineXnnSplitRows(xnn_subgraph_t subgraph,
+                                      uint32_t inputId,
+                                      const std::vector<size_t>& dims,
+                                      std::vector<uint32_t>* outputIds) {
+            const size_t count = dims[0];
+            if (count == 1) {
+                outputIds->push_back(inputId);
+                return xnn_status_success;
+            }
+            size_t parts = 0;
+            for (size_t candidate : {4, 3, 2}) {
+                if (count % candidate == 0) {
+                    parts = candidate;
+                    break;
+                }
+            }
+            if (parts == 0) {
+                dawn::ErrorLog() << "XNNPACK backend can't split " << count << " rows evenly.";
+                return xnn_status_unsupported_parameter;
+            }
+            std::vector<size_t> partDims = dims;
+            partDims[0] = count / parts;
+            uint32_t partIds[4];
+            for (size_t i = 0; i < parts; ++i) {
+                XNN_TRY(xnn_define_tensor_value(subgraph, xnn_datatype_fp32, partDims.size(),
+                                                partDims.data(), nullptr, XNN_INVALID_VALUE_ID, 0,
+                                                &partIds[i]));
+            }
+            switch (parts) {
+                case 2:
+                    XNN_TRY(
+                        xnn_define_even_split2(subgraph, 0, inputId, partIds[0], partIds[1], 0));
+                    break;
+                case 3:
+                    XNN_TRY(xnn_define_even_split3(subgraph, 0, inputId, partIds[0], partIds[1],
+                                                   partIds[2], 0));
+                    break;
+                case 4:
+                    XNN_TRY(xnn_define_even_split4(subgraph, 0, inputId, partIds[0], partIds[1],
+                                                   partIds[2], partIds[3], 0));
+                    break;
+                default:
+                    UNREACHABLE();
+            }
+            for (size_t i = 0; i < parts; ++i) {
+                XNN_TRY(DefineXnnSplitRows(subgraph, partIds[i], partDims, outputIds));
+            }
+            return xnn_status_success;
+        }
+
+        // Whether |count| rows can be split by DefineXnnSplitRows.
+        bool CanSplitRows(size_t count) {
+            for (size_t factor : {2, 3}) {
+                while (count % factor == 0) {
+                    count /= factor;
+                }
+            }
+            return count == 1;
+        }
+
+        // XNNPACK only runs a 1x1 conv2d with the sparse kernels if at least two thirds of its
+        // weights are zero.
+        constexpr double kSparseInferenceThreshold = 2.0 / 3.0;
+
+        const std::vector<int32_t> kNchwToNhwc = {0, 2, 3, 1};
+        const std::vector<int32_t> kNhwcToNchw = {0, 3, 1, 2};
+        const std::vector<int32_t> kTransposeMatrix = {1, 0};
     }  // anonymous namespace
 
     Graph::Graph(Context* context)
         : GraphBase(context),
           mExternalId(0),
-          mRuntime(nullptr),
-          mNamedInputs(nullptr),
-          mNamedOutputs(nullptr) {
+          mPointwiseWeightCount(0),
+          mPointwiseZeroCount(0),
+          mSparseInference(false),
+          mSubgraph(nullptr),
+          mContextCount(0),
+          mMaxContexts(1) {
     }
 
     Graph::~Graph() {
-        if (mRuntime) {
-            xnn_delete_runtime(mRuntime);
+        mIdleContexts.clear();
+        if (mSubgraph) {
+            xnn_delete_subgraph(mSubgraph);
+        }
+    }
+
+    Graph::ExecutionContext::~ExecutionContext() {
+        if (runtime) {
+            xnn_delete_runtime(runtime);
         }
     }
 
@@ -136,6 +371,7 @@ namespace webnn::native::xnnpack {
     GRAPH_ADD_OP(Reshape)
     GRAPH_ADD_OP(Split)
     GRAPH_ADD_OP(Squeeze)
+    GRAPH_ADD_OP(Transpose)
     GRAPH_ADD_OP(Unary)
 
     xnn_status Graph::DefineXnnTensorValue(xnn_subgraph_t subgraph,
@@ -168,8 +404,462 @@ namespace webnn::native::xnnpack {
         return xnn_status_success;
     }
 
+    xnn_status Graph::DefineXnnPermutedConstant(xnn_subgraph_t subgraph,
+                                                const OperandBase* constant,
+                                                const std::vector<int32_t>& permutation,
+                                                uint32_t* id,
+                                                float scale) {
+        DAWN_ASSERT(mConstantData.find(constant) != mConstantData.end());
+        if (constant->Type() != wnn::OperandType::Float32 ||
+            permutation.size() < constant->Shape().size()) {
+            return xnn_status_invalid_parameter;
+        }
+        std::vector<int32_t> shape(permutation.size() - constant->Shape().size(), 1);
+        shape.insert(shape.end(), constant->Shape().begin(), constant->Shape().end());
+        std::vector<size_t> dims;
+        size_t count = 1;
+        for (int32_t axis : permutation) {
+            dims.push_back(static_cast<size_t>(shape[axis]));
+            count *= dims.back();
+        }
+        std::unique_ptr<char[]> buffer(new char[count * sizeof(float)]);
+        if (buffer.get() == nullptr) {
+            return xnn_status_out_of_memory;
+        }
+        float* data = reinterpret_cast<float*>(buffer.get());
+        PermuteData(static_cast<const float*>(mConstantData.at(constant)), shape, permutation,
+                    data);
+        if (scale != 1.0f) {
+            for (size_t i = 0; i < count; ++i) {
+                data[i] *= scale;
+            }
+        }
+        XNN_TRY(DefineXnnInternalValue(subgraph, dims, id, buffer.get()));
+        mBuffers.push_back(std::move(buffer));
+        return xnn_status_success;
+    }
+
+    xnn_status Graph::DefineXnnInternalValue(xnn_subgraph_t subgraph,
+                                             const std::vector<size_t>& dims,
+                                             uint32_t* id,
+                                             const void* data) {
+        XNN_TRY(xnn_define_tensor_value(subgraph, xnn_datatype_fp32, dims.size(), dims.data(),
+                                        data, XNN_INVALID_VALUE_ID, 0, id));
+        return xnn_status_success;
+    }
+
+    xnn_status Graph::DefineXnnReshape(xnn_subgraph_t subgraph,
+                                       uint32_t inputId,
+                                       const std::vector<size_t>& dims,
+                                       uint32_t* id) {
+        XNN_TRY(DefineXnnInternalValue(subgraph, dims, id));
+        XNN_TRY(xnn_define_static_reshape(subgraph, dims.size(), dims.data(), inputId, *id, 0));
+        return xnn_status_success;
+    }
+
+    xnn_status Graph::DefineXnnMatMul(xnn_subgraph_t subgraph,
+                                      const OperandBase* a,
+                                      const OperandBase* b,
+                                      const OperandBase* output,
+                                      uint32_t outputId) {
+        DAWN_ASSERT(mOperands.find(a) != mOperands.end());
+        DAWN_ASSERT(mOperands.find(b) != mOperands.end());
+        uint32_t aId = mOperands.at(a);
+        uint32_t bId = mOperands.at(b);
+        // A 1-D a is a row and a 1-D b a column, both are then given the rank of the other with
+        // leading ones so that the batch dimensions line up.
+        std::vector<size_t> aDims(a->Shape().begin(), a->Shape().end());
+        std::vector<size_t> bDims(b->Shape().begin(), b->Shape().end());
+        if (aDims.size() == 1) {
+            aDims.insert(aDims.begin(), 1);
+        }
+        if (bDims.size() == 1) {
+            bDims.push_back(1);
+        }
+        const size_t rank = std::max(aDims.size(), bDims.size());
+        if (rank > XNN_MAX_TENSOR_DIMS) {
+            dawn::ErrorLog() << "XNNPACK backend doesn't support matmul rank " << rank;
+            return xnn_status_invalid_parameter;
+        }
+        aDims.insert(aDims.begin(), rank - aDims.size(), 1);
+        bDims.insert(bDims.begin(), rank - bDims.size(), 1);
+        std::vector<size_t> productDims(rank);
+        bool batched = false;
+        for (size_t i = 0; i < rank - 2; ++i) {
+            productDims[i] = std::max(aDims[i], bDims[i]);
+            batched = batched || bDims[i] != 1;
+        }
+        productDims[rank - 2] = aDims[rank - 2];
+        productDims[rank - 1] = bDims[rank - 1];
+        const std::vector<size_t> outputDims(output->Shape().begin(), output->Shape().end());
+        if (batched) {
+            // The XNNPACK the backend is built with has no batch matrix multiply node, each
+            // matrix of b must be the weights of a fully connected node.
+            if (mConstantData.find(b) == mConstantData.end()) {
+                dawn::ErrorLog() << "XNNPACK backend only supports matmul with a constant "
+                                    "batched b.";
+                return xnn_status_unsupported_parameter;
+            }
+            XNN_TRY(DefineXnnBatchedMatMul(subgraph, a, aDims, b, bDims, productDims,
+                                           outputDims, outputId));
+            return xnn_status_success;
+        }
+
+        if (aDims.size() != a->Shape().size()) {
+            XNN_TRY(DefineXnnReshape(subgraph, aId, aDims, &aId));
+        }
+        uint32_t productId = outputId;
+        if (productDims != outputDims) {
+            XNN_TRY(DefineXnnInternalValue(subgraph, productDims, &productId));
+        }
+        const float outputMin = -std::numeric_limits<float>::infinity();
+        const float outputMax = +std::numeric_limits<float>::infinity();
+        const std::vector<size_t> weightDims = {bDims[rank - 2], bDims[rank - 1]};
+        if (b->Shape().size() != 2) {
+            XNN_TRY(DefineXnnReshape(subgraph, bId, weightDims, &bId));
+        }
+        XNN_TRY(xnn_define_fully_connected(subgraph, outputMin, outputMax, aId, bId,
+                                           XNN_INVALID_VALUE_ID, productId,
+                                           XNN_FLAG_TRANSPOSE_WEIGHTS));
+        if (productId != outputId) {
+            XNN_TRY(xnn_define_static_reshape(subgraph, outputDims.size(), outputDims.data(),
+                                              productId, outputId, 0));
+        }
+        return xnn_status_success;
+    }
+
+    xnn_status Graph::DefineXnnBatchedMatMul(xnn_subgraph_t subgraph,
+                                             const OperandBase* a,
+                                             const std::vector<size_t>& aDims,
+                                             const OperandBase* b,
+                                             const std::vector<size_t>& bDims,
+                                             const std::vector<size_t>& productDims,
+                                             const std::vector<size_t>& outputDims,
+                                             uint32_t outputId) {
+        const size_t rank = productDims.size();
+        const size_t rows = aDims[rank - 2];
+        const size_t depth = aDims[rank - 1];
+        const size_t columns = bDims[rank - 1];
+        size_t batchCount = 1;
+        size_t aBatchCount = 1;
+        for (size_t i = 0; i < rank - 2; ++i) {
+            batchCount *= productDims[i];
+            aBatchCount *= aDims[i];
+        }
+        // The matrices of a are split from it with its batch dimensions flattened.
+        const std::vector<size_t> aMatricesDims = {aBatchCount, rows, depth};
+        DAWN_ASSERT(mOperands.find(a) != mOperands.end());
+        uint32_t aId = mOperands.at(a);
+        if (std::vector<size_t>(a->Shape().begin(), a->Shape().end()) != aMatricesDims) {
+            XNN_TRY(DefineXnnReshape(subgraph, aId, aMatricesDims, &aId));
+        }
+        std::vector<uint32_t> aMatrixIds;
+        XNN_TRY(DefineXnnSplitRows(subgraph, aId, aMatricesDims, &aMatrixIds));
+
+        const float outputMin = -std::numeric_limits<float>::infinity();
+        const float outputMax = +std::numeric_limits<float>::infinity();
+        const float* bData = static_cast<const float*>(mConstantData.at(b));
+        const std::vector<size_t> matrixDims = {1, rows, columns};
+        std::vector<uint32_t> productIds;
+        for (size_t i = 0; i < batchCount; ++i) {
+            // The matrices of a and b broadcast to the matrix i of the product.
+            size_t aIndex = 0;
+            size_t bIndex = 0;
+            size_t aStride = 1;
+            size_t bStride = 1;
+            size_t remainder = i;
+            for (size_t d = rank - 2; d-- > 0;) {
+                const size_t index = remainder % productDims[d];
+                remainder /= productDims[d];
+                aIndex += (aDims[d] == 1 ? 0 : index) * aStride;
+                bIndex += (bDims[d] == 1 ? 0 : index) * bStride;
+                aStride *= aDims[d];
+                bStride *= bDims[d];
+            }
+            uint32_t weightsId, productId;
+            XNN_TRY(DefineXnnInternalValue(subgraph, {depth, columns}, &weightsId,
+                                           bData + bIndex * depth * columns));
+            XNN_TRY(DefineXnnInternalValue(subgraph, matrixDims, &productId));
+            XNN_TRY(xnn_define_fully_connected(subgraph, outputMin, outputMax,
+                                               aMatrixIds[aIndex], weightsId,
+                                               XNN_INVALID_VALUE_ID, productId,
+                                               XNN_FLAG_TRANSPOSE_WEIGHTS));
+            productIds.push_back(productId);
+        }
+        const std::vector<size_t> productsDims = {batchCount, rows, columns};
+        uint32_t productsId = outputId;
+        if (productsDims != outputDims) {
+            XNN_TRY(DefineXnnInternalValue(subgraph, productsDims, &productsId));
+        }
+        XNN_TRY(DefineXnnConcatenate(subgraph, 0, std::move(productIds),
+                                     std::vector<std::vector<size_t>>(batchCount, matrixDims),
+                                     productsDims, productsId));
+        if (productsId != outputId) {
+            XNN_TRY(xnn_define_static_reshape(subgraph, outputDims.size(), outputDims.data(),
+                                              productsId, outputId, 0));
+        }
+        return xnn_status_success;
+    }
+
+    xnn_status Graph::DefineXnnScalarConstant(xnn_subgraph_t subgraph, float value, uint32_t* id) {
+        std::unique_ptr<char[]> buffer(new char[sizeof(float)]);
+        if (buffer.get() == nullptr) {
+            return xnn_status_out_of_memory;
+        }
+        memcpy(buffer.get(), &value, sizeof(float));
+        XNN_TRY(DefineXnnInternalValue(subgraph, {1}, id, buffer.get()));
+        mBuffers.push_back(std::move(buffer));
+        return xnn_status_success;
+    }
+
+    xnn_status Graph::DefineXnnActivation(xnn_subgraph_t subgraph,
+                                          const FusionOperatorBase* activation,
+                                          const std::vector<size_t>& dims,
+                                          uint32_t inputId,
+                                          uint32_t outputId) {
+        switch (activation->GetFusionType()) {
+            case FusionType::Sigmoid:
+                XNN_TRY(xnn_define_sigmoid(subgraph, inputId, outputId, 0));
+                break;
+            case FusionType::LeakyRelu:
+                XNN_TRY(xnn_define_leaky_relu(
+                    subgraph, static_cast<const op::FusionLeakyRelu*>(activation)->GetAlpha(),
+                    inputId, outputId, 0));
+                break;
+            case FusionType::HardSwish:
+                XNN_TRY(xnn_define_hardswish(subgraph, inputId, outputId, 0));
+                break;
+            case FusionType::Tanh: {
+                // XNNPACK has no tanh node, it is computed as 2 * sigmoid(2 * x) - 1.
+                const float outputMin = -std::numeric_limits<float>::infinity();
+                const float outputMax = +std::numeric_limits<float>::infinity();
+                uint32_t twoId, minusOneId, doubledId, sigmoidId, scaledId;
+                XNN_TRY(DefineXnnScalarConstant(subgraph, 2.0f, &twoId));
+                XNN_TRY(DefineXnnScalarConstant(subgraph, -1.0f, &minusOneId));
+                XNN_TRY(DefineXnnInternalValue(subgraph, dims, &doubledId));
+                XNN_TRY(DefineXnnInternalValue(subgraph, dims, &sigmoidId));
+                XNN_TRY(DefineXnnInternalValue(subgraph, dims, &scaledId));
+                XNN_TRY(xnn_define_multiply2(subgraph, outputMin, outputMax, inputId, twoId,
+                                             doubledId, 0));
+                XNN_TRY(xnn_define_sigmoid(subgraph, doubledId, sigmoidId, 0));
+                XNN_TRY(xnn_define_multiply2(subgraph, outputMin, outputMax, sigmoidId, twoId,
+                                             scaledId, 0));
+                XNN_TRY(xnn_define_add2(subgraph, outputMin, outputMax, scaledId, minusOneId,
+                                        outputId, 0));
+                break;
+            }
+            default:
+                dawn::ErrorLog() << "XNNPACK backend doesn't support fused operator "
+                                 << static_cast<int>(activation->GetFusionType());
+                return xnn_status_invalid_parameter;
+        }
+        return xnn_status_success;
+    }
+
+    void Graph::AddPermutedInput(const OperandBase* operand,
+                                 const std::vector<int32_t>& permutation) {
+        DAWN_ASSERT(mInputs.find(operand) != mInputs.end());
+        if (operand->Type() != wnn::OperandType::Float32) {
+            return;
+        }
+        for (auto& permuted : mPermutedExternals) {
+            if (permuted.operand == operand && permuted.permutation == permutation) {
+                return;
+            }
+        }
+        const op::Input* input = reinterpret_cast<const op::Input*>(operand->Operator());
+        mPermutedExternals.push_back(
+            {input->GetName(), operand, mExternalId++, operand->Shape(), permutation, false});
+    }
+
+    xnn_status Graph::GetXnnPermutedInput(const OperandBase* operand,
+                                          const std::vector<int32_t>& permutation,
+                                          uint32_t* id) {
+        for (auto& permuted : mPermutedExternals) {
+            if (permuted.operand == operand && permuted.permutation == permutation &&
+                !permuted.isOutput) {
+                *id = permuted.id;
+                return xnn_status_success;
+            }
+        }
+        dawn::ErrorLog() << "XNNPACK backend only permutes graph inputs and outputs.";
+        return xnn_status_unsupported_parameter;
+    }
+
+    xnn_status Graph::DefineXnnPermutedOutput(xnn_subgraph_t subgraph,
+                                              const OperandBase* operand,
+                                              const std::vector<int32_t>& shape,
+                                              const std::vector<int32_t>& permutation,
+                                              uint32_t* id) {
+        DAWN_ASSERT(mOutputs.find(operand) != mOutputs.end());
+        if (operand->Type() != wnn::OperandType::Float32) {
+            return xnn_status_invalid_parameter;
+        }
+        const uint32_t externalId = mOutputs.at(operand);
+        std::string name;
+        for (auto& [externalName, value] : mExternals) {
+            if (value.id == externalId) {
+                name = externalName;
+            }
+        }
+        const std::vector<size_t> dims(shape.begin(), shape.end());
+        XNN_TRY(xnn_define_tensor_value(subgraph, xnn_datatype_fp32, dims.size(), dims.data(),
+                                        nullptr, externalId, XNN_VALUE_FLAG_EXTERNAL_OUTPUT, id));
+        mPermutedExternals.push_back({name, operand, externalId, shape, permutation, true});
+        return xnn_status_success;
+    }
+
+    bool Graph::RunsInNhwc(const OperatorInfo& info) {
+        if (info.type == OperatorType::Conv2d) {
+            return reinterpret_cast<const op::Conv2d*>(info.op)->GetOptions()->inputLayout ==
+                   wnn::InputOperandLayout::Nchw;
+        } else if (info.type == OperatorType::Pool2d) {
+            return reinterpret_cast<const op::Pool2d*>(info.op)->GetOptions()->layout ==
+                   wnn::InputOperandLayout::Nchw;
+        }
+        return false;
+    }
+
+    bool Graph::CanRunInNhwc(const OperatorInfo& info,
+                             const std::unordered_set<const OperandBase*>& constants) const {
+        switch (info.type) {
+            case OperatorType::Binary:
+                if (reinterpret_cast<const op::Binary*>(info.op)->GetType() ==
+                    op::BinaryOpType::kMatMul) {
+                    return false;
+                }
+                break;
+            case OperatorType::Unary:
+                if (reinterpret_cast<const op::Unary*>(info.op)->GetType() ==
+                    op::UnaryOpType::kSoftmax) {
+                    return false;
+                }
+                break;
+            case OperatorType::Clamp:
+            case OperatorType::Concat:
+                break;
+            default:
+                return false;
+        }
+        if (info.op->PrimaryOutput()->Shape().size() != 4) {
+            return false;
+        }
+        bool readsNhwc = false;
+        for (auto& input : info.op->Inputs()) {
+            const OperandBase* operand = input.Get();
+            const std::vector<int32_t>& shape = operand->Shape();
+            if (mNhwcValues.count(operand) != 0) {
+                readsNhwc = true;
+                continue;
+            }
+            // The constants are transposed once when the subgraph is defined and the graph
+            // inputs before every run, a value of the same data in both layouts is reshaped.
+            std::vector<int32_t> paddedShape(4 - std::min<size_t>(shape.size(), 4), 1);
+            paddedShape.insert(paddedShape.end(), shape.begin(), shape.end());
+            if (shape.size() > 4 || (constants.count(operand) == 0 &&
+                                     !IsReshape(paddedShape, kNchwToNhwc) &&
+                                     (shape.size() != 4 || mInputs.count(operand) == 0))) {
+                return false;
+            }
+        }
+        return readsNhwc;
+    }
+
+    bool Graph::ReadsInNhwc(const OperatorInfo& info, size_t index) const {
+        if (RunsInNhwc(info)) {
+            return index == 0;
+        }
+        return info.type != OperatorType::Transpose &&
+               mNhwcValues.count(info.op->PrimaryOutput()) != 0;
+    }
+
+    void Graph::GetTransposeSource(const op::Transpose* transpose,
+                                   std::vector<int32_t>* shape,
+                                   std::vector<int32_t>* permutation) const {
+        const OperandBase* input = transpose->Inputs()[0].Get();
+        if (mNhwcValues.count(input) != 0) {
+            *shape = PermuteShape(input->Shape(), kNchwToNhwc);
+            *permutation = ComposePermutations(kNhwcToNchw, transpose->GetPermutation());
+        } else {
+            *shape = input->Shape();
+            *permutation = transpose->GetPermutation();
+        }
+    }
+
+    xnn_status Graph::GetXnnNhwcValue(xnn_subgraph_t subgraph,
+                                      const OperandBase* operand,
+                                      uint32_t* id) {
+        auto nhwc = mNhwcOperands.find(operand);
+        if (nhwc != mNhwcOperands.end()) {
+            *id = nhwc->second;
+            return xnn_status_success;
+        }
+        const std::vector<int32_t>& shape = operand->Shape();
+        if (shape.size() > 4) {
+            return xnn_status_invalid_parameter;
+        }
+        std::vector<int32_t> paddedShape(4 - shape.size(), 1);
+        paddedShape.insert(paddedShape.end(), shape.begin(), shape.end());
+        const std::vector<int32_t> nhwcShape = PermuteShape(paddedShape, kNchwToNhwc);
+        if (mConstantData.find(operand) != mConstantData.end()) {
+            XNN_TRY(DefineXnnPermutedConstant(subgraph, operand, kNchwToNhwc, id));
+        } else if (nhwcShape == shape) {
+            DAWN_ASSERT(mOperands.find(operand) != mOperands.end());
+            *id = mOperands.at(operand);
+        } else if (IsReshape(paddedShape, kNchwToNhwc)) {
+            DAWN_ASSERT(mOperands.find(operand) != mOperands.end());
+            const std::vector<size_t> dims(nhwcShape.begin(), nhwcShape.end());
+            XNN_TRY(DefineXnnReshape(subgraph, mOperands.at(operand), dims, id));
+        } else {
+            XNN_TRY(GetXnnPermutedInput(operand, kNchwToNhwc, id));
+        }
+        mNhwcOperands.insert(std::make_pair(operand, *id));
+        return xnn_status_success;
+    }
+
+    xnn_status Graph::DefineXnnNhwcValue(xnn_subgraph_t subgraph,
+                                         const OperandBase* operand,
+                                         uint32_t* id) {
+        const std::vector<int32_t> shape = PermuteShape(operand->Shape(), kNchwToNhwc);
+        if (mOutputs.find(operand) != mOutputs.end()) {
+            XNN_TRY(DefineXnnPermutedOutput(subgraph, operand, shape, kNhwcToNchw, id));
+        } else {
+            const std::vector<size_t> dims(shape.begin(), shape.end());
+            XNN_TRY(DefineXnnInternalValue(subgraph, dims, id));
+        }
+        mNhwcOperands.insert(std::make_pair(operand, *id));
+        return xnn_status_success;
+    }
+
+    xnn_status Graph::DefineXnnNchwValue(xnn_subgraph_t subgraph, const OperandBase* operand) {
+        if (mNhwcValues.count(operand) == 0 || mNchwUses.count(operand) == 0) {
+            return xnn_status_success;
+        }
+        DAWN_ASSERT(mNhwcOperands.find(operand) != mNhwcOperands.end());
+        if (!IsReshape(PermuteShape(operand->Shape(), kNchwToNhwc), kNhwcToNchw)) {
+            dawn::ErrorLog() << "XNNPACK backend can't transpose a value computed in nhwc back "
+                                "for the operators reading it in nchw.";
+            return xnn_status_unsupported_parameter;
+        }
+        const std::vector<size_t> dims(operand->Shape().begin(), operand->Shape().end());
+        uint32_t id;
+        XNN_TRY(DefineXnnReshape(subgraph, mNhwcOperands.at(operand), dims, &id));
+        mOperands.insert(std::make_pair(operand, id));
+        return xnn_status_success;
+    }
+
     xnn_status Graph::DefineXnnNode(xnn_subgraph_t subgraph, const op::Constant* constant) {
-        std::unique_ptr<char> buffer(new char[constant->GetByteLength()]);
+        if (constant->GetMappedFile() != nullptr) {
+            // The mapping is read-only and outlives the subgraph, XNNPACK can use it in place.
+            uint32_t id;
+            XNN_TRY(DefineXnnTensorValue(subgraph, constant->PrimaryOutput(), &id,
+                                         constant->GetBuffer()));
+            mOperands.insert(std::make_pair(constant->PrimaryOutput(), id));
+            mConstantData.insert(std::make_pair(constant->PrimaryOutput(), constant->GetBuffer()));
+            mMappedFiles.push_back(constant->GetMappedFile());
+            return xnn_status_success;
+        }
+        std::unique_ptr<char[]> buffer(new char[constant->GetByteLength()]);
         if (buffer.get() == nullptr) {
             return xnn_status_out_of_memory;
         }
@@ -177,6 +867,7 @@ namespace webnn::native::xnnpack {
         uint32_t id;
         XNN_TRY(DefineXnnTensorValue(subgraph, constant->PrimaryOutput(), &id, buffer.get()));
         mOperands.insert(std::make_pair(constant->PrimaryOutput(), id));
+        mConstantData.insert(std::make_pair(constant->PrimaryOutput(), buffer.get()));
         mBuffers.push_back(std::move(buffer));
         return xnn_status_success;
     }
@@ -192,14 +883,20 @@ namespace webnn::native::xnnpack {
     xnn_status Graph::DefineXnnNode(xnn_subgraph_t subgraph, const op::Binary* binary) {
         DAWN_ASSERT(binary->Inputs().size() == 2);
         const OperandBase* input0Operand = binary->Inputs()[0].Get();
-        DAWN_ASSERT(mOperands.find(input0Operand) != mOperands.end());
-        uint32_t input0Id = mOperands.at(input0Operand);
         const OperandBase* input1Operand = binary->Inputs()[1].Get();
-        DAWN_ASSERT(mOperands.find(input1Operand) != mOperands.end());
-        uint32_t input1Id = mOperands.at(input1Operand);
         auto outputOperand = binary->PrimaryOutput();
-        uint32_t outputId;
-        XNN_TRY(DefineXnnTensorValue(subgraph, outputOperand, &outputId));
+        uint32_t input0Id, input1Id, outputId;
+        if (mNhwcValues.count(outputOperand) != 0) {
+            XNN_TRY(GetXnnNhwcValue(subgraph, input0Operand, &input0Id));
+            XNN_TRY(GetXnnNhwcValue(subgraph, input1Operand, &input1Id));
+            XNN_TRY(DefineXnnNhwcValue(subgraph, outputOperand, &outputId));
+        } else {
+            DAWN_ASSERT(mOperands.find(input0Operand) != mOperands.end());
+            input0Id = mOperands.at(input0Operand);
+            DAWN_ASSERT(mOperands.find(input1Operand) != mOperands.end());
+            input1Id = mOperands.at(input1Operand);
+            XNN_TRY(DefineXnnTensorValue(subgraph, outputOperand, &outputId));
+        }
         const float outputMin = -std::numeric_limits<float>::infinity();
         const float outputMax = +std::numeric_limits<float>::infinity();
         switch (binary->GetType()) {
@@ -226,13 +923,8 @@ namespace webnn::native::xnnpack {
                                             outputId, 0));
                 break;
             case op::BinaryOpType::kMatMul:
-                if (input1Operand->Shape().size() != 2) {
-                    dawn::ErrorLog() << "XNNPACK backend only support 2D operand b of matmul.";
-                    return xnn_status_invalid_parameter;
-                }
-                XNN_TRY(xnn_define_fully_connected(subgraph, outputMin, outputMax, input0Id,
-                                                   input1Id, XNN_INVALID_VALUE_ID, outputId,
-                                                   XNN_FLAG_TRANSPOSE_WEIGHTS));
+                XNN_TRY(DefineXnnMatMul(subgraph, input0Operand, input1Operand, outputOperand,
+                                        outputId));
                 break;
             default:
                 dawn::ErrorLog() << "XNNPACK backend doesn't support unary op "
@@ -245,11 +937,16 @@ namespace webnn::native::xnnpack {
     xnn_status Graph::DefineXnnNode(xnn_subgraph_t subgraph, const op::Clamp* clamp) {
         DAWN_ASSERT(clamp->Inputs().size() == 1);
         auto inputOperand = clamp->Inputs()[0].Get();
-        DAWN_ASSERT(mOperands.find(inputOperand) != mOperands.end());
-        uint32_t inputId = mOperands.at(inputOperand);
         auto outputOperand = clamp->PrimaryOutput();
-        uint32_t outputId;
-        XNN_TRY(DefineXnnTensorValue(subgraph, outputOperand, &outputId));
+        uint32_t inputId, outputId;
+        if (mNhwcValues.count(outputOperand) != 0) {
+            XNN_TRY(GetXnnNhwcValue(subgraph, inputOperand, &inputId));
+            XNN_TRY(DefineXnnNhwcValue(subgraph, outputOperand, &outputId));
+        } else {
+            DAWN_ASSERT(mOperands.find(inputOperand) != mOperands.end());
+            inputId = mOperands.at(inputOperand);
+            XNN_TRY(DefineXnnTensorValue(subgraph, outputOperand, &outputId));
+        }
         XNN_TRY(xnn_define_clamp(subgraph, clamp->GetMinValue(), clamp->GetMaxValue(), inputId,
                                  outputId, 0));
         return xnn_status_success;
@@ -258,38 +955,37 @@ namespace webnn::native::xnnpack {
     xnn_status Graph::DefineXnnNode(xnn_subgraph_t subgraph, const op::Concat* concat) {
         auto inputOperands = concat->Inputs();
         DAWN_ASSERT(inputOperands.size() >= 1);
-        if (inputOperands.size() > 4) {
-            dawn::ErrorLog() << "XNNPACK backend doesn't support concat inputs size "
-                             << inputOperands.size();
-            return xnn_status_invalid_parameter;
-        }
+        auto outputOperand = concat->PrimaryOutput();
+        // A concat run in nhwc concatenates along the axis of the same dimension in nhwc.
+        const bool nhwc = mNhwcValues.count(outputOperand) != 0;
         std::vector<uint32_t> inputIds(inputOperands.size());
+        std::vector<std::vector<size_t>> inputDims(inputOperands.size());
         for (size_t i = 0; i < inputOperands.size(); ++i) {
-            DAWN_ASSERT(mOperands.find(inputOperands[i].Get()) != mOperands.end());
-            inputIds[i] = mOperands.at(inputOperands[i].Get());
+            const OperandBase* inputOperand = inputOperands[i].Get();
+            if (nhwc) {
+                XNN_TRY(GetXnnNhwcValue(subgraph, inputOperand, &inputIds[i]));
+                const std::vector<int32_t> shape = PermuteShape(inputOperand->Shape(), kNchwToNhwc);
+                inputDims[i].assign(shape.begin(), shape.end());
+            } else {
+                DAWN_ASSERT(mOperands.find(inputOperand) != mOperands.end());
+                inputIds[i] = mOperands.at(inputOperand);
+                inputDims[i].assign(inputOperand->Shape().begin(), inputOperand->Shape().end());
+            }
         }
-        auto outputOperand = concat->PrimaryOutput();
         uint32_t outputId;
-        XNN_TRY(DefineXnnTensorValue(subgraph, outputOperand, &outputId));
         size_t axis = concat->GetAxis();
-        switch (concat->Inputs().size()) {
-            case 2:
-                XNN_TRY(
-                    xnn_define_concatenate2(subgraph, axis, inputIds[0], inputIds[1], outputId, 0));
-                break;
-            case 3:
-                XNN_TRY(xnn_define_concatenate3(subgraph, axis, inputIds[0], inputIds[1],
-                                                inputIds[2], outputId, 0));
-                break;
-            case 4:
-                XNN_TRY(xnn_define_concatenate4(subgraph, axis, inputIds[0], inputIds[1],
-                                                inputIds[2], inputIds[3], outputId, 0));
-                break;
-            default:
-                dawn::ErrorLog() << "XNNPACK backend doesn't support concat inputs size "
-                                 << inputOperands.size();
-                return xnn_status_invalid_parameter;
+        std::vector<size_t> outputDims(outputOperand->Shape().begin(),
+                                       outputOperand->Shape().end());
+        if (nhwc) {
+            XNN_TRY(DefineXnnNhwcValue(subgraph, outputOperand, &outputId));
+            axis = kNhwcToNchw[axis];
+            const std::vector<int32_t> shape = PermuteShape(outputOperand->Shape(), kNchwToNhwc);
+            outputDims.assign(shape.begin(), shape.end());
+        } else {
+            XNN_TRY(DefineXnnTensorValue(subgraph, outputOperand, &outputId));
         }
+        XNN_TRY(DefineXnnConcatenate(subgraph, axis, std::move(inputIds), std::move(inputDims),
+                                     outputDims, outputId));
         return xnn_status_success;
     }
 
@@ -297,11 +993,8 @@ namespace webnn::native::xnnpack {
         auto inputOperands = conv2d->Inputs();
         DAWN_ASSERT(inputOperands.size() == 2 || inputOperands.size() == 3);
         auto inputOperand = inputOperands[0].Get();
-        DAWN_ASSERT(mOperands.find(inputOperand) != mOperands.end());
-        uint32_t inputId = mOperands.at(inputOperand);
         auto filterOperand = inputOperands[1].Get();
         DAWN_ASSERT(mOperands.find(filterOperand) != mOperands.end());
-        uint32_t filterId = mOperands.at(filterOperand);
         uint32_t biasId = XNN_INVALID_VALUE_ID;
         if (inputOperands.size() == 3) {
             DAWN_ASSERT(mOperands.find(inputOperands[2].Get()) != mOperands.end());
@@ -315,40 +1008,55 @@ namespace webnn::native::xnnpack {
         uint32_t strideWidth = options->strides[1];
         uint32_t dilationHeight = options->dilations[0];
         uint32_t dilationWidth = options->dilations[1];
-        size_t inputHeight, inputWidth;
-        uint32_t filterHeight, filterWidth;
-        size_t inputChannels, outputChannels;
-        bool depthwise = false;
-        if (options->inputLayout == wnn::InputOperandLayout::Nhwc) {
-            inputHeight = inputOperand->Shape()[1];
-            inputWidth = inputOperand->Shape()[2];
-            inputChannels = inputOperand->Shape()[3];
-            depthwise = (groups == inputChannels);
-            if (!depthwise) {
-                // For regular conv2d, xnn pack expects weights layed out like (ohwi):
-                //   [groups * group_output_channels, kernel_height, kernel_width,
-                //   group_input_channels]
-                if (options->filterLayout != wnn::Conv2dFilterOperandLayout::Ohwi) {
-                    dawn::ErrorLog()
-                        << "XNNPACK backend only supports filter layout ohwi for conv2d.";
-                    return xnn_status_invalid_parameter;
-                }
-            } else {
-                // For depthwise conv2d, xnn pack expects weights layed out like (ihwo):
-                //   [1, kernel_height, kernel_width, input_channels * depth_multiplier]
-                if (options->filterLayout != wnn::Conv2dFilterOperandLayout::Ihwo) {
-                    dawn::ErrorLog()
-                        << "XNNPACK backend only supports filter layout ihwo for depthwise conv2d.";
-                    return xnn_status_invalid_parameter;
-                }
-            }
-            filterHeight = filterOperand->Shape()[1];
-            filterWidth = filterOperand->Shape()[2];
-            outputChannels = outputOperand->Shape()[3];
+        // An nchw conv2d runs in nhwc, its input and output are only permuted at the boundaries
+        // of the graph.
+        const bool nchw = options->inputLayout == wnn::InputOperandLayout::Nchw;
+        uint32_t inputId;
+        if (nchw) {
+            XNN_TRY(GetXnnNhwcValue(subgraph, inputOperand, &inputId));
+        } else {
+            DAWN_ASSERT(mOperands.find(inputOperand) != mOperands.end());
+            inputId = mOperands.at(inputOperand);
+        }
+        const std::vector<int32_t>& inputShape = inputOperand->Shape();
+        size_t inputHeight = nchw ? inputShape[2] : inputShape[1];
+        size_t inputWidth = nchw ? inputShape[3] : inputShape[2];
+        size_t inputChannels = nchw ? inputShape[1] : inputShape[3];
+        size_t outputChannels = outputOperand->Shape()[nchw ? 1 : 3];
+        bool depthwise = (groups == inputChannels);
+
+        // For regular conv2d, xnn pack expects weights layed out like (ohwi):
+        //   [groups * group_output_channels, kernel_height, kernel_width, group_input_channels]
+        // For depthwise conv2d, xnn pack expects weights layed out like (ihwo):
+        //   [1, kernel_height, kernel_width, input_channels * depth_multiplier]
+        // A constant filter in another layout is transposed once when the subgraph is defined.
+        const wnn::Conv2dFilterOperandLayout filterLayout =
+            depthwise ? wnn::Conv2dFilterOperandLayout::Ihwo : wnn::Conv2dFilterOperandLayout::Ohwi;
+        const std::vector<int32_t> filterPermutation =
+            utils::FilterPermutation(options->filterLayout, filterLayout);
+        uint32_t filterHeight = filterOperand->Shape()[filterPermutation[1]];
+        uint32_t filterWidth = filterOperand->Shape()[filterPermutation[2]];
+        uint32_t filterId;
+        if (options->filterLayout == filterLayout) {
+            filterId = mOperands.at(filterOperand);
+        } else if (mConstantData.find(filterOperand) != mConstantData.end()) {
+            XNN_TRY(
+                DefineXnnPermutedConstant(subgraph, filterOperand, filterPermutation, &filterId));
         } else {
-            dawn::ErrorLog() << "XNNPACK backend only supports input layout nhwc.";
+            dawn::ErrorLog() << "XNNPACK backend only supports a filter in another layout than "
+                             << (depthwise ? "ihwo" : "ohwi") << " if it is constant.";
             return xnn_status_invalid_parameter;
         }
+        if (!depthwise && filterHeight == 1 && filterWidth == 1 &&
+            mConstantData.find(filterOperand) != mConstantData.end()) {
+            const float* weights = static_cast<const float*>(mConstantData.at(filterOperand));
+            size_t weightCount = 1;
+            for (int32_t dimension : filterOperand->Shape()) {
+                weightCount *= dimension;
+            }
+            mPointwiseWeightCount += weightCount;
+            mPointwiseZeroCount += std::count(weights, weights + weightCount, 0.0f);
+        }
         size_t groupInputChannels = inputChannels / groups;
         size_t groupOutputChannels = outputChannels / groups;
 
@@ -380,39 +1088,48 @@ namespace webnn::native::xnnpack {
             }
         }
 
+        // Clamp and relu are fused as the output range of the convolution, the other activations
+        // are applied by their own node to the value the convolution is computed into.
         float outputMin = -std::numeric_limits<float>::infinity();
         float outputMax = +std::numeric_limits<float>::infinity();
-        if (options->activation) {
-            switch (options->activation->GetFusionType()) {
-                case FusionType::Clamp: {
-                    auto clamp = reinterpret_cast<const op::FusionClamp*>(options->activation);
-                    outputMin = clamp->GetMinValue();
-                    outputMax = clamp->GetMaxValue();
-                    break;
-                }
-                case FusionType::Relu:
-                    outputMin = 0.0f;
-                    outputMax = std::numeric_limits<float>::infinity();
-                    break;
-                default:
-                    dawn::ErrorLog() << "XNNPACK backend doesn't support fused operator "
-                                     << static_cast<int>(options->activation->GetFusionType());
-                    return xnn_status_invalid_parameter;
-            }
+        const FusionOperatorBase* activation = options->activation;
+        if (activation != nullptr && activation->GetFusionType() == FusionType::Clamp) {
+            auto clamp = static_cast<const op::FusionClamp*>(activation);
+            outputMin = clamp->GetMinValue();
+            outputMax = clamp->GetMaxValue();
+            activation = nullptr;
+        } else if (activation != nullptr && activation->GetFusionType() == FusionType::Relu) {
+            outputMin = 0.0f;
+            activation = nullptr;
         }
         uint32_t outputId;
-        XNN_TRY(DefineXnnTensorValue(subgraph, outputOperand, &outputId));
+        if (nchw) {
+            XNN_TRY(DefineXnnNhwcValue(subgraph, outputOperand, &outputId));
+        } else {
+            XNN_TRY(DefineXnnTensorValue(subgraph, outputOperand, &outputId));
+        }
+        std::vector<size_t> outputDims;
+        for (size_t i = 0; i < 4; ++i) {
+            outputDims.push_back(outputOperand->Shape()[nchw ? kNchwToNhwc[i] : i]);
+        }
+        uint32_t convOutputId = outputId;
+        if (activation != nullptr) {
+            XNN_TRY(DefineXnnInternalValue(subgraph, outputDims, &convOutputId));
+        }
         if (depthwise) {
             XNN_TRY(xnn_define_depthwise_convolution_2d(
                 subgraph, padTop, padRight, padBottom, padLeft, filterHeight, filterWidth,
                 strideHeight, strideWidth, dilationHeight, dilationWidth, 1, inputChannels,
-                outputMin, outputMax, inputId, filterId, biasId, outputId, 0));
+                outputMin, outputMax, inputId, filterId, biasId, convOutputId, 0));
         } else {
-            XNN_TRY(xnn_define_convolution_2d(subgraph, padTop, padRight, padBottom, padLeft,
-                                              filterHeight, filterWidth, strideHeight, strideWidth,
-                                              dilationHeight, dilationWidth, groups,
-                                              groupInputChannels, groupOutputChannels, outputMin,
-                                              outputMax, inputId, filterId, biasId, outputId, 0));
+            XNN_TRY(xnn_define_convolution_2d(
+                subgraph, padTop, padRight, padBottom, padLeft, filterHeight, filterWidth,
+                strideHeight, strideWidth, dilationHeight, dilationWidth, groups,
+                groupInputChannels, groupOutputChannels, outputMin, outputMax, inputId, filterId,
+                biasId, convOutputId, 0));
+        }
+        if (activation != nullptr) {
+            XNN_TRY(DefineXnnActivation(subgraph, activation, outputDims, convOutputId, outputId));
         }
         return xnn_status_success;
     }
@@ -420,39 +1137,104 @@ namespace webnn::native::xnnpack {
     xnn_status Graph::DefineXnnNode(xnn_subgraph_t subgraph, const op::Gemm* gemm) {
         auto inputs = gemm->Inputs();
         DAWN_ASSERT(inputs.size() == 2 || inputs.size() == 3);
-        DAWN_ASSERT(mOperands.find(inputs[0].Get()) != mOperands.end());
-        uint32_t inputId = mOperands.at(inputs[0].Get());
-        DAWN_ASSERT(mOperands.find(inputs[1].Get()) != mOperands.end());
-        uint32_t filterId = mOperands.at(inputs[1].Get());
-        uint32_t biasId = XNN_INVALID_VALUE_ID;
-        if (inputs.size() == 3) {
-            DAWN_ASSERT(mOperands.find(inputs[2].Get()) != mOperands.end());
-            biasId = mOperands.at(inputs[2].Get());
-        }
+        const OperandBase* a = inputs[0].Get();
+        const OperandBase* b = inputs[1].Get();
+        const OperandBase* c = inputs.size() == 3 ? inputs[2].Get() : nullptr;
         const GemmOptions* options = gemm->GetOptions();
-        if (fabs(options->alpha - 1.0f) > std::numeric_limits<float>::epsilon()) {
-            dawn::ErrorLog() << "XNNPACK backend doesn't support alpha " << options->alpha;
-            return xnn_status_invalid_parameter;
+        auto outputOperand = gemm->PrimaryOutput();
+        const std::vector<size_t> outputDims(outputOperand->Shape().begin(),
+                                             outputOperand->Shape().end());
+        const float outputMin = -std::numeric_limits<float>::infinity();
+        const float outputMax = +std::numeric_limits<float>::infinity();
+        const bool scaled = fabs(options->alpha - 1.0f) > std::numeric_limits<float>::epsilon();
+        if (fabs(options->beta) <= std::numeric_limits<float>::epsilon()) {
+            c = nullptr;
         }
-        if (fabs(options->beta - 1.0f) > std::numeric_limits<float>::epsilon()) {
-            dawn::ErrorLog() << "XNNPACK backend doesn't support beta " << options->beta;
-            return xnn_status_invalid_parameter;
+
+        // A transposed a is transposed back, once here if it is constant, or before the run if
+        // it is a graph input. A single row or column is only reshaped.
+        uint32_t inputId;
+        if (!options->aTranspose) {
+            DAWN_ASSERT(mOperands.find(a) != mOperands.end());
+            inputId = mOperands.at(a);
+        } else if (mConstantData.find(a) != mConstantData.end()) {
+            XNN_TRY(DefineXnnPermutedConstant(subgraph, a, kTransposeMatrix, &inputId));
+        } else if (IsReshape(a->Shape(), kTransposeMatrix)) {
+            DAWN_ASSERT(mOperands.find(a) != mOperands.end());
+            XNN_TRY(DefineXnnReshape(
+                subgraph, mOperands.at(a),
+                {static_cast<size_t>(a->Shape()[1]), static_cast<size_t>(a->Shape()[0])},
+                &inputId));
+        } else {
+            XNN_TRY(GetXnnPermutedInput(a, kTransposeMatrix, &inputId));
         }
-        if (options->aTranspose) {
-            dawn::ErrorLog() << "XNNPACK backend doesn't support aTranspose.";
-            return xnn_status_invalid_parameter;
+
+        // Alpha is folded into a constant b, otherwise the product is scaled by its own node.
+        uint32_t filterId;
+        bool scaleOutput = false;
+        if (scaled && mConstantData.find(b) != mConstantData.end()) {
+            XNN_TRY(DefineXnnPermutedConstant(subgraph, b, {0, 1}, &filterId, options->alpha));
+        } else {
+            DAWN_ASSERT(mOperands.find(b) != mOperands.end());
+            filterId = mOperands.at(b);
+            scaleOutput = scaled;
         }
         uint32_t flags = 0;
         if (!options->bTranspose) {
             flags = XNN_FLAG_TRANSPOSE_WEIGHTS;
         }
-        auto outputOperand = gemm->PrimaryOutput();
+
+        // Beta is folded into a constant c, otherwise c is scaled by its own node. A c of one
+        // value per output column is the bias of the fully connected node, any other shape is
+        // broadcast by an add node.
+        uint32_t cId = XNN_INVALID_VALUE_ID;
+        if (c != nullptr) {
+            const bool scaledC =
+                fabs(options->beta - 1.0f) > std::numeric_limits<float>::epsilon();
+            if (scaledC && mConstantData.find(c) != mConstantData.end()) {
+                std::vector<int32_t> identity(c->Shape().size());
+                std::iota(identity.begin(), identity.end(), 0);
+                XNN_TRY(DefineXnnPermutedConstant(subgraph, c, identity, &cId, options->beta));
+            } else {
+                DAWN_ASSERT(mOperands.find(c) != mOperands.end());
+                cId = mOperands.at(c);
+                if (scaledC) {
+                    uint32_t betaId, scaledCId;
+                    XNN_TRY(DefineXnnScalarConstant(subgraph, options->beta, &betaId));
+                    std::vector<size_t> cDims(c->Shape().begin(), c->Shape().end());
+                    XNN_TRY(DefineXnnInternalValue(subgraph, cDims, &scaledCId));
+                    XNN_TRY(xnn_define_multiply2(subgraph, outputMin, outputMax, cId, betaId,
+                                                 scaledCId, 0));
+                    cId = scaledCId;
+                }
+            }
+        }
+        const bool cIsBias = c != nullptr && !scaleOutput && c->Shape().size() == 1 &&
+                             static_cast<size_t>(c->Shape()[0]) == outputDims[1];
+
         uint32_t outputId;
         XNN_TRY(DefineXnnTensorValue(subgraph, outputOperand, &outputId));
-        const float outputMin = -std::numeric_limits<float>::infinity();
-        const float outputMax = +std::numeric_limits<float>::infinity();
+        uint32_t productId = outputId;
+        if (scaleOutput || (c != nullptr && !cIsBias)) {
+            XNN_TRY(DefineXnnInternalValue(subgraph, outputDims, &productId));
+        }
         XNN_TRY(xnn_define_fully_connected(subgraph, outputMin, outputMax, inputId, filterId,
-                                           biasId, outputId, flags));
+                                           cIsBias ? cId : XNN_INVALID_VALUE_ID, productId,
+                                           flags));
+        if (scaleOutput) {
+            uint32_t alphaId;
+            XNN_TRY(DefineXnnScalarConstant(subgraph, options->alpha, &alphaId));
+            uint32_t scaledId = outputId;
+            if (c != nullptr) {
+                XNN_TRY(DefineXnnInternalValue(subgraph, outputDims, &scaledId));
+            }
+            XNN_TRY(xnn_define_multiply2(subgraph, outputMin, outputMax, productId, alphaId,
+                                         scaledId, 0));
+            productId = scaledId;
+        }
+        if (c != nullptr && !cIsBias) {
+            XNN_TRY(xnn_define_add2(subgraph, outputMin, outputMax, productId, cId, outputId, 0));
+        }
         return xnn_status_success;
     }
 
@@ -491,20 +1273,23 @@ namespace webnn::native::xnnpack {
     xnn_status Graph::DefineXnnNode(xnn_subgraph_t subgraph, const op::Pool2d* pool2d) {
         DAWN_ASSERT(pool2d->Inputs().size() == 1);
         auto inputOperand = pool2d->Inputs()[0].Get();
-        DAWN_ASSERT(mOperands.find(inputOperand) != mOperands.end());
-        uint32_t inputId = mOperands.at(inputOperand);
         const Pool2dOptions* options = pool2d->GetOptions();
-        if (options->layout != wnn::InputOperandLayout::Nhwc) {
-            dawn::ErrorLog() << "XNNPACK only supports input layout nhwc.";
-            return xnn_status_invalid_parameter;
+        // An nchw pool2d runs in nhwc, its input and output are only permuted at the boundaries
+        // of the graph.
+        const bool nchw = options->layout == wnn::InputOperandLayout::Nchw;
+        uint32_t inputId;
+        if (nchw) {
+            XNN_TRY(GetXnnNhwcValue(subgraph, inputOperand, &inputId));
+        } else {
+            DAWN_ASSERT(mOperands.find(inputOperand) != mOperands.end());
+            inputId = mOperands.at(inputOperand);
         }
         uint32_t strideHeight = options->strides[0];
         uint32_t strideWidth = options->strides[1];
         uint32_t dilationHeight = options->dilations[0];
         uint32_t dilationWidth = options->dilations[1];
-        // nhwc
-        size_t inputHeight = inputOperand->Shape()[1];
-        size_t inputWidth = inputOperand->Shape()[2];
+        size_t inputHeight = inputOperand->Shape()[nchw ? 2 : 1];
+        size_t inputWidth = inputOperand->Shape()[nchw ? 3 : 2];
         uint32_t filterHeight, filterWidth;
         bool global = false;
         if (options->windowDimensions != nullptr) {
@@ -546,7 +1331,11 @@ namespace webnn::native::xnnpack {
 
         auto outputOperand = pool2d->PrimaryOutput();
         uint32_t outputId;
-        XNN_TRY(DefineXnnTensorValue(subgraph, outputOperand, &outputId));
+        if (nchw) {
+            XNN_TRY(DefineXnnNhwcValue(subgraph, outputOperand, &outputId));
+        } else {
+            XNN_TRY(DefineXnnTensorValue(subgraph, outputOperand, &outputId));
+        }
         float outputMin = -std::numeric_limits<float>::infinity();
         float outputMax = +std::numeric_limits<float>::infinity();
         const uint32_t flags = 0;
@@ -659,14 +1448,96 @@ namespace webnn::native::xnnpack {
         return xnn_status_success;
     }
 
+    xnn_status Graph::DefineXnnNode(xnn_subgraph_t subgraph, const op::Transpose* transpose) {
+        DAWN_ASSERT(transpose->Inputs().size() == 1);
+        auto inputOperand = transpose->Inputs()[0].Get();
+        auto outputOperand = transpose->PrimaryOutput();
+        const std::vector<int32_t> permutation = transpose->GetPermutation();
+        if (permutation.size() > XNN_MAX_TENSOR_DIMS) {
+            dawn::ErrorLog() << "XNNPACK backend doesn't support transpose rank "
+                             << permutation.size();
+            return xnn_status_invalid_parameter;
+        }
+        if (mConstantData.find(inputOperand) != mConstantData.end() &&
+            mOutputs.find(outputOperand) == mOutputs.end()) {
+            // The transposes of constants, e.g. of the filters inserted by the layout
+            // propagation, are done once here rather than on every compute.
+            uint32_t id;
+            XNN_TRY(DefineXnnPermutedConstant(subgraph, inputOperand, permutation, &id));
+            mOperands.insert(std::make_pair(outputOperand, id));
+            mConstantData.insert(std::make_pair(outputOperand, mBuffers.back().get()));
+            return xnn_status_success;
+        }
+        // The input may be held in nhwc, the data is then permuted into the output by another
+        // permutation.
+        std::vector<int32_t> inputShape;
+        std::vector<int32_t> dataPermutation;
+        GetTransposeSource(transpose, &inputShape, &dataPermutation);
+        uint32_t inputId;
+        if (mNhwcValues.count(inputOperand) != 0) {
+            DAWN_ASSERT(mNhwcOperands.find(inputOperand) != mNhwcOperands.end());
+            inputId = mNhwcOperands.at(inputOperand);
+        } else {
+            DAWN_ASSERT(mOperands.find(inputOperand) != mOperands.end());
+            inputId = mOperands.at(inputOperand);
+        }
+        const bool isOutput = mOutputs.find(outputOperand) != mOutputs.end();
+        uint32_t outputId;
+        if (mNhwcValues.count(outputOperand) != 0) {
+            // The output is held in nhwc, which has the data of the input in the same order.
+            if (IsIdentity(ComposePermutations(dataPermutation, kNchwToNhwc)) && !isOutput) {
+                mNhwcOperands.insert(std::make_pair(outputOperand, inputId));
+                return xnn_status_success;
+            }
+            XNN_TRY(DefineXnnNhwcValue(subgraph, outputOperand, &outputId));
+            const std::vector<int32_t> shape = PermuteShape(outputOperand->Shape(), kNchwToNhwc);
+            const std::vector<size_t> dims(shape.begin(), shape.end());
+            XNN_TRY(xnn_define_static_reshape(subgraph, dims.size(), dims.data(), inputId,
+                                              outputId, 0));
+        } else if (IsReshape(inputShape, dataPermutation)) {
+            if (IsIdentity(dataPermutation) && !isOutput) {
+                mOperands.insert(std::make_pair(outputOperand, inputId));
+                return xnn_status_success;
+            }
+            XNN_TRY(DefineXnnTensorValue(subgraph, outputOperand, &outputId));
+            const std::vector<size_t> dims(outputOperand->Shape().begin(),
+                                           outputOperand->Shape().end());
+            XNN_TRY(xnn_define_static_reshape(subgraph, dims.size(), dims.data(), inputId,
+                                              outputId, 0));
+        } else if (isOutput) {
+            // The input is copied into the output as it is and permuted after the run, so the
+            // operators of the subgraph can't read the output.
+            if (mNchwUses.count(outputOperand) != 0) {
+                dawn::ErrorLog() << "XNNPACK backend can't read a transposed graph output.";
+                return xnn_status_unsupported_parameter;
+            }
+            XNN_TRY(DefineXnnPermutedOutput(subgraph, outputOperand, inputShape, dataPermutation,
+                                            &outputId));
+            const std::vector<size_t> dims(inputShape.begin(), inputShape.end());
+            XNN_TRY(xnn_define_static_reshape(subgraph, dims.size(), dims.data(), inputId,
+                                              outputId, 0));
+            mOperands.insert(std::make_pair(outputOperand, outputId));
+        } else {
+            // Only a graph input can be permuted, before the run.
+            XNN_TRY(GetXnnPermutedInput(inputOperand, permutation, &outputId));
+            mOperands.insert(std::make_pair(outputOperand, outputId));
+        }
+        return xnn_status_success;
+    }
+
     xnn_status Graph::DefineXnnNode(xnn_subgraph_t subgraph, const op::Unary* unary) {
         DAWN_ASSERT(unary->Inputs().size() == 1);
         auto inputOperand = unary->Inputs()[0].Get();
-        DAWN_ASSERT(mOperands.find(inputOperand) != mOperands.end());
-        uint32_t inputId = mOperands.at(inputOperand);
         auto outputOperand = unary->PrimaryOutput();
-        uint32_t outputId;
-        XNN_TRY(DefineXnnTensorValue(subgraph, outputOperand, &outputId));
+        uint32_t inputId, outputId;
+        if (mNhwcValues.count(outputOperand) != 0) {
+            XNN_TRY(GetXnnNhwcValue(subgraph, inputOperand, &inputId));
+            XNN_TRY(DefineXnnNhwcValue(subgraph, outputOperand, &outputId));
+        } else {
+            DAWN_ASSERT(mOperands.find(inputOperand) != mOperands.end());
+            inputId = mOperands.at(inputOperand);
+            XNN_TRY(DefineXnnTensorValue(subgraph, outputOperand, &outputId));
+        }
         switch (unary->GetType()) {
             case op::UnaryOpType::kAbs:
                 XNN_TRY(xnn_define_abs(subgraph, inputId, outputId, 0));
@@ -682,7 +1553,7 @@ namespace webnn::native::xnnpack {
                 break;
             case op::UnaryOpType::kLeakyRelu:
                 XNN_TRY(xnn_define_leaky_relu(
-                    subgraph, reinterpret_cast<const op::LeakyRelu*>(unary)->GetAlpha(), inputId,
+                    subgraph, static_cast<const op::LeakyRelu*>(unary)->GetAlpha(), inputId,
                     outputId, 0));
                 break;
             case op::UnaryOpType::kNeg:
@@ -716,11 +1587,219 @@ namespace webnn::native::xnnpack {
         break;                                                                                     \
     }
 
+    bool Graph::SupportsFusedActivation(const op::Conv2d* conv2d, FusionType type) const {
+        return type == FusionType::Clamp || type == FusionType::Relu;
+    }
+
+    bool Graph::GetPreferredLayout(wnn::InputOperandLayout* layout) const {
+        *layout = wnn::InputOperandLayout::Nhwc;
+        return true;
+    }
+
+    bool Graph::IsConstant(const OperandBase* operand) const {
+        return operand->Operator()->Inputs().empty() && mInputs.find(operand) == mInputs.end();
+    }
+
+    // The operators are only recorded when they are added, this rejects the ones the nodes
+    // defined by Finish would reject. Whether the values computed in nhwc can be read in nchw
+    // and the transposes of computed values depend on the rest of the graph, they are only
+    // known when the graph is finished.
+    bool Graph::SupportsOperator(const OperatorBase* op) const {
+        auto info = std::find_if(mOperators.begin(), mOperators.end(),
+                                 [op](const OperatorInfo& info) { return info.op == op; });
+        if (info == mOperators.end()) {
+            return false;
+        }
+        for (size_t i = 0; i < op->Inputs().size(); ++i) {
+            const OperandBase* input = op->Inputs()[i].Get();
+            // The padding of a pad is read from its constant when the subgraph is defined.
+            if (info->type == OperatorType::Pad && i == 1) {
+                if (!IsConstant(input)) {
+                    return false;
+                }
+                continue;
+            }
+            if (input->Type() != wnn::OperandType::Float32 ||
+                input->Shape().size() > XNN_MAX_TENSOR_DIMS) {
+                return false;
+            }
+        }
+        for (auto& output : op->Outputs()) {
+            if (output->Type() != wnn::OperandType::Float32 ||
+                output->Shape().size() > XNN_MAX_TENSOR_DIMS) {
+                return false;
+            }
+        }
+        switch (info->type) {
+            case OperatorType::Binary: {
+                const op::Binary* binary = reinterpret_cast<const op::Binary*>(op);
+                if (binary->GetType() == op::BinaryOpType::kPower) {
+                    return false;
+                }
+                if (binary->GetType() != op::BinaryOpType::kMatMul) {
+                    return true;
+                }
+                // A batched b must be constant, the matrices of a are split from it.
+                const OperandBase* a = binary->Inputs()[0].Get();
+                const OperandBase* b = binary->Inputs()[1].Get();
+                if (b->Shape().size() <= 2 ||
+                    std::all_of(b->Shape().begin(), b->Shape().end() - 2,
+                                [](int32_t dimension) { return dimension == 1; })) {
+                    return true;
+                }
+                size_t aBatchCount = 1;
+                for (size_t i = 0; i + 2 < a->Shape().size(); ++i) {
+                    aBatchCount *= a->Shape()[i];
+                }
+                return IsConstant(b) && CanSplitRows(aBatchCount);
+            }
+            case OperatorType::Conv2d: {
+                const op::Conv2d* conv2d = reinterpret_cast<const op::Conv2d*>(op);
+                const Conv2dOptions* options = conv2d->GetOptions();
+                const std::vector<int32_t>& inputShape = conv2d->Inputs()[0]->Shape();
+                const bool nchw = options->inputLayout == wnn::InputOperandLayout::Nchw;
+                const bool depthwise =
+                    options->groups == static_cast<uint32_t>(inputShape[nchw ? 1 : 3]);
+                const wnn::Conv2dFilterOperandLayout filterLayout =
+                    depthwise ? wnn::Conv2dFilterOperandLayout::Ihwo
+                              : wnn::Conv2dFilterOperandLayout::Ohwi;
+                // A filter in another layout is transposed when the subgraph is defined.
+                return options->filterLayout == filterLayout ||
+                       IsConstant(conv2d->Inputs()[1].Get());
+            }
+            case OperatorType::Gemm:
+                // A transposed a that is computed can't be transposed back, the XNNPACK the
+                // backend is built with has no transpose node.
+                if (reinterpret_cast<const op::Gemm*>(op)->GetOptions()->aTranspose) {
+                    const OperandBase* a = op->Inputs()[0].Get();
+                    return IsConstant(a) || mInputs.find(a) != mInputs.end() ||
+                           IsReshape(a->Shape(), kTransposeMatrix);
+                }
+                return true;
+            case OperatorType::Pad:
+                return reinterpret_cast<const op::Pad*>(op)->GetOptions()->mode ==
+                       wnn::PaddingMode::Constant;
+            case OperatorType::Pool2d: {
+                const op::Pool2d* pool2d = reinterpret_cast<const op::Pool2d*>(op);
+                const Pool2dOptions* options = pool2d->GetOptions();
+                if (pool2d->GetType() == op::Pool2dType::kL2Pool2d) {
+                    return false;
+                }
+                return pool2d->GetType() != op::Pool2dType::kAveragePool2d ||
+                       (options->dilations[0] == 1 && options->dilations[1] == 1);
+            }
+            case OperatorType::Split: {
+                const op::Split* split = reinterpret_cast<const op::Split*>(op);
+                return split->GetSplits().size() == 1 && split->Outputs().size() >= 2 &&
+                       split->Outputs().size() <= 4;
+            }
+            case OperatorType::Unary:
+                switch (reinterpret_cast<const op::Unary*>(op)->GetType()) {
+                    case op::UnaryOpType::kAbs:
+                    case op::UnaryOpType::kCeil:
+                    case op::UnaryOpType::kFloor:
+                    case op::UnaryOpType::kHardSwish:
+                    case op::UnaryOpType::kLeakyRelu:
+                    case op::UnaryOpType::kNeg:
+                    case op::UnaryOpType::kRelu:
+                    case op::UnaryOpType::kSigmoid:
+                    case op::UnaryOpType::kSoftmax:
+                        return true;
+                    default:
+                        return false;
+                }
+            default:
+                return true;
+        }
+    }
+
     MaybeError Graph::Finish() {
         xnn_subgraph_t subgraph;
-        if (FAILED(xnn_create_subgraph(mExternals.size(), 0, &subgraph))) {
+        // The operators are visited in topological order, so the values computed in nhwc are
+        // known for the operators reading them. The transposes of constants are folded.
+        std::unordered_set<const OperandBase*> constants;
+        for (auto const& info : mOperators) {
+            const OperandBase* output = info.op->PrimaryOutput();
+            if (info.type == OperatorType::Constant) {
+                constants.insert(output);
+            } else if (RunsInNhwc(info) || CanRunInNhwc(info, constants)) {
+                mNhwcValues.insert(output);
+            } else if (info.type == OperatorType::Transpose) {
+                if (constants.count(info.op->Inputs()[0].Get()) != 0) {
+                    if (mOutputs.find(output) == mOutputs.end()) {
+                        constants.insert(output);
+                    }
+                    continue;
+                }
+                std::vector<int32_t> shape;
+                std::vector<int32_t> permutation;
+                GetTransposeSource(reinterpret_cast<const op::Transpose*>(info.op), &shape,
+                                   &permutation);
+                if (shape.size() == 4 &&
+                    IsReshape(shape, ComposePermutations(permutation, kNchwToNhwc))) {
+                    mNhwcValues.insert(output);
+                }
+            }
+        }
+        // The values read as they are by anything but the operators run in nhwc and the
+        // transposes, the values computed in nhwc are only reshaped back for them.
+        for (auto const& info : mOperators) {
+            if (info.type == OperatorType::Transpose) {
+                continue;
+            }
+            for (size_t i = 0; i < info.op->Inputs().size(); ++i) {
+                if (!ReadsInNhwc(info, i)) {
+                    mNchwUses.insert(info.op->Inputs()[i].Get());
+                }
+            }
+        }
+        // The graph inputs read in another layout get external values of their own, which are
+        // permuted from the inputs before every run.
+        for (auto const& info : mOperators) {
+            for (size_t i = 0; i < info.op->Inputs().size(); ++i) {
+                const OperandBase* input = info.op->Inputs()[i].Get();
+                if (mInputs.find(input) != mInputs.end() && ReadsInNhwc(info, i) &&
+                    input->Shape().size() == 4 && !IsReshape(input->Shape(), kNchwToNhwc)) {
+                    AddPermutedInput(input, kNchwToNhwc);
+                }
+            }
+            if (info.op->Inputs().empty() ||
+                mInputs.find(info.op->Inputs()[0].Get()) == mInputs.end()) {
+                continue;
+            }
+            const OperandBase* input = info.op->Inputs()[0].Get();
+            if (info.type == OperatorType::Transpose) {
+                const std::vector<int32_t>& permutation =
+                    reinterpret_cast<const op::Transpose*>(info.op)->GetPermutation();
+                if (!IsReshape(input->Shape(), permutation) &&
+                    mNhwcValues.count(info.op->PrimaryOutput()) == 0 &&
+                    mOutputs.find(info.op->PrimaryOutput()) == mOutputs.end()) {
+                    AddPermutedInput(input, permutation);
+                }
+            } else if (info.type == OperatorType::Gemm) {
+                if (reinterpret_cast<const op::Gemm*>(info.op)->GetOptions()->aTranspose &&
+                    !IsReshape(input->Shape(), kTransposeMatrix)) {
+                    AddPermutedInput(input, kTransposeMatrix);
+                }
+            }
+        }
+        if (FAILED(xnn_create_subgraph(mExternalId, 0, &subgraph))) {
             return DAWN_INTERNAL_ERROR("xnn_create_subgraph failed.");
         }
+        for (auto& permuted : mPermutedExternals) {
+            std::vector<size_t> dims;
+            for (int32_t axis : permuted.permutation) {
+                dims.push_back(static_cast<size_t>(permuted.shape[axis]));
+            }
+            uint32_t id;
+            xnn_status status = xnn_define_tensor_value(subgraph, xnn_datatype_fp32, dims.size(),
+                                                        dims.data(), nullptr, permuted.id,
+                                                        XNN_VALUE_FLAG_EXTERNAL_INPUT, &id);
+            if (status != xnn_status_success) {
+                xnn_delete_subgraph(subgraph);
+            }
+            DAWN_TRY(status);
+        }
         for (auto const& info : mOperators) {
             switch (info.type) {
                 HANDLE_OP(Binary)
@@ -735,18 +1814,65 @@ namespace webnn::native::xnnpack {
                 HANDLE_OP(Reshape)
                 HANDLE_OP(Split)
                 HANDLE_OP(Squeeze)
+                HANDLE_OP(Transpose)
                 HANDLE_OP(Unary)
                 default: {
                     return DAWN_UNIMPLEMENTED_ERROR("");
                 }
             }
+            xnn_status status = DefineXnnNchwValue(subgraph, info.op->PrimaryOutput());
+            if (status != xnn_status_success) {
+                xnn_delete_subgraph(subgraph);
+            }
+            DAWN_TRY(status);
+        }
+        if (mPointwiseWeightCount != 0) {
+            const double sparsity =
+                static_cast<double>(mPointwiseZeroCount) / mPointwiseWeightCount;
+            mSparseInference = sparsity >= kSparseInferenceThreshold;
+            dawn::InfoLog() << "XNNPACK 1x1 conv2d weights are " << sparsity * 100
+                            << "% zero, sparse inference is "
+                            << (mSparseInference ? "enabled." : "disabled.");
         }
-        uint32_t flags = XNN_FLAG_YIELD_WORKERS;
-        DAWN_TRY(xnn_create_runtime_v2(subgraph, GetThreadpool(), flags, &mRuntime));
-        DAWN_TRY(xnn_delete_subgraph(subgraph));
+        // The subgraph is kept to create more runtimes when Compute is called concurrently.
+        mSubgraph = subgraph;
+        // More runtimes than threads only contend for the same pool.
+        mMaxContexts = std::max<size_t>(pthreadpool_get_threads_count(GetThreadpool()), 1);
+        std::unique_ptr<ExecutionContext> context;
+        DAWN_TRY(CreateExecutionContext(&context));
+        mIdleContexts.push_back(std::move(context));
+        mContextCount = 1;
         return {};
     }
 
+    xnn_status Graph::CreateExecutionContext(std::unique_ptr<ExecutionContext>* context) {
+        std::unique_ptr<ExecutionContext> newContext(new ExecutionContext());
+        uint32_t flags = reinterpret_cast<Context*>(GetContext())->GetRuntimeFlags();
+        if (mSparseInference) {
+            // XNNPACK then runs the subgraph regions it can in nchw with the sparse kernels.
+            flags |= XNN_FLAG_HINT_SPARSE_INFERENCE;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mSubgraphMutex);
+            XNN_TRY(
+                xnn_create_runtime_v2(mSubgraph, GetThreadpool(), flags, &newContext->runtime));
+        }
+        newContext->externals = mExternals;
+        for (auto& permuted : mPermutedExternals) {
+            size_t count = 1;
+            for (int32_t dimension : permuted.shape) {
+                count *= dimension;
+            }
+            newContext->permutedData.emplace_back(count);
+            if (permuted.isOutput) {
+                // The runtime always writes the output to the buffer of the context.
+                newContext->externals[permuted.name].data = newContext->permutedData.back().data();
+            }
+        }
+        *context = std::move(newContext);
+        return xnn_status_success;
+    }
+
     pthreadpool_t Graph::GetThreadpool() {
         return reinterpret_cast<Context*>(GetContext())->GetThreadpool();
     }
@@ -756,43 +1882,136 @@ namespace webnn::native::xnnpack {
     }
 
     MaybeError Graph::ComputeImpl(NamedInputsBase* inputs, NamedOutputsBase* outputs) {
-        if (mNamedInputs != inputs || mNamedOutputs != outputs) {
-            bool anyPointersChanged = false;
-            for (auto& input : inputs->GetRecords()) {
-                DAWN_INVALID_IF(mExternals.find(input.first) == mExternals.end(),
-                                "Invalid inputs.");
-                void* data = static_cast<int8_t*>(input.second.resource.arrayBufferView.buffer) +
-                             input.second.resource.arrayBufferView.byteOffset;
-                if (mExternals[input.first].data != data) {
-                    mExternals[input.first].data = data;
-                    anyPointersChanged = true;
+        std::unique_ptr<ExecutionContext> context;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mContextIdle.wait(lock, [this] {
+                return !mIdleContexts.empty() || mContextCount < mMaxContexts;
+            });
+            if (!mIdleContexts.empty()) {
+                context = std::move(mIdleContexts.back());
+                mIdleContexts.pop_back();
+            } else {
+                ++mContextCount;
+            }
+        }
+        if (context == nullptr) {
+            // The other computes return and take contexts while the runtime is created.
+            MaybeError created = [&]() -> MaybeError {
+                DAWN_TRY(CreateExecutionContext(&context));
+                return {};
+            }();
+            if (created.IsError()) {
+                {
+                    std::lock_guard<std::mutex> lock(mMutex);
+                    --mContextCount;
                 }
+                mContextIdle.notify_one();
+                return created;
             }
-            mNamedInputs = inputs;
+        }
 
-            for (auto& output : outputs->GetRecords()) {
-                DAWN_INVALID_IF(mExternals.find(output.first) == mExternals.end(),
-                                "Invalid outputs.");
-                void* data = static_cast<int8_t*>(output.second.arrayBufferView.buffer) +
-                             output.second.arrayBufferView.byteOffset;
-                if (mExternals[output.first].data != data) {
-                    mExternals[output.first].data = data;
-                    anyPointersChanged = true;
-                }
+        MaybeError result = RunExecutionContext(context.get(), inputs, outputs);
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mIdleContexts.push_back(std::move(context));
+        }
+        mContextIdle.notify_one();
+        return result;
+    }
+
+    MaybeError Graph::RunExecutionContext(ExecutionContext* context,
+                                          NamedInputsBase* inputs,
+                                          NamedOutputsBase* outputs) {
+        // The runtime is only set up again when a buffer differs from the last call on this
+        // context.
+        bool anyPointersChanged = !context->isSetUp;
+        for (auto& input : inputs->GetRecords()) {
+            auto iter = context->externals.find(input.first);
+            DAWN_INVALID_IF(iter == context->externals.end(), "Invalid inputs.");
+            void* data = static_cast<int8_t*>(input.second.resource.arrayBufferView.buffer) +
+                         input.second.resource.arrayBufferView.byteOffset;
+            if (iter->second.data != data) {
+                iter->second.data = data;
+                anyPointersChanged = true;
+            }
+        }
+
+        for (size_t i = 0; i < mPermutedExternals.size(); ++i) {
+            const PermutedExternal& permuted = mPermutedExternals[i];
+            if (permuted.isOutput) {
+                continue;
+            }
+            auto input = inputs->GetRecords().find(permuted.name);
+            DAWN_INVALID_IF(input == inputs->GetRecords().end(), "Invalid inputs.");
+            const ArrayBufferView& view = input->second.resource.arrayBufferView;
+            std::vector<float>& data = context->permutedData[i];
+            DAWN_INVALID_IF(view.byteLength < data.size() * sizeof(float),
+                            "The input " + permuted.name + " is too small.");
+            PermuteData(reinterpret_cast<const float*>(static_cast<const int8_t*>(view.buffer) +
+                                                       view.byteOffset),
+                        permuted.shape, permuted.permutation, data.data());
+        }
+
+        // The permuted outputs are written to the buffers of the context and permuted into the
+        // outputs after the run.
+        auto isPermutedOutput = [this](const std::string& name) {
+            return std::any_of(mPermutedExternals.begin(), mPermutedExternals.end(),
+                               [&name](const PermutedExternal& permuted) {
+                                   return permuted.isOutput && permuted.name == name;
+                               });
+        };
+        for (auto& output : outputs->GetRecords()) {
+            auto iter = context->externals.find(output.first);
+            DAWN_INVALID_IF(iter == context->externals.end(), "Invalid outputs.");
+            if (isPermutedOutput(output.first)) {
+                continue;
+            }
+            void* data = static_cast<int8_t*>(output.second.arrayBufferView.buffer) +
+                         output.second.arrayBufferView.byteOffset;
+            if (iter->second.data != data) {
+                iter->second.data = data;
+                anyPointersChanged = true;
             }
-            mNamedOutputs = outputs;
+        }
 
-            if (anyPointersChanged) {
-                std::vector<xnn_external_value> externalValues;
-                for (auto& iterator : mExternals) {
-                    externalValues.push_back(iterator.second);
+        if (anyPointersChanged) {
+            std::vector<xnn_external_value> externalValues;
+            for (auto& iterator : context->externals) {
+                externalValues.push_back(iterator.second);
+            }
+            for (size_t i = 0; i < mPermutedExternals.size(); ++i) {
+                if (!mPermutedExternals[i].isOutput) {
+                    externalValues.push_back(
+                        {mPermutedExternals[i].id, context->permutedData[i].data()});
                 }
-                DAWN_TRY(xnn_setup_runtime(mRuntime, externalValues.size(), externalValues.data()));
             }
+            context->isSetUp = false;
+            DAWN_TRY(xnn_setup_runtime(context->runtime, externalValues.size(),
+                                       externalValues.data()));
+            context->isSetUp = true;
         }
 
-        DAWN_TRY(xnn_invoke_runtime(mRuntime));
+        // The runtime runs the subgraph as a whole, so it is profiled as the work of the graph.
+        ScopedKernelProfile profile(
+            nullptr, mSparseInference ? "xnn_invoke_runtime_sparse" : "xnn_invoke_runtime", 0);
+        DAWN_TRY(xnn_invoke_runtime(context->runtime));
 
+        for (size_t i = 0; i < mPermutedExternals.size(); ++i) {
+            const PermutedExternal& permuted = mPermutedExternals[i];
+            auto output = outputs->GetRecords().find(permuted.name);
+            if (!permuted.isOutput || output == outputs->GetRecords().end()) {
+                continue;
+            }
+            const ArrayBufferView& view = output->second.arrayBufferView;
+            const std::vector<float>& data = context->permutedData[i];
+            DAWN_INVALID_IF(view.byteLength < data.size() * sizeof(float),
+                            "The output " + permuted.name + " is too small.");
+            PermuteData(data.data(), permuted.shape, permuted.permutation,
+                        reinterpret_cast<float*>(static_cast<int8_t*>(view.buffer) +
+                                                 view.byteOffset));
+        }
         return {};
     }
 
@@ -15,7 +15,13 @@
 #ifndef WEBNN_NATIVE_XNNPACK_GRAPH_XNN_H_
 #define WEBNN_NATIVE_XNNPACK_GRAPH_XNN_H_
 
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include <xnnpack.h>
 
@@ -58,8 +64,13 @@ namespace webnn::native::xnnpack {
         virtual MaybeError AddReshape(const op::Reshape* reshape) override;
         virtual MaybeError AddSplit(const op::Split* split) override;
         virtual MaybeError AddSqueeze(const op::Squeeze* squeeze) override;
+        virtual MaybeError AddTranspose(const op::Transpose* transpose) override;
         virtual MaybeError AddUnary(const op::Unary* unary) override;
         virtual MaybeError Finish() override;
+        virtual bool SupportsFusedActivation(const op::Conv2d* conv2d,
+                                             FusionType type) const override;
+        virtual bool GetPreferredLayout(wnn::InputOperandLayout* layout) const override;
+        virtual bool SupportsOperator(const OperatorBase* op) const override;
 
       private:
         MaybeError CompileImpl() override;
@@ -67,10 +78,97 @@ namespace webnn::native::xnnpack {
 
         pthreadpool_t GetThreadpool();
 
+        // A runtime with its own external bindings. Runtimes are created from the same subgraph
+        // so they share the constant buffers, one context is used by one Compute at a time.
+        struct ExecutionContext {
+            ~ExecutionContext();
+
+            xnn_runtime_t runtime = nullptr;
+            std::unordered_map<std::string, xnn_external_value> externals;
+            // The data of mPermutedExternals as the runtime reads or writes it.
+            std::vector<std::vector<float>> permutedData;
+            bool isSetUp = false;
+        };
+        xnn_status CreateExecutionContext(std::unique_ptr<ExecutionContext>* context);
+        MaybeError RunExecutionContext(ExecutionContext* context,
+                                       NamedInputsBase* inputs,
+                                       NamedOutputsBase* outputs);
+
         xnn_status DefineXnnTensorValue(xnn_subgraph_t subgraph,
                                         const OperandBase* operand,
                                         uint32_t* id,
                                         const void* data = nullptr);
+        // Defines a float32 value used only within the subgraph, static if |data| is given.
+        xnn_status DefineXnnInternalValue(xnn_subgraph_t subgraph,
+                                          const std::vector<size_t>& dims,
+                                          uint32_t* id,
+                                          const void* data = nullptr);
+        // Defines a static tensor holding the float32 |constant| with its dimensions reordered
+        // by |permutation| and multiplied by |scale|, the data is transposed once here. A
+        // constant of a lower rank is broadcast, its shape is padded with leading ones.
+        xnn_status DefineXnnPermutedConstant(xnn_subgraph_t subgraph,
+                                             const OperandBase* constant,
+                                             const std::vector<int32_t>& permutation,
+                                             uint32_t* id,
+                                             float scale = 1.0f);
+        // Defines a reshape of |inputId| into a new internal value of |dims|.
+        xnn_status DefineXnnReshape(xnn_subgraph_t subgraph,
+                                    uint32_t inputId,
+                                    const std::vector<size_t>& dims,
+                                    uint32_t* id);
+        // Defines a matmul of |a| of any rank and |b| whose batch dimensions are all 1, the same
+        // matrix is the weights of every matrix of |a|. A batched |b| must be constant.
+        xnn_status DefineXnnMatMul(xnn_subgraph_t subgraph,
+                                   const OperandBase* a,
+                                   const OperandBase* b,
+                                   const OperandBase* output,
+                                   uint32_t outputId);
+        // Defines the matmul of |a| and the constant |b|, of |aDims| and |bDims| padded to the
+        // rank of |productDims|, as a fully connected node per matrix of the product, whose
+        // weights are the matrix of |b| in place. The products are concatenated into |outputId|.
+        xnn_status DefineXnnBatchedMatMul(xnn_subgraph_t subgraph,
+                                          const OperandBase* a,
+                                          const std::vector<size_t>& aDims,
+                                          const OperandBase* b,
+                                          const std::vector<size_t>& bDims,
+                                          const std::vector<size_t>& productDims,
+                                          const std::vector<size_t>& outputDims,
+                                          uint32_t outputId);
+        // Defines a static tensor of one element broadcast by the binary nodes.
+        xnn_status DefineXnnScalarConstant(xnn_subgraph_t subgraph, float value, uint32_t* id);
+        // Defines the nodes applying |activation| to |inputId| into |outputId| for the fused
+        // activations XNNPACK can't clamp the output of a node to.
+        xnn_status DefineXnnActivation(xnn_subgraph_t subgraph,
+                                       const FusionOperatorBase* activation,
+                                       const std::vector<size_t>& dims,
+                                       uint32_t inputId,
+                                       uint32_t outputId);
+        // Registers the graph input |operand| as read with its dimensions reordered by
+        // |permutation|, once per permutation, before the subgraph is created.
+        void AddPermutedInput(const OperandBase* operand, const std::vector<int32_t>& permutation);
+        // Returns the value of the graph input |operand| permuted by |permutation|.
+        xnn_status GetXnnPermutedInput(const OperandBase* operand,
+                                       const std::vector<int32_t>& permutation,
+                                       uint32_t* id);
+        // Defines the value of the graph output |operand| as the subgraph computes it, of
+        // |shape|, it is permuted by |permutation| into the output after every run.
+        xnn_status DefineXnnPermutedOutput(xnn_subgraph_t subgraph,
+                                           const OperandBase* operand,
+                                           const std::vector<int32_t>& shape,
+                                           const std::vector<int32_t>& permutation,
+                                           uint32_t* id);
+        // Returns the nhwc value of the nchw |operand|, which is computed in nhwc, a constant, a
+        // graph input, or a value whose data is the same in both layouts.
+        xnn_status GetXnnNhwcValue(xnn_subgraph_t subgraph,
+                                   const OperandBase* operand,
+                                   uint32_t* id);
+        // Defines the nhwc value the nchw |operand| is computed into.
+        xnn_status DefineXnnNhwcValue(xnn_subgraph_t subgraph,
+                                      const OperandBase* operand,
+                                      uint32_t* id);
+        // Defines the nchw value of the |operand| computed in nhwc once it is computed, if other
+        // operators read it in nchw. Only a reshape is needed for that, there is no transpose.
+        xnn_status DefineXnnNchwValue(xnn_subgraph_t subgraph, const OperandBase* operand);
         xnn_status DefineXnnNode(xnn_subgraph_t subgraph, const op::Constant* constant);
         xnn_status DefineXnnNode(xnn_subgraph_t subgraph, const op::Input* Input);
         xnn_status DefineXnnNode(xnn_subgraph_t subgraph, const op::Binary* binary);
@@ -83,6 +181,7 @@ namespace webnn::native::xnnpack {
         xnn_status DefineXnnNode(xnn_subgraph_t subgraph, const op::Reshape* reshape);
         xnn_status DefineXnnNode(xnn_subgraph_t subgraph, const op::Split* split);
         xnn_status DefineXnnNode(xnn_subgraph_t subgraph, const op::Squeeze* squeeze);
+        xnn_status DefineXnnNode(xnn_subgraph_t subgraph, const op::Transpose* transpose);
         xnn_status DefineXnnNode(xnn_subgraph_t subgraph, const op::Unary* unary);
 
         enum OperatorType {
@@ -98,6 +197,7 @@ namespace webnn::native::xnnpack {
             Reshape,
             Split,
             Squeeze,
+            Transpose,
             Unary
         };
         struct OperatorInfo {
@@ -106,18 +206,72 @@ namespace webnn::native::xnnpack {
             OperatorType type;
             const OperatorBase* op;
         };
+        // Whether |operand| is produced by a constant, it is then read when the subgraph is
+        // defined, e.g. to transpose it.
+        bool IsConstant(const OperandBase* operand) const;
+        // Whether |info| is a conv2d or pool2d in nchw, which are run in nhwc.
+        static bool RunsInNhwc(const OperatorInfo& info);
+        // Whether |info| is an element-wise operator, a clamp or a concat reading a value computed
+        // in nhwc, and its other inputs can be read in nhwc too, so that it is run in nhwc.
+        bool CanRunInNhwc(const OperatorInfo& info,
+                          const std::unordered_set<const OperandBase*>& constants) const;
+        // Whether |info| reads its input |index| in nhwc.
+        bool ReadsInNhwc(const OperatorInfo& info, size_t index) const;
+        // Returns the shape of the data the subgraph holds for the input of |transpose| and the
+        // permutation of that data into the output.
+        void GetTransposeSource(const op::Transpose* transpose,
+                                std::vector<int32_t>* shape,
+                                std::vector<int32_t>* permutation) const;
         std::vector<OperatorInfo> mOperators;
         std::unordered_map<const OperandBase*, uint32_t> mOperands;
         std::unordered_map<const OperandBase*, uint32_t> mInputs;
         std::unordered_map<const OperandBase*, uint32_t> mOutputs;
         uint32_t mExternalId;
+        // The data of the constants and of the transposes of constants.
+        std::unordered_map<const OperandBase*, const void*> mConstantData;
+        // The nchw operands computed in nhwc: the outputs of the nchw conv2d and pool2d, of the
+        // operators reading them that don't depend on the layout, and of the transposes between
+        // the layouts. A region of nchw operators then runs in nhwc without transposing in
+        // between, and transposes from and to nhwc only reshape the data.
+        std::unordered_set<const OperandBase*> mNhwcValues;
+        // The nhwc values of nchw operands, and the operands something else reads as they are,
+        // in nchw.
+        std::unordered_map<const OperandBase*, uint32_t> mNhwcOperands;
+        std::unordered_set<const OperandBase*> mNchwUses;
+        // A graph input or output the subgraph reads or writes with its dimensions permuted.
+        // The XNNPACK the backend is built with has no transpose node, so the data is permuted
+        // on the CPU before and after the runtime runs.
+        struct PermutedExternal {
+            std::string name;
+            const OperandBase* operand;
+            uint32_t id;
+            // The shape of the data before it is permuted.
+            std::vector<int32_t> shape;
+            std::vector<int32_t> permutation;
+            bool isOutput;
+        };
+        std::vector<PermutedExternal> mPermutedExternals;
+        // The weights of the constant 1x1 conv2d filters and how many of them are zero, the
+        // runtime is hinted to use the sparse nchw kernels if most of them are.
+        size_t mPointwiseWeightCount;
+        size_t mPointwiseZeroCount;
+        bool mSparseInference;
 
-        std::vector<std::unique_ptr<char>> mBuffers;
+        std::vector<std::unique_ptr<char[]>> mBuffers;
+        std::vector<Ref<MappedFile>> mMappedFiles;
         std::unordered_map<std::string, xnn_external_value> mExternals;
 
-        xnn_runtime_t mRuntime;
-        NamedInputsBase* mNamedInputs;
-        NamedOutputsBase* mNamedOutputs;
+        xnn_subgraph_t mSubgraph;
+        // Creating a runtime optimizes mSubgraph in place, so runtimes are created one at a time.
+        std::mutex mSubgraphMutex;
+        // Guards the idle contexts and their count. Every runtime packs its own copy of the
+        // weights, so at most mMaxContexts are created and further computes wait for one to be
+        // idle. A context is counted before it is created, outside the lock.
+        std::mutex mMutex;
+        std::condition_variable mContextIdle;
+        std::vector<std::unique_ptr<ExecutionContext>> mIdleContexts;
+        size_t mContextCount;
+        size_t mMaxContexts;
     };
 
 }  // namespace webnn::native::xnnpack
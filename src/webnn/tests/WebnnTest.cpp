@@ -17,7 +17,11 @@
 static WebnnTestEnvironment* gTestEnv = nullptr;
 
 void InitWebnnEnd2EndTestEnvironment(wnn::ContextOptions const* options) {
-    gTestEnv = new WebnnTestEnvironment(options);
+    InitWebnnTestEnvironment(new WebnnTestEnvironment(options));
+}
+
+void InitWebnnTestEnvironment(WebnnTestEnvironment* env) {
+    gTestEnv = env;
     testing::AddGlobalTestEnvironment(gTestEnv);
 }
 
@@ -37,7 +37,11 @@ class WebnnTest : public testing::Test {
     bool mError = false;
 };
 
+class WebnnTestEnvironment;
+
 void InitWebnnEnd2EndTestEnvironment(wnn::ContextOptions const* options = nullptr);
+// Registers |env| as the environment providing the context of every WebnnTest.
+void InitWebnnTestEnvironment(WebnnTestEnvironment* env);
 
 class WebnnTestEnvironment : public testing::Environment {
   public:
@@ -0,0 +1,222 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <webnn/native/WebnnNative.h>
+#include <webnn/webnn_proc.h>
+#include <list>
+#include <memory>
+#include <thread>
+
+#include "examples/SampleUtils.h"
+#include "gtest/gtest.h"
+#include "webnn/utils/TerribleCommandBuffer.h"
+#include "webnn/wire/WireClient.h"
+#include "webnn/wire/WireServer.h"
+
+// The requests are computed through a wire server of their own, which batches the
+// GraphComputeAsync commands it handles together.
+class ComputeBatchTests : public testing::Test {
+  protected:
+    static constexpr uint32_t kMaxComputeBatchSize = 4;
+
+    void SetUp() override {
+        mNativeInstance = std::make_unique<webnn::native::Instance>();
+        mBackendProcs = webnn::native::GetProcs();
+        mC2sBuf = std::make_unique<utils::TerribleCommandBuffer>();
+        mS2cBuf = std::make_unique<utils::TerribleCommandBuffer>();
+
+        webnn::wire::WireServerDescriptor serverDesc = {};
+        serverDesc.procs = &mBackendProcs;
+        serverDesc.serializer = mS2cBuf.get();
+        serverDesc.maxComputeBatchSize = kMaxComputeBatchSize;
+        mWireServer = std::make_unique<webnn::wire::WireServer>(serverDesc);
+        mC2sBuf->SetHandler(mWireServer.get());
+
+        webnn::wire::WireClientDescriptor clientDesc = {};
+        clientDesc.serializer = mC2sBuf.get();
+        mWireClient = std::make_unique<webnn::wire::WireClient>(clientDesc);
+        mS2cBuf->SetHandler(mWireClient.get());
+
+        WebnnProcTable procs = webnn::wire::client::GetProcs();
+        webnnProcSetProcs(&procs);
+        webnn::wire::ReservedInstance reservation = mWireClient->ReserveInstance();
+        mWireServer->InjectInstance(mNativeInstance->Get(), reservation.id,
+                                    reservation.generation);
+        mInstance = wnn::Instance::Acquire(reservation.instance);
+        mContext = mInstance.CreateContext(nullptr);
+        mBuilder = mInstance.CreateGraphBuilder(mContext);
+    }
+
+    void TearDown() override {
+        mRequests.clear();
+        mBuilder = nullptr;
+        mContext = nullptr;
+        mInstance = nullptr;
+        mWireClient = nullptr;
+        mWireServer = nullptr;
+#if !defined(WEBNN_ENABLE_WIRE)
+        // The other tests call the native procs directly.
+        WebnnProcTable procs = webnn::native::GetProcs();
+        webnnProcSetProcs(&procs);
+#endif
+    }
+
+    wnn::Graph Build(const wnn::Operand& output) {
+        wnn::NamedOperands namedOperands = mInstance.CreateNamedOperands();
+        namedOperands.Set("y", output);
+        wnn::Graph graph = mBuilder.Build(namedOperands);
+        EXPECT_TRUE(mC2sBuf->Flush());
+        return graph;
+    }
+
+    struct Request {
+        std::vector<float> input;
+        std::vector<int32_t> dimensions;
+        std::vector<float> output;
+        wnn::NamedInputs namedInputs;
+        wnn::NamedOutputs namedOutputs;
+        bool done = false;
+        WNNErrorType type = WNNErrorType_NoError;
+    };
+
+    // Queues the compute of |input|, of shape |dimensions|, into an output of |outputSize|.
+    // The inputs other than "x" are set to |input| too.
+    Request& ComputeAsync(const wnn::Graph& graph,
+                          std::vector<float> input,
+                          std::vector<int32_t> dimensions,
+                          size_t outputSize,
+                          const std::vector<std::string>& otherInputs = {}) {
+        Request& request = mRequests.emplace_back();
+        request.input = std::move(input);
+        request.dimensions = std::move(dimensions);
+        request.output.resize(outputSize);
+        request.namedInputs = mInstance.CreateNamedInputs();
+        wnn::Input namedInput = {};
+        namedInput.resource.arrayBufferView = {request.input.data(),
+                                               request.input.size() * sizeof(float)};
+        namedInput.dimensions = request.dimensions.data();
+        namedInput.dimensionsCount = static_cast<uint32_t>(request.dimensions.size());
+        request.namedInputs.Set("x", &namedInput);
+        for (auto& name : otherInputs) {
+            request.namedInputs.Set(name.c_str(), &namedInput);
+        }
+        request.namedOutputs = mInstance.CreateNamedOutputs();
+        wnn::Resource resource = {};
+        resource.arrayBufferView.buffer = request.output.data();
+        resource.arrayBufferView.byteLength = request.output.size() * sizeof(float);
+        request.namedOutputs.Set("y", &resource);
+        graph.ComputeAsync(
+            request.namedInputs, request.namedOutputs,
+            [](WNNErrorType type, char const*, void* userdata) {
+                Request* request = static_cast<Request*>(userdata);
+                request->type = type;
+                request->done = true;
+            },
+            &request);
+        return request;
+    }
+
+    // Sends the queued computes to the server at once, so that it can batch them, and waits
+    // for their replies.
+    void Wait() {
+        ASSERT_TRUE(mC2sBuf->Flush());
+        for (;;) {
+            mWireServer->ProcessEvents();
+            ASSERT_TRUE(mS2cBuf->Flush());
+            bool done = true;
+            for (auto& request : mRequests) {
+                done = done && request.done;
+            }
+            if (done) {
+                return;
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    std::unique_ptr<webnn::native::Instance> mNativeInstance;
+    WebnnProcTable mBackendProcs;
+    std::unique_ptr<utils::TerribleCommandBuffer> mC2sBuf;
+    std::unique_ptr<utils::TerribleCommandBuffer> mS2cBuf;
+    std::unique_ptr<webnn::wire::WireServer> mWireServer;
+    std::unique_ptr<webnn::wire::WireClient> mWireClient;
+    wnn::Instance mInstance;
+    wnn::Context mContext;
+    wnn::GraphBuilder mBuilder;
+    // The callbacks point into the requests, so they must not move.
+    std::list<Request> mRequests;
+};
+
+TEST_F(ComputeBatchTests, BatchDynamicGraph) {
+    const wnn::Operand x = utils::BuildInput(mBuilder, "x", {-1, 2});
+    const wnn::Graph graph = Build(mBuilder.Add(mBuilder.Relu(x), x));
+    Request& first = ComputeAsync(graph, {-1, 2}, {1, 2}, 2);
+    Request& second = ComputeAsync(graph, {3, -4, -5, 6}, {2, 2}, 4);
+    Request& third = ComputeAsync(graph, {7, 8, -9, 10, 11, -12}, {3, 2}, 6);
+    Wait();
+    EXPECT_EQ(first.type, WNNErrorType_NoError);
+    EXPECT_TRUE(utils::CheckValue(first.output, std::vector<float>({-1, 4})));
+    EXPECT_EQ(second.type, WNNErrorType_NoError);
+    EXPECT_TRUE(utils::CheckValue(second.output, std::vector<float>({6, -4, -5, 12})));
+    EXPECT_EQ(third.type, WNNErrorType_NoError);
+    EXPECT_TRUE(utils::CheckValue(third.output, std::vector<float>({14, 16, -9, 20, 22, -12})));
+}
+
+// A static graph computes every request on its own.
+TEST_F(ComputeBatchTests, StaticGraph) {
+    const wnn::Operand x = utils::BuildInput(mBuilder, "x", {1, 2});
+    const wnn::Graph graph = Build(mBuilder.Relu(x));
+    Request& first = ComputeAsync(graph, {-1, 2}, {1, 2}, 2);
+    Request& second = ComputeAsync(graph, {3, -4}, {1, 2}, 2);
+    Wait();
+    EXPECT_EQ(first.type, WNNErrorType_NoError);
+    EXPECT_TRUE(utils::CheckValue(first.output, std::vector<float>({0, 2})));
+    EXPECT_EQ(second.type, WNNErrorType_NoError);
+    EXPECT_TRUE(utils::CheckValue(second.output, std::vector<float>({3, 0})));
+}
+
+// The leading dimension of the output is twice the batch size, so the outputs of the requests
+// aren't slices of the output of their batch.
+TEST_F(ComputeBatchTests, OutputNotBatched) {
+    const wnn::Operand x = utils::BuildInput(mBuilder, "x", {-1, 2});
+    const std::vector<int32_t> newShape = {-1, 1};
+    const wnn::Operand y = mBuilder.Reshape(x, newShape.data(), newShape.size());
+    const wnn::Graph graph = Build(mBuilder.Relu(y));
+    Request& first = ComputeAsync(graph, {-1, 2}, {1, 2}, 2);
+    Request& second = ComputeAsync(graph, {3, -4, -5, 6}, {2, 2}, 4);
+    Wait();
+    EXPECT_EQ(first.type, WNNErrorType_NoError);
+    EXPECT_TRUE(utils::CheckValue(first.output, std::vector<float>({0, 2})));
+    EXPECT_EQ(second.type, WNNErrorType_NoError);
+    EXPECT_TRUE(utils::CheckValue(second.output, std::vector<float>({3, 0, 0, 6})));
+}
+
+// A request missing an input fails, even if its named inputs reuse the id of destroyed ones
+// that had it.
+TEST_F(ComputeBatchTests, MissingInputAfterDestroy) {
+    const wnn::Operand x = utils::BuildInput(mBuilder, "x", {-1, 2});
+    const wnn::Operand b = utils::BuildInput(mBuilder, "b", {-1, 2});
+    const wnn::Graph graph = Build(mBuilder.Add(x, b));
+    ComputeAsync(graph, {1, 2}, {1, 2}, 2, {"b"});
+    Wait();
+    mRequests.clear();
+    ASSERT_TRUE(mC2sBuf->Flush());
+
+    Request& incomplete = ComputeAsync(graph, {1, 2}, {1, 2}, 2);
+    Request& complete = ComputeAsync(graph, {3, 4}, {1, 2}, 2, {"b"});
+    Wait();
+    EXPECT_NE(incomplete.type, WNNErrorType_NoError);
+    EXPECT_EQ(complete.type, WNNErrorType_NoError);
+    EXPECT_TRUE(utils::CheckValue(complete.output, std::vector<float>({6, 8})));
+}
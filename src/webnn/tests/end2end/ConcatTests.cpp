@@ -339,6 +339,30 @@ TEST_F(ConcatTests, ConcatFive4DIuputs) {
     }
 }
 
+// More than 4 inputs are concatenated by a tree of nodes on XNNPACK, 9 inputs take two levels
+// and leave a run of a single value.
+TEST_F(ConcatTests, ConcatNine1DInputs) {
+    std::vector<TensorDescriptor> inputs;
+    std::vector<float> expectedValue;
+    for (int32_t i = 0; i < 9; ++i) {
+        inputs.push_back({{2}, {float(2 * i), float(2 * i + 1)}});
+        expectedValue.push_back(2 * i);
+        expectedValue.push_back(2 * i + 1);
+    }
+    CheckConcat(inputs, 0, {18}, expectedValue);
+}
+
+TEST_F(ConcatTests, ConcatSeventeen2DInputsWithAxis1) {
+    std::vector<TensorDescriptor> inputs;
+    std::vector<float> expectedValue(2 * 17);
+    for (int32_t i = 0; i < 17; ++i) {
+        inputs.push_back({{2, 1}, {float(i), float(-i)}});
+        expectedValue[i] = i;
+        expectedValue[17 + i] = -i;
+    }
+    CheckConcat(inputs, 1, {2, 17}, expectedValue);
+}
+
 TEST_F(ConcatTests, DISABLED_ConcatTwo1DConstants) {
     const std::vector<TensorDescriptor> inputs = {{{2}, {1, 2}}, {{2}, {3, 4}}};
     const std::vector<int32_t> expectedShape = {4};
@@ -0,0 +1,58 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <thread>
+
+#include "webnn/tests/WebnnTest.h"
+
+class ConcurrentComputeTests : public WebnnTest {};
+
+// Threads computing the same graph each get the outputs of their own inputs.
+TEST_F(ConcurrentComputeTests, ComputeOneGraph) {
+#if defined(WEBNN_ENABLE_WIRE)
+    GTEST_SKIP() << "The wire client is used from one thread.";
+#endif
+    const wnn::GraphBuilder builder = wnn::CreateGraphBuilder(GetContext());
+    const wnn::Operand x = utils::BuildInput(builder, "x", {1, 1, 3, 3});
+    const std::vector<float> filterData(4, 1);
+    const wnn::Operand filter = utils::BuildConstant(builder, {1, 1, 2, 2}, filterData.data(),
+                                                     filterData.size() * sizeof(float));
+    const wnn::Operand y = builder.Relu(builder.Conv2d(x, filter));
+    const wnn::Graph graph = utils::Build(builder, {{"y", y}});
+    ASSERT_TRUE(graph);
+
+    constexpr int kThreadCount = 4;
+    constexpr int kComputeCount = 20;
+    std::vector<int> mismatches(kThreadCount, 0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreadCount; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < kComputeCount; ++i) {
+                // Every window sums four equal values, the negative ones are clamped to 0.
+                const float value = static_cast<float>(t * kComputeCount + i) - 30;
+                const std::vector<float> input(9, value);
+                std::vector<float> result(4);
+                utils::Compute(graph, {{"x", input}}, {{"y", result}});
+                if (!utils::CheckValue(result, std::vector<float>(4, std::max(4 * value, 0.f)))) {
+                    ++mismatches[t];
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(mismatches, std::vector<int>(kThreadCount, 0));
+}
@@ -815,6 +815,48 @@ TEST_F(Conv2dTests, FusedConv2dWithPaddingDefault) {
     CheckConv2d(input, filter, expected, options, bias, utils::FusedActivation::SIGMOID, true);
 }
 
+// Backends without a fused form of these activations compute them after the convolution, e.g.
+// tanh as 2 * sigmoid(2x) - 1 on XNNPACK.
+TEST_F(Conv2dTests, FusedConv2dWithTanhLeakyReluHardSwish) {
+    Tensor input = {{1, 1, 4, 4}, {-4, -3.5, -3, -2.5, -2, -1.5, -1, -0.5, 0, 0.5, 1, 1.5, 2, 2.5,
+                                   3, 3.5}};
+    Tensor filter = {{1, 1, 2, 2}, {1, -0.5, 0.75, 0.25}};
+    Tensor bias = {{1}, {0.5}};
+    utils::Conv2dOptions options;
+    Tensor expected = {{1, 1, 3, 3},
+                       {-0.998580659, -0.993654634, -0.971872746, -0.554599722, 0.124353002,
+                        0.703905604, 0.982845029, 0.996146531, 0.999138886}};
+    CheckConv2d(input, filter, expected, options, bias, utils::FusedActivation::TANH);
+    CheckConv2d(input, filter, expected, options, bias, utils::FusedActivation::TANH, true);
+
+    expected = {{1, 1, 3, 3},
+                {-0.3625, -0.2875, -0.2125, -0.0625, 0.125, 0.875, 2.375, 3.125, 3.875}};
+    wnn::LeakyReluOptions leakyReluOptions = {0.1};
+    CheckConv2d(input, filter, expected, options, bias, utils::FusedActivation::LEAKYRELU, false,
+                &leakyReluOptions);
+    CheckConv2d(input, filter, expected, options, bias, utils::FusedActivation::LEAKYRELU, true,
+                &leakyReluOptions);
+
+    expected = {{1, 1, 3, 3},
+                {0, -0.0598958333, -0.309895833, -0.247395833, 0.0651041667, 0.565104167,
+                 2.12760417, 3.125, 3.875}};
+    CheckConv2d(input, filter, expected, options, bias, utils::FusedActivation::HARDSWISH);
+    CheckConv2d(input, filter, expected, options, bias, utils::FusedActivation::HARDSWISH, true);
+}
+
+// Three quarters of the weights are zero, which makes XNNPACK hint the sparse kernels.
+TEST_F(Conv2dTests, Conv2d1x1WithPrunedFilter) {
+    Tensor input = {{1, 4, 2, 2}, {1, 2, 3, 4, -1, -2, -3, -4, 0.5, 1, 1.5, 2, 10, 20, 30, 40}};
+    Tensor filter = {{4, 4, 1, 1}, {1, 0, 0, 0, 0, 2, 0, 0, 0, 0, 0, -1, 0, 0, 0.5, 0}};
+    Tensor bias = {{4}, {0, 1, -1, 0.5}};
+    utils::Conv2dOptions options;
+    Tensor expected = {{1, 4, 2, 2}, {1, 2, 3, 4, -1, -3, -5, -7, -11, -21, -31, -41, 0.75, 1,
+                                      1.25, 1.5}};
+    CheckConv2d(input, filter, expected, options, bias, utils::FusedActivation::NONE, true);
+    expected = {{1, 4, 2, 2}, {1, 2, 3, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0.75, 1, 1.25, 1.5}};
+    CheckConv2d(input, filter, expected, options, bias, utils::FusedActivation::RELU, true);
+}
+
 TEST_F(Conv2dTests, FusedConv2dWithPaddingNchwHwio) {
     Tensor input = {{1, 1, 5, 5}, {0,  1,  2,  3,  4,  5,  6,  7,  8,  9,  10, 11, 12,
                                    13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24}};
@@ -1212,3 +1254,45 @@ TEST_F(Conv2dTests, Conv2dWithAutoPadSameUpperNhwcIhwo) {
     options.filterLayout = wnn::Conv2dFilterOperandLayout::Ihwo;
     CheckConv2d(input, filter, expected, options);
 }
+
+// The add between the nchw conv2ds broadcasts a bias, it runs in the layout the backend computes
+// the conv2ds in without transposing the values back and forth.
+TEST_F(Conv2dTests, Conv2dAddConv2dNchw) {
+    const wnn::Operand x = utils::BuildInput(builder, "input", {1, 2, 3, 3});
+    const std::vector<float> filter0Data = {1, 0, 1, 2};
+    const wnn::Operand filter0 = utils::BuildConstant(
+        builder, {2, 2, 1, 1}, filter0Data.data(), filter0Data.size() * sizeof(float));
+    const std::vector<float> biasData = {1, -2};
+    const wnn::Operand bias =
+        utils::BuildConstant(builder, {2, 1, 1}, biasData.data(), biasData.size() * sizeof(float));
+    const std::vector<float> filter1Data = {1, 2};
+    const wnn::Operand filter1 = utils::BuildConstant(
+        builder, {1, 2, 1, 1}, filter1Data.data(), filter1Data.size() * sizeof(float));
+    const wnn::Operand conv0 = builder.Conv2d(x, filter0);
+    const wnn::Operand add = builder.Add(conv0, bias);
+    const wnn::Operand y = builder.Conv2d(add, filter1);
+    const wnn::Graph graph = utils::Build(builder, {{"output", y}});
+    ASSERT_TRUE(graph);
+    const std::vector<float> input = {0, 1, 2, 3, 4, 5, 6, 7, 8, 1, 1, 1, 1, 1, 1, 1, 1, 1};
+    std::vector<float> result(9);
+    utils::Compute(graph, {{"input", input}}, {{"output", result}});
+    EXPECT_TRUE(utils::CheckValue(result, std::vector<float>({1, 4, 7, 10, 13, 16, 19, 22, 25})));
+}
+
+// The concat of nchw conv2ds along the channels concatenates the same dimension in any layout.
+TEST_F(Conv2dTests, Conv2dConcatNchw) {
+    const wnn::Operand x = utils::BuildInput(builder, "input", {1, 1, 2, 2});
+    const std::vector<float> filter0Data = {2};
+    const wnn::Operand filter0 = utils::BuildConstant(
+        builder, {1, 1, 1, 1}, filter0Data.data(), filter0Data.size() * sizeof(float));
+    const std::vector<float> filter1Data = {3};
+    const wnn::Operand filter1 = utils::BuildConstant(
+        builder, {1, 1, 1, 1}, filter1Data.data(), filter1Data.size() * sizeof(float));
+    std::vector<wnn::Operand> inputs = {builder.Conv2d(x, filter0), builder.Conv2d(x, filter1)};
+    const wnn::Operand y = builder.Concat(inputs.size(), inputs.data(), 1);
+    const wnn::Graph graph = utils::Build(builder, {{"output", y}});
+    ASSERT_TRUE(graph);
+    std::vector<float> result(8);
+    utils::Compute(graph, {{"input", {1, 2, 3, 4}}}, {{"output", result}});
+    EXPECT_TRUE(utils::CheckValue(result, std::vector<float>({2, 4, 6, 8, 3, 6, 9, 12})));
+}
@@ -366,3 +366,34 @@ TEST_F(GemmTests, bTransposeWithConstantWeight) {
     TestGemm(inputAShape, inputAData, inputBShape, inputBData, expectedShape, expectedValue,
              &options, true);
 }
+
+// Backends may fold alpha into a constant b and beta into c, or scale the product and c instead.
+TEST_F(GemmTests, AlphaBetaFolding) {
+    const std::vector<int32_t> inputAShape = {2, 3};
+    const std::vector<float> inputAData = {1, 2, 3, 4, 5, 6};
+    const std::vector<int32_t> inputBShape = {3, 2};
+    const std::vector<float> inputBData = {1, 0, 0, 1, 1, 1};
+    const std::vector<int32_t> expectedShape = {2, 2};
+    for (bool constantWeight : {false, true}) {
+        Options options;
+        options.alpha = 0.5;
+        TestGemm(inputAShape, inputAData, inputBShape, inputBData, expectedShape,
+                 {2, 2.5, 5, 5.5}, &options, constantWeight);
+
+        // One value of c per column.
+        options.beta = 2;
+        options.cShape = {2};
+        options.cData = {1, -1};
+        TestGemm(inputAShape, inputAData, inputBShape, inputBData, expectedShape,
+                 {4, 0.5, 7, 3.5}, &options, constantWeight);
+
+        // One value of c per row.
+        options.cShape = {2, 1};
+        TestGemm(inputAShape, inputAData, inputBShape, inputBData, expectedShape,
+                 {4, 4.5, 3, 3.5}, &options, constantWeight);
+
+        options.beta = 0;
+        TestGemm(inputAShape, inputAData, inputBShape, inputBData, expectedShape,
+                 {2, 2.5, 5, 5.5}, &options, constantWeight);
+    }
+}
@@ -0,0 +1,106 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "webnn/tests/WebnnTest.h"
+
+class GraphBindTests : public WebnnTest {
+  protected:
+    void SetUp() override {
+        WebnnTest::SetUp();
+        const wnn::GraphBuilder builder = wnn::CreateGraphBuilder(GetContext());
+        const wnn::Operand a = utils::BuildInput(builder, "a", {2, 3});
+        const wnn::Operand b = builder.Relu(a);
+        mGraph = utils::Build(builder, {{"b", b}});
+        ASSERT_TRUE(mGraph);
+    }
+
+    // Binds |inputData| and |result| to the graph, the buffers have to outlive the binding.
+    void Bind(std::vector<float>& inputData, std::vector<float>& result) {
+        mNamedInputs = CreateCppNamedInputs();
+        SetInput(inputData);
+        wnn::Resource output = {};
+        output.arrayBufferView.buffer = result.data();
+        output.arrayBufferView.byteLength = result.size() * sizeof(float);
+        wnn::NamedOutputs namedOutputs = CreateCppNamedOutputs();
+        namedOutputs.Set("b", &output);
+        mGraph.Bind(mNamedInputs, namedOutputs);
+    }
+
+    // Setting the bound input again is what makes the new data visible over the wire.
+    void SetInput(std::vector<float>& inputData) {
+        wnn::Input input = {};
+        input.resource.arrayBufferView = {inputData.data(), inputData.size() * sizeof(float)};
+        mNamedInputs.Set("a", &input);
+    }
+
+    wnn::Graph mGraph;
+    wnn::NamedInputs mNamedInputs;
+};
+
+TEST_F(GraphBindTests, ComputeBoundRepeatedly) {
+    std::vector<float> inputData = {-1, 2, -3, 4, -5, 6};
+    std::vector<float> result(inputData.size());
+    Bind(inputData, result);
+    mGraph.ComputeBound();
+    DoFlush();
+    EXPECT_TRUE(utils::CheckValue(result, std::vector<float>({0, 2, 0, 4, 0, 6})));
+
+    // The binding is kept, only the data of the bound input is updated.
+    inputData = {1, -2, 3, -4, 5, -6};
+    SetInput(inputData);
+    mGraph.ComputeBound();
+    DoFlush();
+    EXPECT_TRUE(utils::CheckValue(result, std::vector<float>({1, 0, 3, 0, 5, 0})));
+}
+
+TEST_F(GraphBindTests, Rebind) {
+    std::vector<float> inputData = {-1, 2, -3, 4, -5, 6};
+    std::vector<float> result(inputData.size());
+    Bind(inputData, result);
+    mGraph.ComputeBound();
+    DoFlush();
+    EXPECT_TRUE(utils::CheckValue(result, std::vector<float>({0, 2, 0, 4, 0, 6})));
+
+    std::vector<float> otherInputData = {6, -5, 4, -3, 2, -1};
+    std::vector<float> otherResult(otherInputData.size());
+    Bind(otherInputData, otherResult);
+    mGraph.ComputeBound();
+    DoFlush();
+    EXPECT_TRUE(utils::CheckValue(otherResult, std::vector<float>({6, 0, 4, 0, 2, 0})));
+    // The buffers of the previous binding are left untouched.
+    EXPECT_TRUE(utils::CheckValue(result, std::vector<float>({0, 2, 0, 4, 0, 6})));
+}
+
+TEST_F(GraphBindTests, ComputeBoundBeforeBind) {
+    StartExpectContextError();
+    mGraph.ComputeBound();
+    DoFlush();
+    EXPECT_TRUE(EndExpectContextError());
+}
+
+TEST_F(GraphBindTests, ComputeMixedWithComputeBound) {
+    std::vector<float> inputData = {-1, 2, -3, 4, -5, 6};
+    std::vector<float> result(inputData.size());
+    Bind(inputData, result);
+
+    // A plain compute with other records doesn't change the binding.
+    const std::vector<float> otherInputData = {1, -2, 3, -4, 5, -6};
+    std::vector<float> otherResult(otherInputData.size());
+    utils::Compute(mGraph, {{"a", otherInputData}}, {{"b", otherResult}});
+    EXPECT_TRUE(utils::CheckValue(otherResult, std::vector<float>({1, 0, 3, 0, 5, 0})));
+
+    mGraph.ComputeBound();
+    DoFlush();
+    EXPECT_TRUE(utils::CheckValue(result, std::vector<float>({0, 2, 0, 4, 0, 6})));
+}
@@ -0,0 +1,343 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <functional>
+#include <initializer_list>
+
+#include "webnn/tests/WebnnTest.h"
+
+class GraphOptimizerTests : public WebnnTest {
+  protected:
+    using BuildFunction =
+        std::function<wnn::Operand(const wnn::GraphBuilder& builder, const wnn::Operand& x)>;
+
+    void SetUp() override {
+        WebnnTest::SetUp();
+        mDisabled.constantFolding = false;
+        mDisabled.deadNodeElimination = false;
+        mDisabled.commonSubexpressionElimination = false;
+        mDisabled.operatorFusion = false;
+        mDisabled.layoutPropagation = false;
+    }
+
+    // Computes the graph built by |build| from the input "x" on a context created with
+    // |options|. The builder is released before computing, so the graph has to keep alive
+    // whatever the passes created.
+    std::vector<float> Compute(const wnn::ContextOptions& options,
+                               const std::vector<int32_t>& inputShape,
+                               size_t outputSize,
+                               const BuildFunction& build) {
+        const wnn::Context context = CreateCppContext(&options);
+        wnn::Graph graph;
+        {
+            const wnn::GraphBuilder builder = wnn::CreateGraphBuilder(context);
+            const wnn::Operand x = utils::BuildInput(builder, "x", inputShape);
+            graph = utils::Build(builder, {{"y", build(builder, x)}});
+        }
+        EXPECT_TRUE(graph);
+        std::vector<float> input(utils::SizeOfShape(inputShape));
+        for (size_t i = 0; i < input.size(); ++i) {
+            input[i] = static_cast<float>(static_cast<int>(i % 11) - 5) / 2.0f;
+        }
+        std::vector<float> result(outputSize);
+        utils::Compute(graph, {{"x", input}}, {{"y", result}});
+        return result;
+    }
+
+    // Expects the graph to compute the same values with only |passes| enabled as with every
+    // pass disabled.
+    void CheckPasses(std::initializer_list<bool wnn::ContextOptions::*> passes,
+                     const std::vector<int32_t>& inputShape,
+                     size_t outputSize,
+                     const BuildFunction& build) {
+        wnn::ContextOptions enabled = mDisabled;
+        for (bool wnn::ContextOptions::*pass : passes) {
+            enabled.*pass = true;
+        }
+        const std::vector<float> expected = Compute(mDisabled, inputShape, outputSize, build);
+        EXPECT_TRUE(utils::CheckValue(Compute(enabled, inputShape, outputSize, build), expected));
+    }
+
+    wnn::ContextOptions mDisabled;
+};
+
+namespace {
+
+    const std::vector<float> kFilter = {1, -2, 3, -1, 2, -3, 0.5, 1, -0.5};
+    const std::vector<float> kValues = {-1.5, 2, -0.5, 3, 0.25, -4};
+
+    wnn::Operand BuildConv2d(const wnn::GraphBuilder& builder, const wnn::Operand& x) {
+        const wnn::Operand w = utils::BuildConstant(builder, {1, 1, 3, 3}, kFilter.data(),
+                                                    kFilter.size() * sizeof(float));
+        utils::Conv2dOptions options;
+        options.padding = {1, 1, 1, 1};
+        return builder.Conv2d(x, w, options.AsPtr());
+    }
+
+    // A conv2d with one input and one output channel in |layout|.
+    wnn::Operand BuildConv2d(const wnn::GraphBuilder& builder,
+                             const wnn::Operand& x,
+                             wnn::InputOperandLayout layout) {
+        const bool nchw = layout == wnn::InputOperandLayout::Nchw;
+        const std::vector<int32_t> filterShape =
+            nchw ? std::vector<int32_t>{1, 1, 3, 3} : std::vector<int32_t>{3, 3, 1, 1};
+        const wnn::Operand w = utils::BuildConstant(builder, filterShape, kFilter.data(),
+                                                    kFilter.size() * sizeof(float));
+        utils::Conv2dOptions options;
+        options.padding = {1, 1, 1, 1};
+        options.inputLayout = layout;
+        options.filterLayout =
+            nchw ? wnn::Conv2dFilterOperandLayout::Oihw : wnn::Conv2dFilterOperandLayout::Hwio;
+        return builder.Conv2d(x, w, options.AsPtr());
+    }
+
+    const std::vector<float> kFilters = {1,   -2, 3,  -1, 2,  -3,   0.5, 1,  -0.5,
+                                         0.5, 1,  -1, 2,  -2, 0.25, 1,   -3, 1.5};
+    const std::vector<float> kChannelBias = {0.5, -1.5};
+    const std::vector<float> kMean = {0.5, -1};
+    const std::vector<float> kVariance = {2, 0.25};
+    const std::vector<float> kScale = {1.5, -0.5};
+    const std::vector<float> kBias = {0.1, 2};
+
+    struct BatchNormFolding {
+        wnn::InputOperandLayout layout = wnn::InputOperandLayout::Nchw;
+        bool convBias = false;
+        bool scaleAndBias = true;
+        utils::FusedActivation activation = utils::FusedActivation::NONE;
+    };
+
+    // A conv2d with two output channels followed by a batchNorm of its channels.
+    wnn::Operand BuildConv2dBatchNorm(const wnn::GraphBuilder& builder,
+                                      const wnn::Operand& x,
+                                      const BatchNormFolding& folding) {
+        const bool nchw = folding.layout == wnn::InputOperandLayout::Nchw;
+        auto channelConstant = [&builder](const std::vector<float>& values) {
+            return utils::BuildConstant(builder, {2}, values.data(), values.size() * sizeof(float));
+        };
+        utils::Conv2dOptions convOptions;
+        convOptions.padding = {1, 1, 1, 1};
+        convOptions.inputLayout = folding.layout;
+        convOptions.filterLayout =
+            nchw ? wnn::Conv2dFilterOperandLayout::Oihw : wnn::Conv2dFilterOperandLayout::Hwio;
+        if (folding.convBias) {
+            convOptions.bias = channelConstant(kChannelBias);
+        }
+        const std::vector<int32_t> filterShape =
+            nchw ? std::vector<int32_t>{2, 1, 3, 3} : std::vector<int32_t>{3, 3, 1, 2};
+        const wnn::Operand w = utils::BuildConstant(builder, filterShape, kFilters.data(),
+                                                    kFilters.size() * sizeof(float));
+        const wnn::Operand conv = builder.Conv2d(x, w, convOptions.AsPtr());
+
+        wnn::BatchNormOptions options;
+        options.axis = nchw ? 1 : 3;
+        if (folding.scaleAndBias) {
+            options.scale = channelConstant(kScale);
+            options.bias = channelConstant(kBias);
+        }
+        if (folding.activation != utils::FusedActivation::NONE) {
+            options.activation = utils::CreateActivationOperator(builder, folding.activation);
+        }
+        return builder.BatchNorm(conv, channelConstant(kMean), channelConstant(kVariance),
+                                 &options);
+    }
+
+}  // namespace
+
+TEST_F(GraphOptimizerTests, FuseRelu) {
+    CheckPasses({&wnn::ContextOptions::operatorFusion}, {1, 1, 5, 5}, 25,
+                [](const wnn::GraphBuilder& builder, const wnn::Operand& x) {
+                    return builder.Relu(BuildConv2d(builder, x));
+                });
+}
+
+TEST_F(GraphOptimizerTests, FuseClamp) {
+    CheckPasses({&wnn::ContextOptions::operatorFusion}, {1, 1, 5, 5}, 25,
+                [](const wnn::GraphBuilder& builder, const wnn::Operand& x) {
+                    wnn::ClampOptions options;
+                    options.minValue = -1;
+                    options.maxValue = 3;
+                    return builder.Clamp(BuildConv2d(builder, x), &options);
+                });
+}
+
+TEST_F(GraphOptimizerTests, FuseLeakyRelu) {
+    CheckPasses({&wnn::ContextOptions::operatorFusion}, {1, 1, 5, 5}, 25,
+                [](const wnn::GraphBuilder& builder, const wnn::Operand& x) {
+                    wnn::LeakyReluOptions options;
+                    options.alpha = 0.1;
+                    return builder.LeakyRelu(BuildConv2d(builder, x), &options);
+                });
+}
+
+TEST_F(GraphOptimizerTests, FuseChainedActivations) {
+    // Only the first activation can be fused, the second one uses a value that is no longer
+    // produced by a conv2d.
+    CheckPasses({&wnn::ContextOptions::operatorFusion}, {1, 1, 5, 5}, 25,
+                [](const wnn::GraphBuilder& builder, const wnn::Operand& x) {
+                    return builder.Sigmoid(builder.Relu(BuildConv2d(builder, x)));
+                });
+}
+
+TEST_F(GraphOptimizerTests, DontFuseSharedValue) {
+    CheckPasses({&wnn::ContextOptions::operatorFusion}, {1, 1, 5, 5}, 25,
+                [](const wnn::GraphBuilder& builder, const wnn::Operand& x) {
+                    const wnn::Operand conv = BuildConv2d(builder, x);
+                    return builder.Add(builder.Relu(conv), conv);
+                });
+}
+
+TEST_F(GraphOptimizerTests, EliminateCommonSubexpressions) {
+    CheckPasses({&wnn::ContextOptions::commonSubexpressionElimination,
+                 &wnn::ContextOptions::deadNodeElimination},
+                {2, 3}, 6, [](const wnn::GraphBuilder& builder, const wnn::Operand& x) {
+                    const wnn::Operand a = builder.Add(builder.Relu(x), x);
+                    const wnn::Operand b = builder.Add(builder.Relu(x), x);
+                    return builder.Mul(a, b);
+                });
+}
+
+TEST_F(GraphOptimizerTests, DontMergeDifferentOptions) {
+    CheckPasses({&wnn::ContextOptions::commonSubexpressionElimination,
+                 &wnn::ContextOptions::deadNodeElimination},
+                {2, 3}, 6, [](const wnn::GraphBuilder& builder, const wnn::Operand& x) {
+                    wnn::LeakyReluOptions options;
+                    options.alpha = 0.1;
+                    const wnn::Operand a = builder.LeakyRelu(x, &options);
+                    options.alpha = 0.2;
+                    const wnn::Operand b = builder.LeakyRelu(x, &options);
+                    return builder.Sub(a, b);
+                });
+}
+
+TEST_F(GraphOptimizerTests, FoldConstantSubgraph) {
+    CheckPasses({&wnn::ContextOptions::constantFolding, &wnn::ContextOptions::deadNodeElimination},
+                {2, 3}, 6, [](const wnn::GraphBuilder& builder, const wnn::Operand& x) {
+                    const wnn::Operand c = utils::BuildConstant(builder, {2, 3}, kValues.data(),
+                                                                kValues.size() * sizeof(float));
+                    return builder.Add(x, builder.Relu(builder.Mul(c, c)));
+                });
+}
+
+TEST_F(GraphOptimizerTests, FoldConstantFilter) {
+    CheckPasses({&wnn::ContextOptions::constantFolding, &wnn::ContextOptions::deadNodeElimination},
+                {1, 1, 5, 5}, 25, [](const wnn::GraphBuilder& builder, const wnn::Operand& x) {
+                    const wnn::Operand w = utils::BuildConstant(builder, {9}, kFilter.data(),
+                                                                kFilter.size() * sizeof(float));
+                    const std::vector<int32_t> newShape = {1, 1, 3, 3};
+                    utils::Conv2dOptions options;
+                    options.padding = {1, 1, 1, 1};
+                    return builder.Conv2d(
+                        x, builder.Reshape(w, newShape.data(), newShape.size()), options.AsPtr());
+                });
+}
+
+TEST_F(GraphOptimizerTests, FoldConstantBranch) {
+    // Only the sigmoid of the constant is folded, the operators using the input are computed.
+    CheckPasses({&wnn::ContextOptions::constantFolding, &wnn::ContextOptions::deadNodeElimination},
+                {2, 3}, 6, [](const wnn::GraphBuilder& builder, const wnn::Operand& x) {
+                    const wnn::Operand c = utils::BuildConstant(builder, {2, 3}, kValues.data(),
+                                                                kValues.size() * sizeof(float));
+                    return builder.Sigmoid(builder.Add(builder.Sigmoid(c), x));
+                });
+}
+
+TEST_F(GraphOptimizerTests, FoldBatchNormNchw) {
+    CheckPasses({&wnn::ContextOptions::operatorFusion}, {1, 1, 5, 5}, 50,
+                [](const wnn::GraphBuilder& builder, const wnn::Operand& x) {
+                    return BuildConv2dBatchNorm(builder, x, {});
+                });
+}
+
+TEST_F(GraphOptimizerTests, FoldBatchNormNhwc) {
+    BatchNormFolding folding;
+    folding.layout = wnn::InputOperandLayout::Nhwc;
+    CheckPasses({&wnn::ContextOptions::operatorFusion}, {1, 5, 5, 1}, 50,
+                [&folding](const wnn::GraphBuilder& builder, const wnn::Operand& x) {
+                    return BuildConv2dBatchNorm(builder, x, folding);
+                });
+}
+
+TEST_F(GraphOptimizerTests, FoldBatchNormIntoConv2dBias) {
+    BatchNormFolding folding;
+    folding.convBias = true;
+    CheckPasses({&wnn::ContextOptions::operatorFusion}, {1, 1, 5, 5}, 50,
+                [&folding](const wnn::GraphBuilder& builder, const wnn::Operand& x) {
+                    return BuildConv2dBatchNorm(builder, x, folding);
+                });
+}
+
+TEST_F(GraphOptimizerTests, FoldBatchNormWithoutScaleAndBias) {
+    BatchNormFolding folding;
+    folding.scaleAndBias = false;
+    CheckPasses({&wnn::ContextOptions::operatorFusion}, {1, 1, 5, 5}, 50,
+                [&folding](const wnn::GraphBuilder& builder, const wnn::Operand& x) {
+                    return BuildConv2dBatchNorm(builder, x, folding);
+                });
+}
+
+TEST_F(GraphOptimizerTests, FoldBatchNormWithActivation) {
+    // The graph is computed after its builder and the activation are released.
+    BatchNormFolding folding;
+    folding.activation = utils::FusedActivation::RELU;
+    CheckPasses({&wnn::ContextOptions::operatorFusion}, {1, 1, 5, 5}, 50,
+                [&folding](const wnn::GraphBuilder& builder, const wnn::Operand& x) {
+                    return BuildConv2dBatchNorm(builder, x, folding);
+                });
+}
+
+TEST_F(GraphOptimizerTests, PropagateLayoutThroughRegion) {
+    CheckPasses({&wnn::ContextOptions::layoutPropagation}, {1, 5, 5, 1}, 25,
+                [](const wnn::GraphBuilder& builder, const wnn::Operand& x) {
+                    const wnn::InputOperandLayout nhwc = wnn::InputOperandLayout::Nhwc;
+                    utils::Pool2dOptions options;
+                    options.windowDimensions = {3, 3};
+                    options.padding = {1, 1, 1, 1};
+                    options.layout = nhwc;
+                    const wnn::Operand pool = builder.MaxPool2d(
+                        builder.Relu(BuildConv2d(builder, x, nhwc)), options.AsPtr());
+                    return BuildConv2d(builder, pool, nhwc);
+                });
+}
+
+TEST_F(GraphOptimizerTests, PropagateLayoutThroughResidual) {
+    CheckPasses({&wnn::ContextOptions::layoutPropagation, &wnn::ContextOptions::constantFolding},
+                {1, 5, 5, 1}, 50, [](const wnn::GraphBuilder& builder, const wnn::Operand& x) {
+                    const wnn::InputOperandLayout nhwc = wnn::InputOperandLayout::Nhwc;
+                    const wnn::Operand conv = BuildConv2d(builder, x, nhwc);
+                    const wnn::Operand add =
+                        builder.Add(BuildConv2d(builder, builder.Relu(conv), nhwc), conv);
+                    const std::vector<wnn::Operand> inputs = {add, conv};
+                    return builder.Concat(inputs.size(), inputs.data(), 3);
+                });
+}
+
+TEST_F(GraphOptimizerTests, PropagateLayoutToBoundary) {
+    // The reshape doesn't depend on the layout, the value it uses is transposed back.
+    CheckPasses({&wnn::ContextOptions::layoutPropagation}, {1, 5, 5, 1}, 25,
+                [](const wnn::GraphBuilder& builder, const wnn::Operand& x) {
+                    const wnn::InputOperandLayout nhwc = wnn::InputOperandLayout::Nhwc;
+                    const std::vector<int32_t> newShape = {5, 5};
+                    const wnn::Operand conv = BuildConv2d(builder, builder.Sigmoid(x), nhwc);
+                    return builder.Reshape(builder.Relu(conv), newShape.data(), newShape.size());
+                });
+}
+
+TEST_F(GraphOptimizerTests, PropagateLayoutNchw) {
+    CheckPasses({&wnn::ContextOptions::layoutPropagation}, {1, 1, 5, 5}, 25,
+                [](const wnn::GraphBuilder& builder, const wnn::Operand& x) {
+                    const wnn::InputOperandLayout nchw = wnn::InputOperandLayout::Nchw;
+                    const wnn::Operand conv = BuildConv2d(builder, x, nchw);
+                    return BuildConv2d(builder, builder.Sigmoid(conv), nchw);
+                });
+}
@@ -0,0 +1,144 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "webnn/tests/WebnnTest.h"
+
+class GraphOutputsTests : public WebnnTest {
+  protected:
+    // The data of a 2x2 tensor, aligned so that backends like MLAS bind it to the graph
+    // instead of copying it.
+    struct alignas(64) Buffer {
+        std::vector<float> Values() const {
+            return std::vector<float>(data, data + 4);
+        }
+        float data[4];
+    };
+
+    void Compute(const wnn::Graph& graph,
+                 const std::vector<std::pair<std::string, Buffer*>>& inputs,
+                 const std::vector<std::pair<std::string, Buffer*>>& outputs) {
+        std::vector<wnn::Input> namedInputData(inputs.size());
+        wnn::NamedInputs namedInputs = CreateCppNamedInputs();
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            namedInputData[i].resource.arrayBufferView = {inputs[i].second->data,
+                                                          sizeof(Buffer::data)};
+            namedInputs.Set(inputs[i].first.c_str(), &namedInputData[i]);
+        }
+        std::vector<wnn::Resource> namedOutputData(outputs.size());
+        wnn::NamedOutputs namedOutputs = CreateCppNamedOutputs();
+        for (size_t i = 0; i < outputs.size(); ++i) {
+            namedOutputData[i].arrayBufferView.buffer = outputs[i].second->data;
+            namedOutputData[i].arrayBufferView.byteLength = sizeof(Buffer::data);
+            namedOutputs.Set(outputs[i].first.c_str(), &namedOutputData[i]);
+        }
+        graph.Compute(namedInputs, namedOutputs);
+        DoFlush();
+    }
+};
+
+// A compute only writes the outputs it asks for, not the buffers of earlier computes.
+TEST_F(GraphOutputsTests, ComputeSomeOutputs) {
+    const wnn::GraphBuilder builder = wnn::CreateGraphBuilder(GetContext());
+    const wnn::Operand x = utils::BuildInput(builder, "x", {2, 2});
+    const wnn::Operand a = builder.Relu(x);
+    const wnn::Operand b = builder.Add(x, x);
+    const wnn::Graph graph = utils::Build(builder, {{"a", a}, {"b", b}});
+    ASSERT_TRUE(graph);
+
+    std::vector<float> a0(4);
+    std::vector<float> b0(4);
+    utils::Compute(graph, {{"x", {-1, 2, -3, 4}}}, {{"a", a0}, {"b", b0}});
+    EXPECT_TRUE(utils::CheckValue(a0, std::vector<float>({0, 2, 0, 4})));
+    EXPECT_TRUE(utils::CheckValue(b0, std::vector<float>({-2, 4, -6, 8})));
+
+    std::vector<float> a1(4);
+    utils::Compute(graph, {{"x", {5, -6, 7, -8}}}, {{"a", a1}});
+    EXPECT_TRUE(utils::CheckValue(a1, std::vector<float>({5, 0, 7, 0})));
+    EXPECT_TRUE(utils::CheckValue(b0, std::vector<float>({-2, 4, -6, 8})));
+
+    std::vector<float> b2(4);
+    utils::Compute(graph, {{"x", {1, 1, 1, 1}}}, {{"b", b2}});
+    EXPECT_TRUE(utils::CheckValue(b2, std::vector<float>({2, 2, 2, 2})));
+    EXPECT_TRUE(utils::CheckValue(a1, std::vector<float>({5, 0, 7, 0})));
+}
+
+// The intermediate results of backends that plan them into shared memory aren't overwritten
+// while they are live: c1 is used after r1 and c2 are computed, and r1 is also an output.
+TEST_F(GraphOutputsTests, OverlappingIntermediates) {
+    const wnn::GraphBuilder builder = wnn::CreateGraphBuilder(GetContext());
+    const wnn::Operand x = utils::BuildInput(builder, "x", {1, 1, 3, 3});
+    const std::vector<float> filter1Data = {1, -1};
+    const wnn::Operand filter1 = utils::BuildConstant(builder, {2, 1, 1, 1}, filter1Data.data(),
+                                                      filter1Data.size() * sizeof(float));
+    const std::vector<float> filter2Data = {1, 1, 1, -1};
+    const wnn::Operand filter2 = utils::BuildConstant(builder, {2, 2, 1, 1}, filter2Data.data(),
+                                                      filter2Data.size() * sizeof(float));
+    // c1 is [x, -x], r1 is [max(x, 0), max(-x, 0)] and c2 is [|x|, x].
+    const wnn::Operand c1 = builder.Conv2d(x, filter1);
+    const wnn::Operand r1 = builder.Relu(c1);
+    const wnn::Operand c2 = builder.Conv2d(r1, filter2);
+    const wnn::Operand y = builder.Add(c2, c1);
+    const wnn::Graph graph = utils::Build(builder, {{"r", r1}, {"y", y}});
+    ASSERT_TRUE(graph);
+
+    std::vector<float> r(18);
+    std::vector<float> yResult(18);
+    utils::Compute(graph, {{"x", {-4, -3, -2, -1, 0, 1, 2, 3, 4}}}, {{"r", r}, {"y", yResult}});
+    EXPECT_TRUE(utils::CheckValue(r, std::vector<float>({0, 0, 0, 0, 0, 1, 2, 3, 4,
+                                                         4, 3, 2, 1, 0, 0, 0, 0, 0})));
+    EXPECT_TRUE(utils::CheckValue(yResult, std::vector<float>({0, 0, 0, 0, 0, 2, 4, 6, 8,
+                                                               0, 0, 0, 0, 0, 0, 0, 0, 0})));
+
+    utils::Compute(graph, {{"x", {4, 3, 2, 1, 0, -1, -2, -3, -4}}}, {{"r", r}, {"y", yResult}});
+    EXPECT_TRUE(utils::CheckValue(r, std::vector<float>({4, 3, 2, 1, 0, 0, 0, 0, 0,
+                                                         0, 0, 0, 0, 0, 1, 2, 3, 4})));
+    EXPECT_TRUE(utils::CheckValue(yResult, std::vector<float>({8, 6, 4, 2, 0, 0, 0, 0, 0,
+                                                               0, 0, 0, 0, 0, 0, 0, 0, 0})));
+}
+
+// Outputs that are a graph input or a constant get their values even if the backend binds the
+// output buffers to the graph, and the input and the constant are left unchanged.
+TEST_F(GraphOutputsTests, OutputsAliasInputAndConstant) {
+    const wnn::GraphBuilder builder = wnn::CreateGraphBuilder(GetContext());
+    const wnn::Operand x = utils::BuildInput(builder, "x", {2, 2});
+    const std::vector<float> constantData = {1, 2, 3, 4};
+    const wnn::Operand c = utils::BuildConstant(builder, {2, 2}, constantData.data(),
+                                                constantData.size() * sizeof(float));
+    const wnn::Graph graph = utils::Build(builder, {{"x", x}, {"c", c}, {"y", builder.Relu(x)}});
+    ASSERT_TRUE(graph);
+
+    Buffer input = {{-1, 2, -3, 4}};
+    Buffer xOutput = {};
+    Buffer cOutput = {};
+    Buffer yOutput = {};
+    Compute(graph, {{"x", &input}}, {{"x", &xOutput}, {"c", &cOutput}, {"y", &yOutput}});
+    EXPECT_TRUE(utils::CheckValue(xOutput.Values(), std::vector<float>({-1, 2, -3, 4})));
+    EXPECT_TRUE(utils::CheckValue(cOutput.Values(), constantData));
+    EXPECT_TRUE(utils::CheckValue(yOutput.Values(), std::vector<float>({0, 2, 0, 4})));
+    EXPECT_TRUE(utils::CheckValue(input.Values(), std::vector<float>({-1, 2, -3, 4})));
+
+    // The buffers of the first compute are no longer bound.
+    Buffer otherInput = {{5, -6, 7, -8}};
+    Buffer otherCOutput = {};
+    Buffer otherYOutput = {};
+    Compute(graph, {{"x", &otherInput}}, {{"c", &otherCOutput}, {"y", &otherYOutput}});
+    EXPECT_TRUE(utils::CheckValue(otherCOutput.Values(), constantData));
+    EXPECT_TRUE(utils::CheckValue(otherYOutput.Values(), std::vector<float>({5, 0, 7, 0})));
+    EXPECT_TRUE(utils::CheckValue(cOutput.Values(), constantData));
+    EXPECT_TRUE(utils::CheckValue(yOutput.Values(), std::vector<float>({0, 2, 0, 4})));
+}
@@ -226,3 +226,70 @@ TEST_F(MatMulTests, MatMul4dx2d) {
     };
     EXPECT_TRUE(utils::CheckValue(result, expectedValue));
 }
+
+TEST_F(MatMulTests, MatMul2dx3dBroadcastA) {
+    const wnn::GraphBuilder builder = wnn::CreateGraphBuilder(GetContext());
+    const wnn::Operand a = utils::BuildInput(builder, "a", {2, 2});
+    const std::vector<float> bData = {-5, -4, -3, -2, -1, 0, 1, 2, 3, 4, 5, 6};
+    const wnn::Operand b =
+        utils::BuildConstant(builder, {3, 2, 2}, bData.data(), bData.size() * sizeof(float));
+    const wnn::Operand c = builder.Matmul(a, b);
+    const wnn::Graph graph = utils::Build(builder, {{"c", c}});
+    ASSERT_TRUE(graph);
+    const std::vector<float> aData = {1, 2, 3, 4};
+    std::vector<float> result(utils::SizeOfShape({3, 2, 2}));
+    utils::Compute(graph, {{"a", aData}}, {{"c", result}});
+    const std::vector<float> expectedValue = {-11, -8, -27, -20, 1, 4, 1, 8, 13, 16, 29, 36};
+    EXPECT_TRUE(utils::CheckValue(result, expectedValue));
+}
+
+TEST_F(MatMulTests, MatMul4dBroadcastBatches) {
+    const wnn::GraphBuilder builder = wnn::CreateGraphBuilder(GetContext());
+    const wnn::Operand a = utils::BuildInput(builder, "a", {2, 1, 1, 2});
+    const std::vector<float> bData = {-1.0, -0.5, 0.0, 0.5, 1.0, 1.5};
+    const wnn::Operand b =
+        utils::BuildConstant(builder, {1, 3, 2, 1}, bData.data(), bData.size() * sizeof(float));
+    const wnn::Operand c = builder.Matmul(a, b);
+    const wnn::Graph graph = utils::Build(builder, {{"c", c}});
+    ASSERT_TRUE(graph);
+    const std::vector<float> aData = {1, -2, 3, 0.5};
+    std::vector<float> result(utils::SizeOfShape({2, 3, 1, 1}));
+    utils::Compute(graph, {{"a", aData}}, {{"c", result}});
+    const std::vector<float> expectedValue = {0.0, -1.0, -2.0, -3.25, 0.25, 3.75};
+    EXPECT_TRUE(utils::CheckValue(result, expectedValue));
+}
+
+// The XNNPACK backend splits the matrices of a by a tree of even splits into 2 to 4 values, 5
+// matrices can't be split that way and the matmul falls back to the reference backend.
+TEST_F(MatMulTests, MatMul3dFiveBatches) {
+    const wnn::GraphBuilder builder = wnn::CreateGraphBuilder(GetContext());
+    const wnn::Operand a = utils::BuildInput(builder, "a", {5, 1, 2});
+    const std::vector<float> bData = {0.0, 0.25, 0.5, 0.75, 1.0, 1.25, 1.5, 1.75, 2.0, 2.25};
+    const wnn::Operand b =
+        utils::BuildConstant(builder, {5, 2, 1}, bData.data(), bData.size() * sizeof(float));
+    const wnn::Operand c = builder.Matmul(a, b);
+    const wnn::Graph graph = utils::Build(builder, {{"c", c}});
+    ASSERT_TRUE(graph);
+    const std::vector<float> aData = {-4, -3, -2, -1, 0, 1, 2, 3, 4, 5};
+    std::vector<float> result(utils::SizeOfShape({5, 1, 1}));
+    utils::Compute(graph, {{"a", aData}}, {{"c", result}});
+    const std::vector<float> expectedValue = {-0.75, -1.75, 1.25, 8.25, 19.25};
+    EXPECT_TRUE(utils::CheckValue(result, expectedValue));
+}
+
+// The XNNPACK backend only supports a batched b that is constant, the matrices of b are the
+// weights of fully connected nodes, a batched b computed by the graph falls back.
+TEST_F(MatMulTests, MatMul3dBatchedInputB) {
+    const wnn::GraphBuilder builder = wnn::CreateGraphBuilder(GetContext());
+    const wnn::Operand a = utils::BuildInput(builder, "a", {2, 2, 2});
+    const wnn::Operand b = utils::BuildInput(builder, "b", {2, 2, 2});
+    const wnn::Operand c = builder.Matmul(a, b);
+    const wnn::Graph graph = utils::Build(builder, {{"c", c}});
+    ASSERT_TRUE(graph);
+    const std::vector<float> aData = {1, 2, 3, 4, 5, 6, 7, 8};
+    const std::vector<float> bData = {1, 0, -1, 2, 0.5, 1, 3, -2};
+    std::vector<float> result(utils::SizeOfShape({2, 2, 2}));
+    utils::Compute(graph, {{"a", aData}, {"b", bData}}, {{"c", result}});
+    const std::vector<float> expectedValue = {-1, 4, -1, 8, 20.5, -7, 27.5, -9};
+    EXPECT_TRUE(utils::CheckValue(result, expectedValue));
+}
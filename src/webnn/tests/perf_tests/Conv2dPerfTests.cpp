@@ -0,0 +1,94 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "webnn/tests/perf_tests/WebnnPerfTest.h"
+
+namespace {
+
+    struct Conv2dParams {
+        int32_t batch;
+        int32_t inputChannels;
+        int32_t size;
+        int32_t outputChannels;
+        int32_t kernel;
+        int32_t stride;
+        bool depthwise;
+        bool nhwc;
+    };
+
+    std::string Conv2dParamsName(const testing::TestParamInfo<Conv2dParams>& info) {
+        const Conv2dParams& p = info.param;
+        return std::string(p.nhwc ? "Nhwc" : "Nchw") + (p.depthwise ? "Depthwise" : "") + "_N" +
+               std::to_string(p.batch) + "_C" + std::to_string(p.inputChannels) + "_S" +
+               std::to_string(p.size) + "_K" + std::to_string(p.outputChannels) + "_R" +
+               std::to_string(p.kernel) + "_Stride" + std::to_string(p.stride);
+    }
+
+}  // namespace
+
+class Conv2dPerfTests : public WebnnPerfTest, public testing::WithParamInterface<Conv2dParams> {};
+
+TEST_P(Conv2dPerfTests, Conv2d) {
+    const Conv2dParams& p = GetParam();
+    const int32_t groups = p.depthwise ? p.inputChannels : 1;
+    const int32_t padding = p.kernel / 2;
+    const int32_t outputSize = (p.size + 2 * padding - p.kernel) / p.stride + 1;
+
+    utils::Conv2dOptions options;
+    options.padding = {padding, padding, padding, padding};
+    options.strides = {p.stride, p.stride};
+    options.groups = groups;
+    std::vector<int32_t> inputShape, filterShape, outputShape;
+    if (p.nhwc) {
+        options.inputLayout = wnn::InputOperandLayout::Nhwc;
+        inputShape = {p.batch, p.size, p.size, p.inputChannels};
+        outputShape = {p.batch, outputSize, outputSize, p.outputChannels};
+        if (p.depthwise) {
+            options.filterLayout = wnn::Conv2dFilterOperandLayout::Ihwo;
+            filterShape = {1, p.kernel, p.kernel, p.outputChannels};
+        } else {
+            options.filterLayout = wnn::Conv2dFilterOperandLayout::Ohwi;
+            filterShape = {p.outputChannels, p.kernel, p.kernel, p.inputChannels};
+        }
+    } else {
+        inputShape = {p.batch, p.inputChannels, p.size, p.size};
+        outputShape = {p.batch, p.outputChannels, outputSize, outputSize};
+        filterShape = {p.outputChannels, p.inputChannels / groups, p.kernel, p.kernel};
+    }
+
+    const wnn::GraphBuilder builder = wnn::CreateGraphBuilder(GetContext());
+    const wnn::Operand input = utils::BuildInput(builder, "input", inputShape);
+    const std::vector<float> filterData(utils::SizeOfShape(filterShape), 0.1f);
+    const wnn::Operand filter = utils::BuildConstant(builder, filterShape, filterData.data(),
+                                                     filterData.size() * sizeof(float));
+    const wnn::Operand output = builder.Conv2d(input, filter, options.AsPtr());
+    RunPerfTest(builder, {{"output", output}}, {{"input", inputShape}},
+                {{"output", outputShape}});
+}
+
+INSTANTIATE_TEST_SUITE_P(,
+                         Conv2dPerfTests,
+                         testing::Values(Conv2dParams{1, 3, 224, 32, 3, 2, false, false},
+                                         Conv2dParams{1, 64, 56, 64, 3, 1, false, false},
+                                         Conv2dParams{1, 256, 14, 256, 3, 1, false, false},
+                                         Conv2dParams{1, 256, 56, 64, 1, 1, false, false},
+                                         Conv2dParams{1, 144, 56, 144, 3, 1, true, false},
+                                         Conv2dParams{8, 64, 56, 64, 3, 1, false, false},
+                                         Conv2dParams{1, 3, 224, 32, 3, 2, false, true},
+                                         Conv2dParams{1, 64, 56, 64, 3, 1, false, true},
+                                         Conv2dParams{1, 256, 14, 256, 3, 1, false, true},
+                                         Conv2dParams{1, 256, 56, 64, 1, 1, false, true},
+                                         Conv2dParams{1, 144, 56, 144, 3, 1, true, true},
+                                         Conv2dParams{8, 64, 56, 64, 3, 1, false, true}),
+                         Conv2dParamsName);
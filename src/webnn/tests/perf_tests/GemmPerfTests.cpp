@@ -0,0 +1,64 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "webnn/tests/perf_tests/WebnnPerfTest.h"
+
+namespace {
+
+    struct GemmParams {
+        int32_t m;
+        int32_t k;
+        int32_t n;
+        bool bTranspose;
+    };
+
+    std::string GemmParamsName(const testing::TestParamInfo<GemmParams>& info) {
+        const GemmParams& p = info.param;
+        return "M" + std::to_string(p.m) + "_K" + std::to_string(p.k) + "_N" +
+               std::to_string(p.n) + (p.bTranspose ? "_BTranspose" : "");
+    }
+
+}  // namespace
+
+class GemmPerfTests : public WebnnPerfTest, public testing::WithParamInterface<GemmParams> {};
+
+TEST_P(GemmPerfTests, Gemm) {
+    const GemmParams& p = GetParam();
+    const std::vector<int32_t> aShape = {p.m, p.k};
+    const std::vector<int32_t> bShape =
+        p.bTranspose ? std::vector<int32_t>{p.n, p.k} : std::vector<int32_t>{p.k, p.n};
+    const std::vector<int32_t> cShape = {p.n};
+
+    const wnn::GraphBuilder builder = wnn::CreateGraphBuilder(GetContext());
+    const wnn::Operand a = utils::BuildInput(builder, "a", aShape);
+    const std::vector<float> bData(utils::SizeOfShape(bShape), 0.1f);
+    const wnn::Operand b =
+        utils::BuildConstant(builder, bShape, bData.data(), bData.size() * sizeof(float));
+    const std::vector<float> cData(utils::SizeOfShape(cShape), 0.1f);
+    wnn::GemmOptions options;
+    options.c = utils::BuildConstant(builder, cShape, cData.data(), cData.size() * sizeof(float));
+    options.bTranspose = p.bTranspose;
+    const wnn::Operand output = builder.Gemm(a, b, &options);
+    RunPerfTest(builder, {{"output", output}}, {{"a", aShape}}, {{"output", {p.m, p.n}}});
+}
+
+INSTANTIATE_TEST_SUITE_P(,
+                         GemmPerfTests,
+                         testing::Values(GemmParams{1, 1280, 1000, false},
+                                         GemmParams{1, 2048, 1000, true},
+                                         GemmParams{64, 512, 512, false},
+                                         GemmParams{128, 1024, 1024, true},
+                                         GemmParams{512, 512, 512, false}),
+                         GemmParamsName);
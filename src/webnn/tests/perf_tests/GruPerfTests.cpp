@@ -0,0 +1,64 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "webnn/tests/perf_tests/WebnnPerfTest.h"
+
+namespace {
+
+    struct GruParams {
+        int32_t steps;
+        int32_t batch;
+        int32_t inputSize;
+        int32_t hiddenSize;
+    };
+
+    std::string GruParamsName(const testing::TestParamInfo<GruParams>& info) {
+        const GruParams& p = info.param;
+        return "Steps" + std::to_string(p.steps) + "_Batch" + std::to_string(p.batch) +
+               "_Input" + std::to_string(p.inputSize) + "_Hidden" + std::to_string(p.hiddenSize);
+    }
+
+}  // namespace
+
+class GruPerfTests : public WebnnPerfTest, public testing::WithParamInterface<GruParams> {};
+
+TEST_P(GruPerfTests, Gru) {
+    const GruParams& p = GetParam();
+    const std::vector<int32_t> inputShape = {p.steps, p.batch, p.inputSize};
+    const std::vector<int32_t> weightShape = {1, 3 * p.hiddenSize, p.inputSize};
+    const std::vector<int32_t> recurrentWeightShape = {1, 3 * p.hiddenSize, p.hiddenSize};
+
+    const wnn::GraphBuilder builder = wnn::CreateGraphBuilder(GetContext());
+    const wnn::Operand input = utils::BuildInput(builder, "input", inputShape);
+    const std::vector<float> weightData(utils::SizeOfShape(weightShape), 0.1f);
+    const wnn::Operand weight = utils::BuildConstant(builder, weightShape, weightData.data(),
+                                                     weightData.size() * sizeof(float));
+    const std::vector<float> recurrentWeightData(utils::SizeOfShape(recurrentWeightShape), 0.1f);
+    const wnn::Operand recurrentWeight =
+        utils::BuildConstant(builder, recurrentWeightShape, recurrentWeightData.data(),
+                             recurrentWeightData.size() * sizeof(float));
+    const wnn::OperandArray outputs =
+        builder.Gru(input, weight, recurrentWeight, p.steps, p.hiddenSize);
+    RunPerfTest(builder, {{"output", outputs.Get(0)}}, {{"input", inputShape}},
+                {{"output", {1, p.batch, p.hiddenSize}}});
+}
+
+INSTANTIATE_TEST_SUITE_P(,
+                         GruPerfTests,
+                         testing::Values(GruParams{1, 1, 256, 256},
+                                         GruParams{16, 1, 256, 256},
+                                         GruParams{16, 8, 512, 512},
+                                         GruParams{64, 1, 128, 128}),
+                         GruParamsName);
@@ -0,0 +1,104 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "examples/MobileNetV2/MobileNetV2.h"
+#include "examples/ResNet/ResNet.h"
+#include "examples/SqueezeNet/SqueezeNet.h"
+#include "examples/SuperResolution/SuperResolution.h"
+#include "webnn/tests/perf_tests/WebnnPerfTest.h"
+
+static const std::string kModelPath = WEBNN_END2END_TEST_MODEL_PATH;
+
+// The models of the end2end tests, built the same way with their real weights and timed on a
+// generated input.
+class ModelPerfTests : public WebnnPerfTest {
+  protected:
+    const std::vector<int32_t> kNchwInputShape = {1, 3, 224, 224};
+    const std::vector<int32_t> kNhwcInputShape = {1, 224, 224, 3};
+};
+
+TEST_F(ModelPerfTests, MobileNetV2Nchw) {
+    MobileNetV2 mobilenetv2;
+    mobilenetv2.mWeightsPath = kModelPath + "/mobilenetv2_nchw/weights/";
+    const wnn::GraphBuilder builder = wnn::CreateGraphBuilder(GetContext());
+    const wnn::Operand output = mobilenetv2.LoadNchw(builder, false);
+    RunPerfTest(builder, {{"output", output}}, {{"input", kNchwInputShape}},
+                {{"output", {1, 1000}}});
+}
+
+TEST_F(ModelPerfTests, MobileNetV2BatchNormNchw) {
+    MobileNetV2 mobilenetv2;
+    mobilenetv2.mWeightsPath = kModelPath + "/mobilenetv2_batchnorm_nchw/weights/";
+    const wnn::GraphBuilder builder = wnn::CreateGraphBuilder(GetContext());
+    const wnn::Operand output = mobilenetv2.LoadBatchNormNchw(builder, false);
+    RunPerfTest(builder, {{"output", output}}, {{"input", kNchwInputShape}},
+                {{"output", {1, 1000}}});
+}
+
+TEST_F(ModelPerfTests, MobileNetV2Nhwc) {
+    MobileNetV2 mobilenetv2;
+    mobilenetv2.mWeightsPath = kModelPath + "/mobilenetv2_nhwc/weights/";
+    mobilenetv2.mLayout = "nhwc";
+    const wnn::GraphBuilder builder = wnn::CreateGraphBuilder(GetContext());
+    const wnn::Operand output = mobilenetv2.LoadNhwc(builder);
+    RunPerfTest(builder, {{"output", output}}, {{"input", kNhwcInputShape}},
+                {{"output", {1, 1001}}});
+}
+
+TEST_F(ModelPerfTests, ResNetNchw) {
+    ResNet resnet;
+    resnet.mWeightsPath = kModelPath + "/resnet50v2_nchw/weights/";
+    const wnn::GraphBuilder builder = wnn::CreateGraphBuilder(GetContext());
+    const wnn::Operand output = resnet.LoadNchw(builder, false);
+    RunPerfTest(builder, {{"output", output}}, {{"input", kNchwInputShape}},
+                {{"output", {1, 1000}}});
+}
+
+TEST_F(ModelPerfTests, ResNetNhwc) {
+    ResNet resnet;
+    resnet.mWeightsPath = kModelPath + "/resnet50v2_nhwc/weights/";
+    const wnn::GraphBuilder builder = wnn::CreateGraphBuilder(GetContext());
+    const wnn::Operand output = resnet.LoadNhwc(builder, true);
+    RunPerfTest(builder, {{"output", output}}, {{"input", kNhwcInputShape}},
+                {{"output", {1, 1001}}});
+}
+
+TEST_F(ModelPerfTests, SqueezeNetNchw) {
+    SqueezeNet squeezenet;
+    squeezenet.mWeightsPath = kModelPath + "/squeezenet1.1_nchw/weights/";
+    const wnn::GraphBuilder builder = wnn::CreateGraphBuilder(GetContext());
+    const wnn::Operand output = squeezenet.LoadNchw(builder, false);
+    RunPerfTest(builder, {{"output", output}}, {{"input", kNchwInputShape}},
+                {{"output", {1, 1000}}});
+}
+
+TEST_F(ModelPerfTests, SqueezeNetNhwc) {
+    SqueezeNet squeezenet;
+    squeezenet.mWeightsPath = kModelPath + "/squeezenet1.0_nhwc/weights/";
+    squeezenet.mLayout = "nhwc";
+    const wnn::GraphBuilder builder = wnn::CreateGraphBuilder(GetContext());
+    const wnn::Operand output = squeezenet.LoadNhwc(builder);
+    RunPerfTest(builder, {{"output", output}}, {{"input", kNhwcInputShape}},
+                {{"output", {1, 1001}}});
+}
+
+TEST_F(ModelPerfTests, SuperResolutionNchw) {
+    SuperResolution superresolution;
+    superresolution.mWeightsPath = kModelPath + "/super_resolution_nchw/weights/";
+    const wnn::GraphBuilder builder = wnn::CreateGraphBuilder(GetContext());
+    const wnn::Operand output = superresolution.LoadNchw(builder, false);
+    RunPerfTest(builder, {{"output", output}}, {{"input", {1, 1, 224, 224}}},
+                {{"output", {1, 1, 672, 672}}});
+}
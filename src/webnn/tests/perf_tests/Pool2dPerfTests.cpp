@@ -0,0 +1,76 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "webnn/tests/perf_tests/WebnnPerfTest.h"
+
+namespace {
+
+    enum class PoolType { kAverage, kMax };
+
+    struct Pool2dParams {
+        PoolType type;
+        int32_t channels;
+        int32_t size;
+        int32_t window;
+        int32_t stride;
+        bool nhwc;
+    };
+
+    std::string Pool2dParamsName(const testing::TestParamInfo<Pool2dParams>& info) {
+        const Pool2dParams& p = info.param;
+        return std::string(p.type == PoolType::kAverage ? "Average" : "Max") +
+               (p.nhwc ? "Nhwc" : "Nchw") + "_C" + std::to_string(p.channels) + "_S" +
+               std::to_string(p.size) + "_Window" + std::to_string(p.window) + "_Stride" +
+               std::to_string(p.stride);
+    }
+
+}  // namespace
+
+class Pool2dPerfTests : public WebnnPerfTest, public testing::WithParamInterface<Pool2dParams> {};
+
+TEST_P(Pool2dPerfTests, Pool2d) {
+    const Pool2dParams& p = GetParam();
+    const int32_t outputSize = (p.size - p.window) / p.stride + 1;
+    utils::Pool2dOptions options;
+    options.windowDimensions = {p.window, p.window};
+    options.strides = {p.stride, p.stride};
+    std::vector<int32_t> inputShape, outputShape;
+    if (p.nhwc) {
+        options.layout = wnn::InputOperandLayout::Nhwc;
+        inputShape = {1, p.size, p.size, p.channels};
+        outputShape = {1, outputSize, outputSize, p.channels};
+    } else {
+        inputShape = {1, p.channels, p.size, p.size};
+        outputShape = {1, p.channels, outputSize, outputSize};
+    }
+
+    const wnn::GraphBuilder builder = wnn::CreateGraphBuilder(GetContext());
+    const wnn::Operand input = utils::BuildInput(builder, "input", inputShape);
+    const wnn::Operand output = p.type == PoolType::kAverage
+                                    ? builder.AveragePool2d(input, options.AsPtr())
+                                    : builder.MaxPool2d(input, options.AsPtr());
+    RunPerfTest(builder, {{"output", output}}, {{"input", inputShape}},
+                {{"output", outputShape}});
+}
+
+INSTANTIATE_TEST_SUITE_P(,
+                         Pool2dPerfTests,
+                         testing::Values(Pool2dParams{PoolType::kMax, 64, 112, 3, 2, false},
+                                         Pool2dParams{PoolType::kAverage, 1280, 7, 7, 1, false},
+                                         Pool2dParams{PoolType::kAverage, 256, 56, 2, 2, false},
+                                         Pool2dParams{PoolType::kMax, 64, 112, 3, 2, true},
+                                         Pool2dParams{PoolType::kAverage, 1280, 7, 7, 1, true},
+                                         Pool2dParams{PoolType::kAverage, 256, 56, 2, 2, true}),
+                         Pool2dParamsName);
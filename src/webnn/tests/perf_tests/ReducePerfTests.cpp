@@ -0,0 +1,83 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "webnn/tests/perf_tests/WebnnPerfTest.h"
+
+namespace {
+
+    enum class ReduceType { kMax, kMean, kSum };
+
+    struct ReduceParams {
+        ReduceType type;
+        std::vector<int32_t> shape;
+        std::vector<int32_t> axes;
+    };
+
+    std::string ReduceParamsName(const testing::TestParamInfo<ReduceParams>& info) {
+        const ReduceParams& p = info.param;
+        std::string name = p.type == ReduceType::kMax    ? "Max"
+                           : p.type == ReduceType::kMean ? "Mean"
+                                                         : "Sum";
+        name += "_Shape";
+        for (int32_t dimension : p.shape) {
+            name += "x" + std::to_string(dimension);
+        }
+        name += "_Axes";
+        for (int32_t axis : p.axes) {
+            name += std::to_string(axis);
+        }
+        return name;
+    }
+
+}  // namespace
+
+class ReducePerfTests : public WebnnPerfTest, public testing::WithParamInterface<ReduceParams> {};
+
+TEST_P(ReducePerfTests, Reduce) {
+    const ReduceParams& p = GetParam();
+    std::vector<int32_t> outputShape = p.shape;
+    for (int32_t axis : p.axes) {
+        outputShape[axis] = 1;
+    }
+    wnn::ReduceOptions options;
+    options.axes = p.axes.data();
+    options.axesCount = p.axes.size();
+    options.keepDimensions = true;
+
+    const wnn::GraphBuilder builder = wnn::CreateGraphBuilder(GetContext());
+    const wnn::Operand input = utils::BuildInput(builder, "input", p.shape);
+    wnn::Operand output;
+    switch (p.type) {
+        case ReduceType::kMax:
+            output = builder.ReduceMax(input, &options);
+            break;
+        case ReduceType::kMean:
+            output = builder.ReduceMean(input, &options);
+            break;
+        case ReduceType::kSum:
+            output = builder.ReduceSum(input, &options);
+            break;
+    }
+    RunPerfTest(builder, {{"output", output}}, {{"input", p.shape}}, {{"output", outputShape}});
+}
+
+INSTANTIATE_TEST_SUITE_P(,
+                         ReducePerfTests,
+                         testing::Values(ReduceParams{ReduceType::kMean, {1, 1280, 7, 7}, {2, 3}},
+                                         ReduceParams{ReduceType::kMean, {1, 256, 56, 56}, {1}},
+                                         ReduceParams{ReduceType::kMax, {1, 256, 56, 56}, {2, 3}},
+                                         ReduceParams{ReduceType::kSum, {64, 1024}, {1}},
+                                         ReduceParams{ReduceType::kSum, {64, 1024}, {0}}),
+                         ReduceParamsName);
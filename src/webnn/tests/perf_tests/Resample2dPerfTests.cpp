@@ -0,0 +1,65 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "webnn/tests/perf_tests/WebnnPerfTest.h"
+
+namespace {
+
+    struct Resample2dParams {
+        wnn::InterpolationMode mode;
+        int32_t channels;
+        int32_t size;
+        int32_t scale;
+    };
+
+    std::string Resample2dParamsName(const testing::TestParamInfo<Resample2dParams>& info) {
+        const Resample2dParams& p = info.param;
+        return std::string(p.mode == wnn::InterpolationMode::Linear ? "Linear" : "Nearest") +
+               "_C" + std::to_string(p.channels) + "_S" + std::to_string(p.size) + "_Scale" +
+               std::to_string(p.scale);
+    }
+
+}  // namespace
+
+class Resample2dPerfTests : public WebnnPerfTest,
+                            public testing::WithParamInterface<Resample2dParams> {};
+
+TEST_P(Resample2dPerfTests, Resample2d) {
+    const Resample2dParams& p = GetParam();
+    const std::vector<int32_t> inputShape = {1, p.channels, p.size, p.size};
+    const std::vector<float> scales = {static_cast<float>(p.scale), static_cast<float>(p.scale)};
+    const std::vector<int32_t> axes = {2, 3};
+    wnn::Resample2dOptions options;
+    options.mode = p.mode;
+    options.scales = scales.data();
+    options.scalesCount = scales.size();
+    options.axes = axes.data();
+    options.axesCount = axes.size();
+
+    const wnn::GraphBuilder builder = wnn::CreateGraphBuilder(GetContext());
+    const wnn::Operand input = utils::BuildInput(builder, "input", inputShape);
+    const wnn::Operand output = builder.Resample2d(input, &options);
+    RunPerfTest(builder, {{"output", output}}, {{"input", inputShape}},
+                {{"output", {1, p.channels, p.size * p.scale, p.size * p.scale}}});
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    ,
+    Resample2dPerfTests,
+    testing::Values(Resample2dParams{wnn::InterpolationMode::NearestNeighbor, 64, 56, 2},
+                    Resample2dParams{wnn::InterpolationMode::Linear, 64, 56, 2},
+                    Resample2dParams{wnn::InterpolationMode::Linear, 3, 224, 2},
+                    Resample2dParams{wnn::InterpolationMode::NearestNeighbor, 256, 14, 4}),
+    Resample2dParamsName);
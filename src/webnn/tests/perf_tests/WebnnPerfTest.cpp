@@ -0,0 +1,186 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "webnn/tests/perf_tests/WebnnPerfTest.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include <thread>
+
+static WebnnPerfTestEnvironment* gPerfTestEnv = nullptr;
+
+namespace {
+
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+
+    // Nearest-rank percentile of the sorted |samples|.
+    double Percentile(const std::vector<double>& samples, double percentile) {
+        size_t rank = static_cast<size_t>(std::ceil(percentile / 100.0 * samples.size()));
+        return samples[std::max<size_t>(rank, 1) - 1];
+    }
+
+    std::string EscapeJson(const std::string& value) {
+        std::string escaped;
+        for (char c : value) {
+            if (c == '"' || c == '\\') {
+                escaped += '\\';
+            }
+            escaped += c;
+        }
+        return escaped;
+    }
+
+}  // namespace
+
+void InitWebnnPerfTestEnvironment(int argc, char** argv) {
+    PerfTestOptions options;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp("-d", argv[i]) == 0 && i + 1 < argc) {
+            options.devicePreference = argv[i + 1];
+        } else if (strcmp("-p", argv[i]) == 0 && i + 1 < argc) {
+            options.powerPreference = argv[i + 1];
+        } else if (strcmp("-w", argv[i]) == 0 && i + 1 < argc) {
+            options.warmupIterations = atoi(argv[i + 1]);
+        } else if (strcmp("-n", argv[i]) == 0 && i + 1 < argc) {
+            options.iterations = std::max(atoi(argv[i + 1]), 1);
+        } else if (strcmp("-t", argv[i]) == 0 && i + 1 < argc) {
+            options.threadCount = atoi(argv[i + 1]);
+        } else if (strcmp("-o", argv[i]) == 0 && i + 1 < argc) {
+            options.outputPath = argv[i + 1];
+        }
+    }
+    gPerfTestEnv = new WebnnPerfTestEnvironment(options);
+    InitWebnnTestEnvironment(gPerfTestEnv);
+}
+
+WebnnPerfTestEnvironment::WebnnPerfTestEnvironment(const PerfTestOptions& perfOptions)
+    : WebnnTestEnvironment(&mContextOptions),
+      mPerfOptions(perfOptions),
+      mContextOptions(utils::CreateContextOptions(perfOptions.devicePreference,
+                                                  perfOptions.powerPreference)) {
+    mContextOptions.threadCount = perfOptions.threadCount;
+}
+
+const PerfTestOptions& WebnnPerfTestEnvironment::GetPerfOptions() const {
+    return mPerfOptions;
+}
+
+void WebnnPerfTestEnvironment::AddResult(const PerfTestResult& result) {
+    mResults.push_back(result);
+}
+
+void WebnnPerfTestEnvironment::TearDown() {
+    if (mPerfOptions.outputPath.empty()) {
+        return;
+    }
+    std::ofstream file(mPerfOptions.outputPath);
+    if (!file) {
+        dawn::ErrorLog() << "Failed to open " << mPerfOptions.outputPath << ".";
+        return;
+    }
+    file << "{\n";
+    file << "  \"devicePreference\": \"" << EscapeJson(mPerfOptions.devicePreference) << "\",\n";
+    file << "  \"powerPreference\": \"" << EscapeJson(mPerfOptions.powerPreference) << "\",\n";
+    file << "  \"hardwareConcurrency\": " << std::thread::hardware_concurrency() << ",\n";
+    file << "  \"threadCount\": " << mPerfOptions.threadCount << ",\n";
+    file << "  \"warmupIterations\": " << mPerfOptions.warmupIterations << ",\n";
+    file << "  \"results\": [";
+    for (size_t i = 0; i < mResults.size(); ++i) {
+        const PerfTestResult& result = mResults[i];
+        file << (i == 0 ? "\n" : ",\n");
+        file << "    {\"name\": \"" << EscapeJson(result.name) << "\", \"unit\": \"ms\""
+             << ", \"iterations\": " << result.iterations << ", \"build\": " << result.buildTime
+             << ", \"min\": " << result.min << ", \"mean\": " << result.mean
+             << ", \"p50\": " << result.p50 << ", \"p90\": " << result.p90
+             << ", \"p99\": " << result.p99 << ", \"max\": " << result.max << "}";
+    }
+    file << "\n  ]\n}\n";
+}
+
+void WebnnPerfTest::RunPerfTest(const wnn::GraphBuilder& builder,
+                                const std::vector<utils::NamedOperand>& outputs,
+                                const std::vector<NamedShape>& inputShapes,
+                                const std::vector<NamedShape>& outputShapes) {
+    const PerfTestOptions& options = gPerfTestEnv->GetPerfOptions();
+
+    auto buildStart = std::chrono::steady_clock::now();
+    const wnn::Graph graph = utils::Build(builder, outputs);
+    DoFlush();
+    Milliseconds buildTime = std::chrono::steady_clock::now() - buildStart;
+    ASSERT_TRUE(graph);
+
+    // Binding once keeps the creation of the named inputs and outputs out of the timed loop.
+    std::vector<std::vector<float>> buffers;
+    buffers.reserve(inputShapes.size() + outputShapes.size());
+    std::vector<wnn::Input> inputs;
+    inputs.reserve(inputShapes.size());
+    wnn::NamedInputs namedInputs = CreateCppNamedInputs();
+    for (auto& input : inputShapes) {
+        buffers.emplace_back(utils::SizeOfShape(input.shape));
+        std::vector<float>& data = buffers.back();
+        for (size_t i = 0; i < data.size(); ++i) {
+            data[i] = static_cast<float>(i % 256) / 256.0f;
+        }
+        wnn::Input wnnInput = {};
+        wnnInput.resource.arrayBufferView = {data.data(), data.size() * sizeof(float)};
+        inputs.push_back(wnnInput);
+        namedInputs.Set(input.name.c_str(), &inputs.back());
+    }
+    std::vector<wnn::Resource> resources;
+    resources.reserve(outputShapes.size());
+    wnn::NamedOutputs namedOutputs = CreateCppNamedOutputs();
+    for (auto& output : outputShapes) {
+        buffers.emplace_back(utils::SizeOfShape(output.shape));
+        wnn::Resource resource = {};
+        resource.arrayBufferView = {buffers.back().data(), buffers.back().size() * sizeof(float)};
+        resources.push_back(resource);
+        namedOutputs.Set(output.name.c_str(), &resources.back());
+    }
+    graph.Bind(namedInputs, namedOutputs);
+
+    for (uint32_t i = 0; i < options.warmupIterations; ++i) {
+        graph.ComputeBound();
+        DoFlush();
+    }
+    std::vector<double> samples;
+    samples.reserve(options.iterations);
+    for (uint32_t i = 0; i < options.iterations; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        graph.ComputeBound();
+        DoFlush();
+        samples.push_back(Milliseconds(std::chrono::steady_clock::now() - start).count());
+    }
+    std::sort(samples.begin(), samples.end());
+
+    const testing::TestInfo* testInfo = testing::UnitTest::GetInstance()->current_test_info();
+    PerfTestResult result;
+    result.name = std::string(testInfo->test_suite_name()) + "." + testInfo->name();
+    result.iterations = options.iterations;
+    result.buildTime = buildTime.count();
+    result.min = samples.front();
+    result.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+    result.p50 = Percentile(samples, 50);
+    result.p90 = Percentile(samples, 90);
+    result.p99 = Percentile(samples, 99);
+    result.max = samples.back();
+    gPerfTestEnv->AddResult(result);
+
+    dawn::InfoLog() << result.name << ": build " << result.buildTime << " ms, p50 " << result.p50
+                    << " ms, p90 " << result.p90 << " ms, p99 " << result.p99 << " ms";
+}
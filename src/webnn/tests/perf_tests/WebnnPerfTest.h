@@ -0,0 +1,78 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TESTS_PERF_TESTS_WEBNN_PERF_TEST_H_
+#define TESTS_PERF_TESTS_WEBNN_PERF_TEST_H_
+
+#include <string>
+#include <vector>
+
+#include "webnn/tests/WebnnTest.h"
+
+struct PerfTestOptions {
+    std::string devicePreference = "default";
+    std::string powerPreference = "default";
+    uint32_t warmupIterations = 10;
+    uint32_t iterations = 100;
+    // The threads of the context, zero lets the backend choose.
+    uint32_t threadCount = 0;
+    // Where the results are written as JSON, nothing is written if empty.
+    std::string outputPath;
+};
+
+struct PerfTestResult {
+    std::string name;
+    uint32_t iterations;
+    double buildTime;
+    // Statistics of the compute time over the timed iterations, in milliseconds.
+    double min;
+    double mean;
+    double p50;
+    double p90;
+    double p99;
+    double max;
+};
+
+void InitWebnnPerfTestEnvironment(int argc, char** argv);
+
+class WebnnPerfTestEnvironment : public WebnnTestEnvironment {
+  public:
+    explicit WebnnPerfTestEnvironment(const PerfTestOptions& perfOptions);
+    void TearDown() override;
+
+    const PerfTestOptions& GetPerfOptions() const;
+    void AddResult(const PerfTestResult& result);
+
+  private:
+    PerfTestOptions mPerfOptions;
+    wnn::ContextOptions mContextOptions;
+    std::vector<PerfTestResult> mResults;
+};
+
+class WebnnPerfTest : public WebnnTest {
+  protected:
+    struct NamedShape {
+        std::string name;
+        std::vector<int32_t> shape;
+    };
+
+    // Builds |outputs| with |builder|, binds inputs and outputs of the given shapes, runs the
+    // warmup iterations and then records the time of every following compute.
+    void RunPerfTest(const wnn::GraphBuilder& builder,
+                     const std::vector<utils::NamedOperand>& outputs,
+                     const std::vector<NamedShape>& inputShapes,
+                     const std::vector<NamedShape>& outputShapes);
+};
+
+#endif  // TESTS_PERF_TESTS_WEBNN_PERF_TEST_H_
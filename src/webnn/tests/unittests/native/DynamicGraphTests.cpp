@@ -0,0 +1,296 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "webnn/native/Context.h"
+#include "webnn/native/Graph.h"
+#include "webnn/native/GraphBuilder.h"
+#include "webnn/native/NamedInputs.h"
+#include "webnn/native/NamedOperands.h"
+#include "webnn/native/NamedOutputs.h"
+#include "webnn/native/Operand.h"
+#include "webnn/native/OperandArray.h"
+#include "webnn/native/reference/GraphReference.h"
+
+namespace webnn::native { namespace {
+
+    class ReferenceContext : public ContextBase {
+      private:
+        GraphBase* CreateGraphImpl() override {
+            return new reference::Graph(this, nullptr);
+        }
+    };
+
+    class DynamicGraphTests : public testing::Test {
+      protected:
+        void SetUp() override {
+            mContext = AcquireRef(new ReferenceContext());
+            mContext->SetUncapturedErrorCallback(
+                [](WNNErrorType, char const*, void* userdata) {
+                    *static_cast<std::atomic<bool>*>(userdata) = true;
+                },
+                &mError);
+            mBuilder = AcquireRef(new GraphBuilderBase(mContext.Get()));
+            mX = BuildInput("x", {-1, 2});
+        }
+
+        Ref<OperandBase> BuildInput(char const* name, const std::vector<int32_t>& shape) {
+            OperandDescriptor desc = {wnn::OperandType::Float32, shape.data(),
+                                      static_cast<uint32_t>(shape.size())};
+            return AcquireRef(mBuilder->Input(name, &desc));
+        }
+
+        // Builds relu(x) + x, with x of shape [-1, 2].
+        Ref<GraphBase> Build() {
+            Ref<OperandBase> relu = AcquireRef(mBuilder->Relu(mX.Get()));
+            Ref<OperandBase> y = AcquireRef(mBuilder->Add(relu.Get(), mX.Get()));
+            Ref<NamedOperandsBase> namedOperands = AcquireRef(new NamedOperandsBase());
+            namedOperands->Set("y", y.Get());
+            return AcquireRef(mBuilder->Build(namedOperands.Get()));
+        }
+
+        // Computes |graph| for a batch of |batch| rows of x and checks the result.
+        void ComputeAndCheck(GraphBase* graph, int32_t batch) {
+            std::vector<float> inputData(batch * 2);
+            for (size_t i = 0; i < inputData.size(); ++i) {
+                inputData[i] = static_cast<float>(i) - batch;
+            }
+            const std::vector<int32_t> dimensions = {batch, 2};
+            Input input = {};
+            input.resource.arrayBufferView.buffer = inputData.data();
+            input.resource.arrayBufferView.byteLength = inputData.size() * sizeof(float);
+            input.dimensions = dimensions.data();
+            input.dimensionsCount = static_cast<uint32_t>(dimensions.size());
+            Ref<NamedInputsBase> inputs = AcquireRef(new NamedInputsBase());
+            inputs->Set("x", &input);
+
+            std::vector<float> outputData(inputData.size());
+            Resource output = {};
+            output.arrayBufferView.buffer = outputData.data();
+            output.arrayBufferView.byteLength = outputData.size() * sizeof(float);
+            Ref<NamedOutputsBase> outputs = AcquireRef(new NamedOutputsBase());
+            outputs->Set("y", &output);
+
+            graph->Compute(inputs.Get(), outputs.Get());
+            for (size_t i = 0; i < inputData.size(); ++i) {
+                EXPECT_EQ(outputData[i], std::max(inputData[i], 0.0f) + inputData[i]);
+            }
+        }
+
+        // Computes |graph| for |inputData| of |dimensions| given to the input |name|, the outputs
+        // are written to the buffers of |outputs|, which are sized for them.
+        void Compute(GraphBase* graph,
+                     char const* name,
+                     const std::vector<int32_t>& dimensions,
+                     std::vector<float>& inputData,
+                     const std::map<std::string, std::vector<float>*>& outputs) {
+            Input input = {};
+            input.resource.arrayBufferView.buffer = inputData.data();
+            input.resource.arrayBufferView.byteLength = inputData.size() * sizeof(float);
+            input.dimensions = dimensions.data();
+            input.dimensionsCount = static_cast<uint32_t>(dimensions.size());
+            Ref<NamedInputsBase> namedInputs = AcquireRef(new NamedInputsBase());
+            namedInputs->Set(name, &input);
+
+            std::vector<Resource> resources(outputs.size());
+            Ref<NamedOutputsBase> namedOutputs = AcquireRef(new NamedOutputsBase());
+            size_t i = 0;
+            for (auto& [outputName, outputData] : outputs) {
+                resources[i].arrayBufferView.buffer = outputData->data();
+                resources[i].arrayBufferView.byteLength = outputData->size() * sizeof(float);
+                namedOutputs->Set(outputName.c_str(), &resources[i]);
+                ++i;
+            }
+            graph->Compute(namedInputs.Get(), namedOutputs.Get());
+        }
+
+        Ref<ContextBase> mContext;
+        Ref<GraphBuilderBase> mBuilder;
+        Ref<OperandBase> mX;
+        std::atomic<bool> mError{false};
+    };
+
+    TEST_F(DynamicGraphTests, ComputeDifferentShapes) {
+        Ref<GraphBase> graph = Build();
+        ASSERT_FALSE(graph->IsError());
+        ComputeAndCheck(graph.Get(), 1);
+        ComputeAndCheck(graph.Get(), 3);
+        ComputeAndCheck(graph.Get(), 1);
+        EXPECT_FALSE(mError);
+    }
+
+    // Specializing re-infers the operators of the builder, their declared shapes are restored.
+    TEST_F(DynamicGraphTests, KeepDeclaredShapes) {
+        Ref<GraphBase> graph = Build();
+        ASSERT_FALSE(graph->IsError());
+        ComputeAndCheck(graph.Get(), 3);
+        EXPECT_EQ(mX->Shape(), (std::vector<int32_t>{-1, 2}));
+        Ref<OperandBase> relu = AcquireRef(mBuilder->Relu(mX.Get()));
+        EXPECT_EQ(relu->Shape(), (std::vector<int32_t>{-1, 2}));
+        EXPECT_FALSE(mError);
+    }
+
+    TEST_F(DynamicGraphTests, Batchable) {
+        Ref<GraphBase> graph = Build();
+        ASSERT_FALSE(graph->IsError());
+        EXPECT_TRUE(graph->IsBatchable());
+        EXPECT_FALSE(mError);
+    }
+
+    // The leading dimension of the output is twice the one of the input, the output of a batch
+    // isn't the outputs of its slices concatenated.
+    TEST_F(DynamicGraphTests, NotBatchable) {
+        const std::vector<int32_t> newShape = {-1, 1};
+        Ref<OperandBase> y =
+            AcquireRef(mBuilder->Reshape(mX.Get(), newShape.data(), newShape.size()));
+        Ref<NamedOperandsBase> namedOperands = AcquireRef(new NamedOperandsBase());
+        namedOperands->Set("y", y.Get());
+        Ref<GraphBase> graph = AcquireRef(mBuilder->Build(namedOperands.Get()));
+        ASSERT_FALSE(graph->IsError());
+        EXPECT_FALSE(graph->IsBatchable());
+        EXPECT_FALSE(mError);
+    }
+
+    // The graphs built by a builder specialize on other threads while it adds operators and
+    // builds, which all wait for each other.
+    TEST_F(DynamicGraphTests, ComputeWhileBuilding) {
+        Ref<GraphBase> first = Build();
+        Ref<GraphBase> second = Build();
+        ASSERT_FALSE(first->IsError());
+        ASSERT_FALSE(second->IsError());
+        constexpr int32_t kMaxBatch = 20;
+        std::thread firstThread([&] {
+            for (int32_t batch = 1; batch <= kMaxBatch; ++batch) {
+                ComputeAndCheck(first.Get(), batch);
+            }
+        });
+        std::thread secondThread([&] {
+            for (int32_t batch = kMaxBatch; batch >= 1; --batch) {
+                ComputeAndCheck(second.Get(), batch);
+            }
+        });
+        for (int32_t i = 0; i < kMaxBatch; ++i) {
+            Ref<GraphBase> graph = Build();
+            EXPECT_FALSE(graph->IsError());
+        }
+        firstThread.join();
+        secondThread.join();
+        EXPECT_EQ(mX->Shape(), (std::vector<int32_t>{-1, 2}));
+        EXPECT_FALSE(mError);
+    }
+
+    // The dynamic dimensions are carried through the shapes inferred by conv2d, pool2d and the
+    // element-wise operators.
+    TEST_F(DynamicGraphTests, InferDynamicDimensions) {
+        Ref<OperandBase> input = BuildInput("input", {-1, 1, -1, 6});
+        Ref<OperandBase> filter = BuildInput("filter", {2, 1, 3, 3});
+        Ref<OperandBase> conv = AcquireRef(mBuilder->Conv2d(input.Get(), filter.Get(), nullptr));
+        EXPECT_EQ(conv->Shape(), (std::vector<int32_t>{-1, 2, -1, 4}));
+
+        const std::vector<int32_t> windowDimensions = {2, 2};
+        const std::vector<int32_t> strides = {2, 2};
+        Pool2dOptions options;
+        options.windowDimensions = windowDimensions.data();
+        options.windowDimensionsCount = windowDimensions.size();
+        options.strides = strides.data();
+        options.stridesCount = strides.size();
+        Ref<OperandBase> pool = AcquireRef(mBuilder->MaxPool2d(conv.Get(), &options));
+        EXPECT_EQ(pool->Shape(), (std::vector<int32_t>{-1, 2, -1, 2}));
+
+        Ref<OperandBase> bias = BuildInput("bias", {2, 1, 1});
+        Ref<OperandBase> add = AcquireRef(mBuilder->Add(pool.Get(), bias.Get()));
+        EXPECT_EQ(add->Shape(), (std::vector<int32_t>{-1, 2, -1, 2}));
+        Ref<OperandBase> relu = AcquireRef(mBuilder->Relu(add.Get()));
+        EXPECT_EQ(relu->Shape(), (std::vector<int32_t>{-1, 2, -1, 2}));
+
+        // A global pooling with explicit padding has static output sizes.
+        Ref<OperandBase> global = AcquireRef(mBuilder->AveragePool2d(relu.Get(), nullptr));
+        EXPECT_EQ(global->Shape(), (std::vector<int32_t>{-1, 2, 1, 1}));
+        EXPECT_FALSE(mError);
+    }
+
+    // Only -1 marks a dynamic dimension.
+    TEST_F(DynamicGraphTests, RejectNegativeDimensions) {
+        Ref<OperandBase> input = BuildInput("input", {-2, 2});
+        EXPECT_TRUE(input->IsError());
+        EXPECT_TRUE(mError);
+    }
+
+    TEST_F(DynamicGraphTests, RejectUnsupportedOperator) {
+        Ref<OperandBase> y = AcquireRef(mBuilder->Squeeze(mX.Get(), nullptr));
+        EXPECT_TRUE(y->IsError());
+        EXPECT_TRUE(mError);
+    }
+
+    // The size of the input must be even, it is validated once it is given.
+    TEST_F(DynamicGraphTests, ReshapeToPairs) {
+        Ref<OperandBase> z = BuildInput("z", {-1});
+        const std::vector<int32_t> newShape = {-1, 2};
+        Ref<OperandBase> y =
+            AcquireRef(mBuilder->Reshape(z.Get(), newShape.data(), newShape.size()));
+        EXPECT_EQ(y->Shape(), (std::vector<int32_t>{-1, 2}));
+        Ref<NamedOperandsBase> namedOperands = AcquireRef(new NamedOperandsBase());
+        namedOperands->Set("y", y.Get());
+        Ref<GraphBase> graph = AcquireRef(mBuilder->Build(namedOperands.Get()));
+        ASSERT_FALSE(graph->IsError());
+        EXPECT_FALSE(mError);
+
+        std::vector<float> inputData = {1, 2, 3, 4};
+        std::vector<float> outputData(4);
+        Compute(graph.Get(), "z", {4}, inputData, {{"y", &outputData}});
+        EXPECT_EQ(outputData, inputData);
+        EXPECT_FALSE(mError);
+
+        std::vector<float> oddData = {1, 2, 3};
+        Compute(graph.Get(), "z", {3}, oddData, {{"y", &outputData}});
+        EXPECT_TRUE(mError);
+    }
+
+    // The batch must split evenly in two, it is validated once it is given.
+    TEST_F(DynamicGraphTests, SplitEvenly) {
+        const std::vector<uint32_t> splits = {2};
+        Ref<OperandArrayBase> y =
+            AcquireRef(mBuilder->Split(mX.Get(), splits.data(), splits.size(), nullptr));
+        ASSERT_FALSE(y->IsError());
+        ASSERT_EQ(y->Size(), 2u);
+        EXPECT_EQ(y->Get(0)->Shape(), (std::vector<int32_t>{-1, 2}));
+        EXPECT_EQ(y->Get(1)->Shape(), (std::vector<int32_t>{-1, 2}));
+        Ref<NamedOperandsBase> namedOperands = AcquireRef(new NamedOperandsBase());
+        namedOperands->Set("y0", y->Get(0));
+        namedOperands->Set("y1", y->Get(1));
+        Ref<GraphBase> graph = AcquireRef(mBuilder->Build(namedOperands.Get()));
+        ASSERT_FALSE(graph->IsError());
+        EXPECT_FALSE(mError);
+
+        std::vector<float> inputData = {1, 2, 3, 4, 5, 6, 7, 8};
+        std::vector<float> y0(4), y1(4);
+        Compute(graph.Get(), "x", {4, 2}, inputData, {{"y0", &y0}, {"y1", &y1}});
+        EXPECT_EQ(y0, (std::vector<float>{1, 2, 3, 4}));
+        EXPECT_EQ(y1, (std::vector<float>{5, 6, 7, 8}));
+        EXPECT_FALSE(mError);
+
+        std::vector<float> oddData = {1, 2, 3, 4, 5, 6};
+        Compute(graph.Get(), "x", {3, 2}, oddData, {{"y0", &y0}, {"y1", &y1}});
+        EXPECT_TRUE(mError);
+    }
+
+}}  // namespace webnn::native::
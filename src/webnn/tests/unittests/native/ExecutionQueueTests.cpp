@@ -0,0 +1,103 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "webnn/native/ExecutionQueue.h"
+
+namespace webnn::native { namespace {
+
+    // Tasks with the same key run in submission order, even with several workers.
+    TEST(ExecutionQueueTests, OrderedPerKey) {
+        constexpr int kTaskCount = 100;
+        std::mutex mutex;
+        std::vector<int> first, second;
+        {
+            ExecutionQueue queue(4, 8);
+            for (int i = 0; i < kTaskCount; ++i) {
+                queue.Submit(&first, [&mutex, &first, i] {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    first.push_back(i);
+                });
+                queue.Submit(&second, [&mutex, &second, i] {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    second.push_back(i);
+                });
+            }
+        }
+        ASSERT_EQ(first.size(), size_t(kTaskCount));
+        ASSERT_EQ(second.size(), size_t(kTaskCount));
+        for (int i = 0; i < kTaskCount; ++i) {
+            EXPECT_EQ(first[i], i);
+            EXPECT_EQ(second[i], i);
+        }
+    }
+
+    // Submit waits while the pending limit is reached.
+    TEST(ExecutionQueueTests, Backpressure) {
+        std::promise<void> release;
+        std::shared_future<void> released = release.get_future().share();
+        std::atomic<bool> submitted(false);
+        {
+            ExecutionQueue queue(1, 1);
+            queue.Submit(&queue, [released] { released.wait(); });
+            std::thread producer([&queue, &submitted] {
+                queue.Submit(&queue, [] {});
+                submitted = true;
+            });
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            EXPECT_FALSE(submitted.load());
+            release.set_value();
+            producer.join();
+            EXPECT_TRUE(submitted.load());
+        }
+    }
+
+    // Wait returns once the tasks already queued for the key are done, the tasks of other keys
+    // aren't waited for.
+    TEST(ExecutionQueueTests, WaitIsOrdered) {
+        std::promise<void> release;
+        std::shared_future<void> released = release.get_future().share();
+        std::atomic<bool> done(false);
+        int other = 0;
+        ExecutionQueue queue(2, 8);
+        queue.Submit(&other, [released] { released.wait(); });
+        queue.Submit(&queue, [&done] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            done = true;
+        });
+        queue.Wait(&queue);
+        EXPECT_TRUE(done.load());
+        release.set_value();
+    }
+
+    // From a task of the same key, Wait returns instead of deadlocking.
+    TEST(ExecutionQueueTests, WaitFromWorker) {
+        std::promise<bool> done;
+        ExecutionQueue queue(1, 1);
+        queue.Submit(&queue, [&queue, &done] {
+            queue.Wait(&queue);
+            done.set_value(true);
+        });
+        EXPECT_TRUE(done.get_future().get());
+    }
+
+}}  // namespace webnn::native::
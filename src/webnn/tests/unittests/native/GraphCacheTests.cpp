@@ -0,0 +1,79 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "webnn/native/GraphCache.h"
+
+namespace webnn::native { namespace {
+
+    class GraphCacheTests : public testing::Test {
+      protected:
+        // Each test writes under its own key so that the runs don't see each other's blobs.
+        std::string GetKey() const {
+            return testing::UnitTest::GetInstance()->current_test_info()->name();
+        }
+
+        const std::string mDirectory = testing::TempDir();
+    };
+
+    TEST_F(GraphCacheTests, WriteThenRead) {
+        const std::vector<float> data = {1, 2, 3, 4};
+        WriteCachedBlob(mDirectory, GetKey(), "blob", data.data(), data.size() * sizeof(float));
+        std::vector<float> read(data.size());
+        EXPECT_TRUE(
+            ReadCachedBlob(mDirectory, GetKey(), "blob", read.data(), read.size() * sizeof(float)));
+        EXPECT_EQ(read, data);
+    }
+
+    TEST_F(GraphCacheTests, MissingBlob) {
+        std::vector<float> read(4);
+        EXPECT_FALSE(ReadCachedBlob(mDirectory, GetKey(), "missing", read.data(),
+                                    read.size() * sizeof(float)));
+    }
+
+    // A blob of another size is never read, e.g. one written for a different layout.
+    TEST_F(GraphCacheTests, SizeMismatch) {
+        const std::vector<float> data = {1, 2, 3, 4};
+        WriteCachedBlob(mDirectory, GetKey(), "blob", data.data(), data.size() * sizeof(float));
+        std::vector<float> read(data.size() + 1);
+        EXPECT_FALSE(
+            ReadCachedBlob(mDirectory, GetKey(), "blob", read.data(), read.size() * sizeof(float)));
+        read.resize(data.size() - 1);
+        EXPECT_FALSE(
+            ReadCachedBlob(mDirectory, GetKey(), "blob", read.data(), read.size() * sizeof(float)));
+    }
+
+    TEST_F(GraphCacheTests, HashCacheName) {
+        const std::string state = "onednn-state";
+        const std::string otherState = "onednn-other-state";
+        EXPECT_EQ(HashCacheName(state.data(), state.size()),
+                  HashCacheName(state.data(), state.size()));
+        EXPECT_NE(HashCacheName(state.data(), state.size()),
+                  HashCacheName(otherState.data(), otherState.size()));
+        EXPECT_EQ(HashCacheName(state.data(), state.size()).size(), 16u);
+    }
+
+    // Empty hashers get the same key, it's what two builds of the same graph start from.
+    TEST_F(GraphCacheTests, HasherIsDeterministic) {
+        GraphHasher hasher(nullptr);
+        GraphHasher otherHasher(nullptr);
+        EXPECT_EQ(hasher.GetKey(), otherHasher.GetKey());
+        EXPECT_EQ(hasher.GetKey().size(), 16u);
+    }
+
+}}  // namespace webnn::native::
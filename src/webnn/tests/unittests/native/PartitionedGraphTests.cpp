@@ -0,0 +1,173 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "webnn/native/Context.h"
+#include "webnn/native/Graph.h"
+#include "webnn/native/GraphBuilder.h"
+#include "webnn/native/NamedInputs.h"
+#include "webnn/native/NamedOperands.h"
+#include "webnn/native/NamedOutputs.h"
+#include "webnn/native/Operand.h"
+#include "webnn/native/ops/Unary.h"
+#include "webnn/native/reference/GraphReference.h"
+
+namespace webnn::native { namespace {
+
+    // A reference graph that rejects sigmoids when they are added, like a backend without them.
+    // With |failFinish| it also fails to finish, like a backend running out of memory.
+    class RejectingGraph : public reference::Graph {
+      public:
+        RejectingGraph(ContextBase* context, InternalErrorType rejection, bool failFinish)
+            : reference::Graph(context, nullptr), mRejection(rejection), mFailFinish(failFinish) {
+        }
+
+        MaybeError AddUnary(const op::Unary* unary) override {
+            if (unary->GetType() != op::UnaryOpType::kSigmoid) {
+                return reference::Graph::AddUnary(unary);
+            }
+            if (mRejection == InternalErrorType::Unimplemented) {
+                return DAWN_UNIMPLEMENTED_ERROR("Sigmoid is not supported.");
+            }
+            return DAWN_VALIDATION_ERROR("Sigmoid is invalid.");
+        }
+
+        MaybeError Finish() override {
+            if (mFailFinish) {
+                return DAWN_INTERNAL_ERROR("Failed to allocate the graph.");
+            }
+            return reference::Graph::Finish();
+        }
+
+      private:
+        InternalErrorType mRejection;
+        bool mFailFinish;
+    };
+
+    class RejectingContext : public ContextBase {
+      public:
+        RejectingContext(ContextOptions const* options,
+                         InternalErrorType rejection,
+                         bool failFinish)
+            : ContextBase(options), mRejection(rejection), mFailFinish(failFinish) {
+        }
+
+      private:
+        GraphBase* CreateGraphImpl() override {
+            return new RejectingGraph(this, mRejection, mFailFinish);
+        }
+
+        InternalErrorType mRejection;
+        bool mFailFinish;
+    };
+
+    class PartitionedGraphTests : public testing::Test {
+      protected:
+        // Builds relu(sigmoid(relu(x))) so that the sigmoid splits the graph in three.
+        Ref<GraphBase> Build(bool operatorFallback,
+                             InternalErrorType rejection,
+                             bool failFinish = false) {
+            ContextOptions options;
+            options.operatorFallback = operatorFallback;
+            mContext = AcquireRef(new RejectingContext(&options, rejection, failFinish));
+            mContext->SetUncapturedErrorCallback(
+                [](WNNErrorType, char const*, void* userdata) {
+                    *static_cast<bool*>(userdata) = true;
+                },
+                &mError);
+
+            Ref<GraphBuilderBase> builder = AcquireRef(new GraphBuilderBase(mContext.Get()));
+            const std::vector<int32_t> shape = {2, 2};
+            OperandDescriptor desc = {wnn::OperandType::Float32, shape.data(),
+                                      static_cast<uint32_t>(shape.size())};
+            Ref<OperandBase> x = AcquireRef(builder->Input("x", &desc));
+            Ref<OperandBase> relu = AcquireRef(builder->Relu(x.Get()));
+            Ref<OperandBase> sigmoid = AcquireRef(builder->Sigmoid(relu.Get()));
+            Ref<OperandBase> y = AcquireRef(builder->Relu(sigmoid.Get()));
+            Ref<NamedOperandsBase> namedOperands = AcquireRef(new NamedOperandsBase());
+            namedOperands->Set("y", y.Get());
+            return AcquireRef(builder->Build(namedOperands.Get()));
+        }
+
+        std::vector<float> Compute(GraphBase* graph, const std::vector<float>& inputData) {
+            Input input = {};
+            input.resource.arrayBufferView.buffer = const_cast<float*>(inputData.data());
+            input.resource.arrayBufferView.byteLength = inputData.size() * sizeof(float);
+            Ref<NamedInputsBase> inputs = AcquireRef(new NamedInputsBase());
+            inputs->Set("x", &input);
+
+            std::vector<float> outputData(inputData.size());
+            Resource output = {};
+            output.arrayBufferView.buffer = outputData.data();
+            output.arrayBufferView.byteLength = outputData.size() * sizeof(float);
+            Ref<NamedOutputsBase> outputs = AcquireRef(new NamedOutputsBase());
+            outputs->Set("y", &output);
+
+            graph->Compute(inputs.Get(), outputs.Get());
+            return outputData;
+        }
+
+        void ExpectValues(const std::vector<float>& actual, const std::vector<float>& expected) {
+            ASSERT_EQ(actual.size(), expected.size());
+            for (size_t i = 0; i < actual.size(); ++i) {
+                EXPECT_NEAR(actual[i], expected[i], 1e-5f);
+            }
+        }
+
+        Ref<ContextBase> mContext;
+        bool mError = false;
+    };
+
+    // The sigmoid runs on the reference backend, the relus before and after it on the backend.
+    TEST_F(PartitionedGraphTests, FallBackForUnimplementedOperator) {
+        Ref<GraphBase> graph = Build(true, InternalErrorType::Unimplemented);
+        ASSERT_FALSE(graph->IsError());
+        ExpectValues(Compute(graph.Get(), {-1, 0, 1, 2}), {0.5f, 0.5f, 0.7310586f, 0.8807971f});
+        EXPECT_FALSE(mError);
+    }
+
+    // Every compute uses its own intermediate buffers, nothing is left from the previous one.
+    TEST_F(PartitionedGraphTests, ComputeRepeatedly) {
+        Ref<GraphBase> graph = Build(true, InternalErrorType::Unimplemented);
+        ASSERT_FALSE(graph->IsError());
+        ExpectValues(Compute(graph.Get(), {-1, 0, 1, 2}), {0.5f, 0.5f, 0.7310586f, 0.8807971f});
+        ExpectValues(Compute(graph.Get(), {3, -3, -2, 0}), {0.9525741f, 0.5f, 0.5f, 0.5f});
+        EXPECT_FALSE(mError);
+    }
+
+    TEST_F(PartitionedGraphTests, NoFallbackWhenDisabled) {
+        Ref<GraphBase> graph = Build(false, InternalErrorType::Unimplemented);
+        EXPECT_TRUE(graph->IsError());
+        EXPECT_TRUE(mError);
+    }
+
+    // Only operators the backend doesn't implement fall back, other errors are reported.
+    TEST_F(PartitionedGraphTests, NoFallbackForValidationError) {
+        Ref<GraphBase> graph = Build(true, InternalErrorType::Validation);
+        EXPECT_TRUE(graph->IsError());
+        EXPECT_TRUE(mError);
+    }
+
+    // A partition the backend fails to build for another reason than an unimplemented operator
+    // fails the graph instead of running on the reference backend.
+    TEST_F(PartitionedGraphTests, NoFallbackForPartitionError) {
+        Ref<GraphBase> graph = Build(true, InternalErrorType::Unimplemented, true);
+        EXPECT_TRUE(graph->IsError());
+        EXPECT_TRUE(mError);
+    }
+
+}}  // namespace webnn::native::
@@ -0,0 +1,73 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "webnn/tests/unittests/validation/ValidationTest.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace testing;
+
+class ConstantValidationTest : public ValidationTest {
+  protected:
+    void SetUp() override {
+        ValidationTest::SetUp();
+        mPath = testing::TempDir() + "constant_validation_test.bin";
+        std::vector<float> data(16, 1.0f);
+        FILE* fp = fopen(mPath.c_str(), "wb");
+        ASSERT_NE(fp, nullptr);
+        fwrite(data.data(), sizeof(float), data.size(), fp);
+        fclose(fp);
+    }
+
+    void TearDown() override {
+        remove(mPath.c_str());
+        ValidationTest::TearDown();
+    }
+
+    std::string mPath;
+};
+
+TEST_F(ConstantValidationTest, ConstantFromFile) {
+    std::vector<int32_t> shape = {2, 2};
+    wnn::OperandDescriptor desc = {wnn::OperandType::Float32, shape.data(),
+                                   (uint32_t)shape.size()};
+    // success
+    { mBuilder.ConstantFromFile(&desc, mPath.c_str(), 0, 4 * sizeof(float)); }
+    // success - the range ends at the end of the file.
+    { mBuilder.ConstantFromFile(&desc, mPath.c_str(), 12 * sizeof(float), 4 * sizeof(float)); }
+    // the range is outside of the file
+    {
+        ASSERT_CONTEXT_ERROR(
+            mBuilder.ConstantFromFile(&desc, mPath.c_str(), 14 * sizeof(float), 4 * sizeof(float)));
+    }
+    // the byte length doesn't match the dimensions
+    {
+        ASSERT_CONTEXT_ERROR(mBuilder.ConstantFromFile(&desc, mPath.c_str(), 0, 3 * sizeof(float)));
+        ASSERT_CONTEXT_ERROR(mBuilder.ConstantFromFile(&desc, mPath.c_str(), 0, 8 * sizeof(float)));
+    }
+    // the byte length is given for another type
+    {
+        wnn::OperandDescriptor halfDesc = {wnn::OperandType::Float16, shape.data(),
+                                           (uint32_t)shape.size()};
+        ASSERT_CONTEXT_ERROR(
+            mBuilder.ConstantFromFile(&halfDesc, mPath.c_str(), 0, 4 * sizeof(float)));
+    }
+    // the file doesn't exist
+    {
+        std::string path = mPath + ".missing";
+        ASSERT_CONTEXT_ERROR(mBuilder.ConstantFromFile(&desc, path.c_str(), 0, 4 * sizeof(float)));
+    }
+}
@@ -25,8 +25,9 @@ class GraphValidationTest : public ValidationTest {
         wnn::OperandDescriptor inputDesc = {wnn::OperandType::Float32, shape.data(),
                                             (uint32_t)shape.size()};
         wnn::Operand a = mBuilder.Input("input", &inputDesc);
-        std::vector<float> data(4, 1);
-        wnn::ArrayBufferView arrayBuffer = {data.data(), data.size() * sizeof(float)};
+        mConstantData.assign(4, 1);
+        wnn::ArrayBufferView arrayBuffer = {mConstantData.data(),
+                                            mConstantData.size() * sizeof(float)};
         wnn::Operand b = mBuilder.Constant(&inputDesc, &arrayBuffer);
         mOutput = mBuilder.Add(a, b);
     }
@@ -36,6 +37,8 @@ class GraphValidationTest : public ValidationTest {
     }
 
     wnn::Operand mOutput;
+    // The Null backend copies constants when the graph is built.
+    std::vector<float> mConstantData;
 };
 
 // Test the simple success case.
@@ -15,6 +15,7 @@
 #include "webnn/wire/ChunkedCommandHandler.h"
 
 #include "common/Alloc.h"
+#include "webnn/wire/WireTrace.h"
 
 #include <algorithm>
 #include <cstring>
@@ -23,8 +24,13 @@ namespace webnn::wire {
 
     ChunkedCommandHandler::~ChunkedCommandHandler() = default;
 
+    void ChunkedCommandHandler::SetTraceEventCallback(TraceEventCallback traceEvent) {
+        mTraceEvent = traceEvent;
+    }
+
     const volatile char* ChunkedCommandHandler::HandleCommands(const volatile char* commands,
                                                                size_t size) {
+        ScopedWireTrace trace(mTraceEvent, "HandleCommands");
         if (mChunkedCommandRemainingSize > 0) {
             // If there is a chunked command in flight, append the command data.
             // We append at most |mChunkedCommandRemainingSize| which is enough to finish the
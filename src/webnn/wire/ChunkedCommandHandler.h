@@ -29,6 +29,8 @@ namespace webnn::wire {
         const volatile char* HandleCommands(const volatile char* commands, size_t size) override;
         ~ChunkedCommandHandler() override;
 
+        void SetTraceEventCallback(TraceEventCallback traceEvent);
+
       protected:
         enum class ChunkedCommandsResult {
             Passthrough,
@@ -61,6 +63,7 @@ namespace webnn::wire {
                                                       size_t commandSize,
                                                       size_t initialSize);
 
+        TraceEventCallback mTraceEvent = nullptr;
         size_t mChunkedCommandRemainingSize = 0;
         size_t mChunkedCommandPutOffset = 0;
         std::unique_ptr<char[]> mChunkedCommandData;
@@ -19,6 +19,7 @@
 #include "common/Compiler.h"
 #include "webnn/wire/Wire.h"
 #include "webnn/wire/WireCmd_autogen.h"
+#include "webnn/wire/WireTrace.h"
 
 #include <algorithm>
 #include <cstring>
@@ -30,6 +31,10 @@ namespace webnn::wire {
       public:
         ChunkedCommandSerializer(CommandSerializer* serializer);
 
+        void SetTraceEventCallback(TraceEventCallback traceEvent) {
+            mTraceEvent = traceEvent;
+        }
+
         template <typename Cmd>
         void SerializeCommand(const Cmd& cmd) {
             SerializeCommand(cmd, 0, [](char*) {});
@@ -71,6 +76,7 @@ namespace webnn::wire {
                                   SerializeCmdFn&& SerializeCmd,
                                   size_t extraSize,
                                   ExtraSizeSerializeFn&& SerializeExtraSize) {
+            ScopedWireTrace trace(mTraceEvent, "SerializeCommand");
             size_t commandSize = cmd.GetRequiredSize();
             size_t requiredSize = commandSize + extraSize;
 
@@ -96,6 +102,7 @@ namespace webnn::wire {
 
         CommandSerializer* mSerializer;
         size_t mMaxAllocationSize;
+        TraceEventCallback mTraceEvent = nullptr;
     };
 
 }  // namespace webnn::wire
@@ -18,7 +18,7 @@
 namespace webnn::wire {
 
     WireClient::WireClient(const WireClientDescriptor& descriptor)
-        : mImpl(new client::Client(descriptor.serializer)) {
+        : mImpl(new client::Client(descriptor.serializer, descriptor.traceEvent)) {
     }
 
     WireClient::~WireClient() {
@@ -18,7 +18,11 @@
 namespace webnn::wire {
 
     WireServer::WireServer(const WireServerDescriptor& descriptor)
-        : mImpl(new server::Server(*descriptor.procs, descriptor.serializer)) {
+        : mImpl(new server::Server(*descriptor.procs,
+                                   descriptor.serializer,
+                                   descriptor.maxComputeBatchSize,
+                                   descriptor.traceEvent,
+                                   descriptor.constantFileDirectory)) {
     }
 
     WireServer::~WireServer() {
@@ -29,6 +33,10 @@ namespace webnn::wire {
         return mImpl->HandleCommands(commands, size);
     }
 
+    void WireServer::ProcessEvents() {
+        mImpl->ProcessEvents();
+    }
+
     bool WireServer::InjectInstance(WNNInstance instance, uint32_t id, uint32_t generation) {
         return mImpl->InjectInstance(instance, id, generation);
     }
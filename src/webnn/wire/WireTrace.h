@@ -0,0 +1,53 @@
+// Copyright 2022 The WebNN-native Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef WEBNN_WIRE_WIRETRACE_H_
+#define WEBNN_WIRE_WIRETRACE_H_
+
+#include <chrono>
+
+#include "webnn/wire/Wire.h"
+
+namespace webnn::wire {
+
+    // Reports the time spent within its scope to |callback| unless it's null.
+    class ScopedWireTrace {
+      public:
+        ScopedWireTrace(TraceEventCallback callback, const char* name)
+            : mCallback(callback), mName(name), mStart(callback != nullptr ? Now() : 0) {
+        }
+        ~ScopedWireTrace() {
+            if (mCallback != nullptr) {
+                mCallback("wire", mName, mStart, Now() - mStart);
+            }
+        }
+
+        ScopedWireTrace(const ScopedWireTrace&) = delete;
+        ScopedWireTrace& operator=(const ScopedWireTrace&) = delete;
+
+      private:
+        static uint64_t Now() {
+            return std::chrono::duration_cast<std::chrono::microseconds>(
+                       std::chrono::steady_clock::now().time_since_epoch())
+                .count();
+        }
+
+        TraceEventCallback mCallback;
+        const char* mName;
+        uint64_t mStart;
+    };
+
+}  // namespace webnn::wire
+
+#endif  // WEBNN_WIRE_WIRETRACE_H_
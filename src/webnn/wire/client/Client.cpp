@@ -43,7 +43,10 @@ namespace webnn::wire::client {
 
     }  // anonymous namespace
 
-    Client::Client(CommandSerializer* serializer) : ClientBase(), mSerializer(serializer) {
+    Client::Client(CommandSerializer* serializer, TraceEventCallback traceEvent)
+        : ClientBase(), mSerializer(serializer) {
+        SetTraceEventCallback(traceEvent);
+        mSerializer.SetTraceEventCallback(traceEvent);
     }
 
     Client::~Client() {
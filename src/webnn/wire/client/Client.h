@@ -30,7 +30,7 @@ namespace webnn::wire::client {
 
     class Client : public ClientBase {
       public:
-        Client(CommandSerializer* serializer);
+        Client(CommandSerializer* serializer, TraceEventCallback traceEvent = nullptr);
         ~Client() override;
 
         // ChunkedCommandHandler implementation
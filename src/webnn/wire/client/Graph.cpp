@@ -58,6 +58,37 @@ namespace webnn::wire::client {
         client->SerializeCommand(cmd);
     }
 
+    void Graph::Bind(WNNNamedInputs inputs, WNNNamedOutputs outputs) {
+        NamedInputs* namedInputs = FromAPI(inputs);
+        NamedOutputs* namedOutputs = FromAPI(outputs);
+
+        GraphBindCmd cmd;
+        cmd.graphId = this->id;
+        cmd.inputsId = namedInputs->id;
+        cmd.outputsId = namedOutputs->id;
+
+        client->SerializeCommand(cmd);
+    }
+
+    void Graph::ComputeBound() {
+        GraphComputeBoundCmd cmd;
+        cmd.graphId = this->id;
+
+        client->SerializeCommand(cmd);
+    }
+
+    uint32_t Graph::GetProfileEntryCount() {
+        return 0;
+    }
+
+    void Graph::GetProfileEntry(uint32_t index, WNNProfileEntry* entry) {
+        // There are no entries to get.
+    }
+
+    bool Graph::IsBatchable() {
+        return false;
+    }
+
     bool Graph::OnComputeAsyncCallback(uint64_t requestSerial,
                                        WNNErrorType type,
                                        const char* message) {
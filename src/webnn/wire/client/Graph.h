@@ -33,6 +33,13 @@ namespace webnn::wire::client {
                           WNNNamedOutputs outputs,
                           WNNComputeAsyncCallback callback,
                           void* userdata);
+        void Bind(WNNNamedInputs inputs, WNNNamedOutputs outputs);
+        void ComputeBound();
+        // The profile is recorded by the server and isn't sent back, so it's always empty.
+        uint32_t GetProfileEntryCount();
+        void GetProfileEntry(uint32_t index, WNNProfileEntry* entry);
+        // Batching is decided by the server, which computes the graph.
+        bool IsBatchable();
         bool OnComputeAsyncCallback(uint64_t requestSerial, WNNErrorType type, const char* message);
 
       private:
@@ -31,7 +31,7 @@ namespace webnn::wire::client {
             cmd.byteOffset = arrayBufferView.byteOffset;
 
             // Save the WNNArrayBufferView in order to be copied after computing from server.
-            mNamedOutputMap.insert(std::make_pair(std::string(name), arrayBufferView));
+            mNamedOutputMap[std::string(name)] = arrayBufferView;
         } else {
             cmd.gpuBufferId = resource->gpuBufferView.id;
             cmd.gpuBufferGeneration = resource->gpuBufferView.generation;
@@ -18,8 +18,19 @@
 
 namespace webnn::wire::server {
 
-    Server::Server(const WebnnProcTable& procs, CommandSerializer* serializer)
-        : mSerializer(serializer), mProcs(procs), mIsAlive(std::make_shared<bool>(true)) {
+    Server::Server(const WebnnProcTable& procs,
+                   CommandSerializer* serializer,
+                   uint32_t maxComputeBatchSize,
+                   TraceEventCallback traceEvent,
+                   const char* constantFileDirectory)
+        : mSerializer(serializer),
+          mProcs(procs),
+          mConstantFileDirectory(constantFileDirectory != nullptr ? constantFileDirectory : ""),
+          mMaxComputeBatchSize(maxComputeBatchSize),
+          mComputeCompletions(std::make_shared<ComputeCompletions>()),
+          mIsAlive(std::make_shared<bool>(true)) {
+        SetTraceEventCallback(traceEvent);
+        mSerializer.SetTraceEventCallback(traceEvent);
     }
 
     Server::~Server() {
@@ -38,6 +49,28 @@ namespace webnn::wire::server {
         // mProcs.contextSetContextLostCallback(context, nullptr, nullptr);
     }
 
+    void Server::OnObjectDestroyed(ObjectType objectType, ObjectId objectId) {
+        switch (objectType) {
+            case ObjectType::Graph:
+                mBoundOutputsMap.erase(objectId);
+                break;
+            case ObjectType::NamedOutputs:
+                for (auto it = mBoundOutputsMap.begin(); it != mBoundOutputsMap.end();) {
+                    if (it->second == objectId) {
+                        it = mBoundOutputsMap.erase(it);
+                    } else {
+                        ++it;
+                    }
+                }
+                break;
+            case ObjectType::NamedInputs:
+                mInputRecords.erase(objectId);
+                break;
+            default:
+                break;
+        }
+    }
+
     bool Server::InjectInstance(WNNInstance instance, uint32_t id, uint32_t generation) {
         ASSERT(instance != nullptr);
         ObjectData<WNNInstance>* data = InstanceObjects().Allocate(id);
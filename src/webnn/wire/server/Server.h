@@ -19,7 +19,13 @@
 #include "webnn/wire/ChunkedCommandSerializer.h"
 #include "webnn/wire/server/ServerBase_autogen.h"
 
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #if defined(WEBNN_ENABLE_GPU_BUFFER)
 #    include <dawn/wire/WireServer.h>
@@ -104,11 +110,34 @@ namespace webnn::wire::server {
         ObjectHandle graph;
         uint64_t requestSerial;
         ObjectId namedOutputsObjectID;
+        uint32_t namedOutputsGeneration;
+        // The outputs to send back, taken when the compute is queued.
+        std::vector<std::string> outputNames;
+    };
+
+    // The native compute callbacks fire on the worker threads of the contexts, possibly after
+    // the server has been destroyed, so they only queue the completions. The server handles
+    // them on its own thread, where the serializer and the object maps may be used.
+    struct ComputeCompletions {
+        using Callback = std::function<void(WNNErrorType type, const char* message)>;
+        struct Completion {
+            Callback callback;
+            WNNErrorType type;
+            std::string message;
+        };
+
+        std::mutex mutex;
+        std::condition_variable completed;
+        std::vector<Completion> completions;
     };
 
     class Server : public ServerBase {
       public:
-        Server(const WebnnProcTable& procs, CommandSerializer* serializer);
+        Server(const WebnnProcTable& procs,
+               CommandSerializer* serializer,
+               uint32_t maxComputeBatchSize = 1,
+               TraceEventCallback traceEvent = nullptr,
+               const char* constantFileDirectory = nullptr);
         ~Server() override;
 
         // ChunkedCommandHandler implementation
@@ -128,6 +157,10 @@ namespace webnn::wire::server {
         bool InjectNamedOperands(WNNNamedOperands namedOperands, uint32_t id, uint32_t generation);
         bool InjectNamedOutputs(WNNNamedOutputs namedOutputs, uint32_t id, uint32_t generation);
 
+        // Sends the replies of the asynchronous computes which have completed since the last
+        // call. It's also done whenever commands are handled.
+        void ProcessEvents();
+
         template <typename T,
                   typename Enable = std::enable_if<std::is_base_of<CallbackUserdata, T>::value>>
         std::unique_ptr<T> MakeUserdata() {
@@ -148,6 +181,8 @@ namespace webnn::wire::server {
         }
 
         void ClearContextCallbacks(WNNContext context);
+        // Drops the server-side state kept for an object so that a reused id doesn't see it.
+        void OnObjectDestroyed(ObjectType objectType, ObjectId objectId);
 
 #if defined(WEBNN_ENABLE_GPU_BUFFER)
         WGPUDevice GetWGPUDevice(uint32_t id, uint32_t generation);
@@ -162,11 +197,48 @@ namespace webnn::wire::server {
         void OnGraphComputeAsyncCallback(ComputeAsyncUserdata* userdata,
                                          WNNErrorType type,
                                          const char* message);
+
+        // Batching of GraphComputeAsync commands, see WireServerDescriptor::maxComputeBatchSize.
+        struct PendingCompute {
+            ObjectId graphId;
+            uint64_t requestSerial;
+            ObjectId inputsId;
+            ObjectId outputsId;
+        };
+        // Computes the pending requests, it's called before any other command is handled so
+        // that they see the objects as they were when the requests were made.
+        void FlushPendingComputes();
+        void ComputeAsync(const PendingCompute& request, std::vector<std::string> outputNames);
+        std::vector<std::string> TakeOutputNames(ObjectId outputsId);
+        // The named inputs and outputs of the queued computes can't be set again until the
+        // computes are done, the native objects update their data in place.
+        void BeginCompute(const PendingCompute& request);
+        void EndCompute(const PendingCompute& request);
+        void WaitForComputes(const std::map<ObjectId, size_t>& computing, ObjectId id);
+        // Computes |graph| on the execution queue of its context, |callback| is called by
+        // ProcessEvents once it's done.
+        void QueueCompute(WNNGraph graph,
+                          WNNNamedInputs inputs,
+                          WNNNamedOutputs outputs,
+                          ComputeCompletions::Callback callback);
+        // Returns false if the requests can't be computed as one batch.
+        bool ComputeBatch(const std::vector<PendingCompute>& batch);
+        void OnComputeBatchDone(const std::vector<PendingCompute>& batch,
+                                const std::vector<std::string>& outputNames,
+                                const std::vector<std::vector<size_t>>& byteLengths,
+                                const std::vector<uint32_t>& generations,
+                                WNNNamedOutputs namedOutputs,
+                                WNNErrorType type);
 #include "webnn/wire/server/ServerPrototypes_autogen.inc"
 
         WireDeserializeAllocator mAllocator;
         ChunkedCommandSerializer mSerializer;
         WebnnProcTable mProcs;
+        // See WireServerDescriptor::constantFileDirectory, empty when no file is allowed.
+        std::string mConstantFileDirectory;
+        // Gives the canonical path of |path|, returns false unless it's a file under
+        // mConstantFileDirectory.
+        bool ResolveConstantFile(const char* path, std::string* resolvedPath) const;
 
 #if defined(WEBNN_ENABLE_GPU_BUFFER)
         dawn::wire::WireServer* mDawnWireServer;
@@ -174,7 +246,26 @@ namespace webnn::wire::server {
         // Save the output names in server because char** type isn't supported in webnn.json to get
         // name.
         std::map<ObjectId, std::vector<std::string>> mOutputNamesMap;
-        bool SerializeComputeResult(ObjectId outputsId);
+        // The named outputs bound to each graph by GraphBind. Their names are kept across
+        // GraphComputeBound commands instead of being reset after one compute.
+        std::map<ObjectId, ObjectId> mBoundOutputsMap;
+        bool SerializeComputeResult(ObjectId outputsId, bool keepOutputNames = false);
+        bool SerializeComputeResult(ObjectId outputsId,
+                                    const std::vector<std::string>& outputNames);
+
+        uint32_t mMaxComputeBatchSize;
+        std::vector<PendingCompute> mPendingComputes;
+        // The data and dimensions of the named inputs, kept to concatenate the inputs of a batch
+        // because the native named inputs can't be read back.
+        struct InputRecord {
+            std::vector<uint8_t> data;
+            std::vector<int32_t> dimensions;
+        };
+        std::map<ObjectId, std::map<std::string, InputRecord>> mInputRecords;
+
+        std::shared_ptr<ComputeCompletions> mComputeCompletions;
+        std::map<ObjectId, size_t> mComputingNamedInputs;
+        std::map<ObjectId, size_t> mComputingNamedOutputs;
 
         std::shared_ptr<bool> mIsAlive;
     };
@@ -16,14 +16,69 @@
 #include "webnn/wire/WireCmd_autogen.h"
 #include "webnn/wire/server/Server.h"
 
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+
 namespace webnn::wire::server {
 
-    bool Server::SerializeComputeResult(ObjectId outputsId) {
+    namespace {
+        struct QueuedCompute {
+            std::shared_ptr<ComputeCompletions> completions;
+            ComputeCompletions::Callback callback;
+        };
+
+        // Runs on a worker thread of the context, see ComputeCompletions.
+        void OnQueuedComputeDone(WNNErrorType type, const char* message, void* userdata) {
+            std::unique_ptr<QueuedCompute> compute(static_cast<QueuedCompute*>(userdata));
+            std::lock_guard<std::mutex> lock(compute->completions->mutex);
+            compute->completions->completions.push_back(
+                {std::move(compute->callback), type, message});
+            compute->completions->completed.notify_one();
+        }
+    }  // namespace
+
+    void Server::QueueCompute(WNNGraph graph,
+                              WNNNamedInputs inputs,
+                              WNNNamedOutputs outputs,
+                              ComputeCompletions::Callback callback) {
+        auto* compute = new QueuedCompute{mComputeCompletions, std::move(callback)};
+        mProcs.graphComputeAsync(graph, inputs, outputs, OnQueuedComputeDone, compute);
+    }
+
+    void Server::ProcessEvents() {
+        std::vector<ComputeCompletions::Completion> completions;
+        {
+            std::lock_guard<std::mutex> lock(mComputeCompletions->mutex);
+            completions.swap(mComputeCompletions->completions);
+        }
+        for (auto& completion : completions) {
+            completion.callback(completion.type, completion.message.c_str());
+        }
+    }
+
+    bool Server::SerializeComputeResult(ObjectId outputsId, bool keepOutputNames) {
+        if (mOutputNamesMap.find(outputsId) == mOutputNamesMap.end() ||
+            !SerializeComputeResult(outputsId, mOutputNamesMap[outputsId])) {
+            return false;
+        }
+        // Reset the mOutputNamesMap which host in the server.
+        if (!keepOutputNames) {
+            mOutputNamesMap.erase(outputsId);
+        }
+        return true;
+    }
+
+    bool Server::SerializeComputeResult(ObjectId outputsId,
+                                        const std::vector<std::string>& outputNames) {
         auto* namedOutputs = NamedOutputsObjects().Get(outputsId);
-        if (mOutputNamesMap.find(outputsId) == mOutputNamesMap.end()) {
+        if (namedOutputs == nullptr) {
             return false;
         }
-        for (auto& name : mOutputNamesMap[outputsId]) {
+        for (auto& name : outputNames) {
             WNNArrayBufferView arrayBuffer = {};
             mProcs.namedOutputsGet(namedOutputs->handle, name.data(), &arrayBuffer);
             if (arrayBuffer.buffer == nullptr) {
@@ -39,8 +94,6 @@ namespace webnn::wire::server {
             cmd.byteOffset = arrayBuffer.byteOffset;
             SerializeCommand(cmd);
         }
-        // Reset the mOutputNamesMap which host in the server.
-        mOutputNamesMap.erase(outputsId);
         return true;
     }
 
@@ -72,22 +125,309 @@ namespace webnn::wire::server {
             return false;
         }
 
+        // Consecutive requests for the same graph are coalesced until another command comes.
+        if (!mPendingComputes.empty() && mPendingComputes.back().graphId != graphId) {
+            FlushPendingComputes();
+        }
+        mPendingComputes.push_back({graphId, requestSerial, inputsId, outputsId});
+        if (mPendingComputes.size() >= mMaxComputeBatchSize) {
+            FlushPendingComputes();
+        }
+        return true;
+    }
+
+    void Server::FlushPendingComputes() {
+        if (mPendingComputes.empty()) {
+            return;
+        }
+        std::vector<PendingCompute> batch = std::move(mPendingComputes);
+        mPendingComputes.clear();
+        if (batch.size() > 1 && ComputeBatch(batch)) {
+            return;
+        }
+        for (auto& request : batch) {
+            ComputeAsync(request, TakeOutputNames(request.outputsId));
+        }
+    }
+
+    void Server::BeginCompute(const PendingCompute& request) {
+        ++mComputingNamedInputs[request.inputsId];
+        ++mComputingNamedOutputs[request.outputsId];
+    }
+
+    void Server::EndCompute(const PendingCompute& request) {
+        if (--mComputingNamedInputs[request.inputsId] == 0) {
+            mComputingNamedInputs.erase(request.inputsId);
+        }
+        if (--mComputingNamedOutputs[request.outputsId] == 0) {
+            mComputingNamedOutputs.erase(request.outputsId);
+        }
+    }
+
+    void Server::WaitForComputes(const std::map<ObjectId, size_t>& computing, ObjectId id) {
+        while (computing.find(id) != computing.end()) {
+            {
+                std::unique_lock<std::mutex> lock(mComputeCompletions->mutex);
+                mComputeCompletions->completed.wait(
+                    lock, [this] { return !mComputeCompletions->completions.empty(); });
+            }
+            ProcessEvents();
+        }
+    }
+
+    std::vector<std::string> Server::TakeOutputNames(ObjectId outputsId) {
+        // The names are reset after each compute, like SerializeComputeResult does.
+        std::vector<std::string> outputNames;
+        auto outputs = mOutputNamesMap.find(outputsId);
+        if (outputs != mOutputNamesMap.end()) {
+            outputNames = std::move(outputs->second);
+            mOutputNamesMap.erase(outputs);
+        }
+        return outputNames;
+    }
+
+    void Server::ComputeAsync(const PendingCompute& request,
+                              std::vector<std::string> outputNames) {
+        auto* graph = GraphObjects().Get(request.graphId);
+        auto* namedInputs = NamedInputsObjects().Get(request.inputsId);
+        auto* namedOutputs = NamedOutputsObjects().Get(request.outputsId);
+        ASSERT(graph != nullptr && namedInputs != nullptr && namedOutputs != nullptr);
+
         auto userdata = MakeUserdata<ComputeAsyncUserdata>();
-        userdata->requestSerial = requestSerial;
-        userdata->graph = ObjectHandle{graphId, graph->generation};
-        userdata->namedOutputsObjectID = outputsId;
+        userdata->requestSerial = request.requestSerial;
+        userdata->graph = ObjectHandle{request.graphId, graph->generation};
+        userdata->namedOutputsObjectID = request.outputsId;
+        userdata->namedOutputsGeneration = namedOutputs->generation;
+        userdata->outputNames = std::move(outputNames);
 
-        mProcs.graphComputeAsync(graph->handle, namedInputs->handle, namedOutputs->handle,
-                                 ForwardToServer<&Server::OnGraphComputeAsyncCallback>,
-                                 userdata.release());
+        std::shared_ptr<ComputeAsyncUserdata> reply(std::move(userdata));
+        BeginCompute(request);
+        QueueCompute(graph->handle, namedInputs->handle, namedOutputs->handle,
+                     [this, request, reply](WNNErrorType type, const char* message) {
+                         EndCompute(request);
+                         OnGraphComputeAsyncCallback(reply.get(), type, message);
+                     });
+    }
+
+    bool Server::ComputeBatch(const std::vector<PendingCompute>& batch) {
+        std::vector<WNNInstance> instances = InstanceObjects().GetAllHandles();
+        auto* graph = GraphObjects().Get(batch[0].graphId);
+        auto firstInputs = mInputRecords.find(batch[0].inputsId);
+        auto firstOutputs = mOutputNamesMap.find(batch[0].outputsId);
+        // The graph must have a dynamic leading dimension on every input and output which is
+        // the batch size, a static graph would only compute the first request of the batch.
+        if (instances.empty() || !mProcs.graphIsBatchable(graph->handle) ||
+            firstInputs == mInputRecords.end() || firstOutputs == mOutputNamesMap.end()) {
+            return false;
+        }
+        const std::map<std::string, InputRecord>& firstRecords = firstInputs->second;
+        const std::vector<std::string> outputNames = firstOutputs->second;
+
+        // The requests must give the dimensions of their inputs and only differ in the leading
+        // one, their batch size, and must not write to the same named outputs.
+        auto isBatchable = [](const InputRecord& first, const InputRecord& record) {
+            const std::vector<int32_t>& a = first.dimensions;
+            const std::vector<int32_t>& b = record.dimensions;
+            if (a.empty() || a.size() != b.size() || a[0] <= 0 || b[0] <= 0 ||
+                !std::equal(a.begin() + 1, a.end(), b.begin() + 1)) {
+                return false;
+            }
+            return first.data.size() * b[0] == record.data.size() * a[0];
+        };
+        std::set<ObjectId> outputsIds;
+        std::vector<int32_t> batchSizes;
+        for (auto& request : batch) {
+            auto inputs = mInputRecords.find(request.inputsId);
+            auto outputs = mOutputNamesMap.find(request.outputsId);
+            if (inputs == mInputRecords.end() || inputs->second.size() != firstRecords.size() ||
+                outputs == mOutputNamesMap.end() || outputs->second != outputNames ||
+                !outputsIds.insert(request.outputsId).second) {
+                return false;
+            }
+            int32_t batchSize = 0;
+            for (auto& [name, record] : inputs->second) {
+                auto first = firstRecords.find(name);
+                if (first == firstRecords.end() || !isBatchable(first->second, record) ||
+                    (batchSize != 0 && record.dimensions[0] != batchSize)) {
+                    return false;
+                }
+                batchSize = record.dimensions[0];
+            }
+            if (batchSize <= 0) {
+                return false;
+            }
+            batchSizes.push_back(batchSize);
+        }
+
+        // The leading dimension of the outputs of the batch is the summed batch size, so the
+        // outputs of every request must hold its batch size of rows of the same byte length.
+        // |byteLengths| are the byte lengths of the outputs of each request, in the order of
+        // |outputNames|.
+        std::vector<std::vector<size_t>> byteLengths(batch.size());
+        std::vector<size_t> batchedByteLengths;
+        for (auto& name : outputNames) {
+            size_t rowByteLength = 0;
+            size_t batchedByteLength = 0;
+            for (size_t i = 0; i < batch.size(); ++i) {
+                WNNArrayBufferView view = {};
+                mProcs.namedOutputsGet(NamedOutputsObjects().Get(batch[i].outputsId)->handle,
+                                       name.data(), &view);
+                if (view.buffer == nullptr || view.byteLength % batchSizes[i] != 0 ||
+                    (i > 0 && view.byteLength / batchSizes[i] != rowByteLength)) {
+                    return false;
+                }
+                rowByteLength = view.byteLength / batchSizes[i];
+                byteLengths[i].push_back(view.byteLength);
+                batchedByteLength += view.byteLength;
+            }
+            batchedByteLengths.push_back(batchedByteLength);
+        }
+
+        // Concatenate the inputs along the leading dimension.
+        WNNNamedInputs namedInputs = mProcs.instanceCreateNamedInputs(instances[0]);
+        std::vector<std::vector<uint8_t>> inputData;
+        std::vector<std::vector<int32_t>> inputDimensions;
+        inputData.reserve(firstRecords.size());
+        inputDimensions.reserve(firstRecords.size());
+        for (auto& [name, first] : firstRecords) {
+            std::vector<uint8_t>& data = inputData.emplace_back();
+            std::vector<int32_t>& dimensions = inputDimensions.emplace_back(first.dimensions);
+            dimensions[0] = 0;
+            for (auto& request : batch) {
+                const InputRecord& record = mInputRecords[request.inputsId][name];
+                data.insert(data.end(), record.data.begin(), record.data.end());
+                dimensions[0] += record.dimensions[0];
+            }
+            WNNInput input = {};
+            input.resource.arrayBufferView.buffer = data.data();
+            input.resource.arrayBufferView.byteLength = data.size();
+            input.dimensions = dimensions.data();
+            input.dimensionsCount = dimensions.size();
+            mProcs.namedInputsSet(namedInputs, name.c_str(), &input);
+        }
+        WNNNamedOutputs namedOutputs = mProcs.instanceCreateNamedOutputs(instances[0]);
+        for (size_t i = 0; i < outputNames.size(); ++i) {
+            WNNResource resource = {};
+            resource.arrayBufferView.byteLength = batchedByteLengths[i];
+            mProcs.namedOutputsSet(namedOutputs, outputNames[i].c_str(), &resource);
+        }
+        std::vector<uint32_t> generations;
+        for (auto& request : batch) {
+            generations.push_back(NamedOutputsObjects().Get(request.outputsId)->generation);
+            TakeOutputNames(request.outputsId);
+            BeginCompute(request);
+        }
+
+        QueueCompute(graph->handle, namedInputs, namedOutputs,
+                     [this, batch, outputNames, byteLengths, generations, namedInputs,
+                      namedOutputs](WNNErrorType type, const char*) {
+                         OnComputeBatchDone(batch, outputNames, byteLengths, generations,
+                                            namedOutputs, type);
+                         mProcs.namedInputsRelease(namedInputs);
+                         mProcs.namedOutputsRelease(namedOutputs);
+                     });
         return true;
     }
 
+    void Server::OnComputeBatchDone(const std::vector<PendingCompute>& batch,
+                                    const std::vector<std::string>& outputNames,
+                                    const std::vector<std::vector<size_t>>& byteLengths,
+                                    const std::vector<uint32_t>& generations,
+                                    WNNNamedOutputs namedOutputs,
+                                    WNNErrorType type) {
+        for (auto& request : batch) {
+            EndCompute(request);
+        }
+        std::vector<size_t> offsets(outputNames.size(), 0);
+        for (size_t i = 0; i < batch.size(); ++i) {
+            const PendingCompute& request = batch[i];
+            auto* graph = GraphObjects().Get(request.graphId);
+            auto* requestInputs = NamedInputsObjects().Get(request.inputsId);
+            auto* requestOutputs = NamedOutputsObjects().Get(request.outputsId);
+            bool dropped = graph == nullptr || requestInputs == nullptr ||
+                           requestOutputs == nullptr ||
+                           requestOutputs->generation != generations[i];
+            bool failed = type != WNNErrorType_NoError;
+            // Scatter the outputs back to the request, they must not have been set again while
+            // the batch was computed.
+            for (size_t j = 0; j < outputNames.size() && !dropped && !failed; ++j) {
+                WNNArrayBufferView view = {};
+                mProcs.namedOutputsGet(requestOutputs->handle, outputNames[j].data(), &view);
+                if (view.buffer == nullptr || view.byteLength != byteLengths[i][j]) {
+                    failed = true;
+                    break;
+                }
+                WNNArrayBufferView batched = {};
+                mProcs.namedOutputsGet(namedOutputs, outputNames[j].data(), &batched);
+                memcpy(view.buffer, static_cast<const uint8_t*>(batched.buffer) + offsets[j],
+                       view.byteLength);
+            }
+            for (size_t j = 0; j < outputNames.size(); ++j) {
+                offsets[j] += byteLengths[i][j];
+            }
+            if (dropped) {
+                // The request has been dropped with its objects while the batch was computed.
+                continue;
+            }
+            if (failed) {
+                // Computing the requests one by one reports the error to the request that caused
+                // it.
+                ComputeAsync(request, outputNames);
+                continue;
+            }
+
+            auto userdata = MakeUserdata<ComputeAsyncUserdata>();
+            userdata->requestSerial = request.requestSerial;
+            userdata->graph = ObjectHandle{request.graphId, graph->generation};
+            userdata->namedOutputsObjectID = request.outputsId;
+            userdata->namedOutputsGeneration = requestOutputs->generation;
+            userdata->outputNames = outputNames;
+            OnGraphComputeAsyncCallback(userdata.get(), WNNErrorType_NoError, "");
+        }
+    }
+
+    bool Server::DoGraphBind(ObjectId graphId, ObjectId inputsId, ObjectId outputsId) {
+        auto* graph = GraphObjects().Get(graphId);
+        auto* namedInputs = NamedInputsObjects().Get(inputsId);
+        auto* namedOutputs = NamedOutputsObjects().Get(outputsId);
+        if (graph == nullptr || namedInputs == nullptr || namedOutputs == nullptr) {
+            return false;
+        }
+
+        mProcs.graphBind(graph->handle, namedInputs->handle, namedOutputs->handle);
+        mBoundOutputsMap[graphId] = outputsId;
+        return true;
+    }
+
+    bool Server::DoGraphComputeBound(ObjectId graphId) {
+        auto* graph = GraphObjects().Get(graphId);
+        if (graph == nullptr) {
+            return false;
+        }
+
+        mProcs.graphComputeBound(graph->handle);
+
+#if defined(WEBNN_ENABLE_GPU_BUFFER)
+        return true;
+#else
+        auto boundOutputs = mBoundOutputsMap.find(graphId);
+        if (boundOutputs == mBoundOutputsMap.end() ||
+            NamedOutputsObjects().Get(boundOutputs->second) == nullptr) {
+            // The native graph has already reported the missing binding as a validation error.
+            return true;
+        }
+        return SerializeComputeResult(boundOutputs->second, true);
+#endif
+    }
+
     void Server::OnGraphComputeAsyncCallback(ComputeAsyncUserdata* userdata,
                                              WNNErrorType type,
                                              const char* message) {
-        if (type == WNNErrorType_NoError) {
-            SerializeComputeResult(userdata->namedOutputsObjectID);
+        // The named outputs may have been destroyed while the compute was queued.
+        auto* namedOutputs = NamedOutputsObjects().Get(userdata->namedOutputsObjectID);
+        if (type == WNNErrorType_NoError && namedOutputs != nullptr &&
+            namedOutputs->generation == userdata->namedOutputsGeneration) {
+            SerializeComputeResult(userdata->namedOutputsObjectID, userdata->outputNames);
         }
         ReturnGraphComputeAsyncCallbackCmd cmd;
         cmd.graph = userdata->graph;
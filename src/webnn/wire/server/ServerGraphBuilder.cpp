@@ -15,8 +15,63 @@
 
 #include "webnn/wire/server/Server.h"
 
+#include <stdlib.h>
+
 namespace webnn::wire::server {
 
+    namespace {
+        // Resolves the symbolic links and the relative components of |path|, returns false if
+        // it doesn't exist.
+        bool GetCanonicalPath(const char* path, std::string* canonicalPath) {
+#if defined(_WIN32)
+            char* resolved = _fullpath(nullptr, path, 0);
+#else
+            char* resolved = realpath(path, nullptr);
+#endif
+            if (resolved == nullptr) {
+                return false;
+            }
+            *canonicalPath = resolved;
+            free(resolved);
+            return true;
+        }
+    }  // namespace
+
+    bool Server::ResolveConstantFile(const char* path, std::string* resolvedPath) const {
+        std::string directory;
+        if (mConstantFileDirectory.empty() ||
+            !GetCanonicalPath(mConstantFileDirectory.c_str(), &directory) ||
+            !GetCanonicalPath(path, resolvedPath)) {
+            return false;
+        }
+#if defined(_WIN32)
+        const char separator = '\\';
+#else
+        const char separator = '/';
+#endif
+        if (directory.back() != separator) {
+            directory += separator;
+        }
+        return resolvedPath->compare(0, directory.size(), directory) == 0;
+    }
+
+    bool Server::DoGraphBuilderConstantFromFile(WNNGraphBuilder self,
+                                                WNNOperandDescriptor const* desc,
+                                                char const* path,
+                                                size_t byteOffset,
+                                                size_t byteLength,
+                                                WNNOperand* result) {
+        // The path names a file of the server, a client must not map files outside of the
+        // directory allowed by the embedder. A rejected path fails like a missing file.
+        std::string resolvedPath;
+        if (!ResolveConstantFile(path, &resolvedPath)) {
+            resolvedPath.clear();
+        }
+        *result = mProcs.graphBuilderConstantFromFile(self, desc, resolvedPath.c_str(), byteOffset,
+                                                      byteLength);
+        return true;
+    }
+
     bool Server::DoGraphBuilderConstantInternal(ObjectId graphBuilderId,
                                                 WNNOperandDescriptor const* desc,
                                                 uint8_t const* buffer,
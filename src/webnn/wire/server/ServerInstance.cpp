@@ -17,6 +17,17 @@
 
 namespace webnn::wire { namespace server {
 
+    bool Server::PreHandleInstanceCreateContext(const InstanceCreateContextCmd& cmd) {
+        if (cmd.options != nullptr) {
+            // The options name paths on the server, a client must not make it read or write
+            // files there.
+            auto* options = const_cast<WNNContextOptions*>(cmd.options);
+            options->cacheDirectory = nullptr;
+            options->traceFile = nullptr;
+        }
+        return true;
+    }
+
     bool Server::DoInstanceCreateContextWithGpuDeviceInternal(ObjectId instanceId,
                                                               uint8_t const* device,
                                                               uint32_t id,
@@ -30,6 +30,7 @@ namespace webnn::wire::server {
         if (namedInputs == nullptr) {
             return false;
         }
+        WaitForComputes(mComputingNamedInputs, namedInputsId);
 
         // The type of output data is ArrayBufferView
         WNNInput input = {};
@@ -39,6 +40,17 @@ namespace webnn::wire::server {
             value.byteLength = byteLength;
             value.byteOffset = byteOffset;
             input.resource.arrayBufferView = value;
+            if (mMaxComputeBatchSize > 1) {
+                // Inputs with an offset aren't batched, they have no record.
+                auto& records = mInputRecords[namedInputsId];
+                if (byteOffset == 0) {
+                    InputRecord& record = records[std::string(name)];
+                    record.data.assign(buffer, buffer + byteLength);
+                    record.dimensions.assign(dimensions, dimensions + dimensionsCount);
+                } else {
+                    records.erase(std::string(name));
+                }
+            }
         } else {
 #if defined(WEBNN_ENABLE_GPU_BUFFER)
             WNNGpuBufferView value = {};
@@ -15,6 +15,8 @@
 
 #include "webnn/wire/server/Server.h"
 
+#include <algorithm>
+
 namespace webnn::wire::server {
 
     bool Server::DoNamedOutputsSet(ObjectId namedOutputsId,
@@ -27,6 +29,7 @@ namespace webnn::wire::server {
         if (namedOutputs == nullptr) {
             return false;
         }
+        WaitForComputes(mComputingNamedOutputs, namedOutputsId);
 
         WNNResource resource = {};
         if (gpuBufferId != 0) {
@@ -46,8 +49,11 @@ namespace webnn::wire::server {
                 names.push_back(std::string(name));
                 mOutputNamesMap.insert(std::make_pair(namedOutputsId, std::move(names)));
             } else {
+                // Setting a bound output again must not duplicate its name.
                 auto& outputNames = mOutputNamesMap[namedOutputsId];
-                outputNames.push_back(std::string(name));
+                if (std::find(outputNames.begin(), outputNames.end(), name) == outputNames.end()) {
+                    outputNames.push_back(std::string(name));
+                }
             }
         }
         mProcs.namedOutputsSet(namedOutputs->handle, name, &resource);